@@ -14,6 +14,8 @@ SET (CPP_BINDING_SRC
     ${CMAKE_CURRENT_SOURCE_DIR}/cpp_package/src/board_shim.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/cpp_package/src/ml_model.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/cpp_package/src/data_filter.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/cpp_package/src/inference_pipeline.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/cpp_package/src/board_shim_group.cpp
 )
 
 add_library (
@@ -37,6 +39,8 @@ install (
     ${CMAKE_CURRENT_SOURCE_DIR}/cpp_package/src/inc/data_filter.h
     ${CMAKE_CURRENT_SOURCE_DIR}/cpp_package/src/inc/board_shim.h
     ${CMAKE_CURRENT_SOURCE_DIR}/cpp_package/src/inc/ml_model.h
+    ${CMAKE_CURRENT_SOURCE_DIR}/cpp_package/src/inc/inference_pipeline.h
+    ${CMAKE_CURRENT_SOURCE_DIR}/cpp_package/src/inc/board_shim_group.h
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/inc/brainflow_array.h
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/inc/brainflow_exception.h
     DESTINATION inc
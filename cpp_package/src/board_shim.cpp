@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <stdlib.h>
 #include <string.h>
@@ -200,7 +201,7 @@ BrainFlowArray<double, 2> BoardShim::get_board_data (int num_datapoints, int pre
             "invalid num_datapoints", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
     }
     int num_samples = std::min (get_board_data_count (preset), num_datapoints);
-    int num_data_channels = get_num_rows (get_board_id (), preset);
+    int num_data_channels = get_session_num_rows (preset);
     double *buf = new double[num_samples * num_data_channels];
     int res = ::get_board_data (num_samples, preset, buf, board_id, serialized_params.c_str ());
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
@@ -215,7 +216,7 @@ BrainFlowArray<double, 2> BoardShim::get_board_data (int num_datapoints, int pre
 
 BrainFlowArray<double, 2> BoardShim::get_current_board_data (int num_samples, int preset)
 {
-    int num_data_channels = BoardShim::get_num_rows (get_board_id (), preset);
+    int num_data_channels = get_session_num_rows (preset);
     double *buf = new double[num_samples * num_data_channels];
     int len = 0;
     int res = ::get_current_board_data (
@@ -230,6 +231,38 @@ BrainFlowArray<double, 2> BoardShim::get_current_board_data (int num_samples, in
     return matrix;
 }
 
+BrainFlowArray<double, 2> BoardShim::get_board_data_by_time (
+    double start_time, double end_time, int preset)
+{
+    int max_samples = get_board_data_count (preset);
+    int num_data_channels = get_session_num_rows (preset);
+    std::vector<double> buf (std::max<size_t> (1, (size_t)max_samples * num_data_channels));
+    int len = 0;
+    int res = ::get_board_data_by_time (start_time, end_time, max_samples, preset, buf.data (),
+        &len, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get board data by time", res);
+    }
+    return BrainFlowArray<double, 2> (buf.data (), num_data_channels, len);
+}
+
+BrainFlowArray<double, 2> BoardShim::pop_board_data_by_time (
+    double start_time, double end_time, int preset)
+{
+    int max_samples = get_board_data_count (preset);
+    int num_data_channels = get_session_num_rows (preset);
+    std::vector<double> buf (std::max<size_t> (1, (size_t)max_samples * num_data_channels));
+    int len = 0;
+    int res = ::pop_board_data_by_time (start_time, end_time, max_samples, preset, buf.data (),
+        &len, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to pop board data by time", res);
+    }
+    return BrainFlowArray<double, 2> (buf.data (), num_data_channels, len);
+}
+
 std::string BoardShim::config_board (std::string config)
 {
     int response_len = 0;
@@ -262,6 +295,265 @@ void BoardShim::insert_marker (double value, int preset)
     }
 }
 
+int BoardShim::get_session_num_rows (int preset)
+{
+    int num_rows = 0;
+    int res = ::get_session_num_rows (preset, &num_rows, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get session num rows", res);
+    }
+    return num_rows;
+}
+
+std::vector<double> BoardShim::get_package_loss_stats (int preset)
+{
+    std::vector<double> stats (4, 0.0);
+    int res = ::get_package_loss_stats (preset, stats.data (), board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get package loss stats", res);
+    }
+    return stats;
+}
+
+void BoardShim::set_lost_packages_fill (bool enable, int max_gap, int preset)
+{
+    int res = ::set_lost_packages_fill (
+        (int)enable, max_gap, preset, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to set lost packages fill", res);
+    }
+}
+
+void BoardShim::set_buffer_duration (double seconds, int preset)
+{
+    int res = ::set_buffer_duration (seconds, preset, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to set buffer duration", res);
+    }
+}
+
+void BoardShim::resize_buffer (int buffer_size, int preset)
+{
+    int res = ::resize_buffer (buffer_size, preset, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to resize buffer", res);
+    }
+}
+
+void BoardShim::set_resampling (int method, int preset)
+{
+    int res = ::set_resampling (method, preset, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to set resampling", res);
+    }
+}
+
+int BoardShim::add_epoch_definition (std::vector<double> marker_values, int pre_samples,
+    int post_samples, int max_epochs, int preset)
+{
+    int definition_id = 0;
+    int res = ::add_epoch_definition (marker_values.data (), (int)marker_values.size (),
+        pre_samples, post_samples, max_epochs, preset, &definition_id, board_id,
+        serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to add epoch definition", res);
+    }
+    epoch_definitions[definition_id] = std::make_pair (preset, pre_samples + post_samples + 1);
+    return definition_id;
+}
+
+void BoardShim::remove_epoch_definition (int definition_id)
+{
+    int res = ::remove_epoch_definition (definition_id, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to remove epoch definition", res);
+    }
+    epoch_definitions.erase (definition_id);
+}
+
+int BoardShim::get_epoch_count (int definition_id)
+{
+    int count = 0;
+    int res = ::get_epoch_count (definition_id, &count, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get epoch count", res);
+    }
+    return count;
+}
+
+long long BoardShim::get_num_dropped_epochs (int definition_id)
+{
+    double count = 0;
+    int res =
+        ::get_num_dropped_epochs (definition_id, &count, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get number of dropped epochs", res);
+    }
+    return (long long)count;
+}
+
+BrainFlowArray<double, 3> BoardShim::get_epochs (int definition_id)
+{
+    auto definition = epoch_definitions.find (definition_id);
+    if (definition == epoch_definitions.end ())
+    {
+        throw BrainFlowException (
+            "no such epoch definition", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    int num_epochs = get_epoch_count (definition_id);
+    int num_rows = get_session_num_rows (definition->second.first);
+    int epoch_size = definition->second.second;
+    std::vector<double> buf (std::max<size_t> (1, (size_t)num_epochs * num_rows * epoch_size));
+    int returned_epochs = 0;
+    int res = ::get_epochs (definition_id, num_epochs, buf.data (), &returned_epochs, board_id,
+        serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get epochs", res);
+    }
+    return BrainFlowArray<double, 3> (buf.data (), returned_epochs, num_rows, epoch_size);
+}
+
+void BoardShim::enable_signal_quality_monitor (std::string config, int preset)
+{
+    int res = ::enable_signal_quality_monitor (
+        config.c_str (), preset, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to enable signal quality monitor", res);
+    }
+}
+
+void BoardShim::disable_signal_quality_monitor (int preset)
+{
+    int res = ::disable_signal_quality_monitor (preset, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to disable signal quality monitor", res);
+    }
+}
+
+BrainFlowArray<double, 2> BoardShim::get_signal_quality (int preset)
+{
+    const int num_metrics = 7;
+    // number of monitored channels doesnt exceed number of rows
+    std::vector<double> buf ((size_t)get_session_num_rows (preset) * num_metrics);
+    int num_channels = 0;
+    int res = ::get_signal_quality (
+        preset, buf.data (), &num_channels, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get signal quality", res);
+    }
+    return BrainFlowArray<double, 2> (buf.data (), num_channels, num_metrics);
+}
+
+void BoardShim::enable_history (int ratio, int method, double seconds, int preset)
+{
+    int res =
+        ::enable_history (ratio, method, seconds, preset, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to enable history", res);
+    }
+}
+
+void BoardShim::disable_history (int preset)
+{
+    int res = ::disable_history (preset, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to disable history", res);
+    }
+}
+
+int BoardShim::get_history_count (int preset)
+{
+    int count = 0;
+    int res = ::get_history_count (preset, &count, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get history count", res);
+    }
+    return count;
+}
+
+BrainFlowArray<double, 2> BoardShim::get_history (int num_samples, int preset)
+{
+    if (num_samples < 0)
+    {
+        throw BrainFlowException (
+            "invalid num_samples", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    int num_rows = get_session_num_rows (preset);
+    std::vector<double> buf (std::max<size_t> (1, (size_t)num_samples * num_rows));
+    int len = 0;
+    int res = ::get_history (
+        num_samples, preset, buf.data (), &len, board_id, serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get history", res);
+    }
+    return BrainFlowArray<double, 2> (buf.data (), num_rows, len);
+}
+
+std::vector<BrainFlowArray<double, 2>> BoardShim::get_current_board_data_snapshot (
+    std::vector<int> presets, std::vector<int> num_samples)
+{
+    if ((presets.empty ()) || (presets.size () != num_samples.size ()))
+    {
+        throw BrainFlowException (
+            "invalid presets or num_samples", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    std::vector<int> num_rows;
+    size_t buf_size = 0;
+    for (size_t i = 0; i < presets.size (); i++)
+    {
+        num_rows.push_back (get_session_num_rows (presets[i]));
+        buf_size += (size_t)num_rows[i] * std::max (0, num_samples[i]);
+    }
+    std::vector<double> buf (std::max<size_t> (1, buf_size));
+    std::vector<int> returned_samples (presets.size ());
+    int res = ::get_current_board_data_snapshot (presets.data (), num_samples.data (),
+        (int)presets.size (), buf.data (), returned_samples.data (), board_id,
+        serialized_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get board data snapshot", res);
+    }
+    std::vector<BrainFlowArray<double, 2>> result;
+    double *matrix = buf.data ();
+    for (size_t i = 0; i < presets.size (); i++)
+    {
+        result.push_back (BrainFlowArray<double, 2> (matrix, num_rows[i], returned_samples[i]));
+        matrix += (size_t)num_rows[i] * num_samples[i];
+    }
+    return result;
+}
+
+std::vector<BrainFlowArray<double, 2>> BoardShim::get_current_board_data_snapshot (
+    std::vector<int> presets, double seconds)
+{
+    std::vector<int> num_samples;
+    int master_board_id = get_board_id ();
+    for (int preset : presets)
+    {
+        num_samples.push_back (
+            (int)std::ceil (seconds * BoardShim::get_sampling_rate (master_board_id, preset)));
+    }
+    return get_current_board_data_snapshot (presets, num_samples);
+}
+
 int BoardShim::get_board_id ()
 {
     int master_board_id = board_id;
@@ -0,0 +1,108 @@
+#include "board_shim_group.h"
+
+
+BoardShimGroup::BoardShimGroup (std::vector<BoardShim *> boards, int preset, double sampling_rate)
+{
+    json config;
+    config["preset"] = preset;
+    config["sampling_rate"] = sampling_rate;
+    config["boards"] = json::array ();
+    for (size_t i = 0; i < boards.size (); i++)
+    {
+        if (boards[i] == NULL)
+        {
+            throw BrainFlowException (
+                "invalid board", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+        }
+        json member;
+        member["board_id"] = boards[i]->board_id;
+        member["input_params"] = json::parse (boards[i]->serialized_params);
+        config["boards"].push_back (member);
+    }
+    std::string config_str = config.dump ();
+    num_boards = (int)boards.size ();
+    group_id = -1;
+    int res = ::create_board_group (config_str.c_str (), &group_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create board group", res);
+    }
+}
+
+BoardShimGroup::~BoardShimGroup ()
+{
+    ::release_board_group (group_id);
+}
+
+void BoardShimGroup::start_stream (int buffer_size, std::string streamer_params)
+{
+    int res = ::start_board_group_stream (buffer_size, streamer_params.c_str (), group_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to start group stream", res);
+    }
+}
+
+void BoardShimGroup::stop_stream ()
+{
+    int res = ::stop_board_group_stream (group_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to stop group stream", res);
+    }
+}
+
+int BoardShimGroup::get_num_rows ()
+{
+    int num_rows = 0;
+    int res = ::get_board_group_num_rows (&num_rows, group_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get num rows", res);
+    }
+    return num_rows;
+}
+
+BrainFlowArray<double, 2> BoardShimGroup::get_data (int max_samples)
+{
+    if (max_samples < 0)
+    {
+        throw BrainFlowException (
+            "invalid max_samples", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    int num_rows = get_num_rows ();
+    std::vector<double> buf ((size_t)num_rows * max_samples);
+    int num_samples = 0;
+    int res = ::get_board_group_data (max_samples, buf.data (), &num_samples, group_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get group data", res);
+    }
+    return BrainFlowArray<double, 2> (buf.data (), num_rows, num_samples);
+}
+
+std::vector<double> BoardShimGroup::get_start_delays ()
+{
+    std::vector<double> start_delays (num_boards);
+    std::vector<double> rates (num_boards);
+    int res =
+        ::get_board_group_start_delays (start_delays.data (), rates.data (), &num_boards, group_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get group start delays", res);
+    }
+    return start_delays;
+}
+
+std::vector<double> BoardShimGroup::get_estimated_rates ()
+{
+    std::vector<double> start_delays (num_boards);
+    std::vector<double> rates (num_boards);
+    int res =
+        ::get_board_group_start_delays (start_delays.data (), rates.data (), &num_boards, group_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get group rates", res);
+    }
+    return rates;
+}
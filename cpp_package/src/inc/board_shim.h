@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cstdarg>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 // include it here to allow user include only this single file
@@ -21,6 +23,13 @@ class BoardShim
 {
     std::string serialized_params;
     struct BrainFlowInputParams params;
+    // epoch definition id -> preset and number of samples in epoch
+    std::map<int, std::pair<int, int>> epoch_definitions;
+
+    // reads ringbuffer directly to avoid allocations per update
+    friend class InferencePipeline;
+    // passes serialized params of boards to the group
+    friend class BoardShimGroup;
 
 public:
     /// disable BrainFlow loggers
@@ -253,18 +262,96 @@ public:
     /// get latest collected data, doesnt remove it from ringbuffer
     BrainFlowArray<double, 2> get_current_board_data (
         int num_samples, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /// get latest data of several presets taken at the same instant, num_samples[i] is max number
+    /// of samples for presets[i]
+    std::vector<BrainFlowArray<double, 2>> get_current_board_data_snapshot (
+        std::vector<int> presets, std::vector<int> num_samples);
+    /// same as above but the latest seconds of data of each preset
+    std::vector<BrainFlowArray<double, 2>> get_current_board_data_snapshot (
+        std::vector<int> presets, double seconds);
     /// Get board id, for some boards can be different than provided (playback, streaming)
     int get_board_id ();
     /// get number of packages in ringbuffer
     int get_board_data_count (int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /// get number of rows in data of this session, layout configured at runtime never has more
+    /// rows than get_num_rows
+    int get_session_num_rows (int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
     /// get all collected data and flush it from internal buffer
     BrainFlowArray<double, 2> get_board_data (int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
     /// get required amount of datapoints or less and flush it from internal buffer
     BrainFlowArray<double, 2> get_board_data (int num_datapoints, int preset);
+    /// get data with timestamps inside [start_time, end_time], doesnt remove it from ringbuffer
+    BrainFlowArray<double, 2> get_board_data_by_time (double start_time, double end_time,
+        int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /// get data with timestamps inside [start_time, end_time] and remove it and all older data
+    /// from ringbuffer
+    BrainFlowArray<double, 2> pop_board_data_by_time (double start_time, double end_time,
+        int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
     /// send string to a board, use it carefully and only if you understand what you are doing
     std::string config_board (std::string config);
     /// send raw bytes to a board, not implemented for majority of devices, not recommended to use
     void config_board_with_bytes (const char *bytes, int len);
     /// insert marker in data stream
     void insert_marker (double value, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /// get numbers of received, lost, duplicated and reordered packages since stream start, values
+    /// are whole numbers stored as double to hold 64 bit counters
+    std::vector<double> get_package_loss_stats (
+        int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /// push NaN filled packages instead of lost ones, gaps longer than max_gap packages are
+    /// treated as device restart and not filled
+    void set_lost_packages_fill (bool enable, int max_gap = 256,
+        int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /// keep seconds of data in ringbuffer of the preset instead of buffer_size from start_stream,
+    /// if stream is running ringbuffer is resized immediately keeping the latest data
+    void set_buffer_duration (
+        double seconds, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /// change capacity of running ringbuffer keeping the latest data
+    void resize_buffer (int buffer_size, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /// put data of the preset on uniform grid with nominal sampling rate, method is a value of
+    /// ResamplingTypes, samples inside gaps have valid timestamps and NaN in other rows
+    void set_resampling (int method, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /**
+     * cut epochs around markers as soon as data after marker is received, epochs are read from
+     * ringbuffer so they are available even if data was already taken by get_board_data
+     * @param marker_values values of markers to cut epochs around
+     * @param pre_samples number of samples before marker
+     * @param post_samples number of samples after marker
+     * @param max_epochs number of complete epochs to keep, the oldest are dropped
+     * @return id of epoch definition
+     */
+    int add_epoch_definition (std::vector<double> marker_values, int pre_samples, int post_samples,
+        int max_epochs = 32, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    void remove_epoch_definition (int definition_id);
+    /// get number of complete epochs
+    int get_epoch_count (int definition_id);
+    /// get number of markers whose epoch was not cut because samples were already overwritten
+    long long get_num_dropped_epochs (int definition_id);
+    /// get complete epochs and remove them, shape is epochs x rows x (pre_samples + post_samples
+    /// + 1), marker is at index pre_samples
+    BrainFlowArray<double, 3> get_epochs (int definition_id);
+    /**
+     * monitor contact quality of exg channels, updated incrementally on each package
+     * @param config json with optional fields window_seconds, railed_threshold, saturation_value,
+     * flatline_threshold and channels
+     */
+    void enable_signal_quality_monitor (
+        std::string config = "", int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    void disable_signal_quality_monitor (int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /// get current quality, shape is channels x 7, columns are channel, standard deviation, railed
+    /// ratio, flatline, 50 Hz amplitude, 60 Hz amplitude and saturation count
+    BrainFlowArray<double, 2> get_signal_quality (
+        int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /**
+     * keep long history of the preset at reduced rate, filled while data is pushed
+     * @param ratio number of input samples per block
+     * @param method value of DecimationTypes, MIN_MAX stores two samples per block
+     * @param seconds duration of history
+     */
+    void enable_history (int ratio, int method, double seconds,
+        int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    void disable_history (int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    int get_history_count (int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /// get the latest decimated samples, history is not cleared
+    BrainFlowArray<double, 2> get_history (
+        int num_samples, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
 };
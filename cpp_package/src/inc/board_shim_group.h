@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+
+#include "board_shim.h"
+
+
+/// Streams several prepared boards together and returns their data merged on a common time grid
+class BoardShimGroup
+{
+    int group_id;
+    int num_boards;
+
+public:
+    /**
+     * @param boards prepared boards, they should outlive the group, data of the group is read from
+     * their buffers so dont read it directly while group is used
+     * @param preset preset to merge, it should have timestamps for all boards
+     * @param sampling_rate rate of the common grid, max rate of boards if <= 0
+     * @throw BrainFlowException if board is not prepared or has no timestamps for this preset
+     */
+    BoardShimGroup (std::vector<BoardShim *> boards,
+        int preset = (int)BrainFlowPresets::DEFAULT_PRESET, double sampling_rate = 0.0);
+    ~BoardShimGroup ();
+
+    /// start streaming for all boards at the same time, stream is started for all or for none
+    void start_stream (int buffer_size = 450000, std::string streamer_params = "");
+    /// stop streaming for all boards
+    void stop_stream ();
+    /// number of rows in merged data: grid timestamp followed by rows of each board without their
+    /// timestamp rows
+    int get_num_rows ();
+    /// get merged data available for all boards, data stays in buffers of boards
+    BrainFlowArray<double, 2> get_data (int max_samples = 1024);
+    /// delays between the first sample of the earliest board and the first sample of each board on
+    /// the host clock in seconds, NaN until board sends data or if board is released
+    std::vector<double> get_start_delays ();
+    /// sampling rates of boards estimated from their timestamps, NaN if board is released
+    std::vector<double> get_estimated_rates ();
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "board_shim.h"
+#include "ml_model.h"
+
+
+/// Calculates band power features and runs classifier over sliding window of board data in a
+/// single native thread of MLModule
+class InferencePipeline
+{
+public:
+    /**
+     * @param board board which streams data, it should outlive the pipeline
+     * @param model_params classifier params, feature vector is average band powers for delta,
+     * theta, alpha, beta and gamma over eeg channels of the preset
+     * @param window_seconds length of sliding window used for each prediction
+     * @param update_interval_ms how often predictions are published
+     * @param apply_filters apply detrend, bandstop and bandpass filters before psd calculation
+     * @param preset preset to read data from
+     * @param bands (start, stop) frequencies in Hz used instead of default bands
+     */
+    InferencePipeline (BoardShim *board, struct BrainFlowModelParams model_params,
+        double window_seconds = 4.0, int update_interval_ms = 1000, bool apply_filters = true,
+        int preset = (int)BrainFlowPresets::DEFAULT_PRESET,
+        const std::vector<std::pair<double, double>> &bands =
+            std::vector<std::pair<double, double>> ());
+    ~InferencePipeline ();
+
+    /// set callback, it's called from pipeline thread with prediction and timestamp of the last
+    /// sample in the window
+    void set_callback (std::function<void (const std::vector<double> &, double)> callback);
+    /// prepare classifier and start pipeline thread, board should be streaming
+    void start ();
+    /// stop pipeline thread and release classifier
+    void stop ();
+    bool is_running ();
+    /// get latest prediction, returns false if there is no prediction yet
+    bool get_latest_prediction (std::vector<double> &prediction, double &timestamp);
+    /// number of updates failed because of errors, updates with not enough data are not counted
+    int get_num_errors ();
+
+private:
+    int handle;
+    bool running;
+    int max_array_size;
+
+    // guards callback, it's called from pipeline thread
+    std::mutex callback_mutex;
+    std::function<void (const std::vector<double> &, double)> callback;
+    // reused across callback calls
+    std::vector<double> callback_prediction;
+
+    static void on_prediction (
+        const double *prediction, int prediction_len, double timestamp, void *user_data);
+};
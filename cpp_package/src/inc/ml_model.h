@@ -17,6 +17,7 @@ class MLModel
 private:
     struct BrainFlowModelParams params;
     std::string serialized_params;
+    int handle;
 
 public:
     MLModel (struct BrainFlowModelParams params);
@@ -40,11 +41,28 @@ public:
     static void release_all ();
     /// get brainflow version
     static std::string get_version ();
+    /// limit number of models loaded by register_model and their total file size, least recently
+    /// used models are unloaded first, 0 means no limit
+    static void set_registry_limits (int max_loaded_models, int max_memory_mb);
 
     /// initialize classifier, should be called first
     void prepare ();
+    /// register classifier without loading it, it's loaded on first prediction or by preload
+    void register_model ();
+    /// start loading registered classifier in background
+    void preload ();
     /// calculate metric from data
     std::vector<double> predict (double *data, int data_len);
+    /// calculate metric for batch_size feature vectors stored one after another, max_array_size
+    /// from params is applied per sample
+    std::vector<double> predict_batch (double *data, int batch_size, int feature_len);
+    /// calculate metric from float32 data, it's passed to model without conversion if possible
+    std::vector<double> predict (float *data, int data_len);
+    /// calculate metric for batch of float32 feature vectors
+    std::vector<double> predict_batch (float *data, int batch_size, int feature_len);
+    /// get number of predict calls, number of errors and p50, p99, max and mean latency in
+    /// microseconds
+    std::vector<double> get_stats ();
     /// release classifier
     void release ();
 };
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <string>
+
+#include "inference_pipeline.h"
+#include "json.hpp"
+#include "ml_module.h"
+
+using json = nlohmann::json;
+
+
+std::string params_to_string (struct BrainFlowModelParams params);
+
+InferencePipeline::InferencePipeline (BoardShim *board, struct BrainFlowModelParams model_params,
+    double window_seconds, int update_interval_ms, bool apply_filters, int preset,
+    const std::vector<std::pair<double, double>> &bands)
+{
+    if (board == NULL)
+    {
+        throw BrainFlowException (
+            "invalid pipeline params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    handle = 0;
+    running = false;
+    max_array_size = std::max (1, model_params.max_array_size);
+    callback_prediction.reserve (max_array_size);
+    std::string pipeline_params = params_to_string (model_params);
+    if (!bands.empty ())
+    {
+        json j = json::parse (pipeline_params);
+        for (const std::pair<double, double> &band : bands)
+        {
+            j["bands"].push_back ({band.first, band.second});
+        }
+        pipeline_params = j.dump ();
+    }
+    int res = ::create_inference_pipeline (pipeline_params.c_str (), board->board_id,
+        board->serialized_params.c_str (), window_seconds, update_interval_ms, (int)apply_filters,
+        preset, &handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create inference pipeline", res);
+    }
+    res = ::set_inference_pipeline_callback (handle, InferencePipeline::on_prediction, this);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        ::release_inference_pipeline (handle);
+        throw BrainFlowException ("failed to set pipeline callback", res);
+    }
+}
+
+InferencePipeline::~InferencePipeline ()
+{
+    // stops pipeline thread, so callback is not called after this point
+    ::release_inference_pipeline (handle);
+}
+
+void InferencePipeline::set_callback (
+    std::function<void (const std::vector<double> &, double)> callback)
+{
+    std::lock_guard<std::mutex> lock (callback_mutex);
+    this->callback = callback;
+}
+
+void InferencePipeline::start ()
+{
+    int res = ::start_inference_pipeline (handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to start inference pipeline", res);
+    }
+    running = true;
+}
+
+void InferencePipeline::stop ()
+{
+    if (!running)
+    {
+        return;
+    }
+    running = false;
+    int res = ::stop_inference_pipeline (handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to stop inference pipeline", res);
+    }
+}
+
+bool InferencePipeline::is_running ()
+{
+    return running;
+}
+
+bool InferencePipeline::get_latest_prediction (std::vector<double> &prediction, double &timestamp)
+{
+    prediction.resize (max_array_size);
+    int len = 0;
+    int res = ::get_inference_pipeline_prediction (handle, prediction.data (), &len, &timestamp);
+    if (res == (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR)
+    {
+        prediction.clear ();
+        return false;
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get prediction", res);
+    }
+    prediction.resize (len);
+    return true;
+}
+
+int InferencePipeline::get_num_errors ()
+{
+    int num_errors = 0;
+    int res = ::get_inference_pipeline_num_errors (handle, &num_errors);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get number of errors", res);
+    }
+    return num_errors;
+}
+
+void InferencePipeline::on_prediction (
+    const double *prediction, int prediction_len, double timestamp, void *user_data)
+{
+    InferencePipeline *pipeline = (InferencePipeline *)user_data;
+    std::lock_guard<std::mutex> lock (pipeline->callback_mutex);
+    if (pipeline->callback)
+    {
+        pipeline->callback_prediction.assign (prediction, prediction + prediction_len);
+        pipeline->callback (pipeline->callback_prediction, timestamp);
+    }
+}
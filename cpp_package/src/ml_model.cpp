@@ -34,36 +34,176 @@ std::string params_to_string (struct BrainFlowModelParams params)
 MLModel::MLModel (struct BrainFlowModelParams model_params) : params (model_params)
 {
     serialized_params = params_to_string (model_params);
+    handle = 0;
 }
 
 void MLModel::prepare ()
 {
-    int res = ::prepare (serialized_params.c_str ());
+    int res = ::prepare_with_handle (serialized_params.c_str (), &handle);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to prepare classifier", res);
     }
 }
 
+void MLModel::register_model ()
+{
+    int res = ::register_model (serialized_params.c_str (), &handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to register classifier", res);
+    }
+}
+
+void MLModel::preload ()
+{
+    int res = ::preload_model (handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to preload classifier", res);
+    }
+}
+
+void MLModel::set_registry_limits (int max_loaded_models, int max_memory_mb)
+{
+    int res = ::set_model_registry_limits (max_loaded_models, max_memory_mb);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to set registry limits", res);
+    }
+}
+
 std::vector<double> MLModel::predict (double *data, int data_len)
 {
-    double *output = new double[params.max_array_size];
+    std::vector<double> output (params.max_array_size);
     int size = 0;
-    int res = ::predict (data, data_len, output, &size, serialized_params.c_str ());
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    // model may be prepared by another instance with the same params
+    if (handle > 0)
+    {
+        res = ::predict_with_handle (data, data_len, output.data (), &size, handle);
+    }
+    else
+    {
+        res = ::predict (data, data_len, output.data (), &size, serialized_params.c_str ());
+    }
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
-        delete[] output;
         throw BrainFlowException ("failed to predict", res);
     }
-    std::vector<double> result (size);
-    std::copy (output, output + size, result.begin ());
-    delete[] output;
-    return result;
+    output.resize (size);
+    return output;
+}
+
+std::vector<double> MLModel::predict (float *data, int data_len)
+{
+    std::vector<double> output (params.max_array_size);
+    int size = 0;
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    if (handle > 0)
+    {
+        res = ::predict_float_with_handle (data, data_len, output.data (), &size, handle);
+    }
+    else
+    {
+        res = ::predict_float (data, data_len, output.data (), &size, serialized_params.c_str ());
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to predict", res);
+    }
+    output.resize (size);
+    return output;
+}
+
+std::vector<double> MLModel::predict_batch (float *data, int batch_size, int feature_len)
+{
+    if (batch_size < 1)
+    {
+        throw BrainFlowException (
+            "invalid batch size", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    std::vector<double> output ((size_t)batch_size * params.max_array_size);
+    int size = 0;
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    if (handle > 0)
+    {
+        res = ::predict_batch_float_with_handle (
+            data, batch_size, feature_len, output.data (), &size, handle);
+    }
+    else
+    {
+        res = ::predict_batch_float (
+            data, batch_size, feature_len, output.data (), &size, serialized_params.c_str ());
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to predict", res);
+    }
+    output.resize (size);
+    return output;
+}
+
+std::vector<double> MLModel::predict_batch (double *data, int batch_size, int feature_len)
+{
+    if (batch_size < 1)
+    {
+        throw BrainFlowException (
+            "invalid batch size", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    std::vector<double> output ((size_t)batch_size * params.max_array_size);
+    int size = 0;
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    if (handle > 0)
+    {
+        res = ::predict_batch_with_handle (
+            data, batch_size, feature_len, output.data (), &size, handle);
+    }
+    else
+    {
+        res = ::predict_batch (
+            data, batch_size, feature_len, output.data (), &size, serialized_params.c_str ());
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to predict", res);
+    }
+    output.resize (size);
+    return output;
+}
+
+std::vector<double> MLModel::get_stats ()
+{
+    double stats[6] = {0};
+    int size = 0;
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    if (handle > 0)
+    {
+        res = ::get_model_stats_with_handle (stats, &size, handle);
+    }
+    else
+    {
+        res = ::get_model_stats (stats, &size, serialized_params.c_str ());
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get model stats", res);
+    }
+    return std::vector<double> (stats, stats + size);
 }
 
 void MLModel::release ()
 {
-    int res = ::release (serialized_params.c_str ());
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    if (handle > 0)
+    {
+        res = ::release_with_handle (handle);
+        handle = 0;
+    }
+    else
+    {
+        res = ::release (serialized_params.c_str ());
+    }
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to release classifier", res);
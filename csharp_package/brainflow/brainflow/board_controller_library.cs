@@ -125,6 +125,7 @@ namespace brainflow
         OB3000_24_CHANNELS_BOARD = 63,
         BIOLISTENER_BOARD = 64,
         CERELOG_X8_BOARD = 65,
+        SYNTHETIC_LOAD_BOARD = 66,
     };
 
 
@@ -19,7 +19,8 @@ namespace brainflow
     {
         DEFAULT_CLASSIFIER = 0,
         DYN_LIB_CLASSIFIER = 1,
-        ONNX_CLASSIFIER = 2
+        ONNX_CLASSIFIER = 2,
+        LINEAR_CLASSIFIER = 3
     };
 
     public static class MLModuleLibrary64
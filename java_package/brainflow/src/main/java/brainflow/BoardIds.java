@@ -74,7 +74,8 @@ public enum BoardIds
     SYNCHRONI_UNO_1_CHANNELS_BOARD(62),
     OB3000_24_CHANNELS_BOARD(63),
     BIOLISTENER_BOARD(64),
-    CERELOG_X8_BOARD(65);
+    CERELOG_X8_BOARD(65),
+    SYNTHETIC_LOAD_BOARD(66);
 
     private final int board_id;
     private static final Map<Integer, BoardIds> bi_map = new HashMap<Integer, BoardIds> ();
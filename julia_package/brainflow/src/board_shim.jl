@@ -70,6 +70,7 @@ export BrainFlowInputParams
     OB3000_24_CHANNELS_BOARD = 63
     BIOLISTENER_BOARD = 64
     CERELOG_X8_BOARD = 65
+    SYNTHETIC_LOAD_BOARD = 66
 
 end
 
@@ -16,6 +16,7 @@ MetricType = Union{BrainFlowMetrics, Integer}
     DEFAULT_CLASSIFIER = 0
     DYN_LIB_CLASSIFIER = 1
     ONNX_CLASSIFIER = 2
+    LINEAR_CLASSIFIER = 3
 
 end
 
@@ -68,5 +68,6 @@ classdef BoardIds < int32
         OB3000_24_CHANNELS_BOARD(63)
         BIOLISTENER_BOARD(64)
         CERELOG_X8_BOARD(65)
+        SYNTHETIC_LOAD_BOARD(66)
     end
 end
\ No newline at end of file
@@ -4,5 +4,6 @@ classdef BrainFlowClassifiers < int32
         DEFAULT_CLASSIFIER(0)
         DYN_LIB_CLASSIFIER(1)
         ONNX_CLASSIFIER(2)
+        LINEAR_CLASSIFIER(3)
     end
 end
\ No newline at end of file
@@ -77,7 +77,8 @@ export enum BoardIds {
     SYNCHRONI_UNO_1_CHANNELS_BOARD = 62,
     OB3000_24_CHANNELS_BOARD = 63,
     BIOLISTENER_BOARD = 64,
-    CERELOG_X8_BOARD = 65
+    CERELOG_X8_BOARD = 65,
+    SYNTHETIC_LOAD_BOARD = 66
 }
 
 export enum IpProtocolTypes {
@@ -241,6 +242,7 @@ export enum BrainFlowClassifiers {
     DEFAULT_CLASSIFIER = 0,
     USER_DEFINED = 1,
     ONNX_CLASSIFIER = 2,
+    LINEAR_CLASSIFIER = 3,
 }
 
 export interface IBrainFlowInputParams {
@@ -1,6 +1,7 @@
 import ctypes
 import enum
 import json
+import math
 import os
 import platform
 import struct
@@ -83,6 +84,7 @@ class BoardIds(enum.IntEnum):
     OB3000_24_CHANNELS_BOARD = 63  #:
     BIOLISTENER_BOARD = 64  #:
     CERELOG_X8_BOARD = 65  #:
+    SYNTHETIC_LOAD_BOARD = 66  #:
 
 
 class IpProtocolTypes(enum.IntEnum):
@@ -101,6 +103,21 @@ class BrainFlowPresets(enum.IntEnum):
     ANCILLARY_PRESET = 2  #:
 
 
+class ResamplingTypes(enum.IntEnum):
+    """Enum to store resampling methods"""
+
+    NONE = 0  #:
+    LINEAR = 1  #:
+    CUBIC = 2  #:
+
+
+class DecimationTypes(enum.IntEnum):
+    """Enum to store decimation methods of history buffer"""
+
+    MEAN = 0  #:
+    MIN_MAX = 1  #:
+
+
 class BrainFlowInputParams(object):
     """ inputs parameters for prepare_session method
 
@@ -245,6 +262,18 @@ class BoardControllerDLL(object):
             ctypes.c_char_p
         ]
 
+        self.get_current_board_data_snapshot = self.lib.get_current_board_data_snapshot
+        self.get_current_board_data_snapshot.restype = ctypes.c_int
+        self.get_current_board_data_snapshot.argtypes = [
+            ndpointer(ctypes.c_int32),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
         self.get_current_board_data = self.lib.get_current_board_data
         self.get_current_board_data.restype = ctypes.c_int
         self.get_current_board_data.argtypes = [
@@ -277,6 +306,58 @@ class BoardControllerDLL(object):
         self.release_all_sessions.restype = ctypes.c_int
         self.release_all_sessions.argtypes = []
 
+        self.create_board_group = self.lib.create_board_group
+        self.create_board_group.restype = ctypes.c_int
+        self.create_board_group.argtypes = [
+            ctypes.c_char_p,
+            ndpointer(ctypes.c_int32)
+        ]
+
+        self.start_board_group_stream = self.lib.start_board_group_stream
+        self.start_board_group_stream.restype = ctypes.c_int
+        self.start_board_group_stream.argtypes = [
+            ctypes.c_int,
+            ctypes.c_char_p,
+            ctypes.c_int
+        ]
+
+        self.stop_board_group_stream = self.lib.stop_board_group_stream
+        self.stop_board_group_stream.restype = ctypes.c_int
+        self.stop_board_group_stream.argtypes = [
+            ctypes.c_int
+        ]
+
+        self.get_board_group_num_rows = self.lib.get_board_group_num_rows
+        self.get_board_group_num_rows.restype = ctypes.c_int
+        self.get_board_group_num_rows.argtypes = [
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int
+        ]
+
+        self.get_board_group_data = self.lib.get_board_group_data
+        self.get_board_group_data.restype = ctypes.c_int
+        self.get_board_group_data.argtypes = [
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int
+        ]
+
+        self.get_board_group_start_delays = self.lib.get_board_group_start_delays
+        self.get_board_group_start_delays.restype = ctypes.c_int
+        self.get_board_group_start_delays.argtypes = [
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int
+        ]
+
+        self.release_board_group = self.lib.release_board_group
+        self.release_board_group.restype = ctypes.c_int
+        self.release_board_group.argtypes = [
+            ctypes.c_int
+        ]
+
         self.insert_marker = self.lib.insert_marker
         self.insert_marker.restype = ctypes.c_int
         self.insert_marker.argtypes = [
@@ -286,6 +367,204 @@ class BoardControllerDLL(object):
             ctypes.c_char_p
         ]
 
+        self.get_board_data_by_time = self.lib.get_board_data_by_time
+        self.get_board_data_by_time.restype = ctypes.c_int
+        self.get_board_data_by_time.argtypes = [
+            ctypes.c_double,
+            ctypes.c_double,
+            ctypes.c_int,
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.pop_board_data_by_time = self.lib.pop_board_data_by_time
+        self.pop_board_data_by_time.restype = ctypes.c_int
+        self.pop_board_data_by_time.argtypes = [
+            ctypes.c_double,
+            ctypes.c_double,
+            ctypes.c_int,
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.get_session_num_rows = self.lib.get_session_num_rows
+        self.get_session_num_rows.restype = ctypes.c_int
+        self.get_session_num_rows.argtypes = [
+            ctypes.c_int,
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.get_package_loss_stats = self.lib.get_package_loss_stats
+        self.get_package_loss_stats.restype = ctypes.c_int
+        self.get_package_loss_stats.argtypes = [
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.set_buffer_duration = self.lib.set_buffer_duration
+        self.set_buffer_duration.restype = ctypes.c_int
+        self.set_buffer_duration.argtypes = [
+            ctypes.c_double,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.resize_buffer = self.lib.resize_buffer
+        self.resize_buffer.restype = ctypes.c_int
+        self.resize_buffer.argtypes = [
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.set_resampling = self.lib.set_resampling
+        self.set_resampling.restype = ctypes.c_int
+        self.set_resampling.argtypes = [
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.add_epoch_definition = self.lib.add_epoch_definition
+        self.add_epoch_definition.restype = ctypes.c_int
+        self.add_epoch_definition.argtypes = [
+            ndpointer(ctypes.c_double),
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.remove_epoch_definition = self.lib.remove_epoch_definition
+        self.remove_epoch_definition.restype = ctypes.c_int
+        self.remove_epoch_definition.argtypes = [
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.get_epoch_count = self.lib.get_epoch_count
+        self.get_epoch_count.restype = ctypes.c_int
+        self.get_epoch_count.argtypes = [
+            ctypes.c_int,
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.get_num_dropped_epochs = self.lib.get_num_dropped_epochs
+        self.get_num_dropped_epochs.restype = ctypes.c_int
+        self.get_num_dropped_epochs.argtypes = [
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.get_epochs = self.lib.get_epochs
+        self.get_epochs.restype = ctypes.c_int
+        self.get_epochs.argtypes = [
+            ctypes.c_int,
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.enable_signal_quality_monitor = self.lib.enable_signal_quality_monitor
+        self.enable_signal_quality_monitor.restype = ctypes.c_int
+        self.enable_signal_quality_monitor.argtypes = [
+            ctypes.c_char_p,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.disable_signal_quality_monitor = self.lib.disable_signal_quality_monitor
+        self.disable_signal_quality_monitor.restype = ctypes.c_int
+        self.disable_signal_quality_monitor.argtypes = [
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.get_signal_quality = self.lib.get_signal_quality
+        self.get_signal_quality.restype = ctypes.c_int
+        self.get_signal_quality.argtypes = [
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.enable_history = self.lib.enable_history
+        self.enable_history.restype = ctypes.c_int
+        self.enable_history.argtypes = [
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_double,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.disable_history = self.lib.disable_history
+        self.disable_history.restype = ctypes.c_int
+        self.disable_history.argtypes = [
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.get_history_count = self.lib.get_history_count
+        self.get_history_count.restype = ctypes.c_int
+        self.get_history_count.argtypes = [
+            ctypes.c_int,
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.get_history = self.lib.get_history
+        self.get_history.restype = ctypes.c_int
+        self.get_history.argtypes = [
+            ctypes.c_int,
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
+        self.set_lost_packages_fill = self.lib.set_lost_packages_fill
+        self.set_lost_packages_fill.restype = ctypes.c_int
+        self.set_lost_packages_fill.argtypes = [
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_char_p
+        ]
+
         self.get_board_data_count = self.lib.get_board_data_count
         self.get_board_data_count.restype = ctypes.c_int
         self.get_board_data_count.argtypes = [
@@ -1290,7 +1569,7 @@ class BoardShim(object):
         :rtype: NDArray[Shape["*, *"], Float64]
         """
 
-        package_length = BoardShim.get_num_rows(self._master_board_id, preset)
+        package_length = self.get_session_num_rows(preset)
         data_arr = numpy.zeros(int(num_samples * package_length)).astype(numpy.float64)
         current_size = numpy.zeros(1).astype(numpy.int32)
 
@@ -1321,6 +1600,45 @@ class BoardShim(object):
             raise BrainFlowError('unable to obtain buffer size', res)
         return data_size[0]
 
+    def get_current_board_data_snapshot(self, presets: List[int], num_samples: List[int] = None,
+                                        seconds: float = None):
+        """Get latest data of several presets taken at the same instant, doesnt remove data from ringbuffer
+
+        :param presets: presets to read
+        :type presets: List[int]
+        :param num_samples: max number of samples for each preset
+        :type num_samples: List[int]
+        :param seconds: duration of data for each preset, used if num_samples is not provided
+        :type seconds: float
+        :return: latest data of each preset
+        :rtype: List[NDArray[Shape["*, *"], Float64]]
+        """
+
+        if num_samples is None:
+            if seconds is None:
+                raise BrainFlowError('num_samples or seconds should be provided',
+                                     BrainFlowExitCodes.INVALID_ARGUMENTS_ERROR.value)
+            master_board_id = self.get_board_id()
+            num_samples = [int(math.ceil(seconds * BoardShim.get_sampling_rate(master_board_id, preset)))
+                           for preset in presets]
+        if len(presets) == 0 or len(presets) != len(num_samples):
+            raise BrainFlowError('invalid presets or num_samples', BrainFlowExitCodes.INVALID_ARGUMENTS_ERROR.value)
+        num_rows = [self.get_session_num_rows(preset) for preset in presets]
+        sizes = [rows * max(0, count) for rows, count in zip(num_rows, num_samples)]
+        data_arr = numpy.zeros(max(1, sum(sizes))).astype(numpy.float64)
+        returned_samples = numpy.zeros(len(presets)).astype(numpy.int32)
+        res = BoardControllerDLL.get_instance().get_current_board_data_snapshot(
+            numpy.array(presets, dtype=numpy.int32), numpy.array(num_samples, dtype=numpy.int32), len(presets),
+            data_arr, returned_samples, self.board_id, self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get board data snapshot', res)
+        result = list()
+        offset = 0
+        for rows, count, size in zip(num_rows, returned_samples, sizes):
+            result.append(data_arr[offset:offset + rows * count].reshape(rows, count))
+            offset = offset + size
+        return result
+
     def get_board_id(self) -> int:
         """Get's the actual board id, can be different than provided
 
@@ -1345,6 +1663,306 @@ class BoardShim(object):
         if res != BrainFlowExitCodes.STATUS_OK.value:
             raise BrainFlowError('unable to insert marker', res)
 
+    def get_session_num_rows(self, preset: int = BrainFlowPresets.DEFAULT_PRESET) -> int:
+        """Get number of rows in data of this session, layout configured at runtime never has more rows than get_num_rows
+
+        :param preset: preset
+        :type preset: int
+        :return: number of rows
+        :rtype: int
+        """
+        num_rows = numpy.zeros(1).astype(numpy.int32)
+        res = BoardControllerDLL.get_instance().get_session_num_rows(preset, num_rows, self.board_id,
+                                                                     self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get session num rows', res)
+        return int(num_rows[0])
+
+    def get_package_loss_stats(self, preset: int = BrainFlowPresets.DEFAULT_PRESET) -> dict:
+        """Get package counters collected since stream start, available for boards which send package numbers
+
+        :param preset: preset
+        :type preset: int
+        :return: numbers of received, lost, duplicated and reordered packages
+        :rtype: dict
+        """
+
+        stats = numpy.zeros(4).astype(numpy.float64)
+        res = BoardControllerDLL.get_instance().get_package_loss_stats(preset, stats, self.board_id, self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get package loss stats', res)
+        return {'received': int(stats[0]), 'lost': int(stats[1]), 'duplicated': int(stats[2]),
+                'reordered': int(stats[3])}
+
+    def set_lost_packages_fill(self, enable: bool, max_gap: int = 256,
+                               preset: int = BrainFlowPresets.DEFAULT_PRESET) -> None:
+        """Push NaN filled packages instead of lost ones to keep number of samples matching device timeline
+
+        :param enable: enable or disable placeholders
+        :type enable: bool
+        :param max_gap: gaps longer than max_gap packages are treated as device restart and not filled
+        :type max_gap: int
+        :param preset: preset
+        :type preset: int
+        """
+
+        res = BoardControllerDLL.get_instance().set_lost_packages_fill(int(enable), max_gap, preset,
+                                                                        self.board_id, self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to set lost packages fill', res)
+
+    def set_buffer_duration(self, seconds: float, preset: int = BrainFlowPresets.DEFAULT_PRESET) -> None:
+        """Keep seconds of data in ringbuffer of the preset instead of buffer_size from start_stream,
+        if stream is running ringbuffer is resized immediately keeping the latest data
+
+        :param seconds: capacity of ringbuffer in seconds
+        :type seconds: float
+        :param preset: preset
+        :type preset: int
+        """
+
+        res = BoardControllerDLL.get_instance().set_buffer_duration(seconds, preset, self.board_id, self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to set buffer duration', res)
+
+    def resize_buffer(self, buffer_size: int, preset: int = BrainFlowPresets.DEFAULT_PRESET) -> None:
+        """Change capacity of running ringbuffer keeping the latest data
+
+        :param buffer_size: new capacity in samples
+        :type buffer_size: int
+        :param preset: preset
+        :type preset: int
+        """
+
+        res = BoardControllerDLL.get_instance().resize_buffer(buffer_size, preset, self.board_id, self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to resize buffer', res)
+
+    def set_resampling(self, method: int, preset: int = BrainFlowPresets.DEFAULT_PRESET) -> None:
+        """Put data of the preset on uniform grid with nominal sampling rate, samples inside gaps have valid timestamps and NaN in other rows
+
+        :param method: resampling method from ResamplingTypes
+        :type method: int
+        :param preset: preset
+        :type preset: int
+        """
+
+        res = BoardControllerDLL.get_instance().set_resampling(method, preset, self.board_id, self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to set resampling', res)
+
+    def add_epoch_definition(self, marker_values: List[float], pre_samples: int, post_samples: int,
+                             max_epochs: int = 32, preset: int = BrainFlowPresets.DEFAULT_PRESET) -> int:
+        """Cut epochs around markers as soon as data after marker is received, epochs are read from ringbuffer so they are available even if data was already taken by get_board_data
+
+        :param marker_values: values of markers to cut epochs around
+        :type marker_values: List[float]
+        :param pre_samples: number of samples before marker
+        :type pre_samples: int
+        :param post_samples: number of samples after marker
+        :type post_samples: int
+        :param max_epochs: number of complete epochs to keep, the oldest are dropped
+        :type max_epochs: int
+        :param preset: preset
+        :type preset: int
+        :return: id of epoch definition
+        :rtype: int
+        """
+
+        values = numpy.array(marker_values).astype(numpy.float64)
+        definition_id = numpy.zeros(1).astype(numpy.int32)
+        res = BoardControllerDLL.get_instance().add_epoch_definition(values, values.shape[0], pre_samples,
+                                                                      post_samples, max_epochs, preset,
+                                                                      definition_id, self.board_id,
+                                                                      self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to add epoch definition', res)
+        if not hasattr(self, '_epoch_definitions'):
+            self._epoch_definitions = dict()
+        self._epoch_definitions[int(definition_id[0])] = (preset, pre_samples + post_samples + 1)
+        return int(definition_id[0])
+
+    def remove_epoch_definition(self, definition_id: int) -> None:
+        """Stop cutting epochs for this definition
+
+        :param definition_id: id returned by add_epoch_definition
+        :type definition_id: int
+        """
+
+        res = BoardControllerDLL.get_instance().remove_epoch_definition(definition_id, self.board_id,
+                                                                         self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to remove epoch definition', res)
+        self._epoch_definitions.pop(definition_id, None)
+
+    def get_epoch_count(self, definition_id: int) -> int:
+        """Get number of complete epochs
+
+        :param definition_id: id returned by add_epoch_definition
+        :type definition_id: int
+        :return: number of epochs
+        :rtype: int
+        """
+
+        count = numpy.zeros(1).astype(numpy.int32)
+        res = BoardControllerDLL.get_instance().get_epoch_count(definition_id, count, self.board_id,
+                                                                 self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get epoch count', res)
+        return int(count[0])
+
+    def get_num_dropped_epochs(self, definition_id: int) -> int:
+        """Get number of markers whose epoch was not cut because samples were already overwritten
+
+        :param definition_id: id returned by add_epoch_definition
+        :type definition_id: int
+        :return: number of dropped epochs
+        :rtype: int
+        """
+
+        count = numpy.zeros(1).astype(numpy.float64)
+        res = BoardControllerDLL.get_instance().get_num_dropped_epochs(definition_id, count, self.board_id,
+                                                                        self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get number of dropped epochs', res)
+        return int(count[0])
+
+    def get_epochs(self, definition_id: int):
+        """Get complete epochs and remove them, marker is at index pre_samples
+
+        :param definition_id: id returned by add_epoch_definition
+        :type definition_id: int
+        :return: epochs
+        :rtype: NDArray[Shape["*, *, *"], Float64]
+        """
+
+        if definition_id not in getattr(self, '_epoch_definitions', dict()):
+            raise BrainFlowError('no such epoch definition', BrainFlowExitCodes.INVALID_ARGUMENTS_ERROR.value)
+        preset, epoch_size = self._epoch_definitions[definition_id]
+        num_epochs = self.get_epoch_count(definition_id)
+        num_rows = self.get_session_num_rows(preset)
+        data_arr = numpy.zeros(max(1, num_epochs * num_rows * epoch_size)).astype(numpy.float64)
+        returned_epochs = numpy.zeros(1).astype(numpy.int32)
+        res = BoardControllerDLL.get_instance().get_epochs(definition_id, num_epochs, data_arr, returned_epochs,
+                                                            self.board_id, self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get epochs', res)
+        return data_arr[0:returned_epochs[0] * num_rows * epoch_size].reshape(returned_epochs[0], num_rows,
+                                                                               epoch_size)
+
+    def enable_signal_quality_monitor(self, config: str = '',
+                                      preset: int = BrainFlowPresets.DEFAULT_PRESET) -> None:
+        """Monitor contact quality of exg channels, updated incrementally on each package
+
+        :param config: json with optional fields window_seconds, railed_threshold, saturation_value,
+            flatline_threshold and channels
+        :type config: str
+        :param preset: preset
+        :type preset: int
+        """
+
+        res = BoardControllerDLL.get_instance().enable_signal_quality_monitor(config.encode(), preset,
+                                                                               self.board_id, self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to enable signal quality monitor', res)
+
+    def disable_signal_quality_monitor(self, preset: int = BrainFlowPresets.DEFAULT_PRESET) -> None:
+        """Stop monitoring contact quality
+
+        :param preset: preset
+        :type preset: int
+        """
+
+        res = BoardControllerDLL.get_instance().disable_signal_quality_monitor(preset, self.board_id,
+                                                                                self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to disable signal quality monitor', res)
+
+    def get_signal_quality(self, preset: int = BrainFlowPresets.DEFAULT_PRESET):
+        """Get current contact quality, columns are channel, standard deviation, railed ratio, flatline,
+        50 Hz amplitude, 60 Hz amplitude and saturation count
+
+        :param preset: preset
+        :type preset: int
+        :return: quality per channel
+        :rtype: NDArray[Shape["*, 7"], Float64]
+        """
+
+        num_metrics = 7
+        num_rows = self.get_session_num_rows(preset)
+        output = numpy.zeros(num_rows * num_metrics).astype(numpy.float64)
+        num_channels = numpy.zeros(1).astype(numpy.int32)
+        res = BoardControllerDLL.get_instance().get_signal_quality(preset, output, num_channels, self.board_id,
+                                                                    self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get signal quality', res)
+        return output[0:num_channels[0] * num_metrics].reshape(num_channels[0], num_metrics)
+
+    def enable_history(self, ratio: int, method: int, seconds: float,
+                       preset: int = BrainFlowPresets.DEFAULT_PRESET) -> None:
+        """Keep long history of the preset at reduced rate, filled while data is pushed
+
+        :param ratio: number of input samples per block
+        :type ratio: int
+        :param method: method from DecimationTypes, MIN_MAX stores two samples per block
+        :type method: int
+        :param seconds: duration of history
+        :type seconds: float
+        :param preset: preset
+        :type preset: int
+        """
+
+        res = BoardControllerDLL.get_instance().enable_history(ratio, method, seconds, preset, self.board_id,
+                                                                self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to enable history', res)
+
+    def disable_history(self, preset: int = BrainFlowPresets.DEFAULT_PRESET) -> None:
+        """Remove history of the preset
+
+        :param preset: preset
+        :type preset: int
+        """
+
+        res = BoardControllerDLL.get_instance().disable_history(preset, self.board_id, self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to disable history', res)
+
+    def get_history_count(self, preset: int = BrainFlowPresets.DEFAULT_PRESET) -> int:
+        """Get number of decimated samples in history
+
+        :param preset: preset
+        :type preset: int
+        :return: number of samples
+        :rtype: int
+        """
+
+        count = numpy.zeros(1).astype(numpy.int32)
+        res = BoardControllerDLL.get_instance().get_history_count(preset, count, self.board_id, self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get history count', res)
+        return int(count[0])
+
+    def get_history(self, num_samples: int, preset: int = BrainFlowPresets.DEFAULT_PRESET):
+        """Get the latest decimated samples, history is not cleared
+
+        :param num_samples: max number of samples
+        :type num_samples: int
+        :param preset: preset
+        :type preset: int
+        :return: decimated data
+        :rtype: NDArray[Float64]
+        """
+
+        num_rows = self.get_session_num_rows(preset)
+        data_arr = numpy.zeros(max(1, num_samples * num_rows)).astype(numpy.float64)
+        returned_samples = numpy.zeros(1).astype(numpy.int32)
+        res = BoardControllerDLL.get_instance().get_history(num_samples, preset, data_arr, returned_samples,
+                                                             self.board_id, self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get history', res)
+        return data_arr[0:returned_samples[0] * num_rows].reshape(num_rows, returned_samples[0])
+
     def is_prepared(self) -> bool:
         """Check if session is ready or not
 
@@ -1375,7 +1993,7 @@ class BoardShim(object):
                 raise BrainFlowError('invalid num_samples', BrainFlowExitCodes.INVALID_ARGUMENTS_ERROR.value)
             else:
                 data_size = min(data_size, num_samples)
-        package_length = BoardShim.get_num_rows(self._master_board_id, preset)
+        package_length = self.get_session_num_rows(preset)
         data_arr = numpy.zeros(data_size * package_length).astype(numpy.float64)
 
         res = BoardControllerDLL.get_instance().get_board_data(data_size, preset, data_arr, self.board_id, self.input_json)
@@ -1384,6 +2002,52 @@ class BoardShim(object):
 
         return data_arr.reshape(package_length, data_size)
 
+    def get_board_data_by_time(self, start_time: float, end_time: float,
+                               preset: int = BrainFlowPresets.DEFAULT_PRESET):
+        """Get data with timestamps inside [start_time, end_time], doesnt remove data from ringbuffer
+
+        :param start_time: first timestamp
+        :type start_time: float
+        :param end_time: last timestamp
+        :type end_time: float
+        :param preset: preset
+        :type preset: int
+        :return: data in the range
+        :rtype: NDArray[Shape["*, *"], Float64]
+        """
+
+        return self._get_board_data_by_time(start_time, end_time, preset, False)
+
+    def pop_board_data_by_time(self, start_time: float, end_time: float,
+                               preset: int = BrainFlowPresets.DEFAULT_PRESET):
+        """Get data with timestamps inside [start_time, end_time] and remove it and all older data from ringbuffer
+
+        :param start_time: first timestamp
+        :type start_time: float
+        :param end_time: last timestamp
+        :type end_time: float
+        :param preset: preset
+        :type preset: int
+        :return: data in the range
+        :rtype: NDArray[Shape["*, *"], Float64]
+        """
+
+        return self._get_board_data_by_time(start_time, end_time, preset, True)
+
+    def _get_board_data_by_time(self, start_time: float, end_time: float, preset: int, remove: bool):
+        max_samples = self.get_board_data_count(preset)
+        package_length = self.get_session_num_rows(preset)
+        data_arr = numpy.zeros(max(1, max_samples * package_length)).astype(numpy.float64)
+        num_samples = numpy.zeros(1).astype(numpy.int32)
+        if remove:
+            func = BoardControllerDLL.get_instance().pop_board_data_by_time
+        else:
+            func = BoardControllerDLL.get_instance().get_board_data_by_time
+        res = func(start_time, end_time, max_samples, preset, data_arr, num_samples, self.board_id, self.input_json)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get board data by time', res)
+        return data_arr[0:num_samples[0] * package_length].reshape(package_length, num_samples[0])
+
     def config_board(self, config) -> str:
         """Use this method carefully and only if you understand what you are doing, do NOT use it to start or stop streaming
 
@@ -1414,3 +2078,104 @@ class BoardShim(object):
         res = BoardControllerDLL.get_instance().config_board_with_bytes(bytes_to_send, len(bytes_to_send), self.board_id, self.input_json)
         if res != BrainFlowExitCodes.STATUS_OK.value:
             raise BrainFlowError('unable to config board', res)
+
+
+class BoardShimGroup(object):
+    """Streams several prepared boards together and returns their data merged on a common time grid
+
+    :param boards: prepared boards, group reads their buffers without removing data, released boards are dropped from the group
+    :type boards: List[BoardShim]
+    :param preset: preset to merge, it should have timestamps for all boards
+    :type preset: int
+    :param sampling_rate: rate of the common grid, max rate of boards if <= 0
+    :type sampling_rate: float
+    """
+
+    def __init__(self, boards: List[BoardShim], preset: int = BrainFlowPresets.DEFAULT_PRESET,
+                 sampling_rate: float = 0.0) -> None:
+        members = list()
+        for board in boards:
+            input_json = board.input_json
+            if isinstance(input_json, bytes):
+                input_json = input_json.decode()
+            members.append({'board_id': board.board_id, 'input_params': json.loads(input_json)})
+        config = json.dumps({'boards': members, 'preset': preset, 'sampling_rate': sampling_rate}).encode()
+        self.num_boards = len(boards)
+        group_id = numpy.zeros(1).astype(numpy.int32)
+        res = BoardControllerDLL.get_instance().create_board_group(config, group_id)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to create board group', res)
+        self.group_id = int(group_id[0])
+
+    def __del__(self) -> None:
+        if hasattr(self, 'group_id'):
+            BoardControllerDLL.get_instance().release_board_group(self.group_id)
+
+    def start_stream(self, num_samples: int = 1800 * 250, streamer_params: str = None) -> None:
+        """Start streaming for all boards at the same time, stream is started for all or for none
+
+        :param num_samples: size of ring buffer of each board
+        :type num_samples: int
+        :param streamer_params: parameter to stream data from brainflow
+        :type streamer_params: str
+        """
+        if streamer_params is None:
+            streamer = None
+        else:
+            try:
+                streamer = streamer_params.encode()
+            except BaseException:
+                streamer = streamer_params
+        res = BoardControllerDLL.get_instance().start_board_group_stream(num_samples, streamer, self.group_id)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to start group streaming session', res)
+
+    def stop_stream(self) -> None:
+        """Stop streaming for all boards"""
+        res = BoardControllerDLL.get_instance().stop_board_group_stream(self.group_id)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to stop group streaming session', res)
+
+    def get_num_rows(self) -> int:
+        """Get number of rows in merged data: grid timestamp followed by rows of each board without their timestamp rows
+
+        :return: number of rows
+        :rtype: int
+        """
+        num_rows = numpy.zeros(1).astype(numpy.int32)
+        res = BoardControllerDLL.get_instance().get_board_group_num_rows(num_rows, self.group_id)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get num rows', res)
+        return int(num_rows[0])
+
+    def get_data(self, max_samples: int = 1024):
+        """Get merged data available for all boards, data stays in board buffers
+
+        :param max_samples: max number of samples to return
+        :type max_samples: int
+        :return: merged data
+        :rtype: NDArray[Shape["*, *"], Float64]
+        """
+        num_rows = self.get_num_rows()
+        data_arr = numpy.zeros(num_rows * max_samples).astype(numpy.float64)
+        num_samples = numpy.zeros(1).astype(numpy.int32)
+        res = BoardControllerDLL.get_instance().get_board_group_data(max_samples, data_arr, num_samples,
+                                                                     self.group_id)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get group data', res)
+        return data_arr[0:num_rows * num_samples[0]].reshape(num_rows, num_samples[0])
+
+    def get_start_delays(self):
+        """Get delays between the first sample of the earliest board and the first sample of each board on the host clock and sampling rates estimated from timestamps
+
+        :return: delays in seconds, NaN until board sends data, and estimated rates, both are NaN for released boards
+        :rtype: tuple
+        """
+        start_delays = numpy.zeros(self.num_boards).astype(numpy.float64)
+        rates = numpy.zeros(self.num_boards).astype(numpy.float64)
+        num_boards = numpy.zeros(1).astype(numpy.int32)
+        res = BoardControllerDLL.get_instance().get_board_group_start_delays(start_delays, rates, num_boards,
+                                                                             self.group_id)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get group start delays', res)
+        return start_delays, rates
@@ -8,7 +8,7 @@ from typing import List
 
 import numpy
 import pkg_resources
-from brainflow.board_shim import BrainFlowError, LogLevels
+from brainflow.board_shim import BrainFlowError, BrainFlowPresets, LogLevels
 from brainflow.exit_codes import BrainFlowExitCodes
 from numpy.ctypeslib import ndpointer
 
@@ -27,6 +27,7 @@ class BrainFlowClassifiers(enum.IntEnum):
     DEFAULT_CLASSIFIER = 0  #:
     DYN_LIB_CLASSIFIER = 1  #:
     ONNX_CLASSIFIER = 2  #:
+    LINEAR_CLASSIFIER = 3  #:
 
 
 class BrainFlowModelParams(object):
@@ -142,6 +143,176 @@ class MLModuleDLL(object):
             ctypes.c_char_p
         ]
 
+        self.predict_batch = self.lib.predict_batch
+        self.predict_batch.restype = ctypes.c_int
+        self.predict_batch.argtypes = [
+            ndpointer(ctypes.c_double),
+            ctypes.c_int,
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_char_p
+        ]
+
+        self.predict_batch_with_handle = self.lib.predict_batch_with_handle
+        self.predict_batch_with_handle.restype = ctypes.c_int
+        self.predict_batch_with_handle.argtypes = [
+            ndpointer(ctypes.c_double),
+            ctypes.c_int,
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int
+        ]
+
+        self.predict_float = self.lib.predict_float
+        self.predict_float.restype = ctypes.c_int
+        self.predict_float.argtypes = [
+            ndpointer(ctypes.c_float),
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_char_p
+        ]
+
+        self.predict_float_with_handle = self.lib.predict_float_with_handle
+        self.predict_float_with_handle.restype = ctypes.c_int
+        self.predict_float_with_handle.argtypes = [
+            ndpointer(ctypes.c_float),
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int
+        ]
+
+        self.predict_batch_float = self.lib.predict_batch_float
+        self.predict_batch_float.restype = ctypes.c_int
+        self.predict_batch_float.argtypes = [
+            ndpointer(ctypes.c_float),
+            ctypes.c_int,
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_char_p
+        ]
+
+        self.predict_batch_float_with_handle = self.lib.predict_batch_float_with_handle
+        self.predict_batch_float_with_handle.restype = ctypes.c_int
+        self.predict_batch_float_with_handle.argtypes = [
+            ndpointer(ctypes.c_float),
+            ctypes.c_int,
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int
+        ]
+
+        self.prepare_with_handle = self.lib.prepare_with_handle
+        self.prepare_with_handle.restype = ctypes.c_int
+        self.prepare_with_handle.argtypes = [
+            ctypes.c_char_p,
+            ndpointer(ctypes.c_int32)
+        ]
+
+        self.predict_with_handle = self.lib.predict_with_handle
+        self.predict_with_handle.restype = ctypes.c_int
+        self.predict_with_handle.argtypes = [
+            ndpointer(ctypes.c_double),
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int
+        ]
+
+        self.release_with_handle = self.lib.release_with_handle
+        self.release_with_handle.restype = ctypes.c_int
+        self.release_with_handle.argtypes = [
+            ctypes.c_int
+        ]
+
+        self.get_model_stats = self.lib.get_model_stats
+        self.get_model_stats.restype = ctypes.c_int
+        self.get_model_stats.argtypes = [
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_char_p
+        ]
+
+        self.get_model_stats_with_handle = self.lib.get_model_stats_with_handle
+        self.get_model_stats_with_handle.restype = ctypes.c_int
+        self.get_model_stats_with_handle.argtypes = [
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ctypes.c_int
+        ]
+
+        self.register_model = self.lib.register_model
+        self.register_model.restype = ctypes.c_int
+        self.register_model.argtypes = [
+            ctypes.c_char_p,
+            ndpointer(ctypes.c_int32)
+        ]
+
+        self.preload_model = self.lib.preload_model
+        self.preload_model.restype = ctypes.c_int
+        self.preload_model.argtypes = [
+            ctypes.c_int
+        ]
+
+        self.set_model_registry_limits = self.lib.set_model_registry_limits
+        self.set_model_registry_limits.restype = ctypes.c_int
+        self.set_model_registry_limits.argtypes = [
+            ctypes.c_int,
+            ctypes.c_int
+        ]
+
+        self.create_inference_pipeline = self.lib.create_inference_pipeline
+        self.create_inference_pipeline.restype = ctypes.c_int
+        self.create_inference_pipeline.argtypes = [
+            ctypes.c_char_p,
+            ctypes.c_int,
+            ctypes.c_char_p,
+            ctypes.c_double,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ndpointer(ctypes.c_int32)
+        ]
+
+        self.start_inference_pipeline = self.lib.start_inference_pipeline
+        self.start_inference_pipeline.restype = ctypes.c_int
+        self.start_inference_pipeline.argtypes = [
+            ctypes.c_int
+        ]
+
+        self.stop_inference_pipeline = self.lib.stop_inference_pipeline
+        self.stop_inference_pipeline.restype = ctypes.c_int
+        self.stop_inference_pipeline.argtypes = [
+            ctypes.c_int
+        ]
+
+        self.get_inference_pipeline_prediction = self.lib.get_inference_pipeline_prediction
+        self.get_inference_pipeline_prediction.restype = ctypes.c_int
+        self.get_inference_pipeline_prediction.argtypes = [
+            ctypes.c_int,
+            ndpointer(ctypes.c_double),
+            ndpointer(ctypes.c_int32),
+            ndpointer(ctypes.c_double)
+        ]
+
+        self.get_inference_pipeline_num_errors = self.lib.get_inference_pipeline_num_errors
+        self.get_inference_pipeline_num_errors.restype = ctypes.c_int
+        self.get_inference_pipeline_num_errors.argtypes = [
+            ctypes.c_int,
+            ndpointer(ctypes.c_int32)
+        ]
+
+        self.release_inference_pipeline = self.lib.release_inference_pipeline
+        self.release_inference_pipeline.restype = ctypes.c_int
+        self.release_inference_pipeline.argtypes = [
+            ctypes.c_int
+        ]
+
         self.get_version_ml_module = self.lib.get_version_ml_module
         self.get_version_ml_module.restype = ctypes.c_int
         self.get_version_ml_module.argtypes = [
@@ -164,6 +335,7 @@ class MLModel(object):
             self.serialized_params = model_params.to_json().encode()
         except BaseException:
             self.serialized_params = model_params.to_json()
+        self.handle = 0
 
     @classmethod
     def set_log_level(cls, log_level: int) -> None:
@@ -247,31 +419,220 @@ class MLModel(object):
             raise BrainFlowError('unable to request info', res)
         return string.tobytes().decode('utf-8')[0:string_len[0]]
 
+    @classmethod
+    def set_registry_limits(cls, max_loaded_models: int, max_memory_mb: int) -> None:
+        """limit number and total file size of models loaded via register_model, least recently used models are unloaded first
+
+        :param max_loaded_models: max number of loaded models, 0 means no limit
+        :type max_loaded_models: int
+        :param max_memory_mb: max total size of loaded models in MB, 0 means no limit
+        :type max_memory_mb: int
+        """
+        res = MLModuleDLL.get_instance().set_model_registry_limits(max_loaded_models, max_memory_mb)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to set registry limits', res)
+
+    def register_model(self) -> None:
+        """register classifier without loading it, it is loaded on first prediction or by preload"""
+
+        handle = numpy.zeros(1).astype(numpy.int32)
+        res = MLModuleDLL.get_instance().register_model(self.serialized_params, handle)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to register classifier', res)
+        self.handle = int(handle[0])
+
+    def preload(self) -> None:
+        """start loading registered classifier in background"""
+
+        res = MLModuleDLL.get_instance().preload_model(self.handle)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to preload classifier', res)
+
     def prepare(self) -> None:
         """prepare classifier"""
 
-        res = MLModuleDLL.get_instance().prepare(self.serialized_params)
+        handle = numpy.zeros(1).astype(numpy.int32)
+        res = MLModuleDLL.get_instance().prepare_with_handle(self.serialized_params, handle)
         if res != BrainFlowExitCodes.STATUS_OK.value:
             raise BrainFlowError('unable to prepare classifier', res)
+        self.handle = int(handle[0])
 
     def release(self) -> None:
         """release classifier"""
 
-        res = MLModuleDLL.get_instance().release(self.serialized_params)
+        if self.handle > 0:
+            res = MLModuleDLL.get_instance().release_with_handle(self.handle)
+            self.handle = 0
+        else:
+            res = MLModuleDLL.get_instance().release(self.serialized_params)
         if res != BrainFlowExitCodes.STATUS_OK.value:
             raise BrainFlowError('unable to release classifier', res)
 
     def predict(self, data) -> List:
         """calculate metric from data
 
-        :param data: input array
+        :param data: input array, float32 arrays are passed to model without conversion
         :type data: NDArray[Shape["*"], Float64]
         :return: metric value
         :rtype: List
         """
         output = numpy.zeros(self.model_params.max_array_size).astype(numpy.float64)
         output_len = numpy.zeros(1).astype(numpy.int32)
-        res = MLModuleDLL.get_instance().predict(data, data.shape[0], output, output_len, self.serialized_params)
+        if data.dtype == numpy.float32:
+            data = numpy.ascontiguousarray(data)
+            if self.handle > 0:
+                res = MLModuleDLL.get_instance().predict_float_with_handle(data, data.shape[0], output, output_len,
+                                                                           self.handle)
+            else:
+                res = MLModuleDLL.get_instance().predict_float(data, data.shape[0], output, output_len,
+                                                               self.serialized_params)
+        elif self.handle > 0:
+            res = MLModuleDLL.get_instance().predict_with_handle(data, data.shape[0], output, output_len, self.handle)
+        else:
+            # model may be prepared by another instance with the same params
+            res = MLModuleDLL.get_instance().predict(data, data.shape[0], output, output_len, self.serialized_params)
         if res != BrainFlowExitCodes.STATUS_OK.value:
             raise BrainFlowError('unable to calc metric', res)
         return output[0:output_len[0]]
+
+    def predict_batch(self, data):
+        """calculate metric for many feature vectors in a single call
+
+        :param data: input array, one feature vector per row, float32 arrays are not converted
+        :type data: NDArray[Shape["*, *"], Float64]
+        :return: metric values, one row per feature vector
+        :rtype: NDArray[Shape["*, *"], Float64]
+        """
+        is_float = data.dtype == numpy.float32
+        data = numpy.ascontiguousarray(data, dtype=numpy.float32 if is_float else numpy.float64)
+        batch_size = data.shape[0]
+        feature_len = data.shape[1]
+        output = numpy.zeros(batch_size * self.model_params.max_array_size).astype(numpy.float64)
+        output_len = numpy.zeros(1).astype(numpy.int32)
+        if is_float and self.handle > 0:
+            res = MLModuleDLL.get_instance().predict_batch_float_with_handle(data, batch_size, feature_len, output,
+                                                                             output_len, self.handle)
+        elif is_float:
+            res = MLModuleDLL.get_instance().predict_batch_float(data, batch_size, feature_len, output, output_len,
+                                                                 self.serialized_params)
+        elif self.handle > 0:
+            res = MLModuleDLL.get_instance().predict_batch_with_handle(data, batch_size, feature_len, output,
+                                                                       output_len, self.handle)
+        else:
+            res = MLModuleDLL.get_instance().predict_batch(data, batch_size, feature_len, output, output_len,
+                                                           self.serialized_params)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to calc metric', res)
+        return output[0:output_len[0]].reshape(batch_size, -1)
+
+    def get_model_stats(self) -> dict:
+        """get number of predict calls, errors and latency of this model, latency is in microseconds
+
+        :return: dict with calls, errors, p50_us, p99_us, max_us and mean_us keys
+        :rtype: dict
+        """
+        stats = numpy.zeros(6).astype(numpy.float64)
+        stats_len = numpy.zeros(1).astype(numpy.int32)
+        if self.handle > 0:
+            res = MLModuleDLL.get_instance().get_model_stats_with_handle(stats, stats_len, self.handle)
+        else:
+            res = MLModuleDLL.get_instance().get_model_stats(stats, stats_len, self.serialized_params)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get model stats', res)
+        keys = ['calls', 'errors', 'p50_us', 'p99_us', 'max_us', 'mean_us']
+        return dict(zip(keys, stats[0:stats_len[0]].tolist()))
+
+
+class InferencePipeline(object):
+    """InferencePipeline calculates average band powers over eeg channels of the latest window of board data
+    and runs classifier over them in a native thread, use get_latest_prediction to poll results
+
+    :param board: board which streams data, it should outlive the pipeline
+    :type board: BoardShim
+    :param model_params: Model Params
+    :type model_params: BrainFlowModelParams
+    :param window_seconds: length of sliding window used for each prediction
+    :type window_seconds: float
+    :param update_interval_ms: how often predictions are published
+    :type update_interval_ms: int
+    :param apply_filters: apply detrend, bandstop and bandpass filters before psd calculation
+    :type apply_filters: bool
+    :param preset: preset to read data from
+    :type preset: int
+    :param bands: (start, stop) frequencies in Hz used instead of default bands
+    :type bands: list
+    """
+
+    def __init__(self, board, model_params: BrainFlowModelParams, window_seconds: float = 4.0,
+                 update_interval_ms: int = 1000, apply_filters: bool = True,
+                 preset: int = BrainFlowPresets.DEFAULT_PRESET, bands: List = None) -> None:
+        self.max_array_size = max(1, model_params.max_array_size)
+        pipeline_params = model_params.to_json()
+        if bands:
+            params_dict = json.loads(pipeline_params)
+            params_dict['bands'] = [[float(band[0]), float(band[1])] for band in bands]
+            pipeline_params = json.dumps(params_dict)
+        try:
+            serialized_params = pipeline_params.encode()
+        except BaseException:
+            serialized_params = pipeline_params
+        handle = numpy.zeros(1).astype(numpy.int32)
+        res = MLModuleDLL.get_instance().create_inference_pipeline(serialized_params, board.board_id,
+                                                                   board.input_json, window_seconds,
+                                                                   update_interval_ms, int(apply_filters),
+                                                                   preset, handle)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to create inference pipeline', res)
+        self.handle = int(handle[0])
+
+    def start(self) -> None:
+        """prepare classifier and start pipeline thread, board should be streaming"""
+
+        res = MLModuleDLL.get_instance().start_inference_pipeline(self.handle)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to start inference pipeline', res)
+
+    def stop(self) -> None:
+        """stop pipeline thread and release classifier"""
+
+        res = MLModuleDLL.get_instance().stop_inference_pipeline(self.handle)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to stop inference pipeline', res)
+
+    def get_latest_prediction(self):
+        """get latest prediction and timestamp of the last sample in its window
+
+        :return: prediction and timestamp or None if there is no prediction yet
+        :rtype: tuple
+        """
+        output = numpy.zeros(self.max_array_size).astype(numpy.float64)
+        output_len = numpy.zeros(1).astype(numpy.int32)
+        timestamp = numpy.zeros(1).astype(numpy.float64)
+        res = MLModuleDLL.get_instance().get_inference_pipeline_prediction(self.handle, output, output_len,
+                                                                           timestamp)
+        if res == BrainFlowExitCodes.CLASSIFIER_IS_NOT_PREPARED_ERROR.value:
+            return None
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get prediction', res)
+        return output[0:output_len[0]], float(timestamp[0])
+
+    def get_num_errors(self) -> int:
+        """get number of updates failed because of errors, updates with not enough data are not counted
+
+        :return: number of errors
+        :rtype: int
+        """
+        num_errors = numpy.zeros(1).astype(numpy.int32)
+        res = MLModuleDLL.get_instance().get_inference_pipeline_num_errors(self.handle, num_errors)
+        if res != BrainFlowExitCodes.STATUS_OK.value:
+            raise BrainFlowError('unable to get number of errors', res)
+        return int(num_errors[0])
+
+    def release(self) -> None:
+        """stop pipeline thread if needed and release pipeline"""
+
+        if self.handle > 0:
+            res = MLModuleDLL.get_instance().release_inference_pipeline(self.handle)
+            self.handle = 0
+            if res != BrainFlowExitCodes.STATUS_OK.value:
+                raise BrainFlowError('unable to release inference pipeline', res)
@@ -103,7 +103,8 @@ pub enum BoardIds {
     SynchroniUno1ChannelsBoard = 62,
     OB300024ChannelsBoard = 63,
     BiolistenerBoard = 64,
-    CerelogX8Board = 65
+    CerelogX8Board = 65,
+    SyntheticLoadBoard = 66
 }
 #[repr(i32)]
 #[derive(FromPrimitive, ToPrimitive, Debug, Copy, Clone, Hash, PartialEq, Eq)]
@@ -157,6 +158,7 @@ pub enum BrainFlowClassifiers {
     DefaultClassifier = 0,
     DynLibClassifier = 1,
     OnnxClassifier = 2,
+    LinearClassifier = 3,
 }
 #[repr(i32)]
 #[derive(FromPrimitive, ToPrimitive, Debug, Copy, Clone, Hash, PartialEq, Eq)]
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <string.h>
 #include <string>
 
 #include "aavaa_v3.h"
@@ -38,6 +40,9 @@ AAVAAv3::AAVAAv3 (struct BrainFlowInputParams params)
     : BLELibBoard ((int)BoardIds::AAVAA_V3_BOARD, params)
 {
     initialized = false;
+    // data notifications are 244 bytes, command responses are shorter
+    notification_queue_size = 256;
+    max_notification_size = 244;
     aavaa_adapter = NULL;
     aavaa_peripheral = NULL;
     is_streaming = false;
@@ -204,6 +209,7 @@ int AAVAAv3::prepare_session ()
 
     if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (num_chars_found == 2))
     {
+        resolve_channels ();
         initialized = true;
     }
     else
@@ -227,11 +233,19 @@ int AAVAAv3::start_stream (int buffer_size, const char *streamer_params)
     int res = prepare_for_acquisition (buffer_size, streamer_params);
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
-        res = send_command (start_command);
+        Incoming_BLE_Data_Buffer.clear ();
+        res = start_notification_thread ();
     }
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
+        // set before the command to not treat the first frames as status strings
         is_streaming = true;
+        res = send_command (start_command);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            is_streaming = false;
+            stop_notification_thread ();
+        }
     }
 
     return res;
@@ -252,12 +266,14 @@ int AAVAAv3::stop_stream ()
     {
         res = (int)BrainFlowExitCodes::STREAM_THREAD_IS_NOT_RUNNING;
     }
+    stop_notification_thread ();
     is_streaming = false;
     return res;
 }
 
 int AAVAAv3::release_session ()
 {
+    stop_notification_thread ();
     if (initialized)
     {
         // repeat it multiple times, failure here may lead to a crash
@@ -468,6 +484,23 @@ void AAVAAv3::adapter_1_on_scan_found (
     }
 }
 
+void AAVAAv3::resolve_channels ()
+{
+    const json &default_preset = board_descr["default"];
+    package.resize (default_preset["num_rows"].get<int> ());
+    data_frame.resize (SIZE_OF_DATA_FRAME);
+    eeg_channels = default_preset["eeg_channels"].get<std::vector<int>> ();
+    for (int i = 0; i < 3; i++)
+    {
+        rotation_channels[i] = default_preset["rotation_channels"][i].get<int> ();
+    }
+    package_num_channel = default_preset["package_num_channel"].get<int> ();
+    battery_channel = default_preset["battery_channel"].get<int> ();
+    imu_status_channel = default_preset["other_channels"][0].get<int> ();
+    device_timestamp_channel = default_preset["other_channels"][1].get<int> ();
+    timestamp_channel = default_preset["timestamp_channel"].get<int> ();
+}
+
 void AAVAAv3::read_data (
     simpleble_uuid_t service, simpleble_uuid_t characteristic, const uint8_t *data, size_t size)
 {
@@ -475,24 +508,24 @@ void AAVAAv3::read_data (
 
     if (!is_streaming)
     {
-        if (data[1] == 64)
+        if ((size > 1) && (data[1] == 64))
         { // when the first byte is @
             std::string temp (reinterpret_cast<const char *> (data), size);
             device_status = temp.substr (1);
             safe_logger (spdlog::level::trace, "received a status string {} ", device_status);
         }
-        else
+        else if (size >= 5)
         {
             safe_logger (spdlog::level::trace, "received a string with start byte {} {} {} {} {}",
                 data[0], data[1], data[2], data[3], data[4]);
         }
         return;
     }
+    enqueue_notification (0, data, size);
+}
 
-    int num_rows = board_descr["default"]["num_rows"];
-
-    std::vector<int> eeg_channels = board_descr["default"]["eeg_channels"];
-
+void AAVAAv3::handle_notification (int type, const uint8_t *data, size_t size, double timestamp)
+{
     if (size == 244)
     {
         data += 3;
@@ -514,7 +547,6 @@ void AAVAAv3::read_data (
             continue;
         }
 
-        uint8_t *data_frame = new uint8_t[SIZE_OF_DATA_FRAME];
         for (int i = 0; i < SIZE_OF_DATA_FRAME; ++i)
         {
             data_frame[i] = Incoming_BLE_Data_Buffer.front ();
@@ -528,55 +560,40 @@ void AAVAAv3::read_data (
             continue;
         }
 
-        double *package = new double[num_rows];
-        for (int i = 0; i < num_rows; i++)
-        {
-            package[i] = 0.0;
-        }
+        std::fill (package.begin (), package.end (), 0.0);
 
         // package num
-        package[board_descr["default"]["package_num_channel"].get<int> ()] = (double)data_frame[1];
+        package[package_num_channel] = (double)data_frame[1];
 
         // eeg
         for (unsigned int i = 0; i < eeg_channels.size (); i++)
         {
             // all the eeg_channels are 4 bytes and we skip the START byte and package number byte
             float f_value;
-            std::memcpy (&f_value, data_frame + 2 + 4 * i, sizeof (f_value));
+            std::memcpy (&f_value, data_frame.data () + 2 + 4 * i, sizeof (f_value));
             double d_value = static_cast<double> (f_value);
             package[eeg_channels[i]] = EEG_SCALE * d_value;
         }
 
-        package[board_descr["default"]["rotation_channels"][0].get<int> ()] =
-            IMU_SCALE * cast_16bit_to_int32 (data_frame + 34);
-        package[board_descr["default"]["rotation_channels"][1].get<int> ()] =
-            IMU_SCALE * cast_16bit_to_int32 (data_frame + 36);
-        package[board_descr["default"]["rotation_channels"][2].get<int> ()] =
-            IMU_SCALE * cast_16bit_to_int32 (data_frame + 38);
+        for (int i = 0; i < 3; i++)
+        {
+            package[rotation_channels[i]] =
+                IMU_SCALE * cast_16bit_to_int32 (data_frame.data () + 34 + 2 * i);
+        }
 
         // battery byte
-        package[board_descr["default"]["battery_channel"].get<int> ()] = (double)data_frame[40];
+        package[battery_channel] = (double)data_frame[40];
 
         // imu status byte
-        package[board_descr["default"]["other_channels"][0].get<int> ()] = (double)data_frame[41];
+        package[imu_status_channel] = (double)data_frame[41];
 
-        // timestamp
-        try
-        {
-            package[board_descr["default"]["other_channels"][1].get<int> ()] =
-                *reinterpret_cast<uint32_t *> (data_frame + 42) *
-                TIMESTAMP_SCALE; // get_timestamp ();
-        }
-        catch (const std::exception &e)
-        {
-            std::string error_message = std::string ("Exception occurred: ") + e.what ();
-            safe_logger (spdlog::level::warn, error_message);
-        }
+        // device timestamp
+        uint32_t device_timestamp;
+        std::memcpy (&device_timestamp, data_frame.data () + 42, sizeof (device_timestamp));
+        package[device_timestamp_channel] = device_timestamp * TIMESTAMP_SCALE;
 
-        package[board_descr["default"]["timestamp_channel"].get<int> ()] = get_timestamp ();
+        package[timestamp_channel] = timestamp;
 
-        push_package (package);
-        delete[] package;
-        delete[] data_frame;
+        push_package (package.data ());
     }
 }
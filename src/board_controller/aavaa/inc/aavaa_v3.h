@@ -50,4 +50,17 @@ protected:
     std::pair<simpleble_uuid_t, simpleble_uuid_t> write_characteristics;
     std::string start_command;
     std::string stop_command;
+    // channel indices are resolved once in prepare_session
+    std::vector<double> package;
+    std::vector<uint8_t> data_frame;
+    std::vector<int> eeg_channels;
+    int rotation_channels[3];
+    int package_num_channel;
+    int battery_channel;
+    int imu_status_channel;
+    int device_timestamp_channel;
+    int timestamp_channel;
+
+    void resolve_channels ();
+    void handle_notification (int type, const uint8_t *data, size_t size, double timestamp);
 };
@@ -321,16 +321,7 @@ void BioListener<BIOLISTENER_DATA_CHANNELS_COUNT>::read_thread ()
                 package[board_descr["default"]["package_num_channel"].template get<int> ()] =
                     parsed_packet.n;
 
-                static uint32_t package_num_channel_last = parsed_packet.n - 1;
-
-                if (package_num_channel_last + 1 != parsed_packet.n)
-                {
-                    safe_logger (spdlog::level::err,
-                        "Package num mismatch BIOLISTENER_DATA_PACKET_BIOSIGNALS! Lost: {} packets",
-                        parsed_packet.n - package_num_channel_last + 1);
-                }
-
-                package_num_channel_last = parsed_packet.n;
+                int num_placeholders = track_package_num ((double)parsed_packet.n, 32);
 
                 int sensor_id = parsed_packet.s_id;
 
@@ -364,6 +355,7 @@ void BioListener<BIOLISTENER_DATA_CHANNELS_COUNT>::read_thread ()
                         return;
                     }
                 }
+                push_placeholder_packages (num_placeholders);
                 push_package (package);
             }
             else if (parsed_packet.type == BIOLISTENER_DATA_PACKET_IMU)
@@ -373,16 +365,8 @@ void BioListener<BIOLISTENER_DATA_CHANNELS_COUNT>::read_thread ()
                 package[board_descr["auxiliary"]["package_num_channel"].template get<int> ()] =
                     parsed_packet.n;
 
-                static uint32_t package_num_channel_last = parsed_packet.n - 1;
-
-                if (package_num_channel_last + 1 != parsed_packet.n)
-                {
-                    safe_logger (spdlog::level::err,
-                        "Package num mismatch BIOLISTENER_DATA_PACKET_IMU! Lost: {} packets",
-                        parsed_packet.n - package_num_channel_last + 1);
-                }
-
-                package_num_channel_last = parsed_packet.n;
+                int num_placeholders = track_package_num (
+                    (double)parsed_packet.n, 32, (int)BrainFlowPresets::AUXILIARY_PRESET);
 
                 for (int i = 0; i < 3; i++)
                 {
@@ -394,6 +378,8 @@ void BioListener<BIOLISTENER_DATA_CHANNELS_COUNT>::read_thread ()
                 package[board_descr["auxiliary"]["battery_channel"].template get<int> ()] =
                     UINT32_TO_FLOAT (parsed_packet.data[7]);
 
+                push_placeholder_packages (
+                    num_placeholders, (int)BrainFlowPresets::AUXILIARY_PRESET);
                 push_package (package, (int)BrainFlowPresets::AUXILIARY_PRESET);
             }
             else
@@ -5,6 +5,7 @@
 
 #include "bluetooth_types.h"
 #include "get_dll_dir.h"
+#include "timestamp.h"
 
 #ifndef STATIC_SIMPLEBLE
 DLLLoader *BLELibBoard::dll_loader = NULL;
@@ -19,10 +20,174 @@ std::mutex BLELibBoard::mutex;
 BLELibBoard::BLELibBoard (int board_id, struct BrainFlowInputParams params)
     : Board (board_id, params)
 {
+    notification_queue = NULL;
+    notification_queue_size = BLE_NOTIFICATION_QUEUE_SIZE;
+    max_notification_size = MAX_BLE_NOTIFICATION_SIZE;
+    keep_notification_thread = false;
+    accept_notifications = false;
+    consumer_waiting = false;
+    active_producers = 0;
+    dropped_notifications = 0;
 }
 
 BLELibBoard::~BLELibBoard ()
 {
+    // derived boards stop the thread in release_session, it's too late to decode anything here
+    stop_notification_thread ();
+    if (notification_queue != NULL)
+    {
+        delete notification_queue;
+        notification_queue = NULL;
+    }
+}
+
+int BLELibBoard::start_notification_thread ()
+{
+    if (keep_notification_thread)
+    {
+        return (int)BrainFlowExitCodes::STREAM_ALREADY_RUN_ERROR;
+    }
+    if ((max_notification_size == 0) || (max_notification_size > MAX_BLE_NOTIFICATION_SIZE))
+    {
+        max_notification_size = MAX_BLE_NOTIFICATION_SIZE;
+    }
+    // callbacks of previous session may still be copying to the queue
+    wait_for_producers ();
+    if ((notification_queue != NULL) &&
+        ((notification_queue->get_capacity () < notification_queue_size) ||
+            (notification_data.size () !=
+                notification_queue->get_capacity () * max_notification_size)))
+    {
+        delete notification_queue;
+        notification_queue = NULL;
+    }
+    if (notification_queue == NULL)
+    {
+        notification_queue = new SPSCQueue<BLENotification> (notification_queue_size);
+        size_t capacity = notification_queue->get_capacity ();
+        notification_data.assign (capacity * max_notification_size, 0);
+        for (size_t i = 0; i < capacity; i++)
+        {
+            notification_queue->get_slot (i).data = notification_data.data () +
+                i * max_notification_size;
+        }
+    }
+    // drop notifications which were enqueued after previous stop
+    while (notification_queue->front () != NULL)
+    {
+        notification_queue->pop ();
+    }
+    dropped_notifications = 0;
+    keep_notification_thread = true;
+    notification_thread = std::thread ([this] { this->notification_thread_worker (); });
+    accept_notifications = true;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void BLELibBoard::stop_notification_thread ()
+{
+    accept_notifications = false;
+    wait_for_producers ();
+    if (keep_notification_thread)
+    {
+        {
+            std::lock_guard<std::mutex> lock (notification_mutex);
+            keep_notification_thread = false;
+        }
+        notification_cv.notify_one ();
+        notification_thread.join ();
+        size_t dropped = dropped_notifications;
+        if (dropped > 0)
+        {
+            safe_logger (spdlog::level::warn, "{} notifications were dropped", dropped);
+        }
+    }
+}
+
+bool BLELibBoard::enqueue_notification (int type, const uint8_t *data, size_t size)
+{
+    // counter is incremented before the check, so start and stop which reset the flag and wait
+    // for zero never touch the queue while a producer is inside
+    active_producers++;
+    bool res = (accept_notifications) && (push_notification (type, data, size));
+    active_producers--;
+    return res;
+}
+
+void BLELibBoard::wait_for_producers ()
+{
+    while (active_producers > 0)
+    {
+        std::this_thread::yield ();
+    }
+}
+
+bool BLELibBoard::push_notification (int type, const uint8_t *data, size_t size)
+{
+    if (size > max_notification_size)
+    {
+        dropped_notifications++;
+        return false;
+    }
+    double timestamp = get_timestamp ();
+    notification_producer_lock.lock ();
+    BLENotification *notification = notification_queue->claim ();
+    if (notification != NULL)
+    {
+        notification->timestamp = timestamp;
+        notification->type = type;
+        notification->size = size;
+        memcpy (notification->data, data, size);
+        notification_queue->publish ();
+    }
+    notification_producer_lock.unlock ();
+    if (notification == NULL)
+    {
+        dropped_notifications++;
+        return false;
+    }
+    // pairs with fence of consumer: either consumer sees published notification before waiting
+    // or producer sees consumer_waiting, empty lock section then orders notify with wait
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    if (consumer_waiting)
+    {
+        {
+            std::lock_guard<std::mutex> lock (notification_mutex);
+        }
+        notification_cv.notify_one ();
+    }
+    return true;
+}
+
+void BLELibBoard::process_notifications ()
+{
+    BLENotification *notification = notification_queue->front ();
+    while (notification != NULL)
+    {
+        handle_notification (
+            notification->type, notification->data, notification->size, notification->timestamp);
+        notification_queue->pop ();
+        notification = notification_queue->front ();
+    }
+}
+
+void BLELibBoard::notification_thread_worker ()
+{
+    while (keep_notification_thread)
+    {
+        {
+            std::unique_lock<std::mutex> lock (notification_mutex);
+            consumer_waiting = true;
+            std::atomic_thread_fence (std::memory_order_seq_cst);
+            notification_cv.wait (lock, [this] {
+                return (!keep_notification_thread) || (notification_queue->front () != NULL);
+            });
+            consumer_waiting = false;
+        }
+        process_notifications ();
+    }
+    // decode notifications received before stop
+    process_notifications ();
 }
 
 bool BLELibBoard::init_dll_loader ()
@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <new>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -12,6 +14,10 @@
 #include "spdlog/sinks/null_sink.h"
 
 #define LOGGER_NAME "board_logger"
+// snapshot copies ringbuffers in chunks of this size, writer waits at most for one of them
+#define SNAPSHOT_CHUNK_SIZE 256
+// after this number of cuts overwritten during copy snapshot is copied under lock
+#define MAX_SNAPSHOT_ATTEMPTS 5
 
 #ifdef __ANDROID__
 #include "spdlog/sinks/android_sink.h"
@@ -128,94 +134,810 @@ int Board::prepare_for_acquisition (int buffer_size, const char *streamer_params
         for (auto &el : board_descr.items ())
         {
             json board_preset = el.value ();
-            DataBuffer *db = new DataBuffer ((int)board_preset["num_rows"], buffer_size);
+            int preset_int = preset_to_int (el.key ());
+            int preset_buffer_size = buffer_size;
+            // duration can be set from another thread, it is read under the same lock as buffers
+            double duration = 0.0;
+            lock.lock ();
+            auto duration_it = buffer_durations.find (preset_int);
+            bool has_duration = duration_it != buffer_durations.end ();
+            if (has_duration)
+            {
+                duration = duration_it->second;
+            }
+            lock.unlock ();
+            if (has_duration)
+            {
+                res = get_preset_buffer_size (duration, preset_int, &preset_buffer_size);
+                if (res != (int)BrainFlowExitCodes::STATUS_OK)
+                {
+                    break;
+                }
+            }
+            DataBuffer *db = new DataBuffer ((int)board_preset["num_rows"], preset_buffer_size);
             if (!db->is_ready ())
             {
-                safe_logger (
-                    spdlog::level::err, "unable to prepare buffer with size {}", buffer_size);
+                safe_logger (spdlog::level::err, "unable to prepare buffer with size {}",
+                    preset_buffer_size);
                 delete db;
                 db = NULL;
                 res = (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
             }
             else
             {
-                int preset_int = preset_to_int (el.key ());
                 dbs[preset_int] = db;
                 marker_queues[preset_int] = std::deque<double> ();
+                sequence_trackers[preset_int].reset ();
+                // new resampler picks up layout of this session and starts from empty state
+                int method = resampling_methods[preset_int];
+                resamplers[preset_int] = (method == (int)ResamplingTypes::NONE) ?
+                    NULL :
+                    create_resampler (method, preset_int);
+                if (quality_monitor_configs.find (preset_int) != quality_monitor_configs.end ())
+                {
+                    std::shared_ptr<SignalQualityMonitor> monitor =
+                        create_quality_monitor (quality_monitor_configs[preset_int], preset_int);
+                    if (monitor)
+                    {
+                        quality_monitors[preset_int] = monitor;
+                    }
+                    else
+                    {
+                        safe_logger (spdlog::level::warn,
+                            "layout changed, signal quality monitor disabled");
+                        quality_monitor_configs.erase (preset_int);
+                        quality_monitors.erase (preset_int);
+                    }
+                }
+                // history starts from empty state together with the main ringbuffer
+                if (history_configs.find (preset_int) != history_configs.end ())
+                {
+                    std::shared_ptr<DecimatedHistory> history =
+                        create_history (history_configs[preset_int], preset_int);
+                    if (history)
+                    {
+                        histories[preset_int] = history;
+                    }
+                    else
+                    {
+                        history_configs.erase (preset_int);
+                        histories.erase (preset_int);
+                    }
+                }
+                // sample indexes start from zero in the new buffer
+                for (auto it = epoch_extractors.begin (); it != epoch_extractors.end ();)
+                {
+                    if (it->second.first != preset_int)
+                    {
+                        ++it;
+                    }
+                    else if (it->second.second->get_num_rows () != (int)board_preset["num_rows"])
+                    {
+                        safe_logger (spdlog::level::warn,
+                            "layout changed, epoch definition {} removed", it->first);
+                        it = epoch_extractors.erase (it);
+                    }
+                    else
+                    {
+                        it->second.second->reset ();
+                        ++it;
+                    }
+                }
+            }
+        }
+    }
+
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        free_packages ();
+    }
+
+    return res;
+}
+
+void Board::push_package (double *package, int preset)
+{
+    std::string preset_str = preset_to_string (preset);
+    if ((board_descr.find (preset_str) == board_descr.end ()) || (dbs.find (preset) == dbs.end ()))
+    {
+        safe_logger (spdlog::level::err, "invalid json or push_package args, no such key");
+        return;
+    }
+    int marker_channel = -1;
+    try
+    {
+        marker_channel = board_descr[preset_str]["marker_channel"];
+    }
+    catch (...)
+    {
+        safe_logger (spdlog::level::err, "Failed to get marker channel/value");
+    }
+
+    lock.lock ();
+    UniformResampler *resampler = resamplers[preset].get ();
+    if (resampler == NULL)
+    {
+        store_package (package, preset, marker_channel);
+    }
+    else
+    {
+        resampler->add_sample (package);
+        while (double *resampled = resampler->next ())
+        {
+            store_package (resampled, preset, marker_channel);
+        }
+    }
+    lock.unlock ();
+}
+
+void Board::store_package (double *package, int preset, int marker_channel)
+{
+    if (marker_channel >= 0)
+    {
+        std::deque<double> &marker_queue = marker_queues[preset];
+        if (marker_queue.empty ())
+        {
+            package[marker_channel] = 0.0;
+        }
+        else
+        {
+            package[marker_channel] = marker_queue.front ();
+            marker_queue.pop_front ();
+        }
+    }
+    if (dbs[preset] != NULL)
+    {
+        if (epoch_extractors.empty ())
+        {
+            dbs[preset]->add_data (package);
+        }
+        else
+        {
+            uint64_t first_index = dbs[preset]->get_total_count ();
+            dbs[preset]->add_data (package);
+            extract_epochs (package, 1, preset, first_index);
+        }
+        auto monitor = quality_monitors.find (preset);
+        if (monitor != quality_monitors.end ())
+        {
+            monitor->second->add_samples (package, 1);
+        }
+        auto history = histories.find (preset);
+        if (history != histories.end ())
+        {
+            history->second->add_samples (package, 1);
+        }
+    }
+    if (streamers.find (preset) != streamers.end ())
+    {
+        for (auto &streamer : streamers[preset])
+        {
+            streamer->stream_data (package);
+        }
+    }
+}
+
+void Board::extract_epochs (const double *samples, size_t count, int preset, uint64_t first_index)
+{
+    for (auto &definition : epoch_extractors)
+    {
+        if (definition.second.first == preset)
+        {
+            definition.second.second->add_samples (samples, count, first_index, dbs[preset]);
+        }
+    }
+}
+
+void Board::push_packages (double *packages, int num_packages, int preset)
+{
+    std::string preset_str = preset_to_string (preset);
+    if ((board_descr.find (preset_str) == board_descr.end ()) || (dbs.find (preset) == dbs.end ()))
+    {
+        safe_logger (spdlog::level::err, "invalid json or push_packages args, no such key");
+        return;
+    }
+    if (num_packages < 1)
+    {
+        return;
+    }
+    int num_rows = 0;
+    int marker_channel = -1;
+    try
+    {
+        const json &board_preset = board_descr[preset_str];
+        num_rows = board_preset["num_rows"];
+        marker_channel = board_preset["marker_channel"];
+    }
+    catch (...)
+    {
+        safe_logger (spdlog::level::err, "Failed to get num rows/marker channel");
+        return;
+    }
+
+    lock.lock ();
+    UniformResampler *resampler = resamplers[preset].get ();
+    if (resampler != NULL)
+    {
+        // grid samples dont match input packages, store them one by one
+        for (int i = 0; i < num_packages; i++)
+        {
+            resampler->add_sample (packages + (size_t)i * num_rows);
+            while (double *resampled = resampler->next ())
+            {
+                store_package (resampled, preset, marker_channel);
+            }
+        }
+        lock.unlock ();
+        return;
+    }
+
+    // packages which dont fit into ring buffer are dropped by it, markers are kept for the stored
+    // ones instead of being consumed by packages nobody can read
+    int num_dropped = 0;
+    if ((dbs[preset] != NULL) && ((size_t)num_packages > dbs[preset]->get_buffer_size ()))
+    {
+        num_dropped = num_packages - (int)dbs[preset]->get_buffer_size ();
+    }
+    std::deque<double> &marker_queue = marker_queues[preset];
+    for (int i = 0; i < num_packages; i++)
+    {
+        double *package = packages + (size_t)i * num_rows;
+        if ((i < num_dropped) || (marker_queue.empty ()))
+        {
+            package[marker_channel] = 0.0;
+        }
+        else
+        {
+            package[marker_channel] = marker_queue.front ();
+            marker_queue.pop_front ();
+        }
+    }
+
+    if (dbs[preset] != NULL)
+    {
+        uint64_t first_index = dbs[preset]->get_total_count ();
+        dbs[preset]->add_data (packages, (size_t)num_packages);
+        if (!epoch_extractors.empty ())
+        {
+            extract_epochs (packages, (size_t)num_packages, preset, first_index);
+        }
+        auto monitor = quality_monitors.find (preset);
+        if (monitor != quality_monitors.end ())
+        {
+            monitor->second->add_samples (packages, (size_t)num_packages);
+        }
+        auto history = histories.find (preset);
+        if (history != histories.end ())
+        {
+            history->second->add_samples (packages, (size_t)num_packages);
+        }
+    }
+    if (streamers.find (preset) != streamers.end ())
+    {
+        for (int i = 0; i < num_packages; i++)
+        {
+            for (auto &streamer : streamers[preset])
+            {
+                streamer->stream_data (packages + (size_t)i * num_rows);
+            }
+        }
+    }
+    lock.unlock ();
+}
+
+int Board::insert_marker (double value, int preset)
+{
+    if (std::fabs (value) < std::numeric_limits<double>::epsilon ())
+    {
+        safe_logger (spdlog::level::err, "0 is a default value for marker, you can not use it.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::string preset_str = preset_to_string (preset);
+    if ((board_descr.find (preset_str) == board_descr.end ()) ||
+        (marker_queues.find (preset) == marker_queues.end ()))
+    {
+        safe_logger (spdlog::level::err, "invalid preset");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    lock.lock ();
+    marker_queues[preset].push_back (value);
+    lock.unlock ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_package_loss_stats (int preset, double *stats)
+{
+    if (stats == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    auto tracker = sequence_trackers.find (preset);
+    if (tracker == sequence_trackers.end ())
+    {
+        safe_logger (spdlog::level::err, "invalid preset");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // counters are 64 bit and exceed int range in long sessions of fast boards, double keeps them
+    // exact up to 2^53
+    stats[0] = (double)tracker->second.get_received ();
+    stats[1] = (double)tracker->second.get_lost ();
+    stats[2] = (double)tracker->second.get_duplicated ();
+    stats[3] = (double)tracker->second.get_reordered ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::set_lost_packages_fill (bool enable, int max_gap, int preset)
+{
+    if (max_gap < 1)
+    {
+        safe_logger (spdlog::level::err, "max gap must be positive");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    auto tracker = sequence_trackers.find (preset);
+    if (tracker == sequence_trackers.end ())
+    {
+        safe_logger (spdlog::level::err, "invalid preset");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    tracker->second.set_fill_lost (enable, max_gap);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::set_resampling (int method, int preset)
+{
+    if ((method < (int)ResamplingTypes::NONE) || (method > (int)ResamplingTypes::CUBIC))
+    {
+        safe_logger (spdlog::level::err, "invalid resampling method {}", method);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (board_descr.find (preset_to_string (preset)) == board_descr.end ())
+    {
+        safe_logger (spdlog::level::err, "invalid preset");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<UniformResampler> resampler = NULL;
+    if (method != (int)ResamplingTypes::NONE)
+    {
+        resampler = create_resampler (method, preset);
+        if (!resampler)
+        {
+            return (int)BrainFlowExitCodes::UNSUPPORTED_BOARD_ERROR;
+        }
+    }
+    // if stream is running new resampler starts from the next package
+    lock.lock ();
+    resampling_methods[preset] = method;
+    resamplers[preset] = resampler;
+    lock.unlock ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+std::shared_ptr<UniformResampler> Board::create_resampler (int method, int preset)
+{
+    try
+    {
+        const json &board_preset = board_descr[preset_to_string (preset)];
+        int package_num_channel = board_preset.value ("package_num_channel", -1);
+        return std::make_shared<UniformResampler> ((int)board_preset["num_rows"],
+            (int)board_preset["timestamp_channel"], package_num_channel,
+            (double)board_preset["sampling_rate"], method);
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, "preset doesnt support resampling: {}", e.what ());
+    }
+    return NULL;
+}
+
+int Board::add_epoch_definition (const double *marker_values, int num_marker_values,
+    int pre_samples, int post_samples, int max_epochs, int preset, int *definition_id)
+{
+    if ((marker_values == NULL) || (num_marker_values < 1) || (pre_samples < 0) ||
+        (post_samples < 0) || (max_epochs < 1) || (definition_id == NULL))
+    {
+        safe_logger (spdlog::level::err, "invalid epoch definition");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::string preset_str = preset_to_string (preset);
+    if (board_descr.find (preset_str) == board_descr.end ())
+    {
+        safe_logger (spdlog::level::err, "invalid preset");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<EpochExtractor> extractor = NULL;
+    try
+    {
+        const json &board_preset = board_descr[preset_str];
+        extractor = std::make_shared<EpochExtractor> (
+            std::vector<double> (marker_values, marker_values + num_marker_values), pre_samples,
+            post_samples, max_epochs, (int)board_preset["num_rows"],
+            (int)board_preset["marker_channel"]);
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, "preset has no marker channel: {}", e.what ());
+        return (int)BrainFlowExitCodes::UNSUPPORTED_BOARD_ERROR;
+    }
+    catch (const std::bad_alloc &)
+    {
+        safe_logger (spdlog::level::err, "unable to allocate {} epochs", max_epochs);
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    lock.lock ();
+    *definition_id = next_epoch_definition_id++;
+    epoch_extractors[*definition_id] = std::make_pair (preset, extractor);
+    lock.unlock ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::remove_epoch_definition (int definition_id)
+{
+    lock.lock ();
+    size_t num_removed = epoch_extractors.erase (definition_id);
+    lock.unlock ();
+    if (num_removed == 0)
+    {
+        safe_logger (spdlog::level::err, "no epoch definition with id {}", definition_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+std::shared_ptr<EpochExtractor> Board::find_epoch_extractor (int definition_id)
+{
+    std::shared_ptr<EpochExtractor> extractor = NULL;
+    lock.lock ();
+    auto it = epoch_extractors.find (definition_id);
+    if (it != epoch_extractors.end ())
+    {
+        extractor = it->second.second;
+    }
+    lock.unlock ();
+    if (!extractor)
+    {
+        safe_logger (spdlog::level::err, "no epoch definition with id {}", definition_id);
+    }
+    return extractor;
+}
+
+int Board::get_epoch_count (int definition_id, int *result)
+{
+    if (result == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<EpochExtractor> extractor = find_epoch_extractor (definition_id);
+    if (!extractor)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *result = extractor->get_epoch_count ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_num_dropped_epochs (int definition_id, double *result)
+{
+    if (result == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<EpochExtractor> extractor = find_epoch_extractor (definition_id);
+    if (!extractor)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *result = (double)extractor->get_num_dropped ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_epochs (int definition_id, int max_epochs, double *data_buf, int *returned_epochs)
+{
+    if ((data_buf == NULL) || (returned_epochs == NULL) || (max_epochs < 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<EpochExtractor> extractor = find_epoch_extractor (definition_id);
+    if (!extractor)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *returned_epochs = extractor->get_epochs (max_epochs, data_buf);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::enable_signal_quality_monitor (const char *json_config, int preset)
+{
+    if (board_descr.find (preset_to_string (preset)) == board_descr.end ())
+    {
+        safe_logger (spdlog::level::err, "invalid preset");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::string config = ((json_config == NULL) || (json_config[0] == '\0')) ? "{}" : json_config;
+    std::shared_ptr<SignalQualityMonitor> monitor = create_quality_monitor (config, preset);
+    if (!monitor)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // if stream is running new monitor starts from the next package
+    lock.lock ();
+    quality_monitor_configs[preset] = config;
+    quality_monitors[preset] = monitor;
+    lock.unlock ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::disable_signal_quality_monitor (int preset)
+{
+    lock.lock ();
+    quality_monitor_configs.erase (preset);
+    size_t num_removed = quality_monitors.erase (preset);
+    lock.unlock ();
+    if (num_removed == 0)
+    {
+        safe_logger (spdlog::level::err, "signal quality monitor is not enabled");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_signal_quality (int preset, double *output, int *num_channels)
+{
+    if ((output == NULL) || (num_channels == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<SignalQualityMonitor> monitor = NULL;
+    lock.lock ();
+    auto it = quality_monitors.find (preset);
+    if (it != quality_monitors.end ())
+    {
+        monitor = it->second;
+    }
+    lock.unlock ();
+    if (!monitor)
+    {
+        safe_logger (spdlog::level::err, "signal quality monitor is not enabled");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *num_channels = monitor->get_quality (output);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+std::shared_ptr<SignalQualityMonitor> Board::create_quality_monitor (
+    const std::string &config, int preset)
+{
+    try
+    {
+        json params = json::parse (config);
+        const json &board_preset = board_descr[preset_to_string (preset)];
+        int num_rows = board_preset["num_rows"];
+        std::set<int> channels;
+        if (params.find ("channels") != params.end ())
+        {
+            for (int channel : params["channels"])
+            {
+                channels.insert (channel);
+            }
+        }
+        else
+        {
+            const char *data_types[4] = {
+                "eeg_channels", "emg_channels", "ecg_channels", "eog_channels"};
+            for (int i = 0; i < 4; i++)
+            {
+                if (board_preset.find (data_types[i]) != board_preset.end ())
+                {
+                    for (int channel : board_preset[data_types[i]])
+                    {
+                        channels.insert (channel);
+                    }
+                }
             }
         }
+        if (channels.empty () || (*channels.begin () < 0) || (*channels.rbegin () >= num_rows))
+        {
+            safe_logger (spdlog::level::err, "invalid channels for signal quality monitor");
+            return NULL;
+        }
+        // 4.5V reference and default gain 24 of ADS1299
+        double saturation_value = params.value ("saturation_value", 187500.0);
+        double window_seconds = params.value ("window_seconds", 1.0);
+        if ((window_seconds <= 0.0) || (saturation_value <= 0.0))
+        {
+            safe_logger (spdlog::level::err, "invalid signal quality monitor config");
+            return NULL;
+        }
+        return std::make_shared<SignalQualityMonitor> (
+            std::vector<int> (channels.begin (), channels.end ()), num_rows,
+            (double)board_preset["sampling_rate"], window_seconds,
+            params.value ("railed_threshold", 0.9 * saturation_value), saturation_value,
+            params.value ("flatline_threshold", 0.5));
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, "invalid signal quality monitor config: {}", e.what ());
+    }
+    return NULL;
+}
+
+int Board::enable_history (int ratio, int method, double seconds, int preset)
+{
+    if ((ratio < 1) || (method < (int)DecimationTypes::MEAN) ||
+        (method > (int)DecimationTypes::MIN_MAX))
+    {
+        safe_logger (spdlog::level::err, "invalid history ratio {} or method {}", ratio, method);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (board_descr.find (preset_to_string (preset)) == board_descr.end ())
+    {
+        safe_logger (spdlog::level::err, "invalid preset");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    HistoryConfig config = {ratio, method, seconds};
+    std::shared_ptr<DecimatedHistory> history = create_history (config, preset);
+    if (!history)
+    {
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    // if stream is running new history starts from the next package
+    lock.lock ();
+    history_configs[preset] = config;
+    histories[preset] = history;
+    lock.unlock ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::disable_history (int preset)
+{
+    lock.lock ();
+    history_configs.erase (preset);
+    size_t num_removed = histories.erase (preset);
+    lock.unlock ();
+    if (num_removed == 0)
+    {
+        safe_logger (spdlog::level::err, "history is not enabled");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+std::shared_ptr<DecimatedHistory> Board::find_history (int preset)
+{
+    std::shared_ptr<DecimatedHistory> history = NULL;
+    lock.lock ();
+    auto it = histories.find (preset);
+    if (it != histories.end ())
+    {
+        history = it->second;
+    }
+    lock.unlock ();
+    if (!history)
+    {
+        safe_logger (spdlog::level::err, "history is not enabled");
+    }
+    return history;
+}
+
+int Board::get_history_count (int preset, int *result)
+{
+    if (result == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<DecimatedHistory> history = find_history (preset);
+    if (!history)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *result = (int)history->get_data_count ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_history (int num_samples, int preset, double *data_buf, int *returned_samples)
+{
+    if ((data_buf == NULL) || (returned_samples == NULL) || (num_samples < 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<DecimatedHistory> history = find_history (preset);
+    if (!history)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-
+    int num_rows = history->get_num_rows ();
+    int res = check_output_rows (preset, num_rows);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
-        free_packages ();
+        return res;
     }
-
-    return res;
-}
-
-void Board::push_package (double *package, int preset)
-{
-    std::string preset_str = preset_to_string (preset);
-    if ((board_descr.find (preset_str) == board_descr.end ()) || (dbs.find (preset) == dbs.end ()))
+    double *buf = new double[(size_t)num_samples * num_rows];
+    int num_data_points = (int)history->get_current_data (num_samples, buf);
+    // same transposition as in get_current_board_data
+    for (int i = 0; i < num_data_points; i++)
     {
-        safe_logger (spdlog::level::err, "invalid json or push_package args, no such key");
-        return;
+        for (int j = 0; j < num_rows; j++)
+        {
+            data_buf[(size_t)j * num_data_points + i] = buf[(size_t)i * num_rows + j];
+        }
     }
+    *returned_samples = num_data_points;
+    delete[] buf;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
-    lock.lock ();
-    json board_preset = board_descr[preset_str];
+std::shared_ptr<DecimatedHistory> Board::create_history (const HistoryConfig &config, int preset)
+{
     try
     {
-        int marker_channel = board_preset["marker_channel"];
-        if (marker_queues[preset].empty ())
+        const json &board_preset = board_descr[preset_to_string (preset)];
+        double num_blocks = std::ceil (config.seconds * (double)board_preset["sampling_rate"] /
+            (double)config.ratio);
+        double capacity =
+            (config.method == (int)DecimationTypes::MIN_MAX) ? 2.0 * num_blocks : num_blocks;
+        if ((!(capacity >= 1.0)) || (capacity > MAX_CAPTURE_SAMPLES))
         {
-            package[marker_channel] = 0.0;
+            safe_logger (spdlog::level::err, "invalid history duration {}", config.seconds);
+            return NULL;
         }
-        else
+        std::shared_ptr<DecimatedHistory> history =
+            std::make_shared<DecimatedHistory> ((int)board_preset["num_rows"], config.ratio,
+                config.method, (size_t)capacity, (int)board_preset["marker_channel"]);
+        if (!history->is_ready ())
         {
-            double marker = marker_queues[preset].at (0);
-            package[marker_channel] = marker;
-            marker_queues[preset].pop_front ();
+            safe_logger (spdlog::level::err, "unable to allocate history of {} samples", capacity);
+            return NULL;
         }
+        return history;
     }
-    catch (...)
+    catch (json::exception &e)
     {
-        safe_logger (spdlog::level::err, "Failed to get marker channel/value");
+        safe_logger (spdlog::level::err, "preset doesnt support history: {}", e.what ());
     }
+    catch (const std::bad_alloc &)
+    {
+        safe_logger (spdlog::level::err, "unable to allocate history");
+    }
+    return NULL;
+}
 
-    if (dbs[preset] != NULL)
+int Board::track_package_num (double package_num, int counter_bits, int preset)
+{
+    auto tracker = sequence_trackers.find (preset);
+    if ((tracker == sequence_trackers.end ()) || (package_num < 0))
     {
-        dbs[preset]->add_data (package);
+        return 0;
     }
-    if (streamers.find (preset) != streamers.end ())
+    int num_lost = tracker->second.update ((uint64_t)package_num, counter_bits);
+    if (num_lost < 1)
     {
-        for (auto &streamer : streamers[preset])
-        {
-            streamer->stream_data (package);
-        }
+        return 0;
     }
-    lock.unlock ();
+    safe_logger (spdlog::level::trace, "lost {} packages before package num {}, preset {}",
+        num_lost, package_num, preset);
+    if (!tracker->second.get_fill_lost ())
+    {
+        return 0;
+    }
+    // huge gap means device restart rather than package loss
+    if (num_lost > tracker->second.get_max_fill_gap ())
+    {
+        safe_logger (spdlog::level::warn, "gap of {} packages is too large to fill", num_lost);
+        return 0;
+    }
+    return num_lost;
 }
 
-int Board::insert_marker (double value, int preset)
+void Board::push_placeholder_packages (int num_packages, int preset)
 {
-    if (std::fabs (value) < std::numeric_limits<double>::epsilon ())
-    {
-        safe_logger (spdlog::level::err, "0 is a default value for marker, you can not use it.");
-        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
-    }
     std::string preset_str = preset_to_string (preset);
-    if ((board_descr.find (preset_str) == board_descr.end ()) ||
-        (marker_queues.find (preset) == marker_queues.end ()))
+    if ((num_packages < 1) || (board_descr.find (preset_str) == board_descr.end ()))
     {
-        safe_logger (spdlog::level::err, "invalid preset");
-        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        return;
     }
-    lock.lock ();
-    marker_queues[preset].push_back (value);
-    lock.unlock ();
-    return (int)BrainFlowExitCodes::STATUS_OK;
+    int num_rows = board_descr[preset_str]["num_rows"];
+    std::vector<double> placeholders (
+        (size_t)num_packages * num_rows, std::numeric_limits<double>::quiet_NaN ());
+    push_packages (placeholders.data (), num_packages, preset);
 }
 
 void Board::free_packages ()
@@ -426,6 +1148,11 @@ int Board::get_current_board_data (
     }
 
     int num_rows = (int)board_descr[preset_str]["num_rows"];
+    int res = check_output_rows (preset, num_rows);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
 
     double *buf = new double[num_samples * num_rows];
     int num_data_points = (int)dbs[preset]->get_current_data (num_samples, buf);
@@ -435,6 +1162,160 @@ int Board::get_current_board_data (
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+bool Board::copy_samples (
+    DataBuffer *db, uint64_t first_index, size_t count, int num_rows, double *data_buf)
+{
+    for (size_t copied = 0; copied < count; copied += SNAPSHOT_CHUNK_SIZE)
+    {
+        size_t chunk = std::min (count - copied, (size_t)SNAPSHOT_CHUNK_SIZE);
+        if (!db->get_samples (first_index + copied, chunk, data_buf + copied * num_rows))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int Board::get_current_board_data_snapshot (const int *presets, const int *num_samples,
+    int num_presets, double *data_buf, int *returned_samples)
+{
+    if ((presets == NULL) || (num_samples == NULL) || (num_presets < 1) || (data_buf == NULL) ||
+        (returned_samples == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::vector<int> num_rows (num_presets);
+    std::vector<std::vector<double>> bufs (num_presets);
+    for (int i = 0; i < num_presets; i++)
+    {
+        std::string preset_str = preset_to_string (presets[i]);
+        if ((board_descr.find (preset_str) == board_descr.end ()) ||
+            (dbs.find (presets[i]) == dbs.end ()) || (num_samples[i] < 0))
+        {
+            safe_logger (spdlog::level::err,
+                "stream is not started or invalid preset {} or num samples", presets[i]);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        if (!dbs[presets[i]])
+        {
+            return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+        }
+        num_rows[i] = (int)board_descr[preset_str]["num_rows"];
+        int res = check_output_rows (presets[i], num_rows[i]);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+        bufs[i].resize ((size_t)num_samples[i] * num_rows[i]);
+    }
+
+    // all presets are pushed under this lock, indexes taken under it are a consistent cut across
+    // presets, stored samples are not changed until overwritten, so they are copied after the lock
+    // is released and the cut is taken again if the oldest of them was overwritten meanwhile
+    std::vector<uint64_t> first_indexes (num_presets);
+    bool is_copied = false;
+    for (int attempt = 0; (attempt < MAX_SNAPSHOT_ATTEMPTS) && (!is_copied); attempt++)
+    {
+        lock.lock ();
+        for (int i = 0; i < num_presets; i++)
+        {
+            DataBuffer *db = dbs[presets[i]];
+            size_t count = std::min (db->get_data_count (), (size_t)num_samples[i]);
+            first_indexes[i] = db->get_total_count () - count;
+            returned_samples[i] = (int)count;
+        }
+        lock.unlock ();
+        is_copied = true;
+        for (int i = 0; (i < num_presets) && (is_copied); i++)
+        {
+            is_copied = copy_samples (dbs[presets[i]], first_indexes[i],
+                (size_t)returned_samples[i], num_rows[i], bufs[i].data ());
+        }
+    }
+    // writer keeps lapping the copy, it's possible only if buffer is not much longer than snapshot
+    if (!is_copied)
+    {
+        lock.lock ();
+        for (int i = 0; i < num_presets; i++)
+        {
+            DataBuffer *db = dbs[presets[i]];
+            size_t count = std::min (db->get_data_count (), (size_t)num_samples[i]);
+            uint64_t first_index = db->get_total_count () - count;
+            if ((count > 0) && (!db->get_samples (first_index, count, bufs[i].data ())))
+            {
+                count = 0;
+            }
+            returned_samples[i] = (int)count;
+        }
+        lock.unlock ();
+    }
+
+    double *output = data_buf;
+    for (int i = 0; i < num_presets; i++)
+    {
+        for (int j = 0; j < returned_samples[i]; j++)
+        {
+            for (int k = 0; k < num_rows[i]; k++)
+            {
+                output[(size_t)k * returned_samples[i] + j] =
+                    bufs[i][(size_t)j * num_rows[i] + k];
+            }
+        }
+        output += (size_t)num_samples[i] * num_rows[i];
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_board_data_by_time (double start_time, double end_time, int max_samples,
+    int preset, bool remove, double *data_buf, int *returned_samples)
+{
+    std::string preset_str = preset_to_string (preset);
+    if (board_descr.find (preset_str) == board_descr.end ())
+    {
+        safe_logger (spdlog::level::err, "invalid preset");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (dbs.find (preset) == dbs.end ())
+    {
+        safe_logger (spdlog::level::err,
+            "stream is not started or no preset: {} found for this board", preset_str.c_str ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (!dbs[preset])
+    {
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    if ((!data_buf) || (!returned_samples) || (max_samples < 0) || (start_time > end_time))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    int num_rows = (int)board_descr[preset_str]["num_rows"];
+    int res = check_output_rows (preset, num_rows);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    int timestamp_channel = 0;
+    try
+    {
+        timestamp_channel = board_descr[preset_str]["timestamp_channel"];
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, "no timestamp channel for this preset: {}", e.what ());
+        return (int)BrainFlowExitCodes::UNSUPPORTED_BOARD_ERROR;
+    }
+
+    double *buf = new double[(size_t)max_samples * num_rows];
+    int num_data_points = (int)dbs[preset]->get_data_by_time (
+        start_time, end_time, timestamp_channel, (size_t)max_samples, remove, buf);
+    reshape_data (num_data_points, preset, buf, data_buf);
+    delete[] buf;
+    *returned_samples = num_data_points;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 int Board::get_board_data_count (int preset, int *result)
 {
     if (dbs.find (preset) == dbs.end ())
@@ -456,6 +1337,99 @@ int Board::get_board_data_count (int preset, int *result)
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+int Board::get_session_num_rows (int preset, int *result)
+{
+    std::string preset_str = preset_to_string (preset);
+    if ((board_descr.find (preset_str) == board_descr.end ()) || (!result))
+    {
+        safe_logger (spdlog::level::err, "invalid preset or null pointer");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *result = (int)board_descr[preset_str]["num_rows"];
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_session_descr (int preset, json &result)
+{
+    std::string preset_str = preset_to_string (preset);
+    if (board_descr.find (preset_str) == board_descr.end ())
+    {
+        safe_logger (spdlog::level::err, "invalid preset");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    result = board_descr[preset_str];
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_preset_buffer_size (double seconds, int preset, int *buffer_size)
+{
+    double sampling_rate = 0.0;
+    try
+    {
+        sampling_rate = board_descr[preset_to_string (preset)]["sampling_rate"];
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, "preset has no sampling rate: {}", e.what ());
+        return (int)BrainFlowExitCodes::UNSUPPORTED_BOARD_ERROR;
+    }
+    double num_samples = std::ceil (seconds * sampling_rate);
+    if ((!(num_samples >= 1.0)) || (num_samples > MAX_CAPTURE_SAMPLES))
+    {
+        safe_logger (spdlog::level::err, "invalid buffer duration {}", seconds);
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    *buffer_size = (int)num_samples;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::set_buffer_duration (double seconds, int preset)
+{
+    if (board_descr.find (preset_to_string (preset)) == board_descr.end ())
+    {
+        safe_logger (spdlog::level::err, "invalid preset");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int buffer_size = 0;
+    int res = get_preset_buffer_size (seconds, preset, &buffer_size);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    if (dbs.find (preset) != dbs.end ())
+    {
+        res = resize_buffer (buffer_size, preset);
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        lock.lock ();
+        buffer_durations[preset] = seconds;
+        lock.unlock ();
+    }
+    return res;
+}
+
+int Board::resize_buffer (int buffer_size, int preset)
+{
+    if ((buffer_size <= 0) || (buffer_size > MAX_CAPTURE_SAMPLES))
+    {
+        safe_logger (spdlog::level::err, "invalid array size");
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    if ((dbs.find (preset) == dbs.end ()) || (dbs[preset] == NULL))
+    {
+        safe_logger (spdlog::level::err, "stream is not started or no such preset");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // data thread keeps pushing, it waits only while samples are copied to the new ring
+    if (!dbs[preset]->resize ((size_t)buffer_size))
+    {
+        safe_logger (spdlog::level::err, "unable to resize buffer to {}", buffer_size);
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 int Board::get_board_data (int data_count, int preset, double *data_buf)
 {
     std::string preset_str = preset_to_string (preset);
@@ -479,6 +1453,11 @@ int Board::get_board_data (int data_count, int preset, double *data_buf)
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
     int num_rows = (int)board_descr[preset_str]["num_rows"];
+    int res = check_output_rows (preset, num_rows);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
     double *buf = new double[data_count * num_rows];
     int num_data_points = (int)dbs[preset]->get_data (data_count, buf);
     reshape_data (num_data_points, preset, buf, data_buf);
@@ -486,6 +1465,88 @@ int Board::get_board_data (int data_count, int preset, double *data_buf)
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+int Board::get_board_data_from_index (
+    int preset, uint64_t *next_index, int max_samples, double *data_buf, int *returned_samples)
+{
+    if ((next_index == NULL) || (max_samples < 0) || (data_buf == NULL) ||
+        (returned_samples == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::string preset_str = preset_to_string (preset);
+    if ((board_descr.find (preset_str) == board_descr.end ()) || (dbs.find (preset) == dbs.end ()))
+    {
+        safe_logger (spdlog::level::err,
+            "stream is not started or no preset: {} found for this board", preset);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (!dbs[preset])
+    {
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    *returned_samples = 0;
+    DataBuffer *db = dbs[preset];
+    // writer may overwrite samples between getting count and copying, retry from the new oldest
+    // sample in this case
+    for (int attempt = 0; attempt < 3; attempt++)
+    {
+        uint64_t total_count = db->get_total_count ();
+        uint64_t buffer_size = (uint64_t)db->get_buffer_size ();
+        // ringbuffer was recreated by start_stream
+        if (*next_index > total_count)
+        {
+            *next_index = 0;
+        }
+        uint64_t first_index = *next_index;
+        if (total_count - first_index > buffer_size)
+        {
+            first_index = total_count - buffer_size;
+        }
+        size_t count = (size_t)std::min (total_count - first_index, (uint64_t)max_samples);
+        if (count == 0)
+        {
+            *next_index = first_index;
+            return (int)BrainFlowExitCodes::STATUS_OK;
+        }
+        int num_rows = (int)board_descr[preset_str]["num_rows"];
+        std::vector<double> buf (count * num_rows);
+        if (db->get_samples (first_index, count, buf.data ()))
+        {
+            reshape_data ((int)count, preset, buf.data (), data_buf);
+            *next_index = first_index + count;
+            *returned_samples = (int)count;
+            return (int)BrainFlowExitCodes::STATUS_OK;
+        }
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::check_output_rows (int preset, int num_rows)
+{
+    // streaming and playback boards use id of master board, its description is used by bindings
+    int layout_rows = 0;
+    try
+    {
+        layout_rows = boards_struct.brainflow_boards_json["boards"]
+                          .at (std::to_string (board_id))
+                          .at (preset_to_string (preset))
+                          .at ("num_rows");
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, "no layout for preset {}: {}", preset, e.what ());
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    if (num_rows > layout_rows)
+    {
+        safe_logger (spdlog::level::err,
+            "session has {} rows for preset {}, more than {} rows of board description", num_rows,
+            preset, layout_rows);
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 void Board::reshape_data (int data_count, int preset, const double *buf, double *output_buf)
 {
     std::string preset_str = preset_to_string (preset);
@@ -12,14 +12,18 @@
 #include <mutex>
 #include <string.h>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "aavaa_v3.h"
 #include "ant_neuro.h"
 #include "biolistener.h"
 #include "board.h"
 #include "board_controller.h"
+#include "board_group.h"
 #include "board_info_getter.h"
+#include "board_session.h"
 #include "brainalive.h"
 #include "brainbit.h"
 #include "brainbit_bled.h"
@@ -63,21 +67,33 @@
 using json = nlohmann::json;
 
 
-std::map<std::pair<int, struct BrainFlowInputParams>, std::shared_ptr<Board>> boards;
+// global mutex guards only maps and is never held during device io, so slow bring up or teardown
+// of one board doesnt block other boards
+std::map<std::pair<int, struct BrainFlowInputParams>, std::shared_ptr<BoardSession>> boards;
+std::map<int, std::shared_ptr<BoardGroup>> groups;
+int next_group_id = 0;
 std::mutex mutex;
 
+// smallest response buffer allocated by bindings for config_board, including null terminator
+#define MAX_CONFIG_RESPONSE_LEN 4096
+
 std::pair<int, struct BrainFlowInputParams> get_key (
     int board_id, struct BrainFlowInputParams params);
 static int check_board_session (int board_id, const char *json_brainflow_input_params,
-    std::pair<int, struct BrainFlowInputParams> &key, bool log_error = true);
+    std::shared_ptr<BoardSession> &session, bool log_error = true);
+static int check_board_session (int board_id, const char *json_brainflow_input_params,
+    std::shared_ptr<BoardSession> &session, std::unique_lock<std::mutex> &session_lock,
+    bool log_error);
 static int string_to_brainflow_input_params (
     const char *json_brainflow_input_params, struct BrainFlowInputParams *params);
 
 
+static int check_board_group (int group_id, std::shared_ptr<BoardGroup> &group);
+static int create_board (
+    int board_id, struct BrainFlowInputParams params, std::shared_ptr<Board> &board);
+
 int prepare_session (int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
-
     Board::board_logger->info ("incoming json: {}", json_brainflow_input_params);
     struct BrainFlowInputParams params;
     int res = string_to_brainflow_input_params (json_brainflow_input_params, &params);
@@ -86,15 +102,51 @@ int prepare_session (int board_id, const char *json_brainflow_input_params)
         return res;
     }
 
+    // reserve key first, device bring up can take seconds and runs without global lock
     std::pair<int, struct BrainFlowInputParams> key = get_key (board_id, params);
-    if (boards.find (key) != boards.end ())
+    std::shared_ptr<BoardSession> session (new BoardSession ());
+    session->key = key;
+    session->is_ready = false;
+    session->is_released = false;
     {
-        Board::board_logger->error (
-            "Board with id {} and the same config already exists", board_id);
-        return (int)BrainFlowExitCodes::ANOTHER_BOARD_IS_CREATED_ERROR;
+        std::lock_guard<std::mutex> lock (mutex);
+        if (boards.find (key) != boards.end ())
+        {
+            Board::board_logger->error (
+                "Board with id {} and the same config already exists", board_id);
+            return (int)BrainFlowExitCodes::ANOTHER_BOARD_IS_CREATED_ERROR;
+        }
+        boards[key] = session;
     }
 
-    std::shared_ptr<Board> board = NULL;
+    {
+        std::lock_guard<std::mutex> session_lock (session->mutex);
+        res = create_board (board_id, params, session->board);
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            Board::board_logger->trace ("Board object created {}", session->board->get_board_id ());
+            res = session->board->prepare_session ();
+        }
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            session->board = NULL;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock (mutex);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        boards.erase (key);
+    }
+    else
+    {
+        session->is_ready = true;
+    }
+    return res;
+}
+
+int create_board (int board_id, struct BrainFlowInputParams params, std::shared_ptr<Board> &board)
+{
     switch (static_cast<BoardIds> (board_id))
     {
         case BoardIds::PLAYBACK_FILE_BOARD:
@@ -104,7 +156,8 @@ int prepare_session (int board_id, const char *json_brainflow_input_params)
             board = std::shared_ptr<Board> (new StreamingBoard (params));
             break;
         case BoardIds::SYNTHETIC_BOARD:
-            board = std::shared_ptr<Board> (new SyntheticBoard (params));
+        case BoardIds::SYNTHETIC_LOAD_BOARD:
+            board = std::shared_ptr<Board> (new SyntheticBoard (board_id, params));
             break;
         case BoardIds::CYTON_BOARD:
             board = std::shared_ptr<Board> (new Cyton (params));
@@ -316,25 +369,13 @@ int prepare_session (int board_id, const char *json_brainflow_input_params)
         default:
             return (int)BrainFlowExitCodes::UNSUPPORTED_BOARD_ERROR;
     }
-    Board::board_logger->trace ("Board object created {}", board->get_board_id ());
-    res = board->prepare_session ();
-    if (res != (int)BrainFlowExitCodes::STATUS_OK)
-    {
-        board = NULL;
-    }
-    else
-    {
-        boards[key] = board;
-    }
-    return res;
+    return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 int is_prepared (int *prepared, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    std::shared_ptr<BoardSession> session = NULL;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, false);
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
         *prepared = 1;
@@ -350,106 +391,404 @@ int is_prepared (int *prepared, int board_id, const char *json_brainflow_input_p
 int start_stream (int buffer_size, const char *streamer_params, int board_id,
     const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->start_stream (buffer_size, streamer_params);
+    return session->board->start_stream (buffer_size, streamer_params);
 }
 
 int stop_stream (int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->stop_stream ();
+    return session->board->stop_stream ();
 }
 
 int insert_marker (double value, int preset, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->insert_marker (value, preset);
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int get_package_loss_stats (
+    int preset, double *stats, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->insert_marker (value, preset);
+    return session->board->get_package_loss_stats (preset, stats);
 }
 
-int release_session (int board_id, const char *json_brainflow_input_params)
+int set_lost_packages_fill (
+    int enable, int max_gap, int preset, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->set_lost_packages_fill (enable != 0, max_gap, preset);
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int set_resampling (
+    int method, int preset, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    res = board_it->second->release_session ();
-    boards.erase (board_it);
-    return res;
+    return session->board->set_resampling (method, preset);
 }
 
-int get_current_board_data (int num_samples, int preset, double *data_buf, int *returned_samples,
+int add_epoch_definition (const double *marker_values, int num_marker_values, int pre_samples,
+    int post_samples, int max_epochs, int preset, int *definition_id, int board_id,
+    const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->add_epoch_definition (marker_values, num_marker_values, pre_samples,
+        post_samples, max_epochs, preset, definition_id);
+}
+
+int remove_epoch_definition (
+    int definition_id, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->remove_epoch_definition (definition_id);
+}
+
+int get_epoch_count (
+    int definition_id, int *result, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->get_epoch_count (definition_id, result);
+}
+
+int get_num_dropped_epochs (
+    int definition_id, double *result, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->get_num_dropped_epochs (definition_id, result);
+}
+
+int get_epochs (int definition_id, int max_epochs, double *data_buf, int *returned_epochs,
     int board_id, const char *json_brainflow_input_params)
 {
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->get_epochs (definition_id, max_epochs, data_buf, returned_epochs);
+}
+
+int release_session (int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    // session stays in map until released to prevent opening the same device twice
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        if (!session->is_ready)
+        {
+            return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+        }
+        session->is_ready = false;
+    }
+    {
+        std::lock_guard<std::mutex> session_lock (session->mutex);
+        session->is_released = true;
+        res = session->board->release_session ();
+    }
     std::lock_guard<std::mutex> lock (mutex);
+    boards.erase (session->key);
+    return res;
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int get_current_board_data (int num_samples, int preset, double *data_buf, int *returned_samples,
+    int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->get_current_board_data (
+    return session->board->get_current_board_data (
         num_samples, preset, data_buf, returned_samples);
 }
 
+int enable_signal_quality_monitor (
+    const char *json_config, int preset, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->enable_signal_quality_monitor (json_config, preset);
+}
+
+int disable_signal_quality_monitor (
+    int preset, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->disable_signal_quality_monitor (preset);
+}
+
+int get_signal_quality (int preset, double *output, int *num_channels, int board_id,
+    const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->get_signal_quality (preset, output, num_channels);
+}
+
+int enable_history (int ratio, int method, double seconds, int preset, int board_id,
+    const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->enable_history (ratio, method, seconds, preset);
+}
+
+int disable_history (int preset, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->disable_history (preset);
+}
+
+int get_history_count (
+    int preset, int *result, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->get_history_count (preset, result);
+}
+
+int get_history (int num_samples, int preset, double *data_buf, int *returned_samples,
+    int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->get_history (num_samples, preset, data_buf, returned_samples);
+}
+
+int get_board_data_by_time (double start_time, double end_time, int max_samples, int preset,
+    double *data_buf, int *returned_samples, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->get_board_data_by_time (
+        start_time, end_time, max_samples, preset, false, data_buf, returned_samples);
+}
+
+int pop_board_data_by_time (double start_time, double end_time, int max_samples, int preset,
+    double *data_buf, int *returned_samples, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->get_board_data_by_time (
+        start_time, end_time, max_samples, preset, true, data_buf, returned_samples);
+}
+
+int get_board_data_from_index (int preset, double *next_index, int max_samples, double *data_buf,
+    int *returned_samples, int board_id, const char *json_brainflow_input_params)
+{
+    if ((next_index == NULL) || (*next_index < 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    uint64_t index = (uint64_t)*next_index;
+    res = session->board->get_board_data_from_index (
+        preset, &index, max_samples, data_buf, returned_samples);
+    *next_index = (double)index;
+    return res;
+}
+
+int get_current_board_data_snapshot (const int *presets, const int *num_samples,
+    int num_presets, double *data_buf, int *returned_samples, int board_id,
+    const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->get_current_board_data_snapshot (
+        presets, num_samples, num_presets, data_buf, returned_samples);
+}
+
 int get_board_data_count (
     int preset, int *result, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->get_board_data_count (preset, result);
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int get_session_num_rows (
+    int preset, int *num_rows, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->get_board_data_count (preset, result);
+    return session->board->get_session_num_rows (preset, num_rows);
+}
+
+int set_buffer_duration (
+    double seconds, int preset, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->set_buffer_duration (seconds, preset);
+}
+
+int resize_buffer (
+    int buffer_size, int preset, int board_id, const char *json_brainflow_input_params)
+{
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return session->board->resize_buffer (buffer_size, preset);
 }
 
 int get_board_data (int data_count, int preset, double *data_buf, int board_id,
     const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->get_board_data (data_count, preset, data_buf);
+    return session->board->get_board_data (data_count, preset, data_buf);
 }
 
 int set_log_level_board_controller (int log_level)
@@ -494,26 +833,31 @@ int java_set_jnienv (JNIEnv *java_jnienv)
 int config_board (const char *config, char *response, int *response_len, int board_id,
     const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
     if ((config == NULL) || (response == NULL) || (response_len == NULL))
     {
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
     std::string conf = config;
     std::string resp = "";
-    res = board_it->second->config_board (conf, resp);
+    res = session->board->config_board (conf, resp);
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
+        if (resp.length () >= MAX_CONFIG_RESPONSE_LEN)
+        {
+            Board::board_logger->error ("config response length {} exceeds max length {}",
+                resp.length (), MAX_CONFIG_RESPONSE_LEN - 1);
+            return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+        }
         *response_len = (int)resp.length ();
-        strcpy (response, resp.c_str ());
+        memcpy (response, resp.c_str (), resp.length () + 1);
     }
     return res;
 }
@@ -521,71 +865,206 @@ int config_board (const char *config, char *response, int *response_len, int boa
 int config_board_with_bytes (
     const char *bytes, int len, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
     if ((bytes == NULL) || (len < 1))
     {
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->config_board_with_bytes (bytes, len);
+    return session->board->config_board_with_bytes (bytes, len);
 }
 
 int add_streamer (
     const char *streamer, int preset, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
     if (streamer == NULL)
     {
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->add_streamer (streamer, preset);
+    return session->board->add_streamer (streamer, preset);
 }
 
 int delete_streamer (
     const char *streamer, int preset, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
     if (streamer == NULL)
     {
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    std::shared_ptr<BoardSession> session = NULL;
+    std::unique_lock<std::mutex> lock;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, lock, false);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->delete_streamer (streamer, preset);
+    return session->board->delete_streamer (streamer, preset);
 }
 
 int release_all_sessions ()
 {
+    std::vector<std::shared_ptr<BoardSession>> sessions;
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        for (auto it = boards.begin (); it != boards.end (); ++it)
+        {
+            if (it->second->is_ready)
+            {
+                it->second->is_ready = false;
+                sessions.push_back (it->second);
+            }
+        }
+    }
+
+    // boards are independent, release them in parallel
+    std::vector<std::thread> release_threads;
+    for (size_t i = 0; i < sessions.size (); i++)
+    {
+        std::shared_ptr<BoardSession> session = sessions[i];
+        release_threads.push_back (std::thread ([session] {
+            std::lock_guard<std::mutex> session_lock (session->mutex);
+            session->is_released = true;
+            session->board->release_session ();
+        }));
+    }
+    for (size_t i = 0; i < release_threads.size (); i++)
+    {
+        release_threads[i].join ();
+    }
+
     std::lock_guard<std::mutex> lock (mutex);
+    for (size_t i = 0; i < sessions.size (); i++)
+    {
+        boards.erase (sessions[i]->key);
+    }
+    groups.clear ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
-    for (auto it = boards.begin (), next_it = it; it != boards.end (); it = next_it)
+int create_board_group (const char *json_group_params, int *group_id)
+{
+    if ((json_group_params == NULL) || (group_id == NULL))
     {
-        ++next_it;
-        it->second->release_session ();
-        boards.erase (it);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
+    std::vector<std::shared_ptr<BoardSession>> sessions;
+    int preset = 0;
+    double sampling_rate = 0.0;
+    try
+    {
+        json config = json::parse (std::string (json_group_params));
+        preset = config.value ("preset", 0);
+        sampling_rate = config.value ("sampling_rate", 0.0);
+        for (auto &member : config["boards"])
+        {
+            std::shared_ptr<BoardSession> session = NULL;
+            std::string params = member["input_params"].dump ();
+            int res = check_board_session (member["board_id"], params.c_str (), session, true);
+            if (res != (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                return res;
+            }
+            sessions.push_back (session);
+        }
+    }
+    catch (json::exception &e)
+    {
+        Board::board_logger->error ("invalid board group json, {}", e.what ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    std::shared_ptr<BoardGroup> group (new BoardGroup (sessions, preset, sampling_rate));
+    int res = group->prepare ();
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    std::lock_guard<std::mutex> lock (mutex);
+    *group_id = next_group_id++;
+    groups[*group_id] = group;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int start_board_group_stream (int buffer_size, const char *streamer_params, int group_id)
+{
+    std::shared_ptr<BoardGroup> group = NULL;
+    int res = check_board_group (group_id, group);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return group->start_stream (buffer_size, streamer_params);
+}
+
+int stop_board_group_stream (int group_id)
+{
+    std::shared_ptr<BoardGroup> group = NULL;
+    int res = check_board_group (group_id, group);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return group->stop_stream ();
+}
+
+int get_board_group_num_rows (int *num_rows, int group_id)
+{
+    std::shared_ptr<BoardGroup> group = NULL;
+    int res = check_board_group (group_id, group);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return group->get_num_rows (num_rows);
+}
+
+int get_board_group_data (int max_samples, double *data_buf, int *returned_samples, int group_id)
+{
+    std::shared_ptr<BoardGroup> group = NULL;
+    int res = check_board_group (group_id, group);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return group->get_data (max_samples, data_buf, returned_samples);
+}
+
+int get_board_group_start_delays (
+    double *start_delays, double *rates, int *num_boards, int group_id)
+{
+    std::shared_ptr<BoardGroup> group = NULL;
+    int res = check_board_group (group_id, group);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return group->get_start_delays (start_delays, rates, num_boards);
+}
 
+int release_board_group (int group_id)
+{
+    // sessions stay prepared, only the group is removed
+    std::lock_guard<std::mutex> lock (mutex);
+    if (groups.erase (group_id) == 0)
+    {
+        Board::board_logger->error ("Board group with id {} is not created", group_id);
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
@@ -608,7 +1087,7 @@ std::pair<int, struct BrainFlowInputParams> get_key (
 }
 
 int check_board_session (int board_id, const char *json_brainflow_input_params,
-    std::pair<int, struct BrainFlowInputParams> &key, bool log_error)
+    std::shared_ptr<BoardSession> &session, bool log_error)
 {
     struct BrainFlowInputParams params;
     int res = string_to_brainflow_input_params (json_brainflow_input_params, &params);
@@ -617,9 +1096,11 @@ int check_board_session (int board_id, const char *json_brainflow_input_params,
         return res;
     }
 
-    key = get_key (board_id, params);
+    std::pair<int, struct BrainFlowInputParams> key = get_key (board_id, params);
 
-    if (boards.find (key) == boards.end ())
+    std::lock_guard<std::mutex> lock (mutex);
+    auto session_it = boards.find (key);
+    if ((session_it == boards.end ()) || (!session_it->second->is_ready))
     {
         if (log_error)
         {
@@ -628,6 +1109,46 @@ int check_board_session (int board_id, const char *json_brainflow_input_params,
         }
         return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
     }
+    session = session_it->second;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// session may be released after lookup and before its mutex is taken, so release flag is checked
+// again under session mutex
+int check_board_session (int board_id, const char *json_brainflow_input_params,
+    std::shared_ptr<BoardSession> &session, std::unique_lock<std::mutex> &session_lock,
+    bool log_error)
+{
+    int res = check_board_session (board_id, json_brainflow_input_params, session, log_error);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    session_lock = std::unique_lock<std::mutex> (session->mutex);
+    if (session->is_released)
+    {
+        session_lock.unlock ();
+        session = NULL;
+        if (log_error)
+        {
+            Board::board_logger->error (
+                "Board with id {} and port provided config is not created", board_id);
+        }
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int check_board_group (int group_id, std::shared_ptr<BoardGroup> &group)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    auto group_it = groups.find (group_id);
+    if (group_it == groups.end ())
+    {
+        Board::board_logger->error ("Board group with id {} is not created", group_id);
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    group = group_it->second;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
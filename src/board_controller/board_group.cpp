@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <math.h>
+#include <thread>
+
+#include "board_group.h"
+
+
+BoardGroup::BoardGroup (
+    std::vector<std::shared_ptr<BoardSession>> sessions, int preset, double sampling_rate)
+{
+    this->sessions = sessions;
+    this->preset = preset;
+    this->sampling_rate = sampling_rate;
+    num_rows = 1;
+    grid_start = NAN;
+    num_grid_samples = 0;
+}
+
+int BoardGroup::prepare ()
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    if (sessions.empty ())
+    {
+        Board::board_logger->error ("board group must contain at least one board");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    double max_rate = 0.0;
+    num_rows = 1;
+    aligners.clear ();
+    next_indexes.assign (sessions.size (), 0);
+    for (size_t i = 0; i < sessions.size (); i++)
+    {
+        json descr;
+        int res = (int)BrainFlowExitCodes::STATUS_OK;
+        {
+            std::lock_guard<std::mutex> session_lock (sessions[i]->mutex);
+            res = sessions[i]->is_released ?
+                (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR :
+                sessions[i]->board->get_session_descr (preset, descr);
+        }
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+        try
+        {
+            int session_rows = descr["num_rows"];
+            int timestamp_channel = descr["timestamp_channel"];
+            int marker_channel = descr.value ("marker_channel", -1);
+            double rate = descr["sampling_rate"];
+            aligners.push_back (std::shared_ptr<StreamAligner> (
+                new StreamAligner (session_rows, timestamp_channel, marker_channel, rate)));
+            num_rows += session_rows - 1;
+            max_rate = std::max (max_rate, rate);
+        }
+        catch (json::exception &e)
+        {
+            Board::board_logger->error ("board {} has no timestamps for this preset: {}",
+                sessions[i]->key.first, e.what ());
+            return (int)BrainFlowExitCodes::UNSUPPORTED_BOARD_ERROR;
+        }
+    }
+    if (sampling_rate <= 0.0)
+    {
+        sampling_rate = max_rate;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BoardGroup::start_stream (int buffer_size, const char *streamer_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    drop_released_sessions ();
+    for (size_t i = 0; i < aligners.size (); i++)
+    {
+        aligners[i]->reset ();
+        next_indexes[i] = 0;
+    }
+    grid_start = NAN;
+    num_grid_samples = 0;
+
+    // threads are created first and released together to start devices as close as possible
+    std::vector<int> results (sessions.size (), (int)BrainFlowExitCodes::STATUS_OK);
+    std::vector<std::thread> threads;
+    std::mutex start_mutex;
+    std::unique_lock<std::mutex> start_lock (start_mutex);
+    for (size_t i = 0; i < sessions.size (); i++)
+    {
+        std::shared_ptr<BoardSession> session = sessions[i];
+        if (!session)
+        {
+            continue;
+        }
+        int *result = &results[i];
+        threads.push_back (std::thread ([session, result, buffer_size, streamer_params,
+                                            &start_mutex] {
+            {
+                std::lock_guard<std::mutex> wait_lock (start_mutex);
+            }
+            std::lock_guard<std::mutex> session_lock (session->mutex);
+            *result = session->is_released ?
+                (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR :
+                session->board->start_stream (buffer_size, streamer_params);
+        }));
+    }
+    start_lock.unlock ();
+    for (size_t i = 0; i < threads.size (); i++)
+    {
+        threads[i].join ();
+    }
+
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    for (size_t i = 0; i < results.size (); i++)
+    {
+        if (results[i] != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            Board::board_logger->error (
+                "failed to start board {} in group: {}", sessions[i]->key.first, results[i]);
+            res = results[i];
+        }
+    }
+    // group is started only if all boards started
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        for (size_t i = 0; i < sessions.size (); i++)
+        {
+            if ((sessions[i]) && (results[i] == (int)BrainFlowExitCodes::STATUS_OK))
+            {
+                std::lock_guard<std::mutex> session_lock (sessions[i]->mutex);
+                if (!sessions[i]->is_released)
+                {
+                    sessions[i]->board->stop_stream ();
+                }
+            }
+        }
+    }
+    return res;
+}
+
+int BoardGroup::stop_stream ()
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    drop_released_sessions ();
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    for (size_t i = 0; i < sessions.size (); i++)
+    {
+        if (!sessions[i])
+        {
+            continue;
+        }
+        std::lock_guard<std::mutex> session_lock (sessions[i]->mutex);
+        if (sessions[i]->is_released)
+        {
+            continue;
+        }
+        int session_res = sessions[i]->board->stop_stream ();
+        if (session_res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            res = session_res;
+        }
+    }
+    return res;
+}
+
+int BoardGroup::get_num_rows (int *num_rows)
+{
+    if (num_rows == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (mutex);
+    *num_rows = this->num_rows;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// session is dropped outside of its mutex, the last reference may destroy it
+void BoardGroup::drop_released_sessions ()
+{
+    for (size_t i = 0; i < sessions.size (); i++)
+    {
+        if (!sessions[i])
+        {
+            continue;
+        }
+        bool is_released = false;
+        {
+            std::lock_guard<std::mutex> session_lock (sessions[i]->mutex);
+            is_released = sessions[i]->is_released;
+        }
+        if (is_released)
+        {
+            Board::board_logger->warn (
+                "board {} is released, it is dropped from group", sessions[i]->key.first);
+            sessions[i] = NULL;
+            aligners[i]->reset ();
+        }
+    }
+}
+
+int BoardGroup::pull_data ()
+{
+    const int chunk_size = 4096;
+    for (size_t i = 0; i < sessions.size (); i++)
+    {
+        if (!sessions[i])
+        {
+            continue;
+        }
+        session_data.resize ((size_t)chunk_size * aligners[i]->get_num_rows ());
+        std::lock_guard<std::mutex> session_lock (sessions[i]->mutex);
+        // released after drop_released_sessions, dropped on the next call
+        if (sessions[i]->is_released)
+        {
+            continue;
+        }
+        int data_count = chunk_size;
+        while (data_count == chunk_size)
+        {
+            int res = sessions[i]->board->get_board_data_from_index (
+                preset, &next_indexes[i], chunk_size, session_data.data (), &data_count);
+            if (res != (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                return res;
+            }
+            aligners[i]->add_samples (session_data.data (), data_count);
+        }
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BoardGroup::get_data (int max_samples, double *data_buf, int *returned_samples)
+{
+    if ((max_samples < 0) || (data_buf == NULL) || (returned_samples == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (mutex);
+    *returned_samples = 0;
+    drop_released_sessions ();
+    int res = pull_data ();
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+
+    // grid starts when all sessions have data and ends at the last sample of the slowest one
+    double end_time = INFINITY;
+    double start_time = -INFINITY;
+    for (size_t i = 0; i < aligners.size (); i++)
+    {
+        if (!sessions[i])
+        {
+            continue;
+        }
+        if (isnan (aligners[i]->get_last_time ()))
+        {
+            return (int)BrainFlowExitCodes::STATUS_OK;
+        }
+        end_time = std::min (end_time, aligners[i]->get_last_time ());
+        start_time = std::max (start_time, aligners[i]->get_first_time ());
+    }
+    if (isinf (end_time))
+    {
+        Board::board_logger->error ("all boards of group are released");
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    if (isnan (grid_start))
+    {
+        grid_start = start_time;
+    }
+
+    merged_data.resize ((size_t)max_samples * num_rows);
+    int num_samples = 0;
+    while (num_samples < max_samples)
+    {
+        double time = grid_start + (double)num_grid_samples / sampling_rate;
+        if (time > end_time)
+        {
+            break;
+        }
+        double *column = merged_data.data () + (size_t)num_samples * num_rows;
+        column[0] = time;
+        int offset = 1;
+        bool is_valid = true;
+        for (size_t i = 0; (i < aligners.size ()) && (is_valid); i++)
+        {
+            if (sessions[i])
+            {
+                is_valid = aligners[i]->get_values (time, column + offset);
+            }
+            else
+            {
+                int num_values = aligners[i]->get_num_rows () - 1;
+                std::fill (column + offset, column + offset + num_values, NAN);
+            }
+            offset += aligners[i]->get_num_rows () - 1;
+        }
+        num_grid_samples++;
+        // grid point before the first sample of a session, possible only if it was restarted
+        if (is_valid)
+        {
+            num_samples++;
+        }
+    }
+    for (int i = 0; i < num_samples; i++)
+    {
+        for (int j = 0; j < num_rows; j++)
+        {
+            data_buf[(size_t)j * num_samples + i] = merged_data[(size_t)i * num_rows + j];
+        }
+    }
+    *returned_samples = num_samples;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BoardGroup::get_start_delays (double *start_delays, double *rates, int *num_boards)
+{
+    if ((start_delays == NULL) || (rates == NULL) || (num_boards == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (mutex);
+    drop_released_sessions ();
+    double earliest = INFINITY;
+    for (size_t i = 0; i < aligners.size (); i++)
+    {
+        double start_time = aligners[i]->get_start_time ();
+        if ((sessions[i]) && (!isnan (start_time)))
+        {
+            earliest = std::min (earliest, start_time);
+        }
+    }
+    for (size_t i = 0; i < aligners.size (); i++)
+    {
+        if (!sessions[i])
+        {
+            start_delays[i] = NAN;
+            rates[i] = NAN;
+            continue;
+        }
+        // NaN until session sends data
+        start_delays[i] = aligners[i]->get_start_time () - earliest;
+        rates[i] = aligners[i]->get_estimated_rate ();
+    }
+    *num_boards = (int)aligners.size ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
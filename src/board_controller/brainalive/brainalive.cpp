@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "brainalive.h"
 #include "custom_cast.h"
 #include "get_dll_dir.h"
@@ -22,23 +24,15 @@ static void brainalive_read_notifications (simpleble_peripheral_t peripheral,
     simpleble_uuid_t service, simpleble_uuid_t characteristic, const uint8_t *data, size_t size,
     void *board)
 {
-    if ((size == BrainAlive::brainalive_handshaking_packet_size) && (data[0] == START_BYTE) &&
-        (data[size - 1] == STOP_BYTE) && (data[2] == BrainAlive::brainalive_handshaking_command))
-    {
-        ((BrainAlive *)(board))->set_internal_gain (data[3]);
-        ((BrainAlive *)(board))->set_external_gain (data[4]);
-        ((BrainAlive *)(board))->set_ref_Voltage (((data[5] << 8) | data[6]));
-    }
-    else
-    {
-        ((BrainAlive *)(board))->read_data (service, characteristic, data, size, 0);
-    }
+    ((BrainAlive *)(board))->read_data (service, characteristic, data, size);
 }
 
 BrainAlive::BrainAlive (struct BrainFlowInputParams params)
     : BLELibBoard ((int)BoardIds::BRAINALIVE_BOARD, params)
 {
     initialized = false;
+    notification_queue_size = 256;
+    max_notification_size = brainalive_packet_size;
     brainalive_adapter = NULL;
     brainalive_peripheral = NULL;
     is_streaming = false;
@@ -192,6 +186,7 @@ int BrainAlive::prepare_session ()
 
     if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (control_characteristics_found))
     {
+        resolve_channels ();
         initialized = true;
         res = config_board ("0a036007000d");
         if (res == (int)BrainFlowExitCodes::STATUS_OK)
@@ -212,11 +207,22 @@ int BrainAlive::start_stream (int buffer_size, const char *streamer_params)
     {
         return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
     }
+    if (is_streaming)
+    {
+        return (int)BrainFlowExitCodes::STREAM_ALREADY_RUN_ERROR;
+    }
     int res = prepare_for_acquisition (buffer_size, streamer_params);
-
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = start_notification_thread ();
+    }
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
         res = config_board ("0a038100000d");
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            stop_notification_thread ();
+        }
     }
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
@@ -242,12 +248,14 @@ int BrainAlive::stop_stream ()
     {
         res = (int)BrainFlowExitCodes::STREAM_ALREADY_RUN_ERROR;
     }
+    stop_notification_thread ();
     is_streaming = false;
     return res;
 }
 
 int BrainAlive::release_session ()
 {
+    stop_notification_thread ();
     if (initialized)
     {
         // repeat it multiple times, failure here may lead to a crash
@@ -381,60 +389,75 @@ void BrainAlive::adapter_1_on_scan_found (
     }
 }
 
+void BrainAlive::resolve_channels ()
+{
+    const json &default_preset = board_descr["default"];
+    package.resize (default_preset["num_rows"].get<int> ());
+    std::fill (package.begin (), package.end (), 0.0);
+    eeg_channels = default_preset["eeg_channels"].get<std::vector<int>> ();
+    accel_channels = default_preset["accel_channels"].get<std::vector<int>> ();
+    gyro_channels = default_preset["gyro_channels"].get<std::vector<int>> ();
+    package_num_channel = default_preset["package_num_channel"].get<int> ();
+    marker_channel = default_preset["marker_channel"].get<int> ();
+    timestamp_channel = default_preset["timestamp_channel"].get<int> ();
+}
+
 void BrainAlive::read_data (simpleble_uuid_t service, simpleble_uuid_t characteristic,
-    const uint8_t *data, size_t size, int channel_num)
+    const uint8_t *data, size_t size)
 {
-    if (size == brainalive_packet_size)
+    // handshake with gains is received after prepare_session, before notification thread starts
+    if ((size == brainalive_handshaking_packet_size) && (data[0] == START_BYTE) &&
+        (data[size - 1] == STOP_BYTE) && (data[2] == brainalive_handshaking_command))
     {
-        for (int i = 0; i < (int)size; i += brainalive_single_packet_size)
-        {
-
-            int num_rows = board_descr["default"]["num_rows"];
-            double *package = new double[num_rows];
-            for (int i = 0; i < num_rows; i++)
-            {
-                package[i] = 0.0;
-            }
-            std::vector<int> eeg_channels = board_descr["default"]["eeg_channels"];
-            std::vector<int> accel_channels = board_descr["default"]["accel_channels"];
-            std::vector<int> gyro_channels = board_descr["default"]["gyro_channels"];
-
-            package[board_descr["default"]["package_num_channel"].get<int> ()] =
-                data[brainalive_packet_index + i];
-
-            for (int j = i + brainalive_eeg_Start_index, k = 0; j < i + brainalive_eeg_end_index;
-                 j += 3, k++)
-            {
-                package[eeg_channels[k]] =
-                    (float)(((data[j] << 16 | data[j + 1] << 8 | data[j + 2]) << 8) >> 8) *
-                    ((((float)get_ref_voltage () * 1000) /
-                        (float)(get_internal_gain () * get_external_gain () * FSR_Value)));
-            }
-
-            for (int j = i + brainalive_axl_start_index, k = 0; j < i + brainalive_axl_end_index;
-                 j += 2, k++)
-            {
-                package[accel_channels[k]] = (data[j] << 8) | data[j + 1];
-                if (package[accel_channels[k]] > 32767)
-                    package[accel_channels[k]] = package[accel_channels[k]] - 65535;
-            }
-            for (int j = i + brainalive_gyro_start_index, k = 0; j < i + brainalive_gyro_end_index;
-                 j += 2, k++)
-            {
-                package[gyro_channels[k]] = (data[j] << 8) | data[j + 1];
-                if (package[gyro_channels[k]] > 32767)
-                    package[gyro_channels[k]] = package[gyro_channels[k]] - 65535;
-            }
-            package[board_descr["default"]["marker_channel"].get<int> ()] =
-                data[(brainalive_packet_index + 1) + i];
-            package[board_descr["default"]["timestamp_channel"].get<int> ()] = get_timestamp ();
-
-            push_package (&package[0]);
-        }
+        set_internal_gain (data[3]);
+        set_external_gain (data[4]);
+        set_ref_Voltage (((data[5] << 8) | data[6]));
     }
     else
+    {
+        enqueue_notification (0, data, size);
+    }
+}
+
+void BrainAlive::handle_notification (int type, const uint8_t *data, size_t size, double timestamp)
+{
+    if (size != brainalive_packet_size)
     {
         safe_logger (spdlog::level::warn, "unknown size of BrainAlive Data {}", size);
         return;
     }
+    float eeg_scale = (((float)get_ref_voltage () * 1000) /
+        (float)(get_internal_gain () * get_external_gain () * FSR_Value));
+    for (int i = 0; i < (int)size; i += brainalive_single_packet_size)
+    {
+        std::fill (package.begin (), package.end (), 0.0);
+        package[package_num_channel] = data[brainalive_packet_index + i];
+
+        for (int j = i + brainalive_eeg_Start_index, k = 0; j < i + brainalive_eeg_end_index;
+             j += 3, k++)
+        {
+            package[eeg_channels[k]] =
+                (float)(((data[j] << 16 | data[j + 1] << 8 | data[j + 2]) << 8) >> 8) *
+                eeg_scale;
+        }
+
+        for (int j = i + brainalive_axl_start_index, k = 0; j < i + brainalive_axl_end_index;
+             j += 2, k++)
+        {
+            package[accel_channels[k]] = (data[j] << 8) | data[j + 1];
+            if (package[accel_channels[k]] > 32767)
+                package[accel_channels[k]] = package[accel_channels[k]] - 65535;
+        }
+        for (int j = i + brainalive_gyro_start_index, k = 0; j < i + brainalive_gyro_end_index;
+             j += 2, k++)
+        {
+            package[gyro_channels[k]] = (data[j] << 8) | data[j + 1];
+            if (package[gyro_channels[k]] > 32767)
+                package[gyro_channels[k]] = package[gyro_channels[k]] - 65535;
+        }
+        package[marker_channel] = data[(brainalive_packet_index + 1) + i];
+        package[timestamp_channel] = timestamp;
+
+        push_package (package.data ());
+    }
 }
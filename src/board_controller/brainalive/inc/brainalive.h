@@ -1,6 +1,8 @@
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "ble_lib_board.h"
 #include "board.h"
@@ -10,9 +12,10 @@ class BrainAlive : public BLELibBoard
 {
 
 private:
-    int internal_gain = 0;
-    int external_gain = 0;
-    int reference_voltage = 0;
+    // written by BLE callback, read by notification thread
+    std::atomic_int internal_gain {0};
+    std::atomic_int external_gain {0};
+    std::atomic_int reference_voltage {0};
 
 public:
     BrainAlive (struct BrainFlowInputParams params);
@@ -27,7 +30,7 @@ public:
 
     void adapter_1_on_scan_found (simpleble_adapter_t adapter, simpleble_peripheral_t peripheral);
     void read_data (simpleble_uuid_t service, simpleble_uuid_t characteristic, const uint8_t *data,
-        size_t size, int channel_num);
+        size_t size);
     void set_internal_gain (int gain)
     {
         internal_gain = gain;
@@ -94,4 +97,15 @@ protected:
     std::condition_variable cv;
     std::pair<simpleble_uuid_t, simpleble_uuid_t> notified_characteristics;
     std::pair<simpleble_uuid_t, simpleble_uuid_t> write_characteristics;
+    // channel indices are resolved once in prepare_session
+    std::vector<double> package;
+    std::vector<int> eeg_channels;
+    std::vector<int> accel_channels;
+    std::vector<int> gyro_channels;
+    int package_num_channel;
+    int marker_channel;
+    int timestamp_channel;
+
+    void resolve_channels ();
+    void handle_notification (int type, const uint8_t *data, size_t size, double timestamp);
 };
@@ -1,3 +1,5 @@
+#include <vector>
+
 #include "brainflow_boards.h"
 
 // clang-format off
@@ -84,6 +86,7 @@ BrainFlowBoards::BrainFlowBoards()
             {"63", json::object()},
             {"64", json::object()},
             {"65", json::object()},
+            {"66", json::object()},
         }
     }};
 
@@ -1228,6 +1231,24 @@ BrainFlowBoards::BrainFlowBoards()
         {"eeg_channels", {1, 2, 3, 4, 5, 6, 7, 8}},
         {"eeg_names", "P1,P2,P3,P4,P5,P6,P7,P8"}
     };
+    // load generator, rows for up to 1024 exg channels, session layout is set by load config,
+    // sampling rate is the default one of load config, rate set by config_board is not described
+    std::vector<int> synthetic_load_channels (1024);
+    for (int i = 0; i < 1024; i++)
+    {
+        synthetic_load_channels[i] = i + 1;
+    }
+    brainflow_boards_json["boards"]["66"]["default"] = {
+        {"name", "SyntheticLoad"},
+        {"sampling_rate", 250},
+        {"package_num_channel", 0},
+        {"timestamp_channel", 1025},
+        {"marker_channel", 1026},
+        {"num_rows", 1027},
+        {"eeg_channels", synthetic_load_channels},
+        {"emg_channels", synthetic_load_channels},
+        {"ecg_channels", synthetic_load_channels}
+    };
 }
 
 BrainFlowBoards boards_struct;
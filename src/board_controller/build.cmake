@@ -25,6 +25,12 @@ endif (CMAKE_SIZEOF_VOID_P EQUAL 8)
 SET (BOARD_CONTROLLER_SRC
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/timestamp.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/sequence_tracker.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/stream_aligner.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/uniform_resampler.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/epoch_extractor.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/signal_quality_monitor.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/decimated_history.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/os_serial.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/os_serial_ioctl.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/serial.cpp
@@ -53,6 +59,7 @@ SET (BOARD_CONTROLLER_SRC
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/board_controller.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/board_info_getter.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/board.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/board_group.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/brainflow_boards.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/streaming_board.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/synthetic_board.cpp
@@ -82,6 +89,7 @@ SET (BOARD_CONTROLLER_SRC
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/muse/muse.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/brainalive/brainalive.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/emotibit/emotibit.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/emotibit/emotibit_parser.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/ntl/ntl_wifi.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/aavaa/aavaa_v3.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/pieeg/pieeg_board.cpp
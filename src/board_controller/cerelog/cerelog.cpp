@@ -10,6 +10,7 @@ This combination is guaranteed to work with the provided firmware.
 #include "cerelog.h"
 #include "os_serial.h"
 #include "serial.h"
+#include <cmath>
 #include <ctime>
 #include <stdint.h>
 
@@ -213,6 +214,12 @@ void Cerelog_X8::read_thread () {
     auto eeg_channels = default_descr["eeg_channels"].get<std::vector<int>> ();
     int timestamp_channel = default_descr["timestamp_channel"];
     int marker_channel = default_descr["marker_channel"];
+    sampling_rate = default_descr["sampling_rate"];
+    // no package counter in protocol, it is derived from ms timestamp relative to the first
+    // package, timestamps can not tell packages apart if period is shorter than 2 ms
+    bool track_packages = (sampling_rate > 0) && (sampling_rate <= 500);
+    bool first_package = true;
+    uint32_t first_board_timestamp = 0;
     std::vector<double> package (num_rows, 0.0);
     std::vector<unsigned char> buffer;
     buffer.reserve (PACKET_TOTAL_SIZE * 100);
@@ -261,6 +268,18 @@ void Cerelog_X8::read_thread () {
                 }
 
             package[marker_channel] = 0.0;
+            if (first_package) {
+                first_board_timestamp = board_timestamp;
+                first_package = false;
+            }
+            if (track_packages) {
+                // rounding to the nearest period tolerates clock jitter below half of a period
+                uint32_t elapsed_ms = board_timestamp - first_board_timestamp;
+                uint64_t package_num =
+                    (uint64_t)std::llround ((double)elapsed_ms * sampling_rate / 1000.0);
+                push_placeholder_packages (
+                    track_package_num ((double)(package_num & 0x3FFFFFFF), 30));
+            }
             push_package (package.data ());
 
             if (this->state != (int)BrainFlowExitCodes::STATUS_OK) {
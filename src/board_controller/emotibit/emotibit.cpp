@@ -4,6 +4,7 @@
 #include <sstream>
 #include <stdint.h>
 #include <string.h>
+#include <string>
 
 #include "broadcast_server.h"
 #include "custom_cast.h"
@@ -12,6 +13,7 @@
 #include "timestamp.h"
 
 #include "emotibit_defines.h"
+#include "emotibit_parser.h"
 
 using json = nlohmann::json;
 
@@ -181,38 +183,20 @@ int Emotibit::release_session ()
 void Emotibit::read_thread ()
 {
     constexpr int max_size = 32768;
-    char message[max_size];
-
-    // emotibit sends multiple data points per transaction and for example accelerometer x and y
-    // data are in different transactions, we have to align them and use max_datapoints_in_package
-    // arrays instead single one
-    constexpr int max_datapoints_in_package =
-        1024; // experimental(random) value, in practice I saw max 9
-    double *default_packages[max_datapoints_in_package];
-    double *aux_packages[max_datapoints_in_package];
-    double *anc_packages[max_datapoints_in_package];
-    int num_default_rows = board_descr["default"]["num_rows"];
-    int num_aux_rows = board_descr["auxiliary"]["num_rows"];
-    int num_anc_rows = board_descr["ancillary"]["num_rows"];
-
-    for (int cur_package = 0; cur_package < max_datapoints_in_package; cur_package++)
-    {
-        default_packages[cur_package] = new double[num_default_rows];
-        for (int i = 0; i < num_default_rows; i++)
-        {
-            default_packages[cur_package][i] = 0.0;
-        }
-        aux_packages[cur_package] = new double[num_aux_rows];
-        for (int i = 0; i < num_aux_rows; i++)
-        {
-            aux_packages[cur_package][i] = 0.0;
-        }
-        anc_packages[cur_package] = new double[num_anc_rows];
-        for (int i = 0; i < num_anc_rows; i++)
-        {
-            anc_packages[cur_package][i] = 0.0;
-        }
-    }
+    char message[max_size + 1];
+    EmotibitParser parser (board_descr);
+    EmotibitParser::PushCallback push = [this] (double *package, int preset) {
+        push_package (package, preset);
+    };
+    EmotibitParser::TimestampCallback get_time = [] () { return get_timestamp (); };
+
+    // invalid packages are reported per message at trace level, warning is rate limited to keep
+    // noisy links from flooding the log
+    constexpr double warn_interval = 10.0;
+    int skipped_since_warn = 0;
+    double last_warn_time = 0.0;
+    // parser cuts message in place, so text for the trace log is copied before parsing
+    std::string original_message;
 
     while (keep_alive)
     {
@@ -222,211 +206,30 @@ void Emotibit::read_thread ()
             safe_logger (spdlog::level::trace, "no data received");
             continue;
         }
-        std::string message_received = std::string (message, bytes_recv);
-        std::vector<std::string> splitted_packages =
-            split_string (message_received, PACKET_DELIMITER_CSV);
-        for (std::string recv_package : splitted_packages)
+        message[bytes_recv] = '\0';
+        double timestamp = get_timestamp ();
+        bool log_message = Board::board_logger->should_log (spdlog::level::trace);
+        if (log_message)
         {
-            int package_num = 0;
-            int data_len = 0;
-            std::string type_tag = "";
-            if (get_header (recv_package, &package_num, &data_len, type_tag))
-            {
-                // default package
-                std::vector<std::string> payload = get_payload (recv_package, data_len);
-                int channel = -1;
-                if (type_tag == ACCELEROMETER_X)
-                {
-                    channel = board_descr["default"]["accel_channels"][0];
-                }
-                if (type_tag == ACCELEROMETER_Y)
-                {
-                    channel = board_descr["default"]["accel_channels"][1];
-                }
-                if (type_tag == ACCELEROMETER_Z)
-                {
-                    channel = board_descr["default"]["accel_channels"][2];
-                }
-                if (type_tag == GYROSCOPE_X)
-                {
-                    channel = board_descr["default"]["gyro_channels"][0];
-                }
-                if (type_tag == GYROSCOPE_Y)
-                {
-                    channel = board_descr["default"]["gyro_channels"][1];
-                }
-                if (type_tag == GYROSCOPE_Z)
-                {
-                    channel = board_descr["default"]["gyro_channels"][2];
-                }
-                if (type_tag == MAGNETOMETER_X)
-                {
-                    channel = board_descr["default"]["magnetometer_channels"][0];
-                }
-                if (type_tag == MAGNETOMETER_Y)
-                {
-                    channel = board_descr["default"]["magnetometer_channels"][1];
-                }
-                if (type_tag == MAGNETOMETER_Z)
-                {
-                    channel = board_descr["default"]["magnetometer_channels"][2];
-                }
-                if (channel > 0)
-                {
-                    for (int i = 0; i < std::min ((int)payload.size (), max_datapoints_in_package);
-                         i++)
-                    {
-                        default_packages[i]
-                                        [board_descr["default"]["timestamp_channel"].get<int> ()] =
-                                            get_timestamp ();
-                        default_packages[i][board_descr["default"]["package_num_channel"]
-                                                .get<int> ()] = package_num;
-                        try
-                        {
-                            default_packages[i][channel] = std::stod (payload[i]);
-                        }
-                        catch (...)
-                        {
-                            safe_logger (spdlog::level::warn, "invalid data in payload: {}",
-                                payload[i].c_str ());
-                        }
-                    }
-                    channel = -1;
-                }
-                // push default preset when magnetometer z is received
-                if (type_tag == MAGNETOMETER_Z)
-                {
-                    for (int i = 0; i < data_len; i++)
-                    {
-                        push_package (default_packages[i], (int)BrainFlowPresets::DEFAULT_PRESET);
-                    }
-                }
-                // auxuliary package
-                if (type_tag == PPG_INFRARED)
-                {
-                    channel = board_descr["auxiliary"]["ppg_channels"][0];
-                }
-                if (type_tag == PPG_RED)
-                {
-                    channel = board_descr["auxiliary"]["ppg_channels"][1];
-                }
-                if (type_tag == PPG_GREEN)
-                {
-                    channel = board_descr["auxiliary"]["ppg_channels"][2];
-                }
-                if (channel > 0)
-                {
-                    for (int i = 0; i < std::min ((int)payload.size (), max_datapoints_in_package);
-                         i++)
-                    {
-                        aux_packages[i][board_descr["auxiliary"]["timestamp_channel"].get<int> ()] =
-                            get_timestamp ();
-                        aux_packages[i]
-                                    [board_descr["auxiliary"]["package_num_channel"].get<int> ()] =
-                                        package_num;
-                        try
-                        {
-                            aux_packages[i][channel] = std::stod (payload[i]);
-                        }
-                        catch (...)
-                        {
-                            safe_logger (spdlog::level::warn, "invalid data in payload: {}",
-                                payload[i].c_str ());
-                        }
-                    }
-                    channel = -1;
-                }
-                // push aux preset when ppg green is received
-                if (type_tag == PPG_GREEN)
-                {
-                    for (int i = 0; i < data_len; i++)
-                    {
-                        push_package (aux_packages[i], (int)BrainFlowPresets::AUXILIARY_PRESET);
-                    }
-                }
-                // ancillary package
-                if ((type_tag == TEMPERATURE_1) || (type_tag == THERMOPILE))
-                {
-                    int temperature_channel = 0;
-                    if (type_tag == TEMPERATURE_1)
-                    {
-                        temperature_channel = board_descr["ancillary"]["temperature_channels"][0];
-                    }
-                    if (type_tag == THERMOPILE)
-                    {
-                        temperature_channel = board_descr["ancillary"]["other_channels"][0];
-                    }
-                    // upsample temperature data 2x to match eda
-                    if (payload.size () < max_datapoints_in_package / 2)
-                    {
-                        for (int i = 0; i < (int)payload.size (); i++)
-                        {
-                            try
-                            {
-                                anc_packages[i * 2][temperature_channel] = std::stod (payload[i]);
-                                anc_packages[i + 1][temperature_channel] =
-                                    anc_packages[i][temperature_channel];
-                            }
-                            catch (...)
-                            {
-                                safe_logger (spdlog::level::warn, "invalid data in payload: {}",
-                                    payload[i].c_str ());
-                            }
-                        }
-                    }
-                    // should not happen, no place in buffer for upsampling, keep as is
-                    else
-                    {
-                        for (int i = 0;
-                             i < std::min ((int)payload.size (), max_datapoints_in_package); i++)
-                        {
-                            try
-                            {
-                                anc_packages[i][temperature_channel] = std::stod (payload[i]);
-                            }
-                            catch (...)
-                            {
-                                safe_logger (spdlog::level::warn, "invalid data in payload: {}",
-                                    payload[i].c_str ());
-                            }
-                        }
-                    }
-                }
-                if (type_tag == EDA)
-                {
-                    int eda_channel = board_descr["ancillary"]["eda_channels"][0];
-                    for (int i = 0; i < (int)payload.size (); i++)
-                    {
-                        anc_packages[i][board_descr["ancillary"]["timestamp_channel"].get<int> ()] =
-                            get_timestamp ();
-                        anc_packages[i]
-                                    [board_descr["ancillary"]["package_num_channel"].get<int> ()] =
-                                        package_num;
-                        try
-                        {
-                            anc_packages[i][eda_channel] = std::stod (payload[i]);
-                        }
-                        catch (...)
-                        {
-                            safe_logger (spdlog::level::warn, "invalid data in payload: {}",
-                                payload[i].c_str ());
-                        }
-                        push_package (anc_packages[i], (int)BrainFlowPresets::ANCILLARY_PRESET);
-                    }
-                }
-            }
-            else
+            original_message.assign (message, bytes_recv);
+        }
+        int num_errors = parser.parse (message, get_time, push);
+        if (num_errors > 0)
+        {
+            if (log_message)
             {
-                safe_logger (
-                    spdlog::level::trace, "invalid header for package: {}", recv_package.c_str ());
+                safe_logger (spdlog::level::trace, "skipped {} invalid packages or values in: {}",
+                    num_errors, original_message.c_str ());
             }
+            skipped_since_warn += num_errors;
+        }
+        if ((skipped_since_warn > 0) && (timestamp - last_warn_time >= warn_interval))
+        {
+            safe_logger (spdlog::level::warn, "skipped {} invalid packages or values",
+                skipped_since_warn);
+            skipped_since_warn = 0;
+            last_warn_time = timestamp;
         }
-    }
-    for (int cur_package = 0; cur_package < max_datapoints_in_package; cur_package++)
-    {
-        delete[] default_packages[cur_package];
-        delete[] aux_packages[cur_package];
-        delete[] anc_packages[cur_package];
     }
 }
 
@@ -562,18 +365,6 @@ bool Emotibit::get_header (const std::string &package_string, int *package_num,
     }
 }
 
-std::vector<std::string> Emotibit::get_payload (const std::string &package_string, int data_len)
-{
-    std::vector<std::string> res;
-    std::vector<std::string> package = split_string (package_string, PAYLOAD_DELIMITER);
-    if (package.size () >= (size_t)HEADER_LENGTH + (size_t)data_len)
-    {
-        res.insert (res.begin (), package.begin () + HEADER_LENGTH,
-            package.begin () + (size_t)HEADER_LENGTH + (size_t)data_len);
-    }
-    return res;
-}
-
 int Emotibit::create_adv_connection ()
 {
     int res = (int)BrainFlowExitCodes::STATUS_OK;
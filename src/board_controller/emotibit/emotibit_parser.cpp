@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <climits>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "brainflow_constants.h"
+#include "emotibit_defines.h"
+#include "emotibit_parser.h"
+
+
+enum class EmotibitDataTag : int
+{
+    UNKNOWN = 0,
+    ACCEL_X,
+    ACCEL_Y,
+    ACCEL_Z,
+    GYRO_X,
+    GYRO_Y,
+    GYRO_Z,
+    MAGNET_X,
+    MAGNET_Y,
+    MAGNET_Z,
+    PPG_IR,
+    PPG_R,
+    PPG_G,
+    TEMP_1,
+    THERMO,
+    EDA_DATA
+};
+
+#define EMOTIBIT_TAG_KEY(tag) (((int)(tag)[0] << 8) | (int)(tag)[1])
+
+// all type tags are 2 chars long, so they can be switched on directly
+static EmotibitDataTag get_data_tag (const char *tag, size_t len)
+{
+    if (len != 2)
+    {
+        return EmotibitDataTag::UNKNOWN;
+    }
+    switch (EMOTIBIT_TAG_KEY (tag))
+    {
+        case EMOTIBIT_TAG_KEY (ACCELEROMETER_X):
+            return EmotibitDataTag::ACCEL_X;
+        case EMOTIBIT_TAG_KEY (ACCELEROMETER_Y):
+            return EmotibitDataTag::ACCEL_Y;
+        case EMOTIBIT_TAG_KEY (ACCELEROMETER_Z):
+            return EmotibitDataTag::ACCEL_Z;
+        case EMOTIBIT_TAG_KEY (GYROSCOPE_X):
+            return EmotibitDataTag::GYRO_X;
+        case EMOTIBIT_TAG_KEY (GYROSCOPE_Y):
+            return EmotibitDataTag::GYRO_Y;
+        case EMOTIBIT_TAG_KEY (GYROSCOPE_Z):
+            return EmotibitDataTag::GYRO_Z;
+        case EMOTIBIT_TAG_KEY (MAGNETOMETER_X):
+            return EmotibitDataTag::MAGNET_X;
+        case EMOTIBIT_TAG_KEY (MAGNETOMETER_Y):
+            return EmotibitDataTag::MAGNET_Y;
+        case EMOTIBIT_TAG_KEY (MAGNETOMETER_Z):
+            return EmotibitDataTag::MAGNET_Z;
+        case EMOTIBIT_TAG_KEY (PPG_INFRARED):
+            return EmotibitDataTag::PPG_IR;
+        case EMOTIBIT_TAG_KEY (PPG_RED):
+            return EmotibitDataTag::PPG_R;
+        case EMOTIBIT_TAG_KEY (PPG_GREEN):
+            return EmotibitDataTag::PPG_G;
+        case EMOTIBIT_TAG_KEY (TEMPERATURE_1):
+            return EmotibitDataTag::TEMP_1;
+        case EMOTIBIT_TAG_KEY (THERMOPILE):
+            return EmotibitDataTag::THERMO;
+        case EMOTIBIT_TAG_KEY (EDA):
+            return EmotibitDataTag::EDA_DATA;
+        default:
+            return EmotibitDataTag::UNKNOWN;
+    }
+}
+
+#undef EMOTIBIT_TAG_KEY
+
+// stores offsets of non empty tokens, returns total number of tokens even if it doesnt fit
+static int tokenize_package (const char *package, const char **tokens, int max_tokens)
+{
+    int num_tokens = 0;
+    const char *cur = package;
+    while (*cur != '\0')
+    {
+        if (*cur == PAYLOAD_DELIMITER)
+        {
+            cur++;
+            continue;
+        }
+        if (num_tokens < max_tokens)
+        {
+            tokens[num_tokens] = cur;
+        }
+        num_tokens++;
+        while ((*cur != '\0') && (*cur != PAYLOAD_DELIMITER))
+        {
+            cur++;
+        }
+    }
+    return num_tokens;
+}
+
+static size_t get_token_len (const char *token)
+{
+    const char *end = token;
+    while ((*end != '\0') && (*end != PAYLOAD_DELIMITER))
+    {
+        end++;
+    }
+    return (size_t)(end - token);
+}
+
+// same rules as std::stoi and std::stod but without exceptions and temp strings, tokens are
+// terminated by delimiter which can not be a part of a number
+static bool parse_int (const char *token, int *value)
+{
+    char *end = NULL;
+    errno = 0;
+    long res = strtol (token, &end, 10);
+    if ((end == token) || (errno == ERANGE) || (res < INT_MIN) || (res > INT_MAX))
+    {
+        return false;
+    }
+    *value = (int)res;
+    return true;
+}
+
+static bool parse_double (const char *token, double *value)
+{
+    char *end = NULL;
+    errno = 0;
+    double res = strtod (token, &end);
+    if ((end == token) || (errno == ERANGE))
+    {
+        return false;
+    }
+    *value = res;
+    return true;
+}
+
+EmotibitParser::EmotibitParser (const nlohmann::json &board_descr)
+{
+    // resolve channels once, json lookups are too slow for per datapoint usage
+    const nlohmann::json &default_descr = board_descr["default"];
+    const nlohmann::json &aux_descr = board_descr["auxiliary"];
+    const nlohmann::json &anc_descr = board_descr["ancillary"];
+    num_default_rows = default_descr["num_rows"];
+    num_aux_rows = aux_descr["num_rows"];
+    num_anc_rows = anc_descr["num_rows"];
+    default_timestamp_channel = default_descr["timestamp_channel"];
+    default_package_num_channel = default_descr["package_num_channel"];
+    aux_timestamp_channel = aux_descr["timestamp_channel"];
+    aux_package_num_channel = aux_descr["package_num_channel"];
+    anc_timestamp_channel = anc_descr["timestamp_channel"];
+    anc_package_num_channel = anc_descr["package_num_channel"];
+    eda_channel = anc_descr["eda_channels"][0];
+    temperature_channel = anc_descr["temperature_channels"][0];
+    thermopile_channel = anc_descr["other_channels"][0];
+    const char *default_types[3] = {"accel_channels", "gyro_channels", "magnetometer_channels"};
+    for (int i = 0; i < 9; i++)
+    {
+        default_channels[i] = default_descr[default_types[i / 3]][i % 3];
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        aux_channels[i] = aux_descr["ppg_channels"][i];
+    }
+
+    default_packages.assign ((size_t)max_datapoints_in_package * num_default_rows, 0.0);
+    aux_packages.assign ((size_t)max_datapoints_in_package * num_aux_rows, 0.0);
+    anc_packages.assign ((size_t)max_datapoints_in_package * num_anc_rows, 0.0);
+    tokens.assign ((size_t)HEADER_LENGTH + max_datapoints_in_package, NULL);
+}
+
+int EmotibitParser::parse (
+    char *message, const TimestampCallback &get_time, const PushCallback &push)
+{
+    int num_errors = 0;
+    char *next_package = message;
+    while (next_package != NULL)
+    {
+        // cut packages in place, empty packages are skipped
+        char *package = next_package;
+        next_package = strchr (package, PACKET_DELIMITER_CSV);
+        if (next_package != NULL)
+        {
+            *next_package = '\0';
+            next_package++;
+        }
+        if (*package != '\0')
+        {
+            num_errors += parse_package (package, get_time, push);
+        }
+    }
+    return num_errors;
+}
+
+int EmotibitParser::parse_package (
+    char *package, const TimestampCallback &get_time, const PushCallback &push)
+{
+    int package_num = 0;
+    int data_len = 0;
+    int num_tokens = tokenize_package (package, tokens.data (), (int)tokens.size ());
+    // truncated packages and packages with invalid header are skipped as a whole
+    if ((num_tokens < HEADER_LENGTH) || (!parse_int (tokens[1], &package_num)) ||
+        (!parse_int (tokens[2], &data_len)) || (data_len < 0) ||
+        (num_tokens < HEADER_LENGTH + data_len))
+    {
+        return 1;
+    }
+
+    int num_errors = 0;
+    const char **payload = tokens.data () + HEADER_LENGTH;
+    int payload_size = std::min (data_len, (int)max_datapoints_in_package);
+    EmotibitDataTag tag = get_data_tag (tokens[3], get_token_len (tokens[3]));
+    switch (tag)
+    {
+        // default package
+        case EmotibitDataTag::ACCEL_X:
+        case EmotibitDataTag::ACCEL_Y:
+        case EmotibitDataTag::ACCEL_Z:
+        case EmotibitDataTag::GYRO_X:
+        case EmotibitDataTag::GYRO_Y:
+        case EmotibitDataTag::GYRO_Z:
+        case EmotibitDataTag::MAGNET_X:
+        case EmotibitDataTag::MAGNET_Y:
+        case EmotibitDataTag::MAGNET_Z:
+        {
+            int channel = default_channels[(int)tag - (int)EmotibitDataTag::ACCEL_X];
+            for (int i = 0; i < payload_size; i++)
+            {
+                double *cur_package = default_packages.data () + (size_t)i * num_default_rows;
+                cur_package[default_timestamp_channel] = get_time ();
+                cur_package[default_package_num_channel] = package_num;
+                if (!parse_double (payload[i], &cur_package[channel]))
+                {
+                    num_errors++;
+                }
+            }
+            // push default preset when magnetometer z is received
+            if (tag == EmotibitDataTag::MAGNET_Z)
+            {
+                for (int i = 0; i < payload_size; i++)
+                {
+                    push (default_packages.data () + (size_t)i * num_default_rows,
+                        (int)BrainFlowPresets::DEFAULT_PRESET);
+                }
+            }
+            break;
+        }
+        // auxuliary package
+        case EmotibitDataTag::PPG_IR:
+        case EmotibitDataTag::PPG_R:
+        case EmotibitDataTag::PPG_G:
+        {
+            int channel = aux_channels[(int)tag - (int)EmotibitDataTag::PPG_IR];
+            for (int i = 0; i < payload_size; i++)
+            {
+                double *cur_package = aux_packages.data () + (size_t)i * num_aux_rows;
+                cur_package[aux_timestamp_channel] = get_time ();
+                cur_package[aux_package_num_channel] = package_num;
+                if (!parse_double (payload[i], &cur_package[channel]))
+                {
+                    num_errors++;
+                }
+            }
+            // push aux preset when ppg green is received
+            if (tag == EmotibitDataTag::PPG_G)
+            {
+                for (int i = 0; i < payload_size; i++)
+                {
+                    push (aux_packages.data () + (size_t)i * num_aux_rows,
+                        (int)BrainFlowPresets::AUXILIARY_PRESET);
+                }
+            }
+            break;
+        }
+        // ancillary package
+        case EmotibitDataTag::TEMP_1:
+        case EmotibitDataTag::THERMO:
+        {
+            int channel =
+                (tag == EmotibitDataTag::TEMP_1) ? temperature_channel : thermopile_channel;
+            // upsample temperature data 2x to match eda, if there is no place in buffer for
+            // upsampling (should not happen) keep as is
+            if (payload_size < max_datapoints_in_package / 2)
+            {
+                for (int i = 0; i < payload_size; i++)
+                {
+                    double *cur_package = anc_packages.data () + (size_t)i * 2 * num_anc_rows;
+                    if (!parse_double (payload[i], &cur_package[channel]))
+                    {
+                        num_errors++;
+                        continue;
+                    }
+                    cur_package[num_anc_rows + channel] = cur_package[channel];
+                }
+            }
+            else
+            {
+                for (int i = 0; i < payload_size; i++)
+                {
+                    double *cur_package = anc_packages.data () + (size_t)i * num_anc_rows;
+                    if (!parse_double (payload[i], &cur_package[channel]))
+                    {
+                        num_errors++;
+                    }
+                }
+            }
+            break;
+        }
+        case EmotibitDataTag::EDA_DATA:
+        {
+            for (int i = 0; i < payload_size; i++)
+            {
+                double *cur_package = anc_packages.data () + (size_t)i * num_anc_rows;
+                cur_package[anc_timestamp_channel] = get_time ();
+                cur_package[anc_package_num_channel] = package_num;
+                if (!parse_double (payload[i], &cur_package[eda_channel]))
+                {
+                    num_errors++;
+                }
+                push (cur_package, (int)BrainFlowPresets::ANCILLARY_PRESET);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return num_errors;
+}
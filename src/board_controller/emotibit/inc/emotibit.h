@@ -48,7 +48,6 @@ private:
         const std::string &package_string, int *package_num, int *data_len, std::string &type_tag);
     bool get_header (const std::string &package_string, int *package_num, int *data_len,
         std::string &type_tag, std::string &serial_number);
-    std::vector<std::string> get_payload (const std::string &package_string, int data_len);
 
     int create_adv_connection ();
     int create_data_connection ();
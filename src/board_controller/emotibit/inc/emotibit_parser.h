@@ -0,0 +1,56 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "json.hpp"
+
+
+// decodes EmotiBit csv packages in place without allocations per datapoint
+// emotibit sends multiple data points per transaction and for example accelerometer x and y data
+// are in different transactions, so values are collected in max_datapoints_in_package packages
+// per preset and pushed when the last type tag of the preset is received
+class EmotibitParser
+{
+public:
+    // experimental(random) value, in practice I saw max 9
+    static const int max_datapoints_in_package = 1024;
+
+    // called for each complete package, preset is a value of BrainFlowPresets
+    typedef std::function<void (double *package, int preset)> PushCallback;
+    // called for each datapoint which sets timestamp channel, like get_timestamp in read thread
+    typedef std::function<double ()> TimestampCallback;
+
+    // board_descr is description of all presets of the board, throws json::exception if some
+    // channels are missing
+    explicit EmotibitParser (const nlohmann::json &board_descr);
+
+    // message should be null terminated and is modified in place, returns number of skipped
+    // packages and values
+    int parse (char *message, const TimestampCallback &get_time, const PushCallback &push);
+
+private:
+    int num_default_rows;
+    int num_aux_rows;
+    int num_anc_rows;
+    int default_timestamp_channel;
+    int default_package_num_channel;
+    int aux_timestamp_channel;
+    int aux_package_num_channel;
+    int anc_timestamp_channel;
+    int anc_package_num_channel;
+    int eda_channel;
+    int temperature_channel;
+    int thermopile_channel;
+    int default_channels[9];
+    int aux_channels[3];
+
+    // max_datapoints_in_package packages of each preset one after another
+    std::vector<double> default_packages;
+    std::vector<double> aux_packages;
+    std::vector<double> anc_packages;
+    // offsets of header and payload values of the current package, allocated once
+    std::vector<const char *> tokens;
+
+    int parse_package (char *package, const TimestampCallback &get_time, const PushCallback &push);
+};
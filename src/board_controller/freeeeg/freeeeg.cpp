@@ -174,6 +174,7 @@ void FreeEEG::read_thread ()
                 package[eeg_channels[i]] = (double)eeg_scale * cast_24bit_to_int32 (b + 1 + 3 * i);
             }
             package[board_descr["default"]["timestamp_channel"].get<int> ()] = get_timestamp ();
+            push_placeholder_packages (track_package_num (b[0], 8));
             push_package (package);
         }
         else
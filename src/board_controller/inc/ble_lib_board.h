@@ -1,11 +1,31 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "board.h"
 #include "board_controller.h"
 #include "runtime_dll_loader.h"
 #include "simpleble_c/types.h"
+#include "spinlock.h"
+#include "spsc_queue.h"
+
+#define MAX_BLE_NOTIFICATION_SIZE 512 // max length of attribute value in BLE spec
+#define BLE_NOTIFICATION_QUEUE_SIZE 256
+
+
+// raw notification copied from BLE callback, type is board specific id of characteristic, data
+// points to a preallocated block of max_notification_size bytes owned by the board
+struct BLENotification
+{
+    double timestamp;
+    int type;
+    size_t size;
+    uint8_t *data;
+};
 
 
 class BLELibBoard : public Board
@@ -17,8 +37,46 @@ private:
     static std::mutex mutex;
 #endif
 
+    SPSCQueue<BLENotification> *notification_queue;
+    std::vector<uint8_t> notification_data;
+    // the queue itself is lock free, but callbacks for different characteristics may come from
+    // different threads of BLE stack, so producers are serialized by this lock, it is held only
+    // for a copy of one notification and never taken by the consumer
+    SpinLock notification_producer_lock;
+    // consumer sleeps on it until a notification is published or thread is stopped, producers
+    // take mutex and notify only if consumer_waiting is set, so busy consumer costs them nothing
+    std::mutex notification_mutex;
+    std::condition_variable notification_cv;
+    std::atomic_bool consumer_waiting;
+    std::thread notification_thread;
+    std::atomic_bool keep_notification_thread;
+    std::atomic_bool accept_notifications;
+    // callbacks which passed accept_notifications check, start and stop wait until they leave
+    // before the queue is drained or reallocated
+    std::atomic_int active_producers;
+    std::atomic_size_t dropped_notifications;
+
+    void notification_thread_worker ();
+    void process_notifications ();
+    bool push_notification (int type, const uint8_t *data, size_t size);
+    void wait_for_producers ();
+
 protected:
     static bool init_dll_loader ();
+    // queue capacity and max size of a single notification, boards set them in constructor
+    // according to their notification sizes and rates, longer notifications are dropped
+    size_t notification_queue_size;
+    size_t max_notification_size;
+
+    // notifications are decoded in a separate thread to keep BLE callbacks short, boards which
+    // use it call enqueue_notification from callbacks and override handle_notification
+    int start_notification_thread ();
+    // boards should call it from release_session, thread calls virtual handle_notification so it
+    // must be stopped before destructor of derived class returns
+    void stop_notification_thread ();
+    virtual void handle_notification (int type, const uint8_t *data, size_t size, double timestamp)
+    {
+    }
     // common
     void simpleble_free (void *handle);
     // adapter
@@ -72,4 +130,12 @@ protected:
 public:
     BLELibBoard (int board_id, struct BrainFlowInputParams params);
     virtual ~BLELibBoard ();
+
+    // copies notification to the queue, safe to call from BLE callbacks, also allows to inject
+    // synthetic notifications without BLE adapter
+    bool enqueue_notification (int type, const uint8_t *data, size_t size);
+    size_t get_dropped_notifications ()
+    {
+        return dropped_notifications;
+    }
 };
@@ -4,6 +4,7 @@
 #include <deque>
 #include <limits>
 #include <map>
+#include <memory>
 #include <string>
 
 #include "board_controller.h"
@@ -11,8 +12,13 @@
 #include "brainflow_constants.h"
 #include "brainflow_input_params.h"
 #include "data_buffer.h"
+#include "decimated_history.h"
+#include "epoch_extractor.h"
+#include "sequence_tracker.h"
+#include "signal_quality_monitor.h"
 #include "spinlock.h"
 #include "streamer.h"
+#include "uniform_resampler.h"
 
 #include "spdlog/spdlog.h"
 
@@ -47,6 +53,12 @@ public:
         {
             safe_logger (spdlog::level::err, e.what ());
         }
+        // map is not modified after construction, trackers can be used without lock
+        for (auto &el : board_descr.items ())
+        {
+            sequence_trackers[preset_to_int (el.key ())];
+        }
+        next_epoch_definition_id = 0;
     }
     virtual int prepare_session () = 0;
     virtual int start_stream (int buffer_size, const char *streamer_params) = 0;
@@ -64,10 +76,60 @@ public:
     int get_current_board_data (
         int num_samples, int preset, double *data_buf, int *returned_samples);
     int get_board_data_count (int preset, int *result);
+    // the latest num_samples[i] samples of presets[i] taken at the same instant, matrix of each
+    // preset is written to data_buf at offset sum of num_rows * num_samples of previous presets
+    int get_current_board_data_snapshot (const int *presets, const int *num_samples,
+        int num_presets, double *data_buf, int *returned_samples);
+    // rows of this session, may differ from static board description if layout is configurable
+    int get_session_num_rows (int preset, int *result);
+    // copy of preset description of this session
+    int get_session_descr (int preset, json &result);
     int get_board_data (int data_count, int preset, double *data_buf);
+    // reads samples by absolute index without removing them from ringbuffer, reading starts at
+    // next_index or at the oldest stored sample if it was overwritten, next_index is moved past
+    // returned samples, data_buf is row major session num_rows x returned_samples
+    int get_board_data_from_index (int preset, uint64_t *next_index, int max_samples,
+        double *data_buf, int *returned_samples);
+    // ringbuffer of the preset keeps this many seconds of data instead of buffer_size samples
+    // passed to start_stream, applied immediately if stream is running
+    int set_buffer_duration (double seconds, int preset);
+    // changes capacity of running ringbuffer without losing the latest samples
+    int resize_buffer (int buffer_size, int preset);
+    // samples with timestamps inside [start_time, end_time], if remove is true returned samples
+    // and all samples before them are removed from ring buffer
+    int get_board_data_by_time (double start_time, double end_time, int max_samples, int preset,
+        bool remove, double *data_buf, int *returned_samples);
     int insert_marker (double value, int preset);
     int add_streamer (const char *streamer_params, int preset);
     int delete_streamer (const char *streamer_params, int preset);
+    // stats layout: received, lost, duplicated, reordered packages since start_stream
+    int get_package_loss_stats (int preset, double *stats);
+    int set_lost_packages_fill (bool enable, int max_gap, int preset);
+    // method is a value of ResamplingTypes, data of the preset is put on uniform grid before ring
+    // buffer and streamers
+    int set_resampling (int method, int preset);
+    // epochs around markers are cut from ring buffer as soon as post window is received
+    int add_epoch_definition (const double *marker_values, int num_marker_values,
+        int pre_samples, int post_samples, int max_epochs, int preset, int *definition_id);
+    int remove_epoch_definition (int definition_id);
+    int get_epoch_count (int definition_id, int *result);
+    // markers of the definition whose window was overwritten in ring buffer before it was cut
+    int get_num_dropped_epochs (int definition_id, double *result);
+    // epochs are written one after another, each as num_rows x (pre + post + 1) matrix
+    int get_epochs (int definition_id, int max_epochs, double *data_buf, int *returned_epochs);
+    // config is json with optional fields window_seconds, railed_threshold, saturation_value,
+    // flatline_threshold and channels, exg channels are monitored by default
+    int enable_signal_quality_monitor (const char *json_config, int preset);
+    int disable_signal_quality_monitor (int preset);
+    // writes num_channels x SignalQualityMonitor::NUM_METRICS matrix, num_channels <= num_rows
+    int get_signal_quality (int preset, double *output, int *num_channels);
+    // secondary ringbuffer with data decimated by ratio, method is a value of DecimationTypes,
+    // it keeps seconds of data and is filled while samples are pushed
+    int enable_history (int ratio, int method, double seconds, int preset);
+    int disable_history (int preset);
+    int get_history_count (int preset, int *result);
+    // the latest decimated samples in the same layout as get_current_board_data
+    int get_history (int num_samples, int preset, double *data_buf, int *returned_samples);
 
     // Board::board_logger should not be called from destructors, to ensure that there are safe log
     // methods Board::board_logger still available but should be used only outside destructors
@@ -106,16 +168,65 @@ protected:
     json board_descr;
     SpinLock lock;
     std::map<int, std::deque<double>> marker_queues;
+    std::map<int, SequenceTracker> sequence_trackers;
+    std::map<int, int> resampling_methods;
+    std::map<int, std::shared_ptr<UniformResampler>> resamplers;
+    // definition id -> preset and extractor, modified under lock
+    std::map<int, std::pair<int, std::shared_ptr<EpochExtractor>>> epoch_extractors;
+    int next_epoch_definition_id;
+    // config is kept to recreate monitor for layout of the next session, both modified under lock
+    std::map<int, std::string> quality_monitor_configs;
+    std::map<int, std::shared_ptr<SignalQualityMonitor>> quality_monitors;
+    struct HistoryConfig
+    {
+        int ratio;
+        int method;
+        double seconds;
+    };
+    // config is kept to recreate history for the next session, both modified under lock
+    std::map<int, HistoryConfig> history_configs;
+    std::map<int, std::shared_ptr<DecimatedHistory>> histories;
+    // preset -> ringbuffer capacity in seconds, presets without entry use start_stream size,
+    // accessed under lock
+    std::map<int, double> buffer_durations;
 
     int prepare_for_acquisition (int buffer_size, const char *streamer_params);
     void free_packages ();
     void push_package (double *package, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    // packages are stored one after another, num_rows values each, lock is acquired only once
+    void push_packages (
+        double *packages, int num_packages, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    // drivers call it for each package with device package counter which wraps after
+    // 2^counter_bits values, returns number of placeholders which should be pushed before package
+    int track_package_num (
+        double package_num, int counter_bits, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    // pushes NaN filled packages to keep number of samples matching device timeline
+    void push_placeholder_packages (
+        int num_packages, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
     std::string preset_to_string (int preset);
     int preset_to_int (std::string preset);
     int parse_streamer_params (const char *streamer_params, std::string &streamer_type,
         std::string &streamer_dest, std::string &streamer_mods);
 
 private:
+    // sets marker and writes package to ring buffer and streamers, lock should be acquired
+    void store_package (double *package, int preset, int marker_channel);
+    // passes samples just added to ring buffer to epoch extractors, lock should be acquired
+    void extract_epochs (const double *samples, size_t count, int preset, uint64_t first_index);
+    std::shared_ptr<EpochExtractor> find_epoch_extractor (int definition_id);
+    // resampler for preset layout of this session or nullptr if resampling is disabled
+    std::shared_ptr<UniformResampler> create_resampler (int method, int preset);
+    std::shared_ptr<SignalQualityMonitor> create_quality_monitor (
+        const std::string &config, int preset);
+    int get_preset_buffer_size (double seconds, int preset, int *buffer_size);
+    std::shared_ptr<DecimatedHistory> create_history (const HistoryConfig &config, int preset);
+    std::shared_ptr<DecimatedHistory> find_history (int preset);
+    // copies samples by absolute index in short chunks to keep ringbuffer lock brief, returns
+    // false if some of them were overwritten
+    static bool copy_samples (
+        DataBuffer *db, uint64_t first_index, size_t count, int num_rows, double *data_buf);
     // reshapes data from DataBuffer format where all channels are mixed to linear buffer
     void reshape_data (int data_count, int preset, const double *buf, double *output_buf);
+    // bindings size output by get_num_rows of board description, runtime layout may not exceed it
+    int check_output_rows (int preset, int num_rows);
 };
@@ -18,10 +18,39 @@ extern "C"
         int board_id, const char *json_brainflow_input_params);
     SHARED_EXPORT int get_current_board_data (int num_samples, int preset, double *data_buf,
         int *returned_samples, int board_id, const char *json_brainflow_input_params);
+    // the latest num_samples[i] samples of presets[i] taken at the same instant, matrix of each
+    // preset is num_rows x returned_samples[i] and starts at offset equal to sum of
+    // num_rows * num_samples of previous presets
+    SHARED_EXPORT int CALLING_CONVENTION get_current_board_data_snapshot (const int *presets,
+        const int *num_samples, int num_presets, double *data_buf, int *returned_samples,
+        int board_id, const char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION get_board_data_count (
         int preset, int *result, int board_id, const char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION get_board_data (int data_count, int preset,
         double *data_buf, int board_id, const char *json_brainflow_input_params);
+    // ringbuffer of the preset keeps seconds of data instead of buffer_size samples from
+    // start_stream, if stream is running ringbuffer is resized immediately keeping the latest data
+    SHARED_EXPORT int CALLING_CONVENTION set_buffer_duration (
+        double seconds, int preset, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION resize_buffer (
+        int buffer_size, int preset, int board_id, const char *json_brainflow_input_params);
+    // samples with timestamps inside [start_time, end_time], get_board_data_by_time keeps data in
+    // ringbuffer, pop_board_data_by_time removes returned samples and all samples before them
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_by_time (double start_time,
+        double end_time, int max_samples, int preset, double *data_buf, int *returned_samples,
+        int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION pop_board_data_by_time (double start_time,
+        double end_time, int max_samples, int preset, double *data_buf, int *returned_samples,
+        int board_id, const char *json_brainflow_input_params);
+    // reads samples by absolute index without removing them, reading starts at next_index or at
+    // the oldest stored sample, next_index is 64 bit and passed as double like package loss stats
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_from_index (int preset, double *next_index,
+        int max_samples, double *data_buf, int *returned_samples, int board_id,
+        const char *json_brainflow_input_params);
+    // number of rows in data returned for this session, board layout configured at runtime never
+    // has more rows than get_num_rows
+    SHARED_EXPORT int CALLING_CONVENTION get_session_num_rows (
+        int preset, int *num_rows, int board_id, const char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION config_board (const char *config, char *response,
         int *response_len, int board_id, const char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION config_board_with_bytes (
@@ -30,12 +59,64 @@ extern "C"
         int *prepared, int board_id, const char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION insert_marker (
         double marker_value, int preset, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_package_loss_stats (
+        int preset, double *stats, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION set_lost_packages_fill (int enable, int max_gap,
+        int preset, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION set_resampling (
+        int method, int preset, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION add_epoch_definition (const double *marker_values,
+        int num_marker_values, int pre_samples, int post_samples, int max_epochs, int preset,
+        int *definition_id, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION remove_epoch_definition (
+        int definition_id, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_epoch_count (
+        int definition_id, int *result, int board_id, const char *json_brainflow_input_params);
+    // 64 bit count is returned as double like package loss stats
+    SHARED_EXPORT int CALLING_CONVENTION get_num_dropped_epochs (
+        int definition_id, double *result, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_epochs (int definition_id, int max_epochs,
+        double *data_buf, int *returned_epochs, int board_id,
+        const char *json_brainflow_input_params);
+    // per channel contact quality updated on each push, output is num_channels x 7 matrix with
+    // channel, standard deviation, railed ratio, flatline, 50 Hz and 60 Hz amplitude, saturation
+    // count
+    SHARED_EXPORT int CALLING_CONVENTION enable_signal_quality_monitor (const char *json_config,
+        int preset, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION disable_signal_quality_monitor (
+        int preset, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_signal_quality (int preset, double *output,
+        int *num_channels, int board_id, const char *json_brainflow_input_params);
+    // secondary ringbuffer with data decimated by ratio, method is a value of DecimationTypes,
+    // get_history returns the latest samples in the same layout as get_current_board_data
+    SHARED_EXPORT int CALLING_CONVENTION enable_history (int ratio, int method, double seconds,
+        int preset, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION disable_history (
+        int preset, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_history_count (
+        int preset, int *result, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_history (int num_samples, int preset,
+        double *data_buf, int *returned_samples, int board_id,
+        const char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION add_streamer (
         const char *streamer, int preset, int board_id, const char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION delete_streamer (
         const char *streamer, int preset, int board_id, const char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION release_all_sessions ();
 
+    // board groups: prepared sessions streamed together with merged clock aligned output
+    SHARED_EXPORT int CALLING_CONVENTION create_board_group (
+        const char *json_group_params, int *group_id);
+    SHARED_EXPORT int CALLING_CONVENTION start_board_group_stream (
+        int buffer_size, const char *streamer_params, int group_id);
+    SHARED_EXPORT int CALLING_CONVENTION stop_board_group_stream (int group_id);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_group_num_rows (int *num_rows, int group_id);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_group_data (
+        int max_samples, double *data_buf, int *returned_samples, int group_id);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_group_start_delays (
+        double *start_delays, double *rates, int *num_boards, int group_id);
+    SHARED_EXPORT int CALLING_CONVENTION release_board_group (int group_id);
+
     // logging methods
     SHARED_EXPORT int CALLING_CONVENTION set_log_level_board_controller (int log_level);
     SHARED_EXPORT int CALLING_CONVENTION set_log_file_board_controller (const char *log_file);
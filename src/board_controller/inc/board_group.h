@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+#include "board_session.h"
+#include "stream_aligner.h"
+
+
+// several prepared sessions streamed together, data of one preset from all sessions is merged and
+// interpolated on a common time grid, group reads session buffers by absolute sample index without
+// removing data, so sessions can still be read directly
+// output rows: grid timestamp followed by rows of each session except its timestamp row, sessions
+// released while group exists are dropped from it and their rows are NaN from then on
+class BoardGroup
+{
+public:
+    // sampling_rate <= 0 means max sampling rate of sessions
+    BoardGroup (
+        std::vector<std::shared_ptr<BoardSession>> sessions, int preset, double sampling_rate);
+
+    int prepare ();
+    // starts all sessions in parallel
+    int start_stream (int buffer_size, const char *streamer_params);
+    int stop_stream ();
+    int get_num_rows (int *num_rows);
+    // data_buf must hold get_num_rows * max_samples values, returns only samples for which all
+    // sessions already have data
+    int get_data (int max_samples, double *data_buf, int *returned_samples);
+    // delays between the first sample of the earliest session and the first sample of each
+    // session on the host clock in seconds, and sampling rates estimated from timestamps, both are
+    // NaN for dropped sessions, delays are NaN until session sends data
+    int get_start_delays (double *start_delays, double *rates, int *num_boards);
+
+private:
+    std::mutex mutex;
+    // NULL for dropped sessions
+    std::vector<std::shared_ptr<BoardSession>> sessions;
+    std::vector<std::shared_ptr<StreamAligner>> aligners;
+    // absolute index of the next sample to read from each session
+    std::vector<uint64_t> next_indexes;
+    int preset;
+    double sampling_rate;
+    int num_rows;
+    double grid_start;
+    int64_t num_grid_samples;
+    std::vector<double> session_data;
+    std::vector<double> merged_data;
+
+    int pull_data ();
+    void drop_released_sessions ();
+};
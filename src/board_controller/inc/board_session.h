@@ -0,0 +1,23 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "board.h"
+#include "brainflow_input_params.h"
+
+
+// session mutex serializes calls for a single board
+struct BoardSession
+{
+    std::pair<int, struct BrainFlowInputParams> key;
+    std::shared_ptr<Board> board;
+    std::mutex mutex;
+    // false while board prepares or releases, such sessions are invisible for other calls but
+    // still reserve the key, guarded by global mutex of board controller
+    bool is_ready;
+    // set before board is released, guarded by session mutex, calls which found the session
+    // before release check it after taking session mutex
+    bool is_released;
+};
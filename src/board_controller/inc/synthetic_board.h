@@ -1,11 +1,25 @@
 #pragma once
 
+#include <string>
 #include <thread>
 
 #include "board.h"
 #include "board_controller.h"
 
 
+enum class SyntheticProfiles : int
+{
+    EEG = 0,
+    SINE = 1,
+    NOISE = 2
+};
+
+// load generator mode is enabled by json in other_info or config_board before start_stream:
+// {"num_channels": 16, "sampling_rate": 32000, "batch_size": 32, "profile": "eeg"}
+// profile is one of "eeg", "sine" or "noise", default preset keeps its number of rows and timestamp
+// and marker channels, num_channels exg channels follow package num and other rows are zero,
+// config_board returns the new layout, {"enabled": false} restores regular mode.
+// SYNTHETIC_LOAD_BOARD is always in load mode, its description has rows for 1024 channels
 class SyntheticBoard : public Board
 {
 
@@ -15,10 +29,21 @@ private:
     bool is_streaming;
     std::thread streaming_thread;
 
+    bool load_mode;
+    int load_num_channels;
+    int load_sampling_rate;
+    int load_batch_size;
+    int load_profile;
+
     void read_thread ();
+    void read_thread_load ();
+    int parse_load_config (const std::string &config);
+    // restores layout of board description
+    void reset_layout ();
+    void apply_load_layout ();
 
 public:
-    SyntheticBoard (struct BrainFlowInputParams params);
+    SyntheticBoard (int board_id, struct BrainFlowInputParams params);
     ~SyntheticBoard ();
 
     int prepare_session ();
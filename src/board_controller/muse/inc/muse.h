@@ -7,6 +7,20 @@
 #include <vector>
 
 
+enum class MuseNotificationTypes : int
+{
+    TP9 = 0,
+    AF7 = 1,
+    AF8 = 2,
+    TP10 = 3,
+    RIGHT_AUX = 4,
+    ACCEL = 5,
+    GYRO = 6,
+    PPG0 = 7,
+    PPG1 = 8,
+    PPG2 = 9
+};
+
 class Muse : public BLELibBoard
 {
 
@@ -16,13 +30,27 @@ protected:
     bool initialized;
     bool is_streaming;
     std::mutex m;
-    std::mutex callback_lock;
     std::condition_variable cv;
     std::vector<std::pair<simpleble_uuid_t, simpleble_uuid_t>> notified_characteristics;
     std::pair<simpleble_uuid_t, simpleble_uuid_t> control_characteristics;
-    std::vector<std::vector<double>> current_default_buf;
-    std::vector<std::vector<double>> current_aux_buf;
-    std::vector<std::vector<double>> current_anc_buf;
+    // packages from single transaction are stored one after another and pushed at once
+    std::vector<double> current_default_buf;
+    std::vector<double> current_aux_buf;
+    std::vector<double> current_anc_buf;
+    int num_default_rows;
+    int num_aux_rows;
+    int num_anc_rows;
+    // channel indices are resolved once in prepare_session
+    std::vector<int> eeg_channels;
+    int aux_eeg_channel; // -1 if board has no other_channels
+    int eeg_package_num_channel;
+    int eeg_timestamp_channel;
+    int accel_channels[3];
+    int gyro_channels[3];
+    int aux_package_num_channel;
+    int aux_timestamp_channel;
+    std::vector<int> ppg_channels;
+    int anc_timestamp_channel;
     std::vector<bool> new_eeg_data;
     std::vector<bool> new_ppg_data;
     double last_fifth_chan_timestamp; // used to determine 4 or 5 channels used
@@ -30,6 +58,9 @@ protected:
     double last_eeg_timestamp;        // used for timestamp correction
     double last_aux_timestamp;        // used for timestamp correction
 
+    void resolve_channels ();
+    void handle_notification (int type, const uint8_t *data, size_t size, double timestamp);
+
 public:
     Muse (int board_id, struct BrainFlowInputParams params);
     ~Muse ();
@@ -42,14 +73,9 @@ public:
     int config_board (std::string config);
 
     void adapter_on_scan_found (simpleble_adapter_t adapter, simpleble_peripheral_t peripheral);
-    void peripheral_on_eeg (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
-        simpleble_uuid_t characteristic, const uint8_t *data, size_t size, size_t channel_num);
-    void peripheral_on_ppg (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
-        simpleble_uuid_t characteristic, const uint8_t *data, size_t size, size_t ppg_num);
-    void peripheral_on_accel (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
-        simpleble_uuid_t characteristic, const uint8_t *data, size_t size);
-    void peripheral_on_gyro (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
-        simpleble_uuid_t characteristic, const uint8_t *data, size_t size);
-    void peripheral_on_status (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
-        simpleble_uuid_t characteristic, const uint8_t *data, size_t size);
+    // called from notification thread, timestamp is time when notification was received
+    void peripheral_on_eeg (const uint8_t *data, size_t size, size_t channel_num, double timestamp);
+    void peripheral_on_ppg (const uint8_t *data, size_t size, size_t ppg_num, double timestamp);
+    void peripheral_on_accel (const uint8_t *data, size_t size);
+    void peripheral_on_gyro (const uint8_t *data, size_t size, double timestamp);
 };
@@ -17,67 +17,70 @@ void adapter_on_scan_found (
 void peripheral_on_tp9 (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
     simpleble_uuid_t characteristic, const uint8_t *data, size_t size, void *board)
 {
-    ((Muse *)(board))->peripheral_on_eeg (peripheral, service, characteristic, data, size, 0);
+    ((Muse *)(board))->enqueue_notification ((int)MuseNotificationTypes::TP9, data, size);
 }
 
 void peripheral_on_af7 (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
     simpleble_uuid_t characteristic, const uint8_t *data, size_t size, void *board)
 {
-    ((Muse *)(board))->peripheral_on_eeg (peripheral, service, characteristic, data, size, 1);
+    ((Muse *)(board))->enqueue_notification ((int)MuseNotificationTypes::AF7, data, size);
 }
 
 void peripheral_on_af8 (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
     simpleble_uuid_t characteristic, const uint8_t *data, size_t size, void *board)
 {
-    ((Muse *)(board))->peripheral_on_eeg (peripheral, service, characteristic, data, size, 2);
+    ((Muse *)(board))->enqueue_notification ((int)MuseNotificationTypes::AF8, data, size);
 }
 
 void peripheral_on_tp10 (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
     simpleble_uuid_t characteristic, const uint8_t *data, size_t size, void *board)
 {
-    ((Muse *)(board))->peripheral_on_eeg (peripheral, service, characteristic, data, size, 3);
+    ((Muse *)(board))->enqueue_notification ((int)MuseNotificationTypes::TP10, data, size);
 }
 
 void peripheral_on_accel (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
     simpleble_uuid_t characteristic, const uint8_t *data, size_t size, void *board)
 {
-    ((Muse *)(board))->peripheral_on_accel (peripheral, service, characteristic, data, size);
+    ((Muse *)(board))->enqueue_notification ((int)MuseNotificationTypes::ACCEL, data, size);
 }
 
 void peripheral_on_gyro (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
     simpleble_uuid_t characteristic, const uint8_t *data, size_t size, void *board)
 {
-    ((Muse *)(board))->peripheral_on_gyro (peripheral, service, characteristic, data, size);
+    ((Muse *)(board))->enqueue_notification ((int)MuseNotificationTypes::GYRO, data, size);
 }
 
 void peripheral_on_ppg0 (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
     simpleble_uuid_t characteristic, const uint8_t *data, size_t size, void *board)
 {
-    ((Muse *)(board))->peripheral_on_ppg (peripheral, service, characteristic, data, size, 0);
+    ((Muse *)(board))->enqueue_notification ((int)MuseNotificationTypes::PPG0, data, size);
 }
 
 void peripheral_on_ppg1 (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
     simpleble_uuid_t characteristic, const uint8_t *data, size_t size, void *board)
 {
-    ((Muse *)(board))->peripheral_on_ppg (peripheral, service, characteristic, data, size, 1);
+    ((Muse *)(board))->enqueue_notification ((int)MuseNotificationTypes::PPG1, data, size);
 }
 
 void peripheral_on_ppg2 (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
     simpleble_uuid_t characteristic, const uint8_t *data, size_t size, void *board)
 {
-    ((Muse *)(board))->peripheral_on_ppg (peripheral, service, characteristic, data, size, 2);
+    ((Muse *)(board))->enqueue_notification ((int)MuseNotificationTypes::PPG2, data, size);
 }
 
 void peripheral_on_right_aux (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
     simpleble_uuid_t characteristic, const uint8_t *data, size_t size, void *board)
 {
-    ((Muse *)(board))->peripheral_on_eeg (peripheral, service, characteristic, data, size, 4);
+    ((Muse *)(board))->enqueue_notification ((int)MuseNotificationTypes::RIGHT_AUX, data, size);
 }
 
 
 Muse::Muse (int board_id, struct BrainFlowInputParams params) : BLELibBoard (board_id, params)
 {
     initialized = false;
+    // eeg, ppg and imu characteristics send 20 byte notifications, about 200 per second in total
+    notification_queue_size = 1024;
+    max_notification_size = 20;
     muse_adapter = NULL;
     muse_peripheral = NULL;
     is_streaming = false;
@@ -387,36 +390,7 @@ int Muse::prepare_session ()
 
     if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (control_characteristics_found))
     {
-        int eeg_buffer_size = board_descr["default"]["num_rows"].get<int> ();
-        int aux_buffer_size = board_descr["auxiliary"]["num_rows"].get<int> ();
-        current_default_buf.resize (12); // 12 eeg packages in single ble transaction
-        new_eeg_data.resize (5);         // 5 eeg channels total
-        current_aux_buf.resize (3);      // 3 samples in each message for gyro and accel
-        for (int i = 0; i < 12; i++)
-        {
-            current_default_buf[i].resize (eeg_buffer_size);
-            std::fill (current_default_buf[i].begin (), current_default_buf[i].end (), 0.0);
-        }
-        std::fill (new_eeg_data.begin (), new_eeg_data.end (), false);
-        for (int i = 0; i < 3; i++)
-        {
-            current_aux_buf[i].resize (aux_buffer_size);
-            std::fill (current_aux_buf[i].begin (), current_aux_buf[i].end (), 0.0);
-        }
-        // muse 2016 has no ppg
-        if (board_id != (int)BoardIds::MUSE_2016_BOARD)
-        {
-            int anc_buffer_size = board_descr["ancillary"]["num_rows"].get<int> ();
-            current_anc_buf.resize (6); // 6 ppg packages in single transaction
-            for (int i = 0; i < 6; i++)
-            {
-                current_anc_buf[i].resize (anc_buffer_size);
-                std::fill (current_anc_buf[i].begin (), current_anc_buf[i].end (), 0.0);
-            }
-            new_ppg_data.resize (3); // 3 ppg chars
-            std::fill (new_ppg_data.begin (), new_ppg_data.end (), false);
-        }
-
+        resolve_channels ();
         initialized = true;
     }
 
@@ -445,8 +419,16 @@ int Muse::start_stream (int buffer_size, const char *streamer_params)
 
     int res = prepare_for_acquisition (buffer_size, streamer_params);
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = start_notification_thread ();
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
         res = config_board ("d");
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            stop_notification_thread ();
+        }
     }
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
@@ -471,6 +453,7 @@ int Muse::stop_stream ()
     {
         res = (int)BrainFlowExitCodes::STREAM_ALREADY_RUN_ERROR;
     }
+    stop_notification_thread ();
     is_streaming = false;
     last_fifth_chan_timestamp = -1.0;
     last_ppg_timestamp = -1.0;
@@ -481,6 +464,7 @@ int Muse::stop_stream ()
 
 int Muse::release_session ()
 {
+    stop_notification_thread ();
     if (initialized)
     {
         // repeat it multiple times, failure here may lead to a crash
@@ -526,21 +510,9 @@ int Muse::release_session ()
         muse_adapter = NULL;
     }
 
-    for (size_t i = 0; i < current_default_buf.size (); i++)
-    {
-        current_default_buf[i].clear ();
-    }
     current_default_buf.clear ();
     new_eeg_data.clear ();
-    for (size_t i = 0; i < current_aux_buf.size (); i++)
-    {
-        current_aux_buf[i].clear ();
-    }
     current_aux_buf.clear ();
-    for (size_t i = 0; i < current_anc_buf.size (); i++)
-    {
-        current_anc_buf[i].clear ();
-    }
     current_anc_buf.clear ();
     new_ppg_data.clear ();
 
@@ -624,10 +596,81 @@ void Muse::adapter_on_scan_found (simpleble_adapter_t adapter, simpleble_periphe
     }
 }
 
-void Muse::peripheral_on_eeg (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
-    simpleble_uuid_t characteristic, const uint8_t *data, size_t size, size_t channel_num)
+void Muse::resolve_channels ()
+{
+    const json &default_preset = board_descr["default"];
+    const json &aux_preset = board_descr["auxiliary"];
+    num_default_rows = default_preset["num_rows"].get<int> ();
+    num_aux_rows = aux_preset["num_rows"].get<int> ();
+    eeg_channels = default_preset["eeg_channels"].get<std::vector<int>> ();
+    aux_eeg_channel = -1;
+    if (default_preset.contains ("other_channels"))
+    {
+        aux_eeg_channel = default_preset["other_channels"][0].get<int> ();
+    }
+    eeg_package_num_channel = default_preset["package_num_channel"].get<int> ();
+    eeg_timestamp_channel = default_preset["timestamp_channel"].get<int> ();
+    for (int i = 0; i < 3; i++)
+    {
+        accel_channels[i] = aux_preset["accel_channels"][i].get<int> ();
+        gyro_channels[i] = aux_preset["gyro_channels"][i].get<int> ();
+    }
+    aux_package_num_channel = aux_preset["package_num_channel"].get<int> ();
+    aux_timestamp_channel = aux_preset["timestamp_channel"].get<int> ();
+    // 12 eeg packages in single ble transaction
+    current_default_buf.resize (12 * num_default_rows);
+    std::fill (current_default_buf.begin (), current_default_buf.end (), 0.0);
+    new_eeg_data.resize (5); // 5 eeg channels total
+    std::fill (new_eeg_data.begin (), new_eeg_data.end (), false);
+    // 3 samples in each message for gyro and accel
+    current_aux_buf.resize (3 * num_aux_rows);
+    std::fill (current_aux_buf.begin (), current_aux_buf.end (), 0.0);
+    // muse 2016 has no ppg
+    if (board_id != (int)BoardIds::MUSE_2016_BOARD)
+    {
+        const json &anc_preset = board_descr["ancillary"];
+        num_anc_rows = anc_preset["num_rows"].get<int> ();
+        ppg_channels = anc_preset["ppg_channels"].get<std::vector<int>> ();
+        anc_timestamp_channel = anc_preset["timestamp_channel"].get<int> ();
+        // 6 ppg packages in single transaction
+        current_anc_buf.resize (6 * num_anc_rows);
+        std::fill (current_anc_buf.begin (), current_anc_buf.end (), 0.0);
+        new_ppg_data.resize (3); // 3 ppg chars
+        std::fill (new_ppg_data.begin (), new_ppg_data.end (), false);
+    }
+}
+
+void Muse::handle_notification (int type, const uint8_t *data, size_t size, double timestamp)
+{
+    switch ((MuseNotificationTypes)type)
+    {
+        case MuseNotificationTypes::TP9:
+        case MuseNotificationTypes::AF7:
+        case MuseNotificationTypes::AF8:
+        case MuseNotificationTypes::TP10:
+        case MuseNotificationTypes::RIGHT_AUX:
+            peripheral_on_eeg (data, size, (size_t)type, timestamp);
+            break;
+        case MuseNotificationTypes::ACCEL:
+            peripheral_on_accel (data, size);
+            break;
+        case MuseNotificationTypes::GYRO:
+            peripheral_on_gyro (data, size, timestamp);
+            break;
+        case MuseNotificationTypes::PPG0:
+        case MuseNotificationTypes::PPG1:
+        case MuseNotificationTypes::PPG2:
+            peripheral_on_ppg (
+                data, size, (size_t)(type - (int)MuseNotificationTypes::PPG0), timestamp);
+            break;
+        default:
+            break;
+    }
+}
+
+void Muse::peripheral_on_eeg (
+    const uint8_t *data, size_t size, size_t channel_num, double timestamp)
 {
-    std::lock_guard<std::mutex> callback_guard (callback_lock);
     if (size != 20)
     {
         safe_logger (spdlog::level::warn, "unknown size for eeg callback: {}", size);
@@ -638,45 +681,34 @@ void Muse::peripheral_on_eeg (simpleble_peripheral_t peripheral, simpleble_uuid_
      * timestamps to determine if its on or not */
     if (channel_num == 4)
     {
-        last_fifth_chan_timestamp = get_timestamp ();
+        last_fifth_chan_timestamp = timestamp;
     }
     new_eeg_data[channel_num] = true;
 
-    std::vector<int> eeg_channels = board_descr["default"]["eeg_channels"];
+    // place optional aux channel to other channels
+    int channel = (channel_num == 4) ? aux_eeg_channel : eeg_channels[channel_num];
+    if (channel < 0)
+    {
+        safe_logger (spdlog::level::trace,
+            "no other_channels for this board"); // should not get here
+    }
     unsigned int package_num = data[0] * 256 + data[1];
     for (size_t i = 2, counter = 0; i < size; i += 3, counter += 2)
     {
         double val1 = data[i] << 4 | data[i + 1] >> 4;
         double val2 = (data[i + 1] & 0xF) << 8 | data[i + 2];
-        val1 = (val1 - 0x800) * 125.0 / 256.0;
-        val2 = (val2 - 0x800) * 125.0 / 256.0;
-        // place optional aux channel to other channels
-        if (channel_num == 4)
-        {
-            try
-            {
-                std::vector<int> other_channels = board_descr["default"]["other_channels"];
-                current_default_buf[counter][other_channels[0]] = val1;
-                current_default_buf[counter + 1][other_channels[0]] = val2;
-            }
-            catch (...)
-            {
-                safe_logger (spdlog::level::trace,
-                    "no other_channels for this board"); // should not get here
-            }
-        }
-        else
+        double *first_package = &current_default_buf[counter * num_default_rows];
+        double *second_package = first_package + num_default_rows;
+        if (channel >= 0)
         {
-            current_default_buf[counter][eeg_channels[channel_num]] = val1;
-            current_default_buf[counter + 1][eeg_channels[channel_num]] = val2;
+            first_package[channel] = (val1 - 0x800) * 125.0 / 256.0;
+            second_package[channel] = (val2 - 0x800) * 125.0 / 256.0;
         }
-        current_default_buf[counter][board_descr["default"]["package_num_channel"].get<int> ()] =
-            package_num;
-        current_default_buf[counter +
-            1][board_descr["default"]["package_num_channel"].get<int> ()] = package_num;
+        first_package[eeg_package_num_channel] = package_num;
+        second_package[eeg_package_num_channel] = package_num;
     }
 
-    int num_trues = 0;
+    size_t num_trues = 0;
     for (size_t i = 0; i < new_eeg_data.size (); i++)
     {
         if (new_eeg_data[i])
@@ -685,32 +717,28 @@ void Muse::peripheral_on_eeg (simpleble_peripheral_t peripheral, simpleble_uuid_
         }
     }
 
-    double current_timestamp = get_timestamp ();
-
     if ((num_trues == new_eeg_data.size ()) ||
-        ((num_trues == new_eeg_data.size () - 1) &&
-            (current_timestamp - last_fifth_chan_timestamp > 1)))
+        ((num_trues == new_eeg_data.size () - 1) && (timestamp - last_fifth_chan_timestamp > 1)))
     {
         // skip one package to setup timestamp correction
         if (last_eeg_timestamp > 0)
         {
-            double step = (current_timestamp - last_eeg_timestamp) / current_default_buf.size ();
-            for (size_t i = 0; i < current_default_buf.size (); i++)
+            int num_packages = (int)current_default_buf.size () / num_default_rows;
+            double step = (timestamp - last_eeg_timestamp) / num_packages;
+            for (int i = 0; i < num_packages; i++)
             {
-                current_default_buf[i][board_descr["default"]["timestamp_channel"].get<int> ()] =
+                current_default_buf[i * num_default_rows + eeg_timestamp_channel] =
                     last_eeg_timestamp + step * (i + 1);
-                push_package (&current_default_buf[i][0]);
             }
+            push_packages (&current_default_buf[0], num_packages);
         }
-        last_eeg_timestamp = current_timestamp;
+        last_eeg_timestamp = timestamp;
         std::fill (new_eeg_data.begin (), new_eeg_data.end (), false);
     }
 }
 
-void Muse::peripheral_on_accel (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
-    simpleble_uuid_t characteristic, const uint8_t *data, size_t size)
+void Muse::peripheral_on_accel (const uint8_t *data, size_t size)
 {
-    std::lock_guard<std::mutex> callback_guard (callback_lock);
     if (size != 20)
     {
         safe_logger (spdlog::level::warn, "unknown size for accel callback: {}", size);
@@ -719,19 +747,17 @@ void Muse::peripheral_on_accel (simpleble_peripheral_t peripheral, simpleble_uui
 
     for (int i = 0; i < 3; i++)
     {
-        double accel_valx = (double)cast_16bit_to_int32 ((unsigned char *)&data[2 + i * 6]) / 16384;
-        double accel_valy = (double)cast_16bit_to_int32 ((unsigned char *)&data[4 + i * 6]) / 16384;
-        double accel_valz = (double)cast_16bit_to_int32 ((unsigned char *)&data[6 + i * 6]) / 16384;
-        current_aux_buf[i][board_descr["auxiliary"]["accel_channels"][0].get<int> ()] = accel_valx;
-        current_aux_buf[i][board_descr["auxiliary"]["accel_channels"][1].get<int> ()] = accel_valy;
-        current_aux_buf[i][board_descr["auxiliary"]["accel_channels"][2].get<int> ()] = accel_valz;
+        double *package = &current_aux_buf[i * num_aux_rows];
+        for (int j = 0; j < 3; j++)
+        {
+            package[accel_channels[j]] =
+                (double)cast_16bit_to_int32 ((unsigned char *)&data[2 + i * 6 + j * 2]) / 16384;
+        }
     }
 }
 
-void Muse::peripheral_on_gyro (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
-    simpleble_uuid_t characteristic, const uint8_t *data, size_t size)
+void Muse::peripheral_on_gyro (const uint8_t *data, size_t size, double timestamp)
 {
-    std::lock_guard<std::mutex> callback_guard (callback_lock);
     if (size != 20)
     {
         safe_logger (spdlog::level::warn, "unknown size for gyro callback: {}", size);
@@ -739,56 +765,50 @@ void Muse::peripheral_on_gyro (simpleble_peripheral_t peripheral, simpleble_uuid
     }
 
     unsigned int package_num = data[0] * 256 + data[1];
-    double current_timestamp = get_timestamp ();
 
     for (int i = 0; i < 3; i++)
     {
-        double gyro_valx = (double)cast_16bit_to_int32 ((unsigned char *)&data[2 + i * 6]) *
-            MUSE_GYRO_SCALE_FACTOR;
-        double gyro_valy = (double)cast_16bit_to_int32 ((unsigned char *)&data[4 + i * 6]) *
-            MUSE_GYRO_SCALE_FACTOR;
-        double gyro_valz = (double)cast_16bit_to_int32 ((unsigned char *)&data[6 + i * 6]) *
-            MUSE_GYRO_SCALE_FACTOR;
-        current_aux_buf[i][board_descr["auxiliary"]["gyro_channels"][0].get<int> ()] = gyro_valx;
-        current_aux_buf[i][board_descr["auxiliary"]["gyro_channels"][1].get<int> ()] = gyro_valy;
-        current_aux_buf[i][board_descr["auxiliary"]["gyro_channels"][2].get<int> ()] = gyro_valz;
-        current_aux_buf[i][board_descr["auxiliary"]["package_num_channel"].get<int> ()] =
-            (double)package_num;
+        double *package = &current_aux_buf[i * num_aux_rows];
+        for (int j = 0; j < 3; j++)
+        {
+            package[gyro_channels[j]] =
+                (double)cast_16bit_to_int32 ((unsigned char *)&data[2 + i * 6 + j * 2]) *
+                MUSE_GYRO_SCALE_FACTOR;
+        }
+        package[aux_package_num_channel] = (double)package_num;
     }
 
     if (last_aux_timestamp > 0)
     {
-        double step = (current_timestamp - last_aux_timestamp) / current_aux_buf.size ();
         // push aux packages from gyro callback
-        for (size_t i = 0; i < current_aux_buf.size (); i++)
+        int num_packages = (int)current_aux_buf.size () / num_aux_rows;
+        double step = (timestamp - last_aux_timestamp) / num_packages;
+        for (int i = 0; i < num_packages; i++)
         {
-            current_aux_buf[i][board_descr["auxiliary"]["timestamp_channel"].get<int> ()] =
+            current_aux_buf[i * num_aux_rows + aux_timestamp_channel] =
                 last_aux_timestamp + step * (i + 1);
-            push_package (&current_aux_buf[i][0], (int)BrainFlowPresets::AUXILIARY_PRESET);
         }
+        push_packages (
+            &current_aux_buf[0], num_packages, (int)BrainFlowPresets::AUXILIARY_PRESET);
     }
-    last_aux_timestamp = current_timestamp;
+    last_aux_timestamp = timestamp;
 }
 
-void Muse::peripheral_on_ppg (simpleble_peripheral_t peripheral, simpleble_uuid_t service,
-    simpleble_uuid_t characteristic, const uint8_t *data, size_t size, size_t ppg_num)
+void Muse::peripheral_on_ppg (const uint8_t *data, size_t size, size_t ppg_num, double timestamp)
 {
-    std::lock_guard<std::mutex> callback_guard (callback_lock);
     if (size != 20)
     {
         safe_logger (spdlog::level::warn, "unknown size for ppg callback: {}", size);
         return;
     }
-    unsigned int package_num = data[0] * 256 + data[1];
     new_ppg_data[ppg_num] = true;
-    std::vector<int> ppg_channels = board_descr["ancillary"]["ppg_channels"];
     // format is: 2 bytes for package num, 6 int24 values for actual data
     for (int i = 0; i < 6; i++)
     {
-        double ppg_val = (double)cast_24bit_to_int32 ((unsigned char *)&data[2 + i * 3]);
-        current_anc_buf[i][ppg_channels[ppg_num]] = ppg_val;
+        current_anc_buf[i * num_anc_rows + ppg_channels[ppg_num]] =
+            (double)cast_24bit_to_int32 ((unsigned char *)&data[2 + i * 3]);
     }
-    int num_trues = 0;
+    size_t num_trues = 0;
     for (size_t i = 0; i < new_ppg_data.size (); i++)
     {
         if (new_ppg_data[i])
@@ -797,23 +817,23 @@ void Muse::peripheral_on_ppg (simpleble_peripheral_t peripheral, simpleble_uuid_
         }
     }
 
-    double current_timestamp = get_timestamp ();
-
     if (num_trues == new_ppg_data.size () - 1) // actually it streams only 2 of 3 ppg data types and
                                                // I am not sure that these 2 are freezed
     {
         // skip one package to setup timestamp correction
         if (last_ppg_timestamp > 0)
         {
-            double step = (current_timestamp - last_ppg_timestamp) / current_anc_buf.size ();
-            for (size_t i = 0; i < current_anc_buf.size (); i++)
+            int num_packages = (int)current_anc_buf.size () / num_anc_rows;
+            double step = (timestamp - last_ppg_timestamp) / num_packages;
+            for (int i = 0; i < num_packages; i++)
             {
-                current_anc_buf[i][board_descr["ancillary"]["timestamp_channel"].get<int> ()] =
+                current_anc_buf[i * num_anc_rows + anc_timestamp_channel] =
                     last_ppg_timestamp + step * (i + 1);
-                push_package (&current_anc_buf[i][0], (int)BrainFlowPresets::ANCILLARY_PRESET);
             }
+            push_packages (
+                &current_anc_buf[0], num_packages, (int)BrainFlowPresets::ANCILLARY_PRESET);
         }
-        last_ppg_timestamp = current_timestamp;
+        last_ppg_timestamp = timestamp;
         std::fill (new_ppg_data.begin (), new_ppg_data.end (), false);
     }
 }
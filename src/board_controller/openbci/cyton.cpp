@@ -138,6 +138,7 @@ void Cyton::read_thread ()
 
         package[board_descr["default"]["timestamp_channel"].get<int> ()] = get_timestamp ();
 
+        push_placeholder_packages (track_package_num (b[0], 8));
         push_package (package);
     }
     delete[] package;
@@ -8,6 +8,7 @@
 #include <regex>
 #include <sstream>
 
+#include "array_conversion.h"
 #include "custom_cast.h"
 #include "json.hpp"
 #include "timestamp.h"
@@ -115,6 +116,28 @@ int GaleaV4::config_board (std::string conf, std::string &response)
         int res = calc_time (response);
         return res;
     }
+    // kernel buffer for incoming datagrams, increase it to avoid drops at high sampling rates
+    if (conf.find ("set_recv_buffer_size:") == 0)
+    {
+        int size = 0;
+        try
+        {
+            size = std::stoi (conf.substr (strlen ("set_recv_buffer_size:")));
+        }
+        catch (...)
+        {
+            safe_logger (spdlog::level::err, "invalid buffer size in {}", conf.c_str ());
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        int res = socket->set_recv_buffer_size (size);
+        if (res != (int)SocketClientUDPReturnCodes::STATUS_OK)
+        {
+            safe_logger (spdlog::level::err, "failed to set recv buffer size: {}", res);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        safe_logger (spdlog::level::info, "recv buffer size is set to {}", size);
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
 
     if (conf == "get_gains")
     {
@@ -357,32 +380,63 @@ int GaleaV4::release_session ()
 
 void GaleaV4::read_thread ()
 {
-    int res;
-    unsigned char b[GaleaV4::max_transaction_size];
+    // all datagrams queued in socket are received at once and decoded into continuous arrays of
+    // packages, so each preset is pushed once per batch
+    constexpr int max_packages_in_batch = MAX_UDP_BATCH_SIZE * GaleaV4::max_num_packages;
+    int transaction_sizes[MAX_UDP_BATCH_SIZE];
+    unsigned char *b = new unsigned char[GaleaV4::max_transaction_size * MAX_UDP_BATCH_SIZE];
+    memset (b, 0, GaleaV4::max_transaction_size * MAX_UDP_BATCH_SIZE);
     DataBuffer time_buffer (1, 11);
     double latest_times[10];
-    for (int i = 0; i < GaleaV4::max_transaction_size; i++)
-    {
-        b[i] = 0;
-    }
 
     int num_exg_rows = board_descr["default"]["num_rows"];
     int num_aux_rows = board_descr["auxiliary"]["num_rows"];
-    double *exg_package = new double[num_exg_rows];
-    double *aux_package = new double[num_aux_rows];
-    for (int i = 0; i < num_exg_rows; i++)
-    {
-        exg_package[i] = 0.0;
-    }
-    for (int i = 0; i < num_aux_rows; i++)
+    double *exg_packages = new double[num_exg_rows * max_packages_in_batch];
+    double *aux_packages = new double[num_aux_rows * max_packages_in_batch];
+    for (int i = 0; i < num_exg_rows * max_packages_in_batch; i++)
+    {
+        exg_packages[i] = 0.0;
+    }
+    for (int i = 0; i < num_aux_rows * max_packages_in_batch; i++)
+    {
+        aux_packages[i] = 0.0;
+    }
+
+    // resolve channels once, json lookups are too slow for per package usage
+    int exg_package_num_channel = board_descr["default"]["package_num_channel"];
+    int exg_timestamp_channel = board_descr["default"]["timestamp_channel"];
+    int exg_pc_timestamp_channel = board_descr["default"]["other_channels"][0];
+    int exg_device_timestamp_channel = board_descr["default"]["other_channels"][1];
+    int aux_package_num_channel = board_descr["auxiliary"]["package_num_channel"];
+    int aux_timestamp_channel = board_descr["auxiliary"]["timestamp_channel"];
+    int aux_pc_timestamp_channel = board_descr["auxiliary"]["other_channels"][0];
+    int aux_device_timestamp_channel = board_descr["auxiliary"]["other_channels"][1];
+    int ppg_red_channel = board_descr["auxiliary"]["ppg_channels"][0];
+    int ppg_ir_channel = board_descr["auxiliary"]["ppg_channels"][1];
+    int eda_channel = board_descr["auxiliary"]["eda_channels"][0];
+    int temperature_channel = board_descr["auxiliary"]["temperature_channels"][0];
+    int battery_channel = board_descr["auxiliary"]["battery_channel"];
+    int accel_channels[3];
+    int gyro_channels[3];
+    int magnetometer_channels[3];
+    for (int i = 0; i < 3; i++)
     {
-        aux_package[i] = 0.0;
+        accel_channels[i] = board_descr["auxiliary"]["accel_channels"][i];
+        gyro_channels[i] = board_descr["auxiliary"]["gyro_channels"][i];
+        magnetometer_channels[i] = board_descr["auxiliary"]["magnetometer_channels"][i];
     }
+    const double accel_scale = (double)(8.0 / static_cast<double> (pow (2, 16) - 1));
+    const double gyro_scale = (double)(1000.0 / static_cast<double> (pow (2, 16) - 1));
+    const double magnetometer_scale_xy = (double)(2.6 / static_cast<double> (pow (2, 13) - 1));
+    const double magnetometer_scale_z = (double)(5.0 / static_cast<double> (pow (2, 15) - 1));
+    constexpr int num_exg_channels = 24;
+    double exg_scales[num_exg_channels];
 
     while (keep_alive)
     {
-        res = socket->recv (b, GaleaV4::max_transaction_size);
-        if (res == -1)
+        int num_transactions = socket->recv_batch (
+            b, GaleaV4::max_transaction_size, MAX_UDP_BATCH_SIZE, transaction_sizes);
+        if (num_transactions == -1)
         {
 #ifdef _WIN32
             safe_logger (spdlog::level::err, "WSAGetLastError is {}", WSAGetLastError ());
@@ -391,25 +445,40 @@ void GaleaV4::read_thread ()
 #endif
             continue;
         }
-        if (res % GaleaV4::package_size != 0)
+
+        // gains can be changed during streaming, but not in the middle of the batch
+        for (int i = 0; i < num_exg_channels; i++)
         {
-            if (res > 0)
-            {
-                // more likely its a string received, try to print it
-                b[res] = '\0';
-                safe_logger (spdlog::level::warn, "Received: {}", b);
-            }
-            continue;
+            exg_scales[i] = (double)(4.5 / float ((pow (2, 23) - 1)) /
+                gain_tracker.get_gain_for_channel (i) * 1000000.);
         }
-        else
+
+        int num_exg_packages = 0;
+        int num_aux_packages = 0;
+        // invalid transactions come in bursts, only the last one of the batch is printed
+        int num_invalid_transactions = 0;
+        int last_invalid_transaction = -1;
+        for (int cur_transaction = 0; cur_transaction < num_transactions; cur_transaction++)
         {
+            int res = transaction_sizes[cur_transaction];
+            unsigned char *transaction = b + cur_transaction * GaleaV4::max_transaction_size;
+            if ((res == 0) || (res % GaleaV4::package_size != 0))
+            {
+                if (res > 0)
+                {
+                    num_invalid_transactions++;
+                    last_invalid_transaction = cur_transaction;
+                }
+                continue;
+            }
+
             int num_packages = res / GaleaV4::package_size;
             int offset_last_package = GaleaV4::package_size * (num_packages - 1);
             // calc delta between PC timestamp and device timestamp in last 10 packages,
             // use this delta later on to assign timestamps
             double pc_timestamp = get_timestamp ();
             unsigned long long timestamp_last_package = 0.0;
-            memcpy (&timestamp_last_package, b + 88 + offset_last_package,
+            memcpy (&timestamp_last_package, transaction + 88 + offset_last_package,
                 sizeof (unsigned long long)); // microseconds
             double timestamp_last_package_converted =
                 static_cast<double> (timestamp_last_package) / 1000000.0; // convert to seconds
@@ -438,102 +507,90 @@ void GaleaV4::read_thread ()
 
             for (int cur_package = 0; cur_package < num_packages; cur_package++)
             {
-                int offset = cur_package * GaleaV4::package_size;
-                // exg (default preset)
-                exg_package[board_descr["default"]["package_num_channel"].get<int> ()] =
-                    (double)b[0 + offset];
-                for (int i = 4, tmp_counter = 0; i < 28; i++, tmp_counter++)
+                const unsigned char *package = transaction + cur_package * GaleaV4::package_size;
+                int num_placeholders = track_package_num ((double)package[0], 8);
+                if (num_placeholders > 0)
                 {
-                    double exg_scale = (double)(4.5 / float ((pow (2, 23) - 1)) /
-                        gain_tracker.get_gain_for_channel (tmp_counter) * 1000000.);
-                    exg_package[i - 3] =
-                        exg_scale * (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
+                    // keep placeholders in order with packages collected so far
+                    push_packages (exg_packages, num_exg_packages);
+                    num_exg_packages = 0;
+                    push_placeholder_packages (num_placeholders);
                 }
-                unsigned long long timestamp_device = 0.0;
-                memcpy (&timestamp_device, b + 88 + offset,
+                // exg (default preset)
+                double *exg_package = exg_packages + num_exg_packages * num_exg_rows;
+                num_exg_packages++;
+                exg_package[exg_package_num_channel] = (double)package[0];
+                convert_int24_to_double (
+                    package + 5, exg_scales, exg_package + 1, num_exg_channels);
+                unsigned long long timestamp_device_raw = 0;
+                memcpy (&timestamp_device_raw, package + 88,
                     sizeof (unsigned long long)); // reports microseconds
+                double timestamp_device = static_cast<double> (timestamp_device_raw);
+                timestamp_device /= 1000000.0; // convert to seconds
 
-                double timestamp_device_converted = static_cast<double> (timestamp_device);
-                timestamp_device_converted /= 1000000.0; // convert to seconds
-
-                exg_package[board_descr["default"]["timestamp_channel"].get<int> ()] =
-                    timestamp_device_converted + time_delta - half_rtt;
-                exg_package[board_descr["default"]["other_channels"][0].get<int> ()] = pc_timestamp;
-                exg_package[board_descr["default"]["other_channels"][1].get<int> ()] =
-                    timestamp_device_converted;
-                push_package (exg_package);
+                exg_package[exg_timestamp_channel] = timestamp_device + time_delta - half_rtt;
+                exg_package[exg_pc_timestamp_channel] = pc_timestamp;
+                exg_package[exg_device_timestamp_channel] = timestamp_device;
 
                 // aux, 5 times smaller sampling rate
-                if (((int)b[0 + offset]) % 5 == 0)
+                if (((int)package[0]) % 5 == 0)
                 {
-                    double accel_scale = (double)(8.0 / static_cast<double> (pow (2, 16) - 1));
-                    double gyro_scale = (double)(1000.0 / static_cast<double> (pow (2, 16) - 1));
-                    double magnetometer_scale_xy =
-                        (double)(2.6 / static_cast<double> (pow (2, 13) - 1));
-                    double magnetometer_scale_z =
-                        (double)(5.0 / static_cast<double> (pow (2, 15) - 1));
-                    aux_package[board_descr["auxiliary"]["package_num_channel"].get<int> ()] =
-                        (double)b[0 + offset];
+                    double *aux_package = aux_packages + num_aux_packages * num_aux_rows;
+                    num_aux_packages++;
+                    aux_package[aux_package_num_channel] = (double)package[0];
                     uint16_t temperature = 0;
                     int32_t ppg_ir = 0;
                     int32_t ppg_red = 0;
                     float eda;
-                    memcpy (&temperature, b + 78 + offset, 2);
-                    memcpy (&eda, b + 1 + offset, 4);
-                    memcpy (&ppg_red, b + 80 + offset, 4);
-                    memcpy (&ppg_ir, b + 84 + offset, 4);
+                    memcpy (&temperature, package + 78, 2);
+                    memcpy (&eda, package + 1, 4);
+                    memcpy (&ppg_red, package + 80, 4);
+                    memcpy (&ppg_ir, package + 84, 4);
                     // ppg
-                    aux_package[board_descr["auxiliary"]["ppg_channels"][0].get<int> ()] =
-                        (double)ppg_red;
-                    aux_package[board_descr["auxiliary"]["ppg_channels"][1].get<int> ()] =
-                        (double)ppg_ir;
+                    aux_package[ppg_red_channel] = (double)ppg_red;
+                    aux_package[ppg_ir_channel] = (double)ppg_ir;
                     // eda
-                    aux_package[board_descr["auxiliary"]["eda_channels"][0].get<int> ()] =
-                        (double)eda;
+                    aux_package[eda_channel] = (double)eda;
                     // temperature
-                    aux_package[board_descr["auxiliary"]["temperature_channels"][0].get<int> ()] =
-                        temperature / 100.0;
+                    aux_package[temperature_channel] = temperature / 100.0;
                     // battery
-                    aux_package[board_descr["auxiliary"]["battery_channel"].get<int> ()] =
-                        (double)b[77 + offset];
-                    aux_package[board_descr["auxiliary"]["timestamp_channel"].get<int> ()] =
-                        timestamp_device_converted + time_delta - half_rtt;
-                    aux_package[board_descr["auxiliary"]["other_channels"][0].get<int> ()] =
-                        pc_timestamp;
-                    aux_package[board_descr["auxiliary"]["other_channels"][1].get<int> ()] =
-                        timestamp_device_converted;
-                    // accel
-                    aux_package[board_descr["auxiliary"]["accel_channels"][0].get<int> ()] =
-                        accel_scale * (double)cast_16bit_to_int32_swap_order (b + 96 + offset);
-                    aux_package[board_descr["auxiliary"]["accel_channels"][1].get<int> ()] =
-                        accel_scale * (double)cast_16bit_to_int32_swap_order (b + 98 + offset);
-                    aux_package[board_descr["auxiliary"]["accel_channels"][2].get<int> ()] =
-                        accel_scale * (double)cast_16bit_to_int32_swap_order (b + 100 + offset);
-                    // gyro
-                    aux_package[board_descr["auxiliary"]["gyro_channels"][0].get<int> ()] =
-                        gyro_scale * (double)cast_16bit_to_int32_swap_order (b + 102 + offset);
-                    aux_package[board_descr["auxiliary"]["gyro_channels"][1].get<int> ()] =
-                        gyro_scale * (double)cast_16bit_to_int32_swap_order (b + 104 + offset);
-                    aux_package[board_descr["auxiliary"]["gyro_channels"][2].get<int> ()] =
-                        gyro_scale * (double)cast_16bit_to_int32_swap_order (b + 106 + offset);
-                    // magnetometer
-                    aux_package[board_descr["auxiliary"]["magnetometer_channels"][0].get<int> ()] =
-                        magnetometer_scale_xy *
-                        (double)cast_13bit_to_int32_swap_order (b + 108 + offset);
-                    aux_package[board_descr["auxiliary"]["magnetometer_channels"][1].get<int> ()] =
-                        magnetometer_scale_xy *
-                        (double)cast_13bit_to_int32_swap_order (b + 110 + offset);
-                    aux_package[board_descr["auxiliary"]["magnetometer_channels"][2].get<int> ()] =
-                        magnetometer_scale_z *
-                        (double)cast_15bit_to_int32_swap_order (b + 112 + offset);
-
-                    push_package (aux_package, (int)BrainFlowPresets::AUXILIARY_PRESET);
+                    aux_package[battery_channel] = (double)package[77];
+                    aux_package[aux_timestamp_channel] = timestamp_device + time_delta - half_rtt;
+                    aux_package[aux_pc_timestamp_channel] = pc_timestamp;
+                    aux_package[aux_device_timestamp_channel] = timestamp_device;
+                    // accel, gyro and magnetometer
+                    for (int i = 0; i < 3; i++)
+                    {
+                        aux_package[accel_channels[i]] = accel_scale *
+                            (double)cast_16bit_to_int32_swap_order (package + 96 + 2 * i);
+                        aux_package[gyro_channels[i]] = gyro_scale *
+                            (double)cast_16bit_to_int32_swap_order (package + 102 + 2 * i);
+                    }
+                    aux_package[magnetometer_channels[0]] = magnetometer_scale_xy *
+                        (double)cast_13bit_to_int32_swap_order (package + 108);
+                    aux_package[magnetometer_channels[1]] = magnetometer_scale_xy *
+                        (double)cast_13bit_to_int32_swap_order (package + 110);
+                    aux_package[magnetometer_channels[2]] = magnetometer_scale_z *
+                        (double)cast_15bit_to_int32_swap_order (package + 112);
                 }
             }
         }
+        push_packages (exg_packages, num_exg_packages);
+        push_packages (aux_packages, num_aux_packages, (int)BrainFlowPresets::AUXILIARY_PRESET);
+        if (num_invalid_transactions > 0)
+        {
+            // more likely its a string received, try to print it
+            const char *invalid_transaction =
+                (const char *)b + last_invalid_transaction * GaleaV4::max_transaction_size;
+            safe_logger (spdlog::level::warn, "Received: {}, invalid transactions in batch: {}",
+                std::string (invalid_transaction, transaction_sizes[last_invalid_transaction])
+                    .c_str (),
+                num_invalid_transactions);
+        }
     }
-    delete[] exg_package;
-    delete[] aux_package;
+    delete[] exg_packages;
+    delete[] aux_packages;
+    delete[] b;
 }
 
 int GaleaV4::calc_time (std::string &resp)
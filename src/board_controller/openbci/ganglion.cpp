@@ -10,6 +10,7 @@
 
 #include "custom_cast.h"
 #include "ganglion.h"
+#include "ganglion_decoder.h"
 #include "ganglion_types.h"
 #include "get_dll_dir.h"
 
@@ -374,183 +375,40 @@ void Ganglion::read_thread ()
 void Ganglion::decompress_firmware_3 (
     struct GanglionLib::GanglionData *data, float *last_data, double *acceleration, double *package)
 {
-    int bits_per_num = 0;
-    unsigned char package_bits[160] = {0}; // 20 * 8
-    for (int i = 0; i < 20; i++)
-    {
-        uchar_to_bits (data->data[i], package_bits + i * 8);
-    }
-
-    // 18 bit compression, sends 17 MSBs + sign bit of 24-bit sample
-    if (data->data[0] >= 0 && data->data[0] < 100)
-    {
-        int last_digit = data->data[0] % 10;
-        switch (last_digit)
-        {
-            // accel data is signed, so we must cast it to signed char
-            // swap x and z, and invert z to convert to standard coordinate space.
-            case 0:
-                acceleration[2] = -accel_scale * (char)data->data[19];
-                break;
-            case 1:
-                acceleration[1] = accel_scale * (char)data->data[19];
-                break;
-            case 2:
-                acceleration[0] = accel_scale * (char)data->data[19];
-                break;
-            default:
-                break;
-        }
-        bits_per_num = 18;
-    }
-    else if (data->data[0] >= 100 && data->data[0] < 200)
-    {
-        bits_per_num = 19;
-    }
-
-    // handle compressed data for 18 or 19 bits
-    for (int i = 8, counter = 0; i < bits_per_num * 8; i += bits_per_num, counter++)
-    {
-        if (bits_per_num == 18)
-        {
-            last_data[counter] = (float)(cast_ganglion_bits_to_int32<18> (package_bits + i) << 6);
-        }
-        else
-        {
-            last_data[counter] = (float)(cast_ganglion_bits_to_int32<19> (package_bits + i) << 5);
-        }
-    }
-
-    // add first encoded package
-    package[board_descr["default"]["package_num_channel"].get<int> ()] = data->data[0];
-    package[board_descr["default"]["eeg_channels"][0].get<int> ()] = eeg_scale * last_data[0];
-    package[board_descr["default"]["eeg_channels"][1].get<int> ()] = eeg_scale * last_data[1];
-    package[board_descr["default"]["eeg_channels"][2].get<int> ()] = eeg_scale * last_data[2];
-    package[board_descr["default"]["eeg_channels"][3].get<int> ()] = eeg_scale * last_data[3];
-    package[board_descr["default"]["accel_channels"][0].get<int> ()] = acceleration[0];
-    package[board_descr["default"]["accel_channels"][1].get<int> ()] = acceleration[1];
-    package[board_descr["default"]["accel_channels"][2].get<int> ()] = acceleration[2];
-    package[board_descr["default"]["timestamp_channel"].get<int> ()] = data->timestamp;
-    push_package (package);
-    // add second package
-    package[board_descr["default"]["eeg_channels"][0].get<int> ()] = eeg_scale * last_data[4];
-    package[board_descr["default"]["eeg_channels"][1].get<int> ()] = eeg_scale * last_data[5];
-    package[board_descr["default"]["eeg_channels"][2].get<int> ()] = eeg_scale * last_data[6];
-    package[board_descr["default"]["eeg_channels"][3].get<int> ()] = eeg_scale * last_data[7];
-    package[board_descr["default"]["timestamp_channel"].get<int> ()] = data->timestamp;
-    push_package (package);
+    int num_samples =
+        GanglionDecoder::decode_firmware_3 (data->data, last_data, acceleration, accel_scale);
+    push_decoded_samples (data, num_samples, last_data, acceleration, package);
 }
 
 void Ganglion::decompress_firmware_2 (
     struct GanglionLib::GanglionData *data, float *last_data, double *acceleration, double *package)
 {
-    int bits_per_num = 0;
-    unsigned char package_bits[160] = {0}; // 20 * 8
-    for (int i = 0; i < 20; i++)
-    {
-        uchar_to_bits (data->data[i], package_bits + i * 8);
-    }
-
-    float delta[8] = {0.f}; // delta holds 8 nums (4 by each package)
-
-    // no compression, used to init variable
-    if (data->data[0] == 0)
-    {
-        // shift the last data packet to make room for a newer one
-        last_data[0] = last_data[4];
-        last_data[1] = last_data[5];
-        last_data[2] = last_data[6];
-        last_data[3] = last_data[7];
-
-        // add new packet
-        last_data[4] = (float)cast_24bit_to_int32 (data->data + 1);
-        last_data[5] = (float)cast_24bit_to_int32 (data->data + 4);
-        last_data[6] = (float)cast_24bit_to_int32 (data->data + 7);
-        last_data[7] = (float)cast_24bit_to_int32 (data->data + 10);
-
-        // scale new packet and insert into result
-        package[board_descr["default"]["package_num_channel"].get<int> ()] = 0.;
-        package[board_descr["default"]["eeg_channels"][0].get<int> ()] = eeg_scale * last_data[4];
-        package[board_descr["default"]["eeg_channels"][1].get<int> ()] = eeg_scale * last_data[5];
-        package[board_descr["default"]["eeg_channels"][2].get<int> ()] = eeg_scale * last_data[6];
-        package[board_descr["default"]["eeg_channels"][3].get<int> ()] = eeg_scale * last_data[7];
-        package[board_descr["default"]["accel_channels"][0].get<int> ()] = acceleration[0];
-        package[board_descr["default"]["accel_channels"][1].get<int> ()] = acceleration[1];
-        package[board_descr["default"]["accel_channels"][2].get<int> ()] = acceleration[2];
-        package[board_descr["default"]["timestamp_channel"].get<int> ()] = data->timestamp;
-        push_package (package);
-        return;
-    }
-    // 18 bit compression, sends delta from previous value instead of real value!
-    else if (data->data[0] >= 1 && data->data[0] <= 100)
-    {
-        int last_digit = data->data[0] % 10;
-        switch (last_digit)
-        {
-            // accel data is signed, so we must cast it to signed char
-            // swap x and z, and invert z to convert to standard coordinate space.
-            case 0:
-                acceleration[2] = -accel_scale * (char)data->data[19];
-                break;
-            case 1:
-                acceleration[1] = accel_scale * (char)data->data[19];
-                break;
-            case 2:
-                acceleration[0] = accel_scale * (char)data->data[19];
-                break;
-            default:
-                break;
-        }
-        bits_per_num = 18;
-    }
-    else if (data->data[0] >= 101 && data->data[0] <= 200)
+    int num_samples =
+        GanglionDecoder::decode_firmware_2 (data->data, last_data, acceleration, accel_scale);
+    push_decoded_samples (data, num_samples, last_data, acceleration, package);
+}
+
+void Ganglion::push_decoded_samples (struct GanglionLib::GanglionData *data, int num_samples,
+    const float *last_data, const double *acceleration, double *package)
+{
+    const json &default_preset = board_descr["default"];
+    const json &eeg_channels = default_preset["eeg_channels"];
+    const json &accel_channels = default_preset["accel_channels"];
+    // first package contains package num and accel data, second package reuses it
+    package[default_preset["package_num_channel"].get<int> ()] = data->data[0];
+    for (int i = 0; i < 3; i++)
     {
-        bits_per_num = 19;
+        package[accel_channels[i].get<int> ()] = acceleration[i];
     }
-
-    // handle compressed data for 18 or 19 bits
-    for (int i = 8, counter = 0; i < bits_per_num * 8; i += bits_per_num, counter++)
+    for (int sample = 8 - 4 * num_samples; sample < 8; sample += 4)
     {
-        if (bits_per_num == 18)
-        {
-            delta[counter] = (float)cast_ganglion_bits_to_int32<18> (package_bits + i);
-        }
-        else
+        for (int i = 0; i < 4; i++)
         {
-            delta[counter] = (float)cast_ganglion_bits_to_int32<19> (package_bits + i);
+            package[eeg_channels[i].get<int> ()] = eeg_scale * last_data[sample + i];
         }
+        package[default_preset["timestamp_channel"].get<int> ()] = data->timestamp;
+        push_package (package);
     }
-
-    // apply the first delta to the last data we got in the previous iteration
-    for (int i = 0; i < 4; i++)
-    {
-        last_data[i] = last_data[i + 4] - delta[i];
-    }
-
-    // apply the second delta to the previous packet which we just decompressed above
-    for (int i = 4; i < 8; i++)
-    {
-        last_data[i] = last_data[i - 4] - delta[i];
-    }
-
-    // add first encoded package
-    package[board_descr["default"]["package_num_channel"].get<int> ()] = data->data[0];
-    package[board_descr["default"]["eeg_channels"][0].get<int> ()] = eeg_scale * last_data[0];
-    package[board_descr["default"]["eeg_channels"][1].get<int> ()] = eeg_scale * last_data[1];
-    package[board_descr["default"]["eeg_channels"][2].get<int> ()] = eeg_scale * last_data[2];
-    package[board_descr["default"]["eeg_channels"][3].get<int> ()] = eeg_scale * last_data[3];
-    package[board_descr["default"]["accel_channels"][0].get<int> ()] = acceleration[0];
-    package[board_descr["default"]["accel_channels"][1].get<int> ()] = acceleration[1];
-    package[board_descr["default"]["accel_channels"][2].get<int> ()] = acceleration[2];
-    package[board_descr["default"]["timestamp_channel"].get<int> ()] = data->timestamp;
-    push_package (package);
-    // add second package
-    package[board_descr["default"]["eeg_channels"][0].get<int> ()] = eeg_scale * last_data[4];
-    package[board_descr["default"]["eeg_channels"][1].get<int> ()] = eeg_scale * last_data[5];
-    package[board_descr["default"]["eeg_channels"][2].get<int> ()] = eeg_scale * last_data[6];
-    package[board_descr["default"]["eeg_channels"][3].get<int> ()] = eeg_scale * last_data[7];
-    package[board_descr["default"]["timestamp_channel"].get<int> ()] = data->timestamp;
-    push_package (package);
 }
 
 int Ganglion::config_board (std::string config, std::string &response)
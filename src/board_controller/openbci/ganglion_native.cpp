@@ -1,9 +1,10 @@
+#include <algorithm>
 #include <string>
 
 #include "custom_cast.h"
+#include "ganglion_decoder.h"
 #include "ganglion_native.h"
 #include "get_dll_dir.h"
-#include "timestamp.h"
 
 
 #define GANGLION_WRITE_CHAR "2d30c083-f39f-4ce6-923f-3484ea480596"
@@ -30,13 +31,16 @@ static void ganglion_adapter_1_on_scan_found (
 static void ganglion_read_notifications (simpleble_peripheral_t handle, simpleble_uuid_t service,
     simpleble_uuid_t characteristic, const uint8_t *data, size_t size, void *board)
 {
-    ((GanglionNative *)(board))->read_data (service, characteristic, data, size);
+    ((GanglionNative *)(board))->enqueue_notification (0, data, size);
 }
 
 GanglionNative::GanglionNative (struct BrainFlowInputParams params)
     : BLELibBoard ((int)BoardIds::GANGLION_NATIVE_BOARD, params)
 {
     initialized = false;
+    // 20 byte packages with 2 samples each at 200 Hz
+    notification_queue_size = 512;
+    max_notification_size = 20;
     ganglion_adapter = NULL;
     ganglion_peripheral = NULL;
     is_streaming = false;
@@ -210,6 +214,7 @@ int GanglionNative::prepare_session ()
 
     if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (num_chars_found == 2))
     {
+        resolve_channels ();
         initialized = true;
     }
     else
@@ -232,8 +237,16 @@ int GanglionNative::start_stream (int buffer_size, const char *streamer_params)
     temp_data.reset (); // reset last data before streaming
     int res = prepare_for_acquisition (buffer_size, streamer_params);
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = start_notification_thread ();
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
         res = send_command (start_command);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            stop_notification_thread ();
+        }
     }
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
@@ -258,12 +271,14 @@ int GanglionNative::stop_stream ()
     {
         res = (int)BrainFlowExitCodes::STREAM_THREAD_IS_NOT_RUNNING;
     }
+    stop_notification_thread ();
     is_streaming = false;
     return res;
 }
 
 int GanglionNative::release_session ()
 {
+    stop_notification_thread ();
     if (initialized)
     {
         // repeat it multiple times, failure here may lead to a crash
@@ -474,8 +489,29 @@ void GanglionNative::adapter_1_on_scan_found (
     }
 }
 
-void GanglionNative::read_data (
-    simpleble_uuid_t service, simpleble_uuid_t characteristic, const uint8_t *data, size_t size)
+void GanglionNative::resolve_channels ()
+{
+    const json &default_preset = board_descr["default"];
+    package.resize (default_preset["num_rows"].get<int> ());
+    std::fill (package.begin (), package.end (), 0.0);
+    for (int i = 0; i < 4; i++)
+    {
+        eeg_channels[i] = default_preset["eeg_channels"][i].get<int> ();
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        accel_channels[i] = default_preset["accel_channels"][i].get<int> ();
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        resistance_channels[i] = default_preset["resistance_channels"][i].get<int> ();
+    }
+    package_num_channel = default_preset["package_num_channel"].get<int> ();
+    timestamp_channel = default_preset["timestamp_channel"].get<int> ();
+}
+
+void GanglionNative::handle_notification (
+    int type, const uint8_t *data, size_t size, double timestamp)
 {
     if (size < 2)
     {
@@ -483,32 +519,25 @@ void GanglionNative::read_data (
         return;
     }
 
-    int num_rows = board_descr["default"]["num_rows"];
-    double *package = new double[num_rows];
-
-    for (int i = 0; i < num_rows; i++)
-    {
-        package[i] = 0.0;
-    }
+    std::fill (package.begin (), package.end (), 0.0);
 
     if (data[0] <= 200 && size == 20)
     {
         if (firmware == 3)
         {
-            decompress_firmware_3 (data, package);
+            decompress_firmware_3 (data, timestamp);
         }
         else if (firmware == 2)
         {
-            decompress_firmware_2 (data, package);
+            decompress_firmware_2 (data, timestamp);
         }
-        delete[] package;
     }
     else if ((data[0] > 200) && (data[0] < 206))
     {
         // ASCII string with value and 'Z' in the end
         int val = 0;
         int i = 0;
-        for (i = 1; i < 6; i++)
+        for (i = 1; i < std::min (6, (int)size); i++)
         {
             if (data[i] == 'Z')
             {
@@ -525,7 +554,6 @@ void GanglionNative::read_data (
         {
             safe_logger (
                 spdlog::level::err, "failed to parse impedance data: {}", ascii_value.c_str ());
-            delete[] package;
             return;
         }
 
@@ -549,231 +577,53 @@ void GanglionNative::read_data (
             default:
                 break;
         }
-        package[board_descr["default"]["package_num_channel"].get<int> ()] = data[0];
-        package[board_descr["default"]["resistance_channels"][0].get<int> ()] =
-            temp_data.resist_first;
-        package[board_descr["default"]["resistance_channels"][1].get<int> ()] =
-            temp_data.resist_second;
-        package[board_descr["default"]["resistance_channels"][2].get<int> ()] =
-            temp_data.resist_third;
-        package[board_descr["default"]["resistance_channels"][3].get<int> ()] =
-            temp_data.resist_fourth;
-        package[board_descr["default"]["resistance_channels"][4].get<int> ()] =
-            temp_data.resist_ref;
-        package[board_descr["default"]["timestamp_channel"].get<int> ()] = get_timestamp ();
-        push_package (package);
-        delete[] package;
-        return;
+        package[package_num_channel] = data[0];
+        package[resistance_channels[0]] = temp_data.resist_first;
+        package[resistance_channels[1]] = temp_data.resist_second;
+        package[resistance_channels[2]] = temp_data.resist_third;
+        package[resistance_channels[3]] = temp_data.resist_fourth;
+        package[resistance_channels[4]] = temp_data.resist_ref;
+        package[timestamp_channel] = timestamp;
+        push_package (package.data ());
     }
     else
     {
-        for (int i = 0; i < 20; i++)
+        for (size_t i = 0; i < size; i++)
         {
             safe_logger (spdlog::level::warn, "byte {} value {}", i, data[i]);
         }
-        delete[] package;
-        return;
     }
 }
 
-void GanglionNative::decompress_firmware_3 (const uint8_t *data, double *package)
+void GanglionNative::decompress_firmware_3 (const uint8_t *data, double timestamp)
 {
-    int bits_per_num = 0;
-    unsigned char package_bits[160] = {0}; // 20 * 8
-    for (int i = 0; i < 20; i++)
-    {
-        uchar_to_bits (data[i], package_bits + i * 8);
-    }
-
-    // 18 bit compression, sends 17 MSBs + sign bit of 24-bit sample
-    if (data[0] >= 0 && data[0] < 100)
-    {
-        int last_digit = data[0] % 10;
-        switch (last_digit)
-        {
-            // accel data is signed, so we must cast it to signed char
-            // swap x and z, and invert z to convert to standard coordinate space.
-            case 0:
-                temp_data.accel_z = -accel_scale * (char)data[19];
-                break;
-            case 1:
-                temp_data.accel_y = accel_scale * (char)data[19];
-                break;
-            case 2:
-                temp_data.accel_x = accel_scale * (char)data[19];
-                break;
-            default:
-                break;
-        }
-        bits_per_num = 18;
-    }
-    else if (data[0] >= 100 && data[0] < 200)
-    {
-        bits_per_num = 19;
-    }
-
-    // handle compressed data for 18 or 19 bits
-    for (int i = 8, counter = 0; i < bits_per_num * 8; i += bits_per_num, counter++)
-    {
-        if (bits_per_num == 18)
-        {
-            temp_data.last_data[counter] =
-                (float)(cast_ganglion_bits_to_int32<18> (package_bits + i) << 6);
-        }
-        else
-        {
-            temp_data.last_data[counter] =
-                (float)(cast_ganglion_bits_to_int32<19> (package_bits + i) << 5);
-        }
-    }
+    int num_samples = GanglionDecoder::decode_firmware_3 (
+        data, temp_data.last_data, temp_data.accel, accel_scale);
+    push_decoded_samples (data, num_samples, timestamp);
+}
 
-    // add first encoded package
-    package[board_descr["default"]["package_num_channel"].get<int> ()] = data[0];
-    package[board_descr["default"]["eeg_channels"][0].get<int> ()] =
-        eeg_scale * temp_data.last_data[0];
-    package[board_descr["default"]["eeg_channels"][1].get<int> ()] =
-        eeg_scale * temp_data.last_data[1];
-    package[board_descr["default"]["eeg_channels"][2].get<int> ()] =
-        eeg_scale * temp_data.last_data[2];
-    package[board_descr["default"]["eeg_channels"][3].get<int> ()] =
-        eeg_scale * temp_data.last_data[3];
-    package[board_descr["default"]["accel_channels"][0].get<int> ()] = temp_data.accel_x;
-    package[board_descr["default"]["accel_channels"][1].get<int> ()] = temp_data.accel_y;
-    package[board_descr["default"]["accel_channels"][2].get<int> ()] = temp_data.accel_z;
-    package[board_descr["default"]["timestamp_channel"].get<int> ()] = get_timestamp ();
-    push_package (package);
-    // add second package
-    package[board_descr["default"]["eeg_channels"][0].get<int> ()] =
-        eeg_scale * temp_data.last_data[4];
-    package[board_descr["default"]["eeg_channels"][1].get<int> ()] =
-        eeg_scale * temp_data.last_data[5];
-    package[board_descr["default"]["eeg_channels"][2].get<int> ()] =
-        eeg_scale * temp_data.last_data[6];
-    package[board_descr["default"]["eeg_channels"][3].get<int> ()] =
-        eeg_scale * temp_data.last_data[7];
-    package[board_descr["default"]["timestamp_channel"].get<int> ()] = get_timestamp ();
-    push_package (package);
+void GanglionNative::decompress_firmware_2 (const uint8_t *data, double timestamp)
+{
+    int num_samples = GanglionDecoder::decode_firmware_2 (
+        data, temp_data.last_data, temp_data.accel, accel_scale);
+    push_decoded_samples (data, num_samples, timestamp);
 }
 
-void GanglionNative::decompress_firmware_2 (const uint8_t *data, double *package)
+void GanglionNative::push_decoded_samples (const uint8_t *data, int num_samples, double timestamp)
 {
-    int bits_per_num = 0;
-    unsigned char package_bits[160] = {0}; // 20 * 8
-    for (int i = 0; i < 20; i++)
-    {
-        uchar_to_bits (data[i], package_bits + i * 8);
-    }
-
-    float delta[8] = {0.f}; // delta holds 8 nums (4 by each package)
-
-    // no compression, used to init variable
-    if (data[0] == 0)
-    {
-        // shift the last data packet to make room for a newer one
-        temp_data.last_data[0] = temp_data.last_data[4];
-        temp_data.last_data[1] = temp_data.last_data[5];
-        temp_data.last_data[2] = temp_data.last_data[6];
-        temp_data.last_data[3] = temp_data.last_data[7];
-
-        // add new packet
-        temp_data.last_data[4] = (float)cast_24bit_to_int32 (data + 1);
-        temp_data.last_data[5] = (float)cast_24bit_to_int32 (data + 4);
-        temp_data.last_data[6] = (float)cast_24bit_to_int32 (data + 7);
-        temp_data.last_data[7] = (float)cast_24bit_to_int32 (data + 10);
-
-        // scale new packet and insert into result
-        package[board_descr["default"]["package_num_channel"].get<int> ()] = 0.;
-        package[board_descr["default"]["eeg_channels"][0].get<int> ()] =
-            eeg_scale * temp_data.last_data[4];
-        package[board_descr["default"]["eeg_channels"][1].get<int> ()] =
-            eeg_scale * temp_data.last_data[5];
-        package[board_descr["default"]["eeg_channels"][2].get<int> ()] =
-            eeg_scale * temp_data.last_data[6];
-        package[board_descr["default"]["eeg_channels"][3].get<int> ()] =
-            eeg_scale * temp_data.last_data[7];
-        package[board_descr["default"]["accel_channels"][0].get<int> ()] = temp_data.accel_x;
-        package[board_descr["default"]["accel_channels"][1].get<int> ()] = temp_data.accel_y;
-        package[board_descr["default"]["accel_channels"][2].get<int> ()] = temp_data.accel_z;
-        package[board_descr["default"]["timestamp_channel"].get<int> ()] = get_timestamp ();
-        push_package (package);
-        return;
-    }
-    // 18 bit compression, sends delta from previous value instead of real value!
-    if (data[0] >= 1 && data[0] <= 100)
+    // first package contains package num and accel data, second package reuses it
+    package[package_num_channel] = data[0];
+    for (int i = 0; i < 3; i++)
     {
-        int last_digit = data[0] % 10;
-        switch (last_digit)
-        {
-            // accel data is signed, so we must cast it to signed char
-            // swap x and z, and invert z to convert to standard coordinate space.
-            case 0:
-                temp_data.accel_z = -accel_scale * (char)data[19];
-                break;
-            case 1:
-                temp_data.accel_y = accel_scale * (char)data[19];
-                break;
-            case 2:
-                temp_data.accel_x = accel_scale * (char)data[19];
-                break;
-            default:
-                break;
-        }
-        bits_per_num = 18;
-    }
-    else if (data[0] >= 101 && data[0] <= 200)
-    {
-        bits_per_num = 19;
+        package[accel_channels[i]] = temp_data.accel[i];
     }
-
-    // handle compressed data for 18 or 19 bits
-    for (int i = 8, counter = 0; i < bits_per_num * 8; i += bits_per_num, counter++)
+    for (int sample = 8 - 4 * num_samples; sample < 8; sample += 4)
     {
-        if (bits_per_num == 18)
-        {
-            delta[counter] = (float)cast_ganglion_bits_to_int32<18> (package_bits + i);
-        }
-        else
+        for (int i = 0; i < 4; i++)
         {
-            delta[counter] = (float)cast_ganglion_bits_to_int32<19> (package_bits + i);
+            package[eeg_channels[i]] = eeg_scale * temp_data.last_data[sample + i];
         }
+        package[timestamp_channel] = timestamp;
+        push_package (package.data ());
     }
-
-    // apply the first delta to the last data we got in the previous iteration
-    for (int i = 0; i < 4; i++)
-    {
-        temp_data.last_data[i] = temp_data.last_data[i + 4] - delta[i];
-    }
-
-    // apply the second delta to the previous packet which we just decompressed above
-    for (int i = 4; i < 8; i++)
-    {
-        temp_data.last_data[i] = temp_data.last_data[i - 4] - delta[i];
-    }
-
-    // add first encoded package
-    package[board_descr["default"]["package_num_channel"].get<int> ()] = data[0];
-    package[board_descr["default"]["eeg_channels"][0].get<int> ()] =
-        eeg_scale * temp_data.last_data[0];
-    package[board_descr["default"]["eeg_channels"][1].get<int> ()] =
-        eeg_scale * temp_data.last_data[1];
-    package[board_descr["default"]["eeg_channels"][2].get<int> ()] =
-        eeg_scale * temp_data.last_data[2];
-    package[board_descr["default"]["eeg_channels"][3].get<int> ()] =
-        eeg_scale * temp_data.last_data[3];
-    package[board_descr["default"]["accel_channels"][0].get<int> ()] = temp_data.accel_x;
-    package[board_descr["default"]["accel_channels"][1].get<int> ()] = temp_data.accel_y;
-    package[board_descr["default"]["accel_channels"][2].get<int> ()] = temp_data.accel_z;
-    package[board_descr["default"]["timestamp_channel"].get<int> ()] = get_timestamp ();
-    push_package (package);
-    // add second package
-    package[board_descr["default"]["eeg_channels"][0].get<int> ()] =
-        eeg_scale * temp_data.last_data[4];
-    package[board_descr["default"]["eeg_channels"][1].get<int> ()] =
-        eeg_scale * temp_data.last_data[5];
-    package[board_descr["default"]["eeg_channels"][2].get<int> ()] =
-        eeg_scale * temp_data.last_data[6];
-    package[board_descr["default"]["eeg_channels"][3].get<int> ()] =
-        eeg_scale * temp_data.last_data[7];
-    package[board_descr["default"]["timestamp_channel"].get<int> ()] = get_timestamp ();
-    push_package (package);
-}
\ No newline at end of file
+}
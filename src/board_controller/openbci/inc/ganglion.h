@@ -67,4 +67,6 @@ public:
         double *acceleration, double *package);
     void decompress_firmware_2 (struct GanglionLib::GanglionData *data, float *last_data,
         double *acceleration, double *package);
+    void push_decoded_samples (struct GanglionLib::GanglionData *data, int num_samples,
+        const float *last_data, const double *acceleration, double *package);
 };
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "custom_cast.h"
+
+// shared by Ganglion and GanglionNative
+// https://docs.openbci.com/Hardware/08-Ganglion_Data_Format
+// each 20 bytes package contains package id and 2 samples for 4 eeg channels, decoders write them
+// into last_data and return number of new samples, they are stored in the tail of last_data:
+// last_data[8 - 4 * num_samples] ... last_data[7]
+class GanglionDecoder
+{
+public:
+    static const int package_size = 20;
+
+    // firmware 3: 18 bit compression sends 17 MSBs + sign bit of 24-bit sample, no deltas
+    static int decode_firmware_3 (
+        const unsigned char *data, float *last_data, double *acceleration, double accel_scale)
+    {
+        if (data[0] < 100)
+        {
+            update_acceleration (data, acceleration, accel_scale);
+            int32_t values[8];
+            unpack_values<18> (data, values);
+            for (int i = 0; i < 8; i++)
+            {
+                last_data[i] = (float)(values[i] << 6);
+            }
+        }
+        else if (data[0] < 200)
+        {
+            int32_t values[8];
+            unpack_values<19> (data, values);
+            for (int i = 0; i < 8; i++)
+            {
+                last_data[i] = (float)(values[i] << 5);
+            }
+        }
+        return 2;
+    }
+
+    // firmware 2: package 0 is uncompressed and used to init, others send deltas
+    static int decode_firmware_2 (
+        const unsigned char *data, float *last_data, double *acceleration, double accel_scale)
+    {
+        if (data[0] == 0)
+        {
+            // shift the last data packet to make room for a newer one
+            for (int i = 0; i < 4; i++)
+            {
+                last_data[i] = last_data[i + 4];
+                last_data[i + 4] = (float)cast_24bit_to_int32 (data + 1 + i * 3);
+            }
+            return 1;
+        }
+
+        int32_t values[8] = {0};
+        if (data[0] <= 100)
+        {
+            update_acceleration (data, acceleration, accel_scale);
+            unpack_values<18> (data, values);
+        }
+        else if (data[0] <= 200)
+        {
+            unpack_values<19> (data, values);
+        }
+
+        // apply the first delta to the last data we got in the previous iteration and the second
+        // delta to the sample we just decompressed
+        for (int i = 0; i < 4; i++)
+        {
+            last_data[i] = last_data[i + 4] - (float)values[i];
+            last_data[i + 4] = last_data[i] - (float)values[i + 4];
+        }
+        return 2;
+    }
+
+private:
+    template <unsigned int N>
+    static void unpack_values (const unsigned char *data, int32_t *values)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            values[i] = cast_ganglion_packed_bits_to_int32<N> (data, 8 + i * (int)N);
+        }
+    }
+
+    static void update_acceleration (
+        const unsigned char *data, double *acceleration, double accel_scale)
+    {
+        // accel data is signed, so we must cast it to signed char
+        // swap x and z, and invert z to convert to standard coordinate space.
+        switch (data[0] % 10)
+        {
+            case 0:
+                acceleration[2] = -accel_scale * (char)data[19];
+                break;
+            case 1:
+                acceleration[1] = accel_scale * (char)data[19];
+                break;
+            case 2:
+                acceleration[0] = accel_scale * (char)data[19];
+                break;
+            default:
+                break;
+        }
+    }
+};
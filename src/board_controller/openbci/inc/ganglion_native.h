@@ -1,6 +1,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "ble_lib_board.h"
 #include "board.h"
@@ -10,9 +11,7 @@ struct GanglionTempData
 {
     float last_data[8];
 
-    double accel_x;
-    double accel_y;
-    double accel_z;
+    double accel[3]; // x, y, z
 
     double resist_ref;
     double resist_first;
@@ -23,9 +22,7 @@ struct GanglionTempData
     GanglionTempData ()
     {
         memset (last_data, 0, sizeof (float) * 8);
-        accel_x = 0.0;
-        accel_y = 0.0;
-        accel_z = 0.0;
+        memset (accel, 0, sizeof (double) * 3);
         resist_ref = 0.0;
         resist_first = 0.0;
         resist_second = 0.0;
@@ -36,9 +33,7 @@ struct GanglionTempData
     GanglionTempData (const GanglionTempData &other)
     {
         memcpy (last_data, other.last_data, sizeof (float) * 8);
-        accel_x = other.accel_x;
-        accel_y = other.accel_y;
-        accel_z = other.accel_z;
+        memcpy (accel, other.accel, sizeof (double) * 3);
         resist_ref = other.resist_ref;
         resist_first = other.resist_first;
         resist_second = other.resist_second;
@@ -52,9 +47,7 @@ struct GanglionTempData
             return *this;
 
         memcpy (last_data, other.last_data, sizeof (float) * 8);
-        accel_x = other.accel_x;
-        accel_y = other.accel_y;
-        accel_z = other.accel_z;
+        memcpy (accel, other.accel, sizeof (double) * 3);
         resist_ref = other.resist_ref;
         resist_first = other.resist_first;
         resist_second = other.resist_second;
@@ -67,9 +60,7 @@ struct GanglionTempData
     void reset ()
     {
         memset (last_data, 0, sizeof (float) * 8);
-        accel_x = 0.0;
-        accel_y = 0.0;
-        accel_z = 0.0;
+        memset (accel, 0, sizeof (double) * 3);
         resist_ref = 0.0;
         resist_first = 0.0;
         resist_second = 0.0;
@@ -95,8 +86,6 @@ public:
     void adapter_1_on_scan_start (simpleble_adapter_t adapter);
     void adapter_1_on_scan_stop (simpleble_adapter_t adapter);
     void adapter_1_on_scan_found (simpleble_adapter_t adapter, simpleble_peripheral_t peripheral);
-    void read_data (simpleble_uuid_t service, simpleble_uuid_t characteristic, const uint8_t *data,
-        size_t size);
 
 protected:
     volatile simpleble_adapter_t ganglion_adapter;
@@ -111,10 +100,20 @@ protected:
     std::string start_command;
     std::string stop_command;
     struct GanglionTempData temp_data;
+    // channel indices are resolved once in prepare_session
+    std::vector<double> package;
+    int eeg_channels[4];
+    int accel_channels[3];
+    int resistance_channels[5];
+    int package_num_channel;
+    int timestamp_channel;
 
     double const accel_scale = 0.016f;
     double const eeg_scale = (1.2f * 1000000) / (8388607.0f * 1.5f * 51.0f);
 
-    void decompress_firmware_3 (const uint8_t *data, double *package);
-    void decompress_firmware_2 (const uint8_t *data, double *package);
+    void resolve_channels ();
+    void handle_notification (int type, const uint8_t *data, size_t size, double timestamp);
+    void decompress_firmware_3 (const uint8_t *data, double timestamp);
+    void decompress_firmware_2 (const uint8_t *data, double timestamp);
+    void push_decoded_samples (const uint8_t *data, int num_samples, double timestamp);
 };
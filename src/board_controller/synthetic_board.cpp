@@ -4,28 +4,29 @@
 #include <random>
 #include <string.h>
 #include <string>
+#include <thread>
 #include <vector>
 
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <unistd.h>
-#endif
-
 #include "synthetic_board.h"
 #include "timestamp.h"
+#include "uniform_noise.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
 
-SyntheticBoard::SyntheticBoard (struct BrainFlowInputParams params)
-    : Board ((int)BoardIds::SYNTHETIC_BOARD, params)
+SyntheticBoard::SyntheticBoard (int board_id, struct BrainFlowInputParams params)
+    : Board (board_id, params)
 {
     is_streaming = false;
     keep_alive = false;
     initialized = false;
+    load_mode = false;
+    load_num_channels = 0;
+    load_sampling_rate = 0;
+    load_batch_size = 1;
+    load_profile = (int)SyntheticProfiles::EEG;
 }
 
 SyntheticBoard::~SyntheticBoard ()
@@ -42,6 +43,23 @@ int SyntheticBoard::prepare_session ()
         return (int)BrainFlowExitCodes::STATUS_OK;
     }
 
+    // layout of previous session may be changed by load config
+    reset_layout ();
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    if ((!params.other_info.empty ()) && (params.other_info[0] == '{'))
+    {
+        res = parse_load_config (params.other_info);
+    }
+    else if (board_id == (int)BoardIds::SYNTHETIC_LOAD_BOARD)
+    {
+        // this board has no regular mode
+        res = parse_load_config ("{}");
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+
     initialized = true;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -61,7 +79,14 @@ int SyntheticBoard::start_stream (int buffer_size, const char *streamer_params)
     }
 
     keep_alive = true;
-    streaming_thread = std::thread ([this] { this->read_thread (); });
+    if (load_mode)
+    {
+        streaming_thread = std::thread ([this] { this->read_thread_load (); });
+    }
+    else
+    {
+        streaming_thread = std::thread ([this] { this->read_thread (); });
+    }
     is_streaming = true;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -92,49 +117,111 @@ int SyntheticBoard::release_session ()
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+// channels are resolved once before streaming, json lookups are too slow for the data loop
+struct SyntheticSensorChannels
+{
+    std::vector<int> accel_channels;
+    std::vector<int> gyro_channels;
+    std::vector<int> eda_channels;
+    std::vector<int> ppg_channels;
+    std::vector<int> temperature_channels;
+    std::vector<int> resistance_channels;
+    int battery_channel;
+    int timestamp_channel;
+    int package_num_channel;
+
+    SyntheticSensorChannels (const json &preset)
+    {
+        accel_channels = preset.value ("accel_channels", std::vector<int> ());
+        gyro_channels = preset.value ("gyro_channels", std::vector<int> ());
+        eda_channels = preset.value ("eda_channels", std::vector<int> ());
+        ppg_channels = preset.value ("ppg_channels", std::vector<int> ());
+        temperature_channels = preset.value ("temperature_channels", std::vector<int> ());
+        resistance_channels = preset.value ("resistance_channels", std::vector<int> ());
+        battery_channel = preset["battery_channel"];
+        timestamp_channel = preset["timestamp_channel"];
+        package_num_channel = preset["package_num_channel"];
+    }
+
+    void fill (double *package, std::uniform_real_distribution<double> &dist_around_one,
+        std::mt19937 &mt) const
+    {
+        for (int channel : accel_channels)
+        {
+            package[channel] = dist_around_one (mt) - 0.1;
+        }
+        for (int channel : gyro_channels)
+        {
+            package[channel] = dist_around_one (mt) - 0.1;
+        }
+        for (int channel : eda_channels)
+        {
+            package[channel] = dist_around_one (mt);
+        }
+        for (size_t chan_num = 0; chan_num < ppg_channels.size (); chan_num++)
+        {
+            if (chan_num == 0)
+            {
+                package[ppg_channels[chan_num]] = 500.0 * dist_around_one (mt);
+            }
+            else
+            {
+                package[ppg_channels[chan_num]] = 253500.0 * dist_around_one (mt);
+            }
+        }
+        for (int channel : temperature_channels)
+        {
+            package[channel] = dist_around_one (mt) / 10.0 + 36.5;
+        }
+        for (int channel : resistance_channels)
+        {
+            package[channel] = 1000.0 * dist_around_one (mt);
+        }
+        package[battery_channel] = (dist_around_one (mt) - 0.1) * 100;
+    }
+};
+
 void SyntheticBoard::read_thread ()
 {
     unsigned char counter = 0;
     std::vector<int> exg_channels =
         board_descr["default"]["eeg_channels"]; // same channels for eeg\emg\ecg
-    double *sin_phase_rad = new double[exg_channels.size ()];
-    for (unsigned int i = 0; i < board_descr["default"]["eeg_channels"].size (); i++)
-    {
-        sin_phase_rad[i] = 0.0;
-    }
+    std::vector<int> other_channels =
+        board_descr["auxiliary"].value ("other_channels", std::vector<int> ());
+    SyntheticSensorChannels default_channels (board_descr["default"]);
+    SyntheticSensorChannels aux_channels (board_descr["auxiliary"]);
     int sampling_rate = board_descr["default"]["sampling_rate"];
-    int sleep_time = (int)((1000.0 / sampling_rate));
     std::uniform_real_distribution<double> dist_around_one (0.90, 1.10);
     uint64_t seed = std::chrono::high_resolution_clock::now ().time_since_epoch ().count ();
     std::mt19937 mt (static_cast<uint32_t> (seed));
-    double accumulated_time_delta = 0.0;
 
-    int num_rows = board_descr["default"]["num_rows"];
-    double *package = new double[num_rows];
-    for (int i = 0; i < num_rows; i++)
+    std::vector<double> sin_phase_rad (exg_channels.size (), 0.0);
+    std::vector<std::uniform_real_distribution<double>> noise_dists;
+    for (size_t i = 0; i < exg_channels.size (); i++)
     {
-        package[i] = 0.0;
+        double range = (10.0 * (i + 1) * 0.1 * (i + 1)) / 2.0;
+        noise_dists.push_back (std::uniform_real_distribution<double> (0 - range, range));
     }
+
+    int num_rows = board_descr["default"]["num_rows"];
+    std::vector<double> package (num_rows, 0.0);
     int num_aux_rows = board_descr["auxiliary"]["num_rows"];
-    double *aux_package = new double[num_aux_rows];
-    for (int i = 0; i < num_aux_rows; i++)
-    {
-        aux_package[i] = 0.0;
-    }
+    std::vector<double> aux_package (num_aux_rows, 0.0);
+
+    // deadline based pacing, sleep errors don't accumulate and rate is not rounded to milliseconds
+    const std::chrono::duration<double> period (1.0 / sampling_rate);
+    auto start = std::chrono::steady_clock::now ();
+    int64_t num_packages = 0;
 
     while (keep_alive)
     {
-        auto start = std::chrono::high_resolution_clock::now ();
-        package[board_descr["default"]["package_num_channel"].get<int> ()] = (double)counter;
+        package[default_channels.package_num_channel] = (double)counter;
         for (unsigned int i = 0; i < exg_channels.size (); i++)
         {
             double amplitude = 10.0 * (i + 1);
-            double noise = 0.1 * (i + 1);
             double freq = 5.0 * (i + 1);
             int peak_frequency = (int)(sampling_rate / (i + 1));
             double shift = 0.05 * i;
-            double range = (amplitude * noise) / 2.0;
-            std::uniform_real_distribution<double> dist (0 - range, range);
             sin_phase_rad[i] += 2.0f * M_PI * freq / (double)sampling_rate;
             if (sin_phase_rad[i] > 2.0f * M_PI)
             {
@@ -146,115 +233,234 @@ void SyntheticBoard::read_thread ()
             {
                 amplitude *= dist_around_one (mt) * 2;
             }
-            package[exg_channels[i]] =
-                amplitude + (amplitude + dist (mt)) * sqrt (2.0) * sin (sin_phase_rad[i] + shift);
-        }
-        for (int channel : board_descr["default"]["accel_channels"])
-        {
-            package[channel] = dist_around_one (mt) - 0.1;
-        }
-        for (int channel : board_descr["default"]["gyro_channels"])
-        {
-            package[channel] = dist_around_one (mt) - 0.1;
-        }
-        for (int channel : board_descr["default"]["eda_channels"])
-        {
-            package[channel] = dist_around_one (mt);
-        }
-        for (int chan_num = 0; chan_num < (int)board_descr["default"]["ppg_channels"].size ();
-             chan_num++)
-        {
-            int channel = board_descr["default"]["ppg_channels"][chan_num];
-            if (chan_num == 0)
-            {
-                package[channel] = 500.0 * dist_around_one (mt);
-            }
-            else
-            {
-                package[channel] = 253500.0 * dist_around_one (mt);
-            }
+            package[exg_channels[i]] = amplitude +
+                (amplitude + noise_dists[i](mt)) * sqrt (2.0) * sin (sin_phase_rad[i] + shift);
         }
-        for (int channel : board_descr["default"]["temperature_channels"])
-        {
-            package[channel] = dist_around_one (mt) / 10.0 + 36.5;
-        }
-        for (int channel : board_descr["default"]["resistance_channels"])
-        {
-            package[channel] = 1000.0 * dist_around_one (mt);
-        }
-        package[board_descr["default"]["battery_channel"].get<int> ()] =
-            (dist_around_one (mt) - 0.1) * 100;
-        package[board_descr["default"]["timestamp_channel"].get<int> ()] = get_timestamp ();
+        default_channels.fill (package.data (), dist_around_one, mt);
+        package[default_channels.timestamp_channel] = get_timestamp ();
 
-        push_package (package); // use this method to submit data to buffers
+        push_package (package.data ()); // use this method to submit data to buffers
 
         // push aux package
-        for (int channel : board_descr["auxiliary"]["other_channels"])
+        for (int channel : other_channels)
         {
             aux_package[channel] = (double)channel;
         }
-        aux_package[board_descr["auxiliary"]["timestamp_channel"].get<int> ()] = get_timestamp ();
-        aux_package[board_descr["auxiliary"]["package_num_channel"].get<int> ()] = (double)counter;
-        aux_package[board_descr["auxiliary"]["battery_channel"].get<int> ()] =
-            (dist_around_one (mt) - 0.1) * 100;
-        for (int channel : board_descr["auxiliary"]["accel_channels"])
-        {
-            aux_package[channel] = dist_around_one (mt) - 0.1;
-        }
-        for (int channel : board_descr["auxiliary"]["gyro_channels"])
+        aux_package[aux_channels.timestamp_channel] = get_timestamp ();
+        aux_package[aux_channels.package_num_channel] = (double)counter;
+        aux_channels.fill (aux_package.data (), dist_around_one, mt);
+
+        push_package (aux_package.data (), (int)BrainFlowPresets::AUXILIARY_PRESET);
+
+        counter++;
+        num_packages++;
+        std::this_thread::sleep_until (
+            start +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration> (
+                period * (double)num_packages));
+    }
+}
+
+void SyntheticBoard::read_thread_load ()
+{
+    const int num_channels = load_num_channels;
+    const int num_rows = board_descr["default"]["num_rows"];
+    const int timestamp_channel = board_descr["default"]["timestamp_channel"];
+    const int batch_size = load_batch_size;
+    const double sampling_rate = (double)load_sampling_rate;
+
+    // sine is read from a table by 32 bit phase accumulator, upper bits are table index
+    const int table_bits = 12;
+    std::vector<double> sine_table (1 << table_bits);
+    for (size_t i = 0; i < sine_table.size (); i++)
+    {
+        sine_table[i] = sin (2.0 * M_PI * (double)i / (double)sine_table.size ());
+    }
+    std::vector<uint32_t> phases (num_channels, 0);
+    std::vector<uint32_t> phase_steps (num_channels);
+    std::vector<double> amplitudes (num_channels);
+    std::vector<double> noise_amplitudes (num_channels);
+    for (int i = 0; i < num_channels; i++)
+    {
+        double freq = 5.0 * (i % 8 + 1);
+        double amplitude = 10.0 * (i % 8 + 1);
+        phase_steps[i] = (uint32_t)(fmod (freq / sampling_rate, 1.0) * 4294967296.0);
+        amplitudes[i] = (load_profile == (int)SyntheticProfiles::NOISE) ? 0.0 : amplitude;
+        noise_amplitudes[i] = amplitude;
+        if (load_profile == (int)SyntheticProfiles::EEG)
         {
-            aux_package[channel] = dist_around_one (mt) - 0.1;
+            noise_amplitudes[i] = 0.1 * amplitude;
         }
-        for (int channel : board_descr["auxiliary"]["eda_channels"])
+        else if (load_profile == (int)SyntheticProfiles::SINE)
         {
-            aux_package[channel] = dist_around_one (mt);
+            noise_amplitudes[i] = 0.0;
         }
-        for (int chan_num = 0; chan_num < (int)board_descr["auxiliary"]["ppg_channels"].size ();
-             chan_num++)
+    }
+    uint64_t seed = std::chrono::high_resolution_clock::now ().time_since_epoch ().count ();
+    UniformNoise noise (seed);
+    std::vector<double> packages ((size_t)num_rows * batch_size, 0.0);
+
+    unsigned char counter = 0;
+    int64_t num_packages = 0;
+    bool is_late = false;
+    const std::chrono::duration<double> period (1.0 / sampling_rate);
+    auto start = std::chrono::steady_clock::now ();
+    double start_timestamp = get_timestamp ();
+
+    while (keep_alive)
+    {
+        for (int i = 0; i < batch_size; i++)
         {
-            int channel = board_descr["auxiliary"]["ppg_channels"][chan_num];
-            if (chan_num == 0)
+            double *package = packages.data () + (size_t)i * num_rows;
+            double *exg = package + 1;
+            package[0] = (double)counter++;
+            noise.fill (exg, num_channels, 1.0);
+            for (int j = 0; j < num_channels; j++)
             {
-                aux_package[channel] = 500.0 * dist_around_one (mt);
+                exg[j] = amplitudes[j] * sine_table[phases[j] >> (32 - table_bits)] +
+                    noise_amplitudes[j] * exg[j];
+                phases[j] += phase_steps[j];
             }
-            else
-            {
-                aux_package[channel] = 253500.0 * dist_around_one (mt);
-            }
-        }
-        for (int channel : board_descr["auxiliary"]["temperature_channels"])
-        {
-            aux_package[channel] = dist_around_one (mt) / 10.0 + 36.5;
+            package[timestamp_channel] = start_timestamp + (num_packages + i) / sampling_rate;
         }
-        for (int channel : board_descr["auxiliary"]["resistance_channels"])
+        num_packages += batch_size;
+
+        // batch is pushed when its last sample is due
+        auto deadline = start +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration> (
+                period * (double)num_packages);
+        if ((!is_late) && (std::chrono::steady_clock::now () - deadline > std::chrono::seconds (1)))
         {
-            aux_package[channel] = 1000.0 * dist_around_one (mt);
+            safe_logger (spdlog::level::warn,
+                "synthetic data is more than 1 second behind schedule, reduce load");
+            is_late = true;
         }
+        std::this_thread::sleep_until (deadline);
+        push_packages (packages.data (), batch_size);
+    }
+}
 
-        push_package (aux_package, (int)BrainFlowPresets::AUXILIARY_PRESET);
-
-        if (sleep_time - accumulated_time_delta > 1)
+int SyntheticBoard::parse_load_config (const std::string &config)
+{
+    int num_channels = 0;
+    int sampling_rate = 0;
+    int batch_size = 0;
+    bool enabled = true;
+    std::string profile;
+    try
+    {
+        json load_config = json::parse (config);
+        enabled = load_config.value ("enabled", true);
+        num_channels = load_config.value ("num_channels", 8);
+        sampling_rate = load_config.value ("sampling_rate", 250);
+        batch_size = load_config.value ("batch_size", 1);
+        profile = load_config.value ("profile", std::string ("eeg"));
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, "invalid synthetic load config: {}", e.what ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (!enabled)
+    {
+        if (board_id == (int)BoardIds::SYNTHETIC_LOAD_BOARD)
         {
-#ifdef _WIN32
-            Sleep ((int)(sleep_time - accumulated_time_delta));
-#else
-            usleep ((int)(1000 * (sleep_time - accumulated_time_delta)));
-#endif
+            safe_logger (spdlog::level::err, "load mode can not be disabled for this board");
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
         }
+        safe_logger (spdlog::level::info, "synthetic load mode is disabled");
+        reset_layout ();
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    // bindings size buffers by get_num_rows, so layout keeps rows of board description and
+    // exg channels are placed between package num and timestamp
+    int max_channels = (int)board_descr["default"]["num_rows"] - 3;
+    if ((num_channels < 1) || (num_channels > max_channels) || (sampling_rate < 1) ||
+        (sampling_rate > 128000) || (batch_size < 1) || (batch_size > 4096))
+    {
+        safe_logger (spdlog::level::err,
+            "num_channels must be in [1, {}], sampling_rate in [1, 128000], batch_size in [1, "
+            "4096], use SYNTHETIC_LOAD_BOARD for up to 1024 channels",
+            max_channels);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (profile == "eeg")
+    {
+        load_profile = (int)SyntheticProfiles::EEG;
+    }
+    else if (profile == "sine")
+    {
+        load_profile = (int)SyntheticProfiles::SINE;
+    }
+    else if (profile == "noise")
+    {
+        load_profile = (int)SyntheticProfiles::NOISE;
+    }
+    else
+    {
+        safe_logger (spdlog::level::err, "unknown profile {}, use eeg, sine or noise", profile);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    load_num_channels = num_channels;
+    load_sampling_rate = sampling_rate;
+    load_batch_size = batch_size;
+    safe_logger (spdlog::level::info,
+        "synthetic load mode: {} channels, sampling rate {}, batch size {}, profile {}",
+        num_channels, sampling_rate, batch_size, profile);
+    apply_load_layout ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
-        counter++;
-        auto stop = std::chrono::high_resolution_clock::now ();
-        auto duration =
-            std::chrono::duration_cast<std::chrono::microseconds> (stop - start).count ();
-        accumulated_time_delta += (duration / 1000.0 - sleep_time);
+void SyntheticBoard::reset_layout ()
+{
+    board_descr = boards_struct.brainflow_boards_json["boards"][std::to_string (board_id)];
+    load_mode = false;
+}
+
+void SyntheticBoard::apply_load_layout ()
+{
+    std::vector<int> exg_channels (load_num_channels);
+    for (int i = 0; i < load_num_channels; i++)
+    {
+        exg_channels[i] = i + 1;
     }
-    delete[] sin_phase_rad;
-    delete[] package;
-    delete[] aux_package;
+    // previous load layout is dropped, rows are taken from board description
+    reset_layout ();
+    load_mode = true;
+    int num_rows = board_descr["default"]["num_rows"];
+    json preset;
+    preset["name"] = "SyntheticLoad";
+    preset["sampling_rate"] = load_sampling_rate;
+    preset["package_num_channel"] = 0;
+    preset["eeg_channels"] = exg_channels;
+    preset["emg_channels"] = exg_channels;
+    preset["ecg_channels"] = exg_channels;
+    preset["timestamp_channel"] = num_rows - 2;
+    preset["marker_channel"] = num_rows - 1;
+    preset["num_rows"] = num_rows;
+    board_descr["default"] = preset;
 }
 
 int SyntheticBoard::config_board (std::string config, std::string &response)
 {
+    if ((!config.empty ()) && (config[0] == '{'))
+    {
+        if (is_streaming)
+        {
+            safe_logger (spdlog::level::err, "stop streaming before changing synthetic load mode");
+            return (int)BrainFlowExitCodes::STREAM_ALREADY_RUN_ERROR;
+        }
+        int res = parse_load_config (config);
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            // short summary, full layout of 1024 channels doesnt fit response buffers
+            int num_rows = board_descr["default"]["num_rows"];
+            int num_channels = load_mode ? load_num_channels : 0;
+            response = "num_channels: " + std::to_string (num_channels) +
+                ", num_rows: " + std::to_string (num_rows);
+        }
+        return res;
+    }
     response = "Config:" + config;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
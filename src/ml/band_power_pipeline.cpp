@@ -0,0 +1,486 @@
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include "band_power_pipeline.h"
+#include "brainflow_constants.h"
+
+
+BandPowerPipeline::BandPowerPipeline (const BandPowerPipelineApi &api,
+    std::shared_ptr<BaseClassifier> model, int board_id, int descr_board_id,
+    const std::string &input_params, int preset, double window_seconds, int update_interval_ms,
+    bool apply_filters, const std::vector<std::pair<double, double>> &bands)
+    : api (api), model (model), input_params (input_params)
+{
+    this->board_id = board_id;
+    this->descr_board_id = descr_board_id;
+    this->preset = preset;
+    this->window_seconds = window_seconds;
+    this->update_interval_ms = update_interval_ms;
+    this->apply_filters = apply_filters;
+    sampling_rate = 0;
+    window_size = 0;
+    num_rows = 0;
+    timestamp_channel = 0;
+    if (bands.empty ())
+    {
+        // same bands as in DataFilter::get_avg_band_powers
+        band_starts = {2.0, 4.0, 8.0, 13.0, 30.0};
+        band_stops = {4.0, 8.0, 13.0, 30.0, 45.0};
+    }
+    for (const std::pair<double, double> &band : bands)
+    {
+        band_starts.push_back (band.first);
+        band_stops.push_back (band.second);
+    }
+    avg_bands.resize (band_starts.size ());
+    stddev_bands.resize (band_starts.size ());
+    int max_output_len = std::max (1, model->params.max_array_size);
+    prediction.resize (max_output_len);
+    latest_prediction.resize (max_output_len);
+    latest_prediction_len = 0;
+    latest_timestamp = 0.0;
+    nfft = 0;
+    segment_step = 0;
+    max_segments = 0;
+    has_stream = false;
+    stream_start = 0;
+    next_index = 0;
+    next_segment_start = 0;
+    last_timestamp = 0.0;
+    callback = NULL;
+    user_data = NULL;
+    keep_alive = false;
+    num_errors = 0;
+}
+
+BandPowerPipeline::~BandPowerPipeline ()
+{
+    stop ();
+}
+
+int BandPowerPipeline::init ()
+{
+    if ((window_seconds <= 0) || (update_interval_ms < 1))
+    {
+        BaseClassifier::ml_logger->error ("invalid pipeline params");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int res = api.get_sampling_rate (descr_board_id, preset, &sampling_rate);
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = api.get_timestamp_channel (descr_board_id, preset, &timestamp_channel);
+    }
+    // board has no more channels than rows
+    int max_channels = 0;
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = api.get_num_rows (descr_board_id, preset, &max_channels);
+    }
+    if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (max_channels > 0))
+    {
+        std::vector<int> channels (max_channels);
+        int len = 0;
+        res = api.get_eeg_channels (descr_board_id, preset, channels.data (), &len);
+        if ((res == (int)BrainFlowExitCodes::STATUS_OK) && ((len < 0) || (len > max_channels)))
+        {
+            res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+        }
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            eeg_channels.assign (channels.begin (), channels.begin () + len);
+        }
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        BaseClassifier::ml_logger->error ("failed to get eeg channels and sampling rate");
+        return res;
+    }
+    if (eeg_channels.empty ())
+    {
+        BaseClassifier::ml_logger->error ("board has no eeg channels");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    window_size = (int)(window_seconds * sampling_rate);
+    if (window_size < 1)
+    {
+        BaseClassifier::ml_logger->error ("window is too small");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    for (size_t i = 0; i < band_starts.size (); i++)
+    {
+        if ((band_starts[i] < 0.0) || (band_starts[i] >= band_stops[i]) ||
+            (band_starts[i] >= sampling_rate / 2.0))
+        {
+            BaseClassifier::ml_logger->error (
+                "invalid band {} - {} Hz", band_starts[i], band_stops[i]);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+    }
+    // same nfft and overlap as in get_custom_band_powers
+    res = api.get_nearest_power_of_two (sampling_rate, &nfft);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    nfft *= 2;
+    // segments are aligned to stream start, not to window start, window should contain at least
+    // one segment for any alignment
+    while ((nfft > window_size) || (window_size - nfft + 1 < nfft - 4 * nfft / 5))
+    {
+        nfft /= 2;
+    }
+    if (nfft < 8)
+    {
+        BaseClassifier::ml_logger->error ("window is too small for psd");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    segment_step = nfft - 4 * nfft / 5;
+    max_segments = (window_size - nfft) / segment_step + 1;
+    size_t num_bins = (size_t)nfft / 2 + 1;
+    eeg_data.resize ((size_t)window_size * eeg_channels.size ());
+    history.resize ((size_t)window_size * eeg_channels.size ());
+    segment.resize (nfft);
+    freqs.resize (num_bins);
+    segment_psds.resize ((size_t)max_segments * eeg_channels.size () * num_bins);
+    segment_starts.resize (max_segments);
+    avg_psd.resize (num_bins);
+    channel_bands.resize (eeg_channels.size () * band_starts.size ());
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void BandPowerPipeline::set_callback (BandPowerPipelineCallback callback, void *user_data)
+{
+    std::lock_guard<std::mutex> lock (callback_mutex);
+    this->callback = callback;
+    this->user_data = user_data;
+}
+
+int BandPowerPipeline::start ()
+{
+    std::lock_guard<std::mutex> state_lock (state_mutex);
+    if (is_running ())
+    {
+        return (int)BrainFlowExitCodes::STREAM_ALREADY_RUN_ERROR;
+    }
+    // layout of the session may differ from board description, rows are resolved here
+    int res = api.get_session_num_rows (preset, &num_rows, board_id, input_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    for (int channel : eeg_channels)
+    {
+        if (channel >= num_rows)
+        {
+            BaseClassifier::ml_logger->error ("eeg channel {} is out of session layout", channel);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+    }
+    window.resize ((size_t)window_size * num_rows);
+    res = model->prepare ();
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    {
+        std::lock_guard<std::mutex> lock (prediction_mutex);
+        latest_prediction_len = 0;
+        latest_timestamp = 0.0;
+    }
+    // session may be restarted between pipeline runs, cached spectra are not reused
+    has_stream = false;
+    next_index = 0;
+    num_errors = 0;
+    {
+        std::lock_guard<std::mutex> lock (run_mutex);
+        keep_alive = true;
+    }
+    pipeline_thread = std::thread ([this] { this->thread_worker (); });
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BandPowerPipeline::stop ()
+{
+    std::lock_guard<std::mutex> state_lock (state_mutex);
+    if (!is_running ())
+    {
+        return (int)BrainFlowExitCodes::STREAM_THREAD_IS_NOT_RUNNING;
+    }
+    {
+        std::lock_guard<std::mutex> lock (run_mutex);
+        keep_alive = false;
+    }
+    run_cv.notify_all ();
+    pipeline_thread.join ();
+    return model->release ();
+}
+
+bool BandPowerPipeline::is_running ()
+{
+    return pipeline_thread.joinable ();
+}
+
+int BandPowerPipeline::get_latest_prediction (double *output, int *output_len, double *timestamp)
+{
+    if ((output == NULL) || (output_len == NULL) || (timestamp == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (prediction_mutex);
+    if (latest_prediction_len == 0)
+    {
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    std::copy (latest_prediction.begin (), latest_prediction.begin () + latest_prediction_len,
+        output);
+    *output_len = latest_prediction_len;
+    *timestamp = latest_timestamp;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BandPowerPipeline::get_num_errors ()
+{
+    return num_errors;
+}
+
+void BandPowerPipeline::thread_worker ()
+{
+    auto next_update = std::chrono::steady_clock::now ();
+    std::unique_lock<std::mutex> lock (run_mutex);
+    while (keep_alive)
+    {
+        next_update += std::chrono::milliseconds (update_interval_ms);
+        lock.unlock ();
+        int res = update ();
+        if ((res != (int)BrainFlowExitCodes::STATUS_OK) &&
+            (res != (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR))
+        {
+            num_errors++;
+            BaseClassifier::ml_logger->warn ("inference pipeline update failed: {}", res);
+        }
+        lock.lock ();
+        // dont try to catch up if update took longer than interval
+        auto now = std::chrono::steady_clock::now ();
+        if (next_update < now)
+        {
+            next_update = now;
+        }
+        run_cv.wait_until (lock, next_update, [this] { return !keep_alive; });
+    }
+}
+
+int BandPowerPipeline::update ()
+{
+    double timestamp = 0.0;
+    int res = apply_filters ? update_full_window (&timestamp) : update_incremental (&timestamp);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+
+    int prediction_len = 0;
+    res = model->run_predict (
+        avg_bands.data (), (int)avg_bands.size (), prediction.data (), &prediction_len);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    prediction_len = std::min (prediction_len, (int)prediction.size ());
+
+    {
+        std::lock_guard<std::mutex> lock (prediction_mutex);
+        std::copy (prediction.begin (), prediction.begin () + prediction_len,
+            latest_prediction.begin ());
+        latest_prediction_len = prediction_len;
+        latest_timestamp = timestamp;
+    }
+    // called without prediction lock, callback can read the latest prediction
+    std::lock_guard<std::mutex> lock (callback_mutex);
+    if (callback != NULL)
+    {
+        callback (prediction.data (), prediction_len, timestamp, user_data);
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BandPowerPipeline::update_full_window (double *timestamp)
+{
+    int len = 0;
+    int res = api.get_current_board_data (
+        window_size, preset, window.data (), &len, board_id, input_params.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    if (len < window_size)
+    {
+        // not enough data yet
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    for (size_t i = 0; i < eeg_channels.size (); i++)
+    {
+        std::copy (window.begin () + (size_t)eeg_channels[i] * len,
+            window.begin () + (size_t)(eeg_channels[i] + 1) * len,
+            eeg_data.begin () + i * (size_t)len);
+    }
+    res = api.get_custom_band_powers (eeg_data.data (), (int)eeg_channels.size (), len,
+        band_starts.data (), band_stops.data (), (int)band_starts.size (), sampling_rate,
+        (int)apply_filters, avg_bands.data (), stddev_bands.data ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    *timestamp = window[(size_t)timestamp_channel * len + len - 1];
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BandPowerPipeline::update_incremental (double *timestamp)
+{
+    // only samples after the previous update are read, window buffer is used as a chunk
+    int len = window_size;
+    while (len == window_size)
+    {
+        double index = (double)next_index;
+        int res = api.get_board_data_from_index (preset, &index, window_size, window.data (),
+            &len, board_id, input_params.c_str ());
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+        if (len == 0)
+        {
+            break;
+        }
+        uint64_t first_index = (uint64_t)index - len;
+        // samples were overwritten before they were read or session was restarted
+        if ((!has_stream) || (first_index != next_index))
+        {
+            reset_spectra (first_index);
+        }
+        for (size_t i = 0; i < eeg_channels.size (); i++)
+        {
+            const double *channel = window.data () + (size_t)eeg_channels[i] * len;
+            double *channel_history = history.data () + i * (size_t)window_size;
+            for (int j = 0; j < len; j++)
+            {
+                channel_history[(first_index + j) % window_size] = channel[j];
+            }
+        }
+        last_timestamp = window[(size_t)timestamp_channel * len + len - 1];
+        next_index = (uint64_t)index;
+    }
+    if ((!has_stream) || (next_index - stream_start < (uint64_t)window_size))
+    {
+        // not enough data yet
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+
+    // segments which started before the window are dropped without computing them
+    uint64_t window_start = next_index - window_size;
+    if (next_segment_start < window_start)
+    {
+        uint64_t skipped = (window_start - next_segment_start + segment_step - 1) / segment_step;
+        next_segment_start += skipped * segment_step;
+    }
+    while (next_segment_start + nfft <= next_index)
+    {
+        int res = compute_segment (next_segment_start);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+        next_segment_start += segment_step;
+    }
+
+    // welch average over cached segments of the window, band powers like in get_custom_band_powers
+    size_t num_bins = (size_t)nfft / 2 + 1;
+    size_t num_bands = band_starts.size ();
+    for (size_t i = 0; i < eeg_channels.size (); i++)
+    {
+        std::fill (avg_psd.begin (), avg_psd.end (), 0.0);
+        int counter = 0;
+        for (int slot = 0; slot < max_segments; slot++)
+        {
+            if ((segment_starts[slot] < window_start) ||
+                (segment_starts[slot] == std::numeric_limits<uint64_t>::max ()))
+            {
+                continue;
+            }
+            const double *psd =
+                segment_psds.data () + ((size_t)slot * eeg_channels.size () + i) * num_bins;
+            for (size_t k = 0; k < num_bins; k++)
+            {
+                avg_psd[k] += psd[k];
+            }
+            counter++;
+        }
+        // last bin is not averaged by get_psd_welch, keep results the same
+        for (size_t k = 0; k < num_bins - 1; k++)
+        {
+            avg_psd[k] /= counter;
+        }
+        for (size_t band = 0; band < num_bands; band++)
+        {
+            int res = api.get_band_power (avg_psd.data (), freqs.data (), (int)num_bins,
+                band_starts[band], band_stops[band], &channel_bands[i * num_bands + band]);
+            if (res != (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                return res;
+            }
+        }
+    }
+    double sum = 0.0;
+    for (size_t band = 0; band < num_bands; band++)
+    {
+        avg_bands[band] = 0.0;
+        for (size_t i = 0; i < eeg_channels.size (); i++)
+        {
+            avg_bands[band] += channel_bands[i * num_bands + band];
+        }
+        avg_bands[band] /= eeg_channels.size ();
+        sum += avg_bands[band];
+    }
+    // use relative band powers
+    for (size_t band = 0; band < num_bands; band++)
+    {
+        avg_bands[band] /= sum;
+    }
+    *timestamp = last_timestamp;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void BandPowerPipeline::reset_spectra (uint64_t first_index)
+{
+    has_stream = true;
+    stream_start = first_index;
+    next_segment_start = first_index;
+    std::fill (
+        segment_starts.begin (), segment_starts.end (), std::numeric_limits<uint64_t>::max ());
+}
+
+int BandPowerPipeline::compute_segment (uint64_t start)
+{
+    // segments of the window never share a slot, at most max_segments of them fit
+    size_t slot = (size_t)(((start - stream_start) / segment_step) % max_segments);
+    size_t num_bins = (size_t)nfft / 2 + 1;
+    for (size_t i = 0; i < eeg_channels.size (); i++)
+    {
+        const double *channel_history = history.data () + i * (size_t)window_size;
+        for (int j = 0; j < nfft; j++)
+        {
+            segment[j] = channel_history[(start + j) % window_size];
+        }
+        double *psd = segment_psds.data () + (slot * eeg_channels.size () + i) * num_bins;
+        int res = api.get_psd (segment.data (), nfft, sampling_rate,
+            (int)WindowOperations::HANNING, psd, freqs.data ());
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            // slot may hold partially overwritten spectra of the older segment
+            segment_starts[slot] = std::numeric_limits<uint64_t>::max ();
+            return res;
+        }
+    }
+    segment_starts[slot] = start;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
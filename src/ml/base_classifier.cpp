@@ -1,3 +1,6 @@
+#include <vector>
+
+#include "array_conversion.h"
 #include "base_classifier.h"
 #include "brainflow_constants.h"
 #include "spdlog/sinks/null_sink.h"
@@ -60,3 +63,71 @@ int BaseClassifier::set_log_file (const char *log_file)
     return (int)BrainFlowExitCodes::STATUS_OK;
 #endif
 }
+
+int BaseClassifier::predict_batch (
+    double *data, int batch_size, int feature_len, double *output, int *output_len)
+{
+    if ((data == NULL) || (output == NULL) || (output_len == NULL) || (batch_size < 1) ||
+        (feature_len < 1))
+    {
+        safe_logger (spdlog::level::err, "invalid input arguments for batch prediction");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int total_len = 0;
+    for (int i = 0; i < batch_size; i++)
+    {
+        int sample_len = 0;
+        int res = predict (data + (size_t)i * feature_len, feature_len, output + total_len,
+            &sample_len);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+        total_len += sample_len;
+    }
+    *output_len = total_len;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BaseClassifier::predict_float (float *data, int data_len, double *output, int *output_len)
+{
+    if ((data == NULL) || (data_len < 1))
+    {
+        safe_logger (spdlog::level::err, "invalid input arguments");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::vector<double> double_data ((size_t)data_len);
+    convert_float_to_double (data, double_data.data (), (size_t)data_len);
+    return predict (double_data.data (), data_len, output, output_len);
+}
+
+int BaseClassifier::predict_batch_float (
+    float *data, int batch_size, int feature_len, double *output, int *output_len)
+{
+    if ((data == NULL) || (batch_size < 1) || (feature_len < 1))
+    {
+        safe_logger (spdlog::level::err, "invalid input arguments for batch prediction");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    size_t len = (size_t)batch_size * feature_len;
+    std::vector<double> double_data (len);
+    convert_float_to_double (data, double_data.data (), len);
+    return predict_batch (double_data.data (), batch_size, feature_len, output, output_len);
+}
+
+int BaseClassifier::get_stats (double *stats, int *stats_len)
+{
+    if ((stats == NULL) || (stats_len == NULL))
+    {
+        safe_logger (spdlog::level::err, "stats and stats_len must not be null");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    stats[0] = (double)num_calls.load (std::memory_order_relaxed);
+    stats[1] = (double)num_errors.load (std::memory_order_relaxed);
+    stats[2] = (double)latency.get_percentile (50.0) / 1000.0;
+    stats[3] = (double)latency.get_percentile (99.0) / 1000.0;
+    stats[4] = (double)latency.get_max () / 1000.0;
+    stats[5] = latency.get_mean () / 1000.0;
+    *stats_len = num_stats;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
@@ -28,6 +28,10 @@ SET (ML_MODULE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/onnx/onnx_classifier.cpp
     ${CMAKE_CURRENT_LIST_DIR}/base_classifier.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mindfulness_classifier.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/linear_classifier.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/band_power_pipeline.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/lazy_classifier.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/model_registry.cpp
     ${CMAKE_CURRENT_LIST_DIR}/generated/mindfulness_model.cpp
 )
 
@@ -117,6 +121,7 @@ install (
     FILES
     ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/inc/ml_module.h
     ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/inc/brainflow_model_params.h
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/inc/dyn_lib_classifier_api.h
     DESTINATION inc
 )
 
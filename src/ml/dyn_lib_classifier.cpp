@@ -21,33 +21,114 @@ int DynLibClassifier::prepare ()
         dll_loader = NULL;
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
-    int (*func) (void *, struct BrainFlowModelParams *) =
+
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    init_context_func =
+        (void *(*)(const struct BrainFlowModelParamsC *))dll_loader->get_address ("init_context");
+    if (init_context_func != NULL)
+    {
+        res = resolve_context_entry_points ();
+    }
+    else
+    {
+        res = resolve_legacy_entry_points ();
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        unload_library ();
+    }
+    return res;
+}
+
+int DynLibClassifier::resolve_legacy_entry_points ()
+{
+    prepare_func =
         (int (*) (void *, struct BrainFlowModelParams *))dll_loader->get_address ("prepare");
-    if (func == NULL)
+    predict_func = (int (*) (double *, int, double *, int *,
+        struct BrainFlowModelParams *))dll_loader->get_address ("predict");
+    release_func = (int (*) (struct BrainFlowModelParams *))dll_loader->get_address ("release");
+    // optional
+    predict_batch_func = (int (*) (double *, int, int, double *, int *,
+        struct BrainFlowModelParams *))dll_loader->get_address ("predict_batch");
+    if ((prepare_func == NULL) || (predict_func == NULL) || (release_func == NULL))
     {
-        safe_logger (spdlog::level::err, "failed to get function address for prepare");
-        delete dll_loader;
-        dll_loader = NULL;
+        safe_logger (spdlog::level::err,
+            "failed to get function address for prepare, predict or release");
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
-    return func ((void *)this, &params);
+    int res = prepare_func ((void *)this, &params);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        // release is called only for prepared models
+        release_func = NULL;
+    }
+    return res;
 }
 
-int DynLibClassifier::predict (double *data, int data_len, double *output, int *output_len)
+int DynLibClassifier::resolve_context_entry_points ()
 {
-    if (dll_loader == NULL)
+    predict_with_context_func = (int (*) (void *, double *, int, double *,
+        int *))dll_loader->get_address ("predict_with_context");
+    release_context_func = (int (*) (void *))dll_loader->get_address ("release_context");
+    // optional
+    predict_batch_with_context_func = (int (*) (void *, double *, int, int, double *,
+        int *))dll_loader->get_address ("predict_batch_with_context");
+    if ((predict_with_context_func == NULL) || (release_context_func == NULL))
     {
-        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+        safe_logger (spdlog::level::err,
+            "failed to get function address for predict_with_context or release_context");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
-    int (*func) (double *, int, double *, int *, struct BrainFlowModelParams *) =
-        (int (*) (double *, int, double *, int *,
-            struct BrainFlowModelParams *))dll_loader->get_address ("predict");
-    if (func == NULL)
+
+    // strings point to params owned by this object
+    params_c.version = BRAINFLOW_MODEL_PARAMS_C_VERSION;
+    params_c.struct_size = (int)sizeof (params_c);
+    params_c.metric = params.metric;
+    params_c.classifier = params.classifier;
+    params_c.file = params.file.c_str ();
+    params_c.other_info = params.other_info.c_str ();
+    params_c.output_name = params.output_name.c_str ();
+    params_c.max_array_size = params.max_array_size;
+    context = init_context_func (&params_c);
+    if (context == NULL)
     {
-        safe_logger (spdlog::level::err, "failed to get function address for predict");
+        safe_logger (spdlog::level::err, "init_context failed");
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
-    return func (data, data_len, output, output_len, &params);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int DynLibClassifier::predict (double *data, int data_len, double *output, int *output_len)
+{
+    if (predict_with_context_func != NULL)
+    {
+        return predict_with_context_func (context, data, data_len, output, output_len);
+    }
+    if (predict_func != NULL)
+    {
+        return predict_func (data, data_len, output, output_len, &params);
+    }
+    return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+}
+
+// predict_batch entry points are optional, libraries without them are called per sample
+int DynLibClassifier::predict_batch (
+    double *data, int batch_size, int feature_len, double *output, int *output_len)
+{
+    if (predict_batch_with_context_func != NULL)
+    {
+        return predict_batch_with_context_func (
+            context, data, batch_size, feature_len, output, output_len);
+    }
+    if (predict_batch_func != NULL)
+    {
+        return predict_batch_func (data, batch_size, feature_len, output, output_len, &params);
+    }
+    if ((predict_with_context_func == NULL) && (predict_func == NULL))
+    {
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    return BaseClassifier::predict_batch (data, batch_size, feature_len, output, output_len);
 }
 
 int DynLibClassifier::release ()
@@ -58,21 +139,39 @@ int DynLibClassifier::release ()
     }
 
     int res = (int)BrainFlowExitCodes::STATUS_OK;
-    int (*func) (struct BrainFlowModelParams *) =
-        (int (*) (struct BrainFlowModelParams *))dll_loader->get_address ("release");
-    if (func == NULL)
+    if ((release_context_func != NULL) && (context != NULL))
     {
-        safe_logger (spdlog::level::err, "failed to get function address for release");
-        res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+        res = release_context_func (context);
     }
-    else
+    else if (release_func != NULL)
     {
-        res = func (&params);
+        res = release_func (&params);
     }
-
-    dll_loader->free_library ();
-    delete dll_loader;
-    dll_loader = NULL;
+    unload_library ();
 
     return res;
 }
+
+void DynLibClassifier::unload_library ()
+{
+    reset_entry_points ();
+    context = NULL;
+    if (dll_loader != NULL)
+    {
+        dll_loader->free_library ();
+        delete dll_loader;
+        dll_loader = NULL;
+    }
+}
+
+void DynLibClassifier::reset_entry_points ()
+{
+    prepare_func = NULL;
+    predict_func = NULL;
+    predict_batch_func = NULL;
+    release_func = NULL;
+    init_context_func = NULL;
+    predict_with_context_func = NULL;
+    predict_batch_with_context_func = NULL;
+    release_context_func = NULL;
+}
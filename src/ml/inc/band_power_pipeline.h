@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "base_classifier.h"
+
+
+// board controller and data handler methods used by pipeline, ml module doesnt link these libs
+// and resolves them at runtime, signatures match exported functions
+struct BandPowerPipelineApi
+{
+    int (*get_sampling_rate) (int board_id, int preset, int *sampling_rate);
+    int (*get_timestamp_channel) (int board_id, int preset, int *timestamp_channel);
+    int (*get_num_rows) (int board_id, int preset, int *num_rows);
+    int (*get_eeg_channels) (int board_id, int preset, int *eeg_channels, int *len);
+    int (*get_session_num_rows) (
+        int preset, int *num_rows, int board_id, const char *json_brainflow_input_params);
+    int (*get_current_board_data) (int num_samples, int preset, double *data_buf,
+        int *returned_samples, int board_id, const char *json_brainflow_input_params);
+    int (*get_board_data_from_index) (int preset, double *next_index, int max_samples,
+        double *data_buf, int *returned_samples, int board_id,
+        const char *json_brainflow_input_params);
+    int (*get_custom_band_powers) (double *raw_data, int rows, int cols, double *start_freqs,
+        double *stop_freqs, int num_bands, int sampling_rate, int apply_filters,
+        double *avg_band_powers, double *stddev_band_powers);
+    int (*get_nearest_power_of_two) (int value, int *output);
+    int (*get_psd) (double *data, int data_len, int sampling_rate, int window_function,
+        double *output_ampl, double *output_freq);
+    int (*get_band_power) (double *ampl, double *freq, int data_len, double freq_start,
+        double freq_end, double *band_power);
+};
+
+// called from pipeline thread for each prediction
+typedef void (*BandPowerPipelineCallback) (
+    const double *prediction, int prediction_len, double timestamp, void *user_data);
+
+// calculates average band powers over eeg channels of the latest window of board data and runs
+// model over them in a single thread, all buffers are allocated in init and start
+// without filters welch spectra of window segments are cached by absolute sample index and each
+// update computes psd only for segments completed by new samples, zero phase filters change the
+// whole window so with apply_filters window is read and processed again on each update
+class BandPowerPipeline
+{
+public:
+    // board_id is id of the session, descr_board_id is used to get board description and differs
+    // from board_id for streaming and playback boards, bands are (start, stop) frequencies in Hz,
+    // delta, theta, alpha, beta and gamma are used if it's empty
+    BandPowerPipeline (const BandPowerPipelineApi &api, std::shared_ptr<BaseClassifier> model,
+        int board_id, int descr_board_id, const std::string &input_params, int preset,
+        double window_seconds, int update_interval_ms, bool apply_filters,
+        const std::vector<std::pair<double, double>> &bands =
+            std::vector<std::pair<double, double>> ());
+    ~BandPowerPipeline ();
+
+    // resolves board description, returns error if board has no eeg channels, window is too
+    // small for psd or band has no frequencies below nyquist
+    int init ();
+    // prepares model and starts thread, board session should exist
+    int start ();
+    // stops thread and releases model, must not be called from callback
+    int stop ();
+    bool is_running ();
+    // waits for running callback to return, so user_data of the previous callback can be freed
+    // after that, must not be called from callback
+    void set_callback (BandPowerPipelineCallback callback, void *user_data);
+    // output must hold max_array_size values of the model, returns
+    // CLASSIFIER_IS_NOT_PREPARED_ERROR if there is no prediction yet
+    int get_latest_prediction (double *output, int *output_len, double *timestamp);
+    int get_num_errors ();
+
+private:
+    BandPowerPipelineApi api;
+    std::shared_ptr<BaseClassifier> model;
+    int board_id;
+    int descr_board_id;
+    std::string input_params;
+    int preset;
+    double window_seconds;
+    int update_interval_ms;
+    bool apply_filters;
+    int sampling_rate;
+    int window_size;
+    int num_rows;
+    int timestamp_channel;
+    std::vector<int> eeg_channels;
+
+    // reused across updates
+    std::vector<double> window;
+    std::vector<double> eeg_data;
+    std::vector<double> band_starts;
+    std::vector<double> band_stops;
+    std::vector<double> avg_bands;
+    std::vector<double> stddev_bands;
+    std::vector<double> prediction;
+
+    // incremental welch state, segments start at stream_start + k * segment_step
+    int nfft;
+    int segment_step;
+    int max_segments;
+    bool has_stream;
+    uint64_t stream_start;
+    uint64_t next_index;
+    uint64_t next_segment_start;
+    double last_timestamp;
+    // eeg samples of the latest window, channel rows of window_size ring indexed by absolute index
+    std::vector<double> history;
+    std::vector<double> segment;
+    std::vector<double> freqs;
+    // max_segments x eeg channels x (nfft / 2 + 1) ring and absolute start of each slot
+    std::vector<double> segment_psds;
+    std::vector<uint64_t> segment_starts;
+    std::vector<double> avg_psd;
+    std::vector<double> channel_bands;
+
+    // serializes start and stop
+    std::mutex state_mutex;
+    std::thread pipeline_thread;
+    bool keep_alive;
+    std::mutex run_mutex;
+    std::condition_variable run_cv;
+
+    // guards latest prediction
+    std::mutex prediction_mutex;
+    std::vector<double> latest_prediction;
+    int latest_prediction_len;
+    double latest_timestamp;
+    // guards callback and is held while it runs
+    std::mutex callback_mutex;
+    BandPowerPipelineCallback callback;
+    void *user_data;
+    std::atomic<int> num_errors;
+
+    void thread_worker ();
+    int update ();
+    // fills avg_bands and timestamp of the last sample in the window
+    int update_full_window (double *timestamp);
+    int update_incremental (double *timestamp);
+    void reset_spectra (uint64_t first_index);
+    int compute_segment (uint64_t start);
+};
@@ -1,6 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdint.h>
+
+#include "brainflow_constants.h"
 #include "brainflow_model_params.h"
+#include "latency_histogram.h"
 #include "spdlog/spdlog.h"
 
 class BaseClassifier
@@ -13,9 +20,14 @@ public:
     static int set_log_level (int log_level);
     static int set_log_file (const char *log_file);
 
+    // layout of get_stats output: calls, errors, p50, p99, max and mean latency in microseconds
+    static const int num_stats = 6;
+
     BaseClassifier (struct BrainFlowModelParams model_params) : params (model_params)
     {
         skip_logs = false;
+        num_calls = 0;
+        num_errors = 0;
     }
 
     virtual ~BaseClassifier ()
@@ -48,4 +60,88 @@ public:
     virtual int prepare () = 0;
     virtual int predict (double *data, int data_len, double *output, int *output_len) = 0;
     virtual int release () = 0;
+    // data is row major batch_size x feature_len, output must hold batch_size * max_array_size
+    // values, results for each sample are written one after another, default implementation calls
+    // predict for each sample
+    virtual int predict_batch (
+        double *data, int batch_size, int feature_len, double *output, int *output_len);
+
+    // classifiers which support concurrent predict calls for the same instance should return true,
+    // for others calls are serialized per model
+    virtual bool is_thread_safe ()
+    {
+        return false;
+    }
+
+    // float input, default implementations convert data to double and call predict or
+    // predict_batch, classifiers which can consume float directly should override them
+    virtual int predict_float (float *data, int data_len, double *output, int *output_len);
+    virtual int predict_batch_float (
+        float *data, int batch_size, int feature_len, double *output, int *output_len);
+
+    int run_predict (double *data, int data_len, double *output, int *output_len)
+    {
+        return run_timed ([&] () { return predict (data, data_len, output, output_len); });
+    }
+
+    int run_predict (float *data, int data_len, double *output, int *output_len)
+    {
+        return run_timed ([&] () { return predict_float (data, data_len, output, output_len); });
+    }
+
+    int run_predict_batch (
+        double *data, int batch_size, int feature_len, double *output, int *output_len)
+    {
+        return run_timed ([&] () {
+            return predict_batch (data, batch_size, feature_len, output, output_len);
+        });
+    }
+
+    int run_predict_batch (
+        float *data, int batch_size, int feature_len, double *output, int *output_len)
+    {
+        return run_timed ([&] () {
+            return predict_batch_float (data, batch_size, feature_len, output, output_len);
+        });
+    }
+
+    // stats must hold num_stats values
+    int get_stats (double *stats, int *stats_len);
+
+private:
+    std::mutex predict_mutex;
+    LatencyHistogram latency;
+    std::atomic<uint64_t> num_calls;
+    std::atomic<uint64_t> num_errors;
+
+    // latency includes waiting for predict_mutex, batch call is recorded as a single call
+    template <typename Func>
+    int run_timed (Func func)
+    {
+        auto start = std::chrono::steady_clock::now ();
+        int res = (int)BrainFlowExitCodes::STATUS_OK;
+        if (is_thread_safe ())
+        {
+            res = func ();
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock (predict_mutex);
+            res = func ();
+        }
+        record_call (start, res);
+        return res;
+    }
+
+    void record_call (std::chrono::steady_clock::time_point start, int res)
+    {
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds> (
+            std::chrono::steady_clock::now () - start);
+        latency.record ((uint64_t)duration.count ());
+        num_calls.fetch_add (1, std::memory_order_relaxed);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            num_errors.fetch_add (1, std::memory_order_relaxed);
+        }
+    }
 };
@@ -3,6 +3,7 @@
 #include <string>
 
 #include "base_classifier.h"
+#include "dyn_lib_classifier_api.h"
 #include "runtime_dll_loader.h"
 
 
@@ -12,6 +13,8 @@ public:
     DynLibClassifier (struct BrainFlowModelParams params) : BaseClassifier (params)
     {
         dll_loader = NULL;
+        context = NULL;
+        reset_entry_points ();
     }
 
     virtual ~DynLibClassifier ()
@@ -22,6 +25,8 @@ public:
 
     virtual int prepare ();
     virtual int predict (double *data, int data_len, double *output, int *output_len);
+    virtual int predict_batch (
+        double *data, int batch_size, int feature_len, double *output, int *output_len);
     virtual int release ();
 
 protected:
@@ -31,4 +36,24 @@ protected:
     }
 
     DLLLoader *dll_loader;
+
+private:
+    // entry points are resolved once in prepare, see dyn_lib_classifier_api.h
+    int (*prepare_func) (void *, struct BrainFlowModelParams *);
+    int (*predict_func) (double *, int, double *, int *, struct BrainFlowModelParams *);
+    int (*predict_batch_func) (double *, int, int, double *, int *, struct BrainFlowModelParams *);
+    int (*release_func) (struct BrainFlowModelParams *);
+
+    void *(*init_context_func) (const struct BrainFlowModelParamsC *);
+    int (*predict_with_context_func) (void *, double *, int, double *, int *);
+    int (*predict_batch_with_context_func) (void *, double *, int, int, double *, int *);
+    int (*release_context_func) (void *);
+
+    struct BrainFlowModelParamsC params_c;
+    void *context;
+
+    int resolve_legacy_entry_points ();
+    int resolve_context_entry_points ();
+    void reset_entry_points ();
+    void unload_library ();
 };
@@ -0,0 +1,35 @@
+#pragma once
+
+// plugin interface for DynLibClassifier, all structures here are plain C to keep ABI stable
+//
+// legacy interface, resolved if plugin doesnt export init_context:
+//   int prepare (void *classifier, struct BrainFlowModelParams *params);
+//   int predict (double *data, int data_len, double *output, int *output_len,
+//       struct BrainFlowModelParams *params);
+//   int predict_batch (double *data, int batch_size, int feature_len, double *output,
+//       int *output_len, struct BrainFlowModelParams *params); // optional
+//   int release (struct BrainFlowModelParams *params);
+//
+// context interface, used if plugin exports init_context:
+//   void *init_context (const struct BrainFlowModelParamsC *params); // NULL on error
+//   int predict_with_context (void *context, double *data, int data_len, double *output,
+//       int *output_len);
+//   int predict_batch_with_context (void *context, double *data, int batch_size,
+//       int feature_len, double *output, int *output_len); // optional
+//   int release_context (void *context);
+
+#define BRAINFLOW_MODEL_PARAMS_C_VERSION 1
+
+// new fields are added only to the end, plugins should check version and struct_size before
+// reading them, strings are valid until release_context returns
+struct BrainFlowModelParamsC
+{
+    int version;
+    int struct_size;
+    int metric;
+    int classifier;
+    const char *file;
+    const char *other_info;
+    const char *output_name;
+    int max_array_size;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base_classifier.h"
+#include "model_registry.h"
+
+
+// registered model which is loaded on first predict or in background and may be unloaded by
+// registry at any time, in flight predictions keep unloaded model alive until they return
+class LazyClassifier : public BaseClassifier, public std::enable_shared_from_this<LazyClassifier>
+{
+public:
+    typedef int (*CreateFunc) (struct BrainFlowModelParams, std::shared_ptr<BaseClassifier> &);
+
+    LazyClassifier (
+        struct BrainFlowModelParams params, CreateFunc create_func, ModelRegistry *registry)
+        : BaseClassifier (params)
+    {
+        this->create_func = create_func;
+        this->registry = registry;
+        last_used = 0;
+    }
+
+    virtual ~LazyClassifier ()
+    {
+        skip_logs = true;
+        release ();
+    }
+
+    // only checks params, model is loaded later
+    virtual int prepare ();
+    virtual int predict (double *data, int data_len, double *output, int *output_len);
+    virtual int predict_batch (
+        double *data, int batch_size, int feature_len, double *output, int *output_len);
+    virtual int predict_float (float *data, int data_len, double *output, int *output_len);
+    virtual int predict_batch_float (
+        float *data, int batch_size, int feature_len, double *output, int *output_len);
+    virtual int release ();
+
+    // loaded model serializes calls itself if it's not thread safe
+    virtual bool is_thread_safe ()
+    {
+        return true;
+    }
+
+    int load ();
+    void unload ();
+    bool is_loaded ();
+    uint64_t get_last_used () const
+    {
+        return last_used.load (std::memory_order_relaxed);
+    }
+
+private:
+    CreateFunc create_func;
+    ModelRegistry *registry;
+    // load_mutex serializes loading of this model only, state_mutex guards model pointer
+    std::mutex load_mutex;
+    std::mutex state_mutex;
+    std::shared_ptr<BaseClassifier> model;
+    std::atomic<uint64_t> last_used;
+
+    int acquire (std::shared_ptr<BaseClassifier> &loaded_model);
+    size_t estimate_memory ();
+};
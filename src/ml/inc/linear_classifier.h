@@ -0,0 +1,89 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "base_classifier.h"
+
+
+// scores linear models without onnxruntime, params.file is either onnx graph or json file with
+// coefficients like {"coefficients": [[0.1, 0.2]], "intercepts": [0.0], "post_transform": "none"},
+// post_transform is "none", "logistic" or "softmax"
+// accepted onnx graphs are a chain of nodes with a single linear operator: LinearClassifier,
+// LinearRegressor, Gemm or MatMul + Add with constant weights, optionally followed by Sigmoid or
+// Softmax and by Normalizer, Cast, Identity and ZipMap nodes which sklearn-onnx adds to
+// classifiers, label outputs are not computed, any other operator is rejected in prepare
+// each node must read output of the previous one and initializers only, graph must have a single
+// input and output scores of the last node
+// output contains scores or probabilities for each class, the same as onnxruntime output
+class LinearClassifier : public BaseClassifier
+{
+public:
+    enum PostTransform
+    {
+        NONE = 0,
+        LOGISTIC = 1,
+        SOFTMAX = 2
+    };
+
+    // onnx Normalizer applied after post transform
+    enum Normalization
+    {
+        NO_NORM = 0,
+        NORM_MAX = 1,
+        NORM_L1 = 2,
+        NORM_L2 = 3
+    };
+
+    LinearClassifier (struct BrainFlowModelParams params) : BaseClassifier (params)
+    {
+        num_features = 0;
+        num_scores = 0;
+        num_outputs = 0;
+        post_transform = NONE;
+        normalization = NO_NORM;
+    }
+
+    virtual ~LinearClassifier ()
+    {
+        skip_logs = true;
+        release ();
+    }
+
+    virtual int prepare ();
+    virtual int predict (double *data, int data_len, double *output, int *output_len);
+    virtual int predict_batch (
+        double *data, int batch_size, int feature_len, double *output, int *output_len);
+    virtual int predict_float (float *data, int data_len, double *output, int *output_len);
+    virtual int predict_batch_float (
+        float *data, int batch_size, int feature_len, double *output, int *output_len);
+    virtual int release ();
+
+    // coefficients are read only after prepare
+    virtual bool is_thread_safe ()
+    {
+        return true;
+    }
+
+private:
+    // row major num_scores x num_features
+    std::vector<double> coefficients;
+    std::vector<double> intercepts;
+    int num_features;
+    int num_scores;
+    // binary classifiers with a single score output values for both classes
+    int num_outputs;
+    int post_transform;
+    int normalization;
+
+    template <typename T>
+    int score_batch (
+        const T *data, int batch_size, int feature_len, double *output, int *output_len);
+    int load_coefficients ();
+    int load_onnx ();
+    int set_linear_part (const std::vector<double> &weights, const std::vector<double> &bias,
+        int scores, bool transposed);
+    int parse_post_transform (const std::string &name);
+    int parse_normalization (const std::string &name);
+    void apply_post_transform (double *values);
+};
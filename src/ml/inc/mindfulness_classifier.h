@@ -19,4 +19,12 @@ public:
     virtual int prepare ();
     virtual int predict (double *data, int data_len, double *output, int *output_len);
     virtual int release ();
+    virtual int predict_batch (
+        double *data, int batch_size, int feature_len, double *output, int *output_len);
+
+    // stateless, only reads model coefficients
+    virtual bool is_thread_safe ()
+    {
+        return true;
+    }
 };
\ No newline at end of file
@@ -10,7 +10,66 @@ extern "C"
     SHARED_EXPORT int CALLING_CONVENTION predict (
         double *data, int data_len, double *output, int *output_len, const char *json_params);
     SHARED_EXPORT int CALLING_CONVENTION release (const char *json_params);
+    // data is row major batch_size x feature_len, output must hold batch_size * max_array_size
+    SHARED_EXPORT int CALLING_CONVENTION predict_batch (double *data, int batch_size,
+        int feature_len, double *output, int *output_len, const char *json_params);
+    // also stops background loading thread, call it before unloading this lib
     SHARED_EXPORT int CALLING_CONVENTION release_all ();
+    // float32 input, passed to models which accept it without conversion
+    SHARED_EXPORT int CALLING_CONVENTION predict_float (
+        float *data, int data_len, double *output, int *output_len, const char *json_params);
+    SHARED_EXPORT int CALLING_CONVENTION predict_batch_float (float *data, int batch_size,
+        int feature_len, double *output, int *output_len, const char *json_params);
+
+    // handle based methods, handle is returned from prepare_with_handle and allows to skip json
+    // parsing and model lookup for each prediction, models are not serialized against each other
+    SHARED_EXPORT int CALLING_CONVENTION prepare_with_handle (const char *json_params, int *handle);
+    SHARED_EXPORT int CALLING_CONVENTION predict_with_handle (
+        double *data, int data_len, double *output, int *output_len, int handle);
+    SHARED_EXPORT int CALLING_CONVENTION predict_batch_with_handle (double *data, int batch_size,
+        int feature_len, double *output, int *output_len, int handle);
+    SHARED_EXPORT int CALLING_CONVENTION predict_float_with_handle (
+        float *data, int data_len, double *output, int *output_len, int handle);
+    SHARED_EXPORT int CALLING_CONVENTION predict_batch_float_with_handle (float *data,
+        int batch_size, int feature_len, double *output, int *output_len, int handle);
+    SHARED_EXPORT int CALLING_CONVENTION release_with_handle (int handle);
+
+    // registered models are loaded on first prediction or by preload_model in background, loaded
+    // models are evicted in least recently used order if registry limits are exceeded and loaded
+    // again on demand, 0 means no limit
+    SHARED_EXPORT int CALLING_CONVENTION register_model (const char *json_params, int *handle);
+    SHARED_EXPORT int CALLING_CONVENTION preload_model (int handle);
+    SHARED_EXPORT int CALLING_CONVENTION set_model_registry_limits (
+        int max_loaded_models, int max_memory_mb);
+
+    // per model stats, stats must hold 6 values: number of predict calls, number of failed calls,
+    // p50, p99, max and mean latency in microseconds
+    SHARED_EXPORT int CALLING_CONVENTION get_model_stats (
+        double *stats, int *stats_len, const char *json_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_model_stats_with_handle (
+        double *stats, int *stats_len, int handle);
+
+    // inference pipeline calculates average band powers over eeg channels of the latest
+    // window_seconds of a board session and runs the model every update_interval_ms in a native
+    // thread, board controller and data handler libs are loaded from the folder of this lib,
+    // json_params may have bands field with [start, stop] pairs in Hz, by default features are
+    // delta, theta, alpha, beta and gamma
+    SHARED_EXPORT int CALLING_CONVENTION create_inference_pipeline (const char *json_params,
+        int board_id, const char *json_brainflow_input_params, double window_seconds,
+        int update_interval_ms, int apply_filters, int preset, int *handle);
+    SHARED_EXPORT int CALLING_CONVENTION start_inference_pipeline (int handle);
+    SHARED_EXPORT int CALLING_CONVENTION stop_inference_pipeline (int handle);
+    // callback is called from pipeline thread for each prediction, NULL removes it, waits for
+    // running callback to return and must not be called from callback
+    SHARED_EXPORT int CALLING_CONVENTION set_inference_pipeline_callback (int handle,
+        void (*callback) (const double *, int, double, void *), void *user_data);
+    // output must hold max_array_size values, returns CLASSIFIER_IS_NOT_PREPARED_ERROR if there
+    // is no prediction yet
+    SHARED_EXPORT int CALLING_CONVENTION get_inference_pipeline_prediction (
+        int handle, double *output, int *output_len, double *timestamp);
+    SHARED_EXPORT int CALLING_CONVENTION get_inference_pipeline_num_errors (
+        int handle, int *num_errors);
+    SHARED_EXPORT int CALLING_CONVENTION release_inference_pipeline (int handle);
 
     // logging methods
     SHARED_EXPORT int CALLING_CONVENTION set_log_level_ml_module (int log_level);
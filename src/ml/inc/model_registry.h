@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <thread>
+#include <vector>
+
+class LazyClassifier;
+
+
+// tracks lazy models which are currently loaded, evicts least recently used ones if count or
+// memory limit is exceeded and loads models in background on a single worker thread, mutex is
+// never held while a model loads or unloads
+// worker thread is stopped by shutdown, destructor calls it too, so registry must not be a static
+// object, joining a thread while dll is unloaded can deadlock on windows
+class ModelRegistry
+{
+public:
+    ModelRegistry ();
+    ~ModelRegistry ();
+
+    // drops scheduled loads and waits for worker thread, next load_in_background starts it again,
+    // must not be called from a model
+    void shutdown ();
+
+    // 0 means no limit, new limits are applied on the next load
+    void set_limits (int max_loaded_models, size_t max_memory_bytes);
+    // called by model after it's loaded, evicts other models if limits are exceeded
+    void on_loaded (std::shared_ptr<LazyClassifier> model, size_t memory_bytes);
+    void on_unloaded (LazyClassifier *model);
+    void load_in_background (std::shared_ptr<LazyClassifier> model);
+
+private:
+    struct Entry
+    {
+        std::weak_ptr<LazyClassifier> model;
+        size_t memory_bytes;
+    };
+
+    std::mutex mutex;
+    std::map<LazyClassifier *, Entry> loaded_models;
+    int max_loaded_models;
+    size_t max_memory_bytes;
+    size_t used_memory_bytes;
+
+    // worker_mutex serializes start and stop of worker, it's never taken by worker itself
+    std::mutex worker_mutex;
+    std::thread worker;
+    bool keep_alive;
+    std::condition_variable queue_cv;
+    std::deque<std::weak_ptr<LazyClassifier>> load_queue;
+
+    void collect_victims (
+        LazyClassifier *loaded_model, std::vector<std::shared_ptr<LazyClassifier>> &victims);
+    void worker_thread ();
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+
+// minimal reader for protobuf wire format, it's enough to walk small onnx graphs without protobuf
+// and onnxruntime, nested messages are read by creating a new reader over length delimited field
+class ProtoReader
+{
+public:
+    static const int varint = 0;
+    static const int fixed64 = 1;
+    static const int length_delimited = 2;
+    static const int fixed32 = 5;
+
+    ProtoReader (const unsigned char *data, size_t size)
+    {
+        pos = data;
+        end = data + size;
+        failed = false;
+    }
+
+    // returns false at the end of message or if message is malformed, check is_failed to tell them
+    // apart
+    bool next_field (int *field, int *wire_type)
+    {
+        if ((failed) || (pos >= end))
+        {
+            return false;
+        }
+        uint64_t key = 0;
+        if (!read_varint (&key))
+        {
+            return false;
+        }
+        *field = (int)(key >> 3);
+        *wire_type = (int)(key & 7);
+        return true;
+    }
+
+    bool read_varint (uint64_t *value)
+    {
+        *value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (pos >= end)
+            {
+                break;
+            }
+            unsigned char byte = *pos++;
+            *value |= (uint64_t)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        failed = true;
+        return false;
+    }
+
+    bool read_bytes (const unsigned char **data, size_t *size)
+    {
+        uint64_t len = 0;
+        if ((!read_varint (&len)) || (len > (uint64_t)(end - pos)))
+        {
+            failed = true;
+            return false;
+        }
+        *data = pos;
+        *size = (size_t)len;
+        pos += len;
+        return true;
+    }
+
+    bool read_string (std::string *value)
+    {
+        const unsigned char *data = NULL;
+        size_t size = 0;
+        if (!read_bytes (&data, &size))
+        {
+            return false;
+        }
+        value->assign ((const char *)data, size);
+        return true;
+    }
+
+    bool read_float (float *value)
+    {
+        if (end - pos < 4)
+        {
+            failed = true;
+            return false;
+        }
+        // onnx stores values in little endian
+        memcpy (value, pos, 4);
+        pos += 4;
+        return true;
+    }
+
+    bool read_double (double *value)
+    {
+        if (end - pos < 8)
+        {
+            failed = true;
+            return false;
+        }
+        memcpy (value, pos, 8);
+        pos += 8;
+        return true;
+    }
+
+    bool skip (int wire_type)
+    {
+        uint64_t value = 0;
+        const unsigned char *data = NULL;
+        size_t size = 0;
+        switch (wire_type)
+        {
+            case varint:
+                return read_varint (&value);
+            case fixed64:
+                return advance (8);
+            case length_delimited:
+                return read_bytes (&data, &size);
+            case fixed32:
+                return advance (4);
+            default:
+                failed = true;
+                return false;
+        }
+    }
+
+    bool at_end () const
+    {
+        return pos >= end;
+    }
+
+    bool is_failed () const
+    {
+        return failed;
+    }
+
+private:
+    const unsigned char *pos;
+    const unsigned char *end;
+    bool failed;
+
+    bool advance (size_t size)
+    {
+        if ((size_t)(end - pos) < size)
+        {
+            failed = true;
+            return false;
+        }
+        pos += size;
+        return true;
+    }
+};
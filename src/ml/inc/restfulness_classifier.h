@@ -21,4 +21,20 @@ public:
         *output = 1.0 - (*output);
         return res;
     }
+
+    int predict_batch (
+        double *data, int batch_size, int feature_len, double *output, int *output_len)
+    {
+        int res = MindfulnessClassifier::predict_batch (
+            data, batch_size, feature_len, output, output_len);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+        for (int i = 0; i < *output_len; i++)
+        {
+            output[i] = 1.0 - output[i];
+        }
+        return res;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include <sys/stat.h>
+
+#include "brainflow_constants.h"
+#include "lazy_classifier.h"
+
+
+// global counter instead of timestamps, registry compares it to find least recently used model
+static std::atomic<uint64_t> lazy_model_clock (0);
+
+
+int LazyClassifier::prepare ()
+{
+    std::shared_ptr<BaseClassifier> test_model = NULL;
+    int res = create_func (params, test_model);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::err, "unsupported model params");
+    }
+    return res;
+}
+
+int LazyClassifier::predict (double *data, int data_len, double *output, int *output_len)
+{
+    std::shared_ptr<BaseClassifier> loaded_model = NULL;
+    int res = acquire (loaded_model);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return loaded_model->run_predict (data, data_len, output, output_len);
+}
+
+int LazyClassifier::predict_batch (
+    double *data, int batch_size, int feature_len, double *output, int *output_len)
+{
+    std::shared_ptr<BaseClassifier> loaded_model = NULL;
+    int res = acquire (loaded_model);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return loaded_model->run_predict_batch (data, batch_size, feature_len, output, output_len);
+}
+
+int LazyClassifier::predict_float (float *data, int data_len, double *output, int *output_len)
+{
+    std::shared_ptr<BaseClassifier> loaded_model = NULL;
+    int res = acquire (loaded_model);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return loaded_model->run_predict (data, data_len, output, output_len);
+}
+
+int LazyClassifier::predict_batch_float (
+    float *data, int batch_size, int feature_len, double *output, int *output_len)
+{
+    std::shared_ptr<BaseClassifier> loaded_model = NULL;
+    int res = acquire (loaded_model);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return loaded_model->run_predict_batch (data, batch_size, feature_len, output, output_len);
+}
+
+int LazyClassifier::release ()
+{
+    unload ();
+    registry->on_unloaded (this);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int LazyClassifier::load ()
+{
+    std::shared_ptr<BaseClassifier> loaded_model = NULL;
+    return acquire (loaded_model);
+}
+
+// model is released by the last predict call which still uses it
+void LazyClassifier::unload ()
+{
+    std::shared_ptr<BaseClassifier> old_model = NULL;
+    {
+        std::lock_guard<std::mutex> lock (state_mutex);
+        old_model = model;
+        model = NULL;
+    }
+    if (old_model != NULL)
+    {
+        safe_logger (spdlog::level::info, "unloading model {}", params.file);
+    }
+}
+
+bool LazyClassifier::is_loaded ()
+{
+    std::lock_guard<std::mutex> lock (state_mutex);
+    return model != NULL;
+}
+
+int LazyClassifier::acquire (std::shared_ptr<BaseClassifier> &loaded_model)
+{
+    last_used.store (++lazy_model_clock, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock (state_mutex);
+        loaded_model = model;
+    }
+    if (loaded_model != NULL)
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    // only callers of this model wait for loading, other models are not blocked
+    std::lock_guard<std::mutex> load_lock (load_mutex);
+    {
+        std::lock_guard<std::mutex> lock (state_mutex);
+        loaded_model = model;
+    }
+    if (loaded_model != NULL)
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    int res = create_func (params, loaded_model);
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::info, "loading model {}", params.file);
+        res = loaded_model->prepare ();
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::err, "failed to load model {}", params.file);
+        loaded_model = NULL;
+        return res;
+    }
+    {
+        std::lock_guard<std::mutex> lock (state_mutex);
+        model = loaded_model;
+    }
+    registry->on_loaded (shared_from_this (), estimate_memory ());
+    return res;
+}
+
+// size of model file is used as an estimation, built in models have no file and cost nothing
+size_t LazyClassifier::estimate_memory ()
+{
+    struct stat file_info;
+    if ((params.file.empty ()) || (stat (params.file.c_str (), &file_info) != 0))
+    {
+        return 0;
+    }
+    return (size_t)file_info.st_size;
+}
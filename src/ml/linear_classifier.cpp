@@ -0,0 +1,969 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdint.h>
+
+#include "brainflow_constants.h"
+#include "linear_classifier.h"
+#include "proto_reader.h"
+
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+
+// only parts of onnx messages which are needed for linear models are parsed, see onnx.proto for
+// field numbers
+struct OnnxAttribute
+{
+    double f;
+    int64_t i;
+    std::string s;
+    std::vector<double> floats;
+    std::vector<int64_t> ints;
+    int num_strings;
+
+    OnnxAttribute ()
+    {
+        f = 0.0;
+        i = 0;
+        num_strings = 0;
+    }
+};
+
+struct OnnxNode
+{
+    std::string op_type;
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+    std::map<std::string, OnnxAttribute> attributes;
+
+    bool has_attribute (const char *name) const
+    {
+        return attributes.find (name) != attributes.end ();
+    }
+
+    const OnnxAttribute &get_attribute (const char *name) const
+    {
+        static const OnnxAttribute empty;
+        auto it = attributes.find (name);
+        return (it == attributes.end ()) ? empty : it->second;
+    }
+};
+
+struct OnnxTensor
+{
+    std::vector<int64_t> dims;
+    std::vector<double> data;
+};
+
+struct OnnxGraph
+{
+    std::vector<OnnxNode> nodes;
+    std::map<std::string, OnnxTensor> initializers;
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+
+    bool is_constant (const std::string &name) const
+    {
+        return initializers.find (name) != initializers.end ();
+    }
+};
+
+static bool read_floats (ProtoReader &reader, int wire_type, std::vector<double> &values)
+{
+    float value = 0.0f;
+    if (wire_type == ProtoReader::fixed32)
+    {
+        if (!reader.read_float (&value))
+        {
+            return false;
+        }
+        values.push_back (value);
+        return true;
+    }
+    const unsigned char *data = NULL;
+    size_t size = 0;
+    if ((wire_type != ProtoReader::length_delimited) || (!reader.read_bytes (&data, &size)) ||
+        (size % 4 != 0))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < size; i += 4)
+    {
+        memcpy (&value, data + i, 4);
+        values.push_back (value);
+    }
+    return true;
+}
+
+static bool read_doubles (ProtoReader &reader, int wire_type, std::vector<double> &values)
+{
+    double value = 0.0;
+    if (wire_type == ProtoReader::fixed64)
+    {
+        if (!reader.read_double (&value))
+        {
+            return false;
+        }
+        values.push_back (value);
+        return true;
+    }
+    const unsigned char *data = NULL;
+    size_t size = 0;
+    if ((wire_type != ProtoReader::length_delimited) || (!reader.read_bytes (&data, &size)) ||
+        (size % 8 != 0))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < size; i += 8)
+    {
+        memcpy (&value, data + i, 8);
+        values.push_back (value);
+    }
+    return true;
+}
+
+static bool read_ints (ProtoReader &reader, int wire_type, std::vector<int64_t> &values)
+{
+    uint64_t value = 0;
+    if (wire_type == ProtoReader::varint)
+    {
+        if (!reader.read_varint (&value))
+        {
+            return false;
+        }
+        values.push_back ((int64_t)value);
+        return true;
+    }
+    const unsigned char *data = NULL;
+    size_t size = 0;
+    if ((wire_type != ProtoReader::length_delimited) || (!reader.read_bytes (&data, &size)))
+    {
+        return false;
+    }
+    ProtoReader packed (data, size);
+    while (!packed.at_end ())
+    {
+        if (!packed.read_varint (&value))
+        {
+            return false;
+        }
+        values.push_back ((int64_t)value);
+    }
+    return true;
+}
+
+static bool parse_attribute (const unsigned char *data, size_t size, OnnxNode &node)
+{
+    ProtoReader reader (data, size);
+    std::string name;
+    OnnxAttribute attribute;
+    std::vector<double> value;
+    int field = 0;
+    int wire_type = 0;
+    bool res = true;
+    while ((res) && (reader.next_field (&field, &wire_type)))
+    {
+        uint64_t integer = 0;
+        switch (field)
+        {
+            case 1:
+                res = reader.read_string (&name);
+                break;
+            case 2:
+                res = read_floats (reader, wire_type, value);
+                attribute.f = value.empty () ? 0.0 : value.back ();
+                break;
+            case 3:
+                res = reader.read_varint (&integer);
+                attribute.i = (int64_t)integer;
+                break;
+            case 4:
+                res = reader.read_string (&attribute.s);
+                break;
+            case 7:
+                res = read_floats (reader, wire_type, attribute.floats);
+                break;
+            case 8:
+                res = read_ints (reader, wire_type, attribute.ints);
+                break;
+            case 9:
+                attribute.num_strings++;
+                res = reader.skip (wire_type);
+                break;
+            default:
+                res = reader.skip (wire_type);
+                break;
+        }
+    }
+    node.attributes[name] = attribute;
+    return (res) && (!reader.is_failed ());
+}
+
+static bool parse_node (const unsigned char *data, size_t size, OnnxGraph &graph)
+{
+    ProtoReader reader (data, size);
+    OnnxNode node;
+    int field = 0;
+    int wire_type = 0;
+    bool res = true;
+    while ((res) && (reader.next_field (&field, &wire_type)))
+    {
+        const unsigned char *nested = NULL;
+        size_t nested_size = 0;
+        std::string name;
+        switch (field)
+        {
+            case 1:
+                res = reader.read_string (&name);
+                node.inputs.push_back (name);
+                break;
+            case 2:
+                res = reader.read_string (&name);
+                node.outputs.push_back (name);
+                break;
+            case 4:
+                res = reader.read_string (&node.op_type);
+                break;
+            case 5:
+                res = (reader.read_bytes (&nested, &nested_size)) &&
+                    (parse_attribute (nested, nested_size, node));
+                break;
+            default:
+                res = reader.skip (wire_type);
+                break;
+        }
+    }
+    graph.nodes.push_back (node);
+    return (res) && (!reader.is_failed ());
+}
+
+static bool parse_tensor (const unsigned char *data, size_t size, OnnxGraph &graph)
+{
+    ProtoReader reader (data, size);
+    OnnxTensor tensor;
+    std::string name;
+    uint64_t data_type = 0;
+    const unsigned char *raw_data = NULL;
+    size_t raw_size = 0;
+    int field = 0;
+    int wire_type = 0;
+    bool res = true;
+    while ((res) && (reader.next_field (&field, &wire_type)))
+    {
+        switch (field)
+        {
+            case 1:
+                res = read_ints (reader, wire_type, tensor.dims);
+                break;
+            case 2:
+                res = reader.read_varint (&data_type);
+                break;
+            case 4:
+                res = read_floats (reader, wire_type, tensor.data);
+                break;
+            case 8:
+                res = reader.read_string (&name);
+                break;
+            case 9:
+                res = reader.read_bytes (&raw_data, &raw_size);
+                break;
+            case 10:
+                res = read_doubles (reader, wire_type, tensor.data);
+                break;
+            default:
+                res = reader.skip (wire_type);
+                break;
+        }
+    }
+    if ((res) && (raw_data != NULL))
+    {
+        // 1 is float and 11 is double in TensorProto.DataType, others are not used by linear models
+        if (data_type == 1)
+        {
+            res = (raw_size % 4 == 0);
+            for (size_t i = 0; (res) && (i < raw_size); i += 4)
+            {
+                float value = 0.0f;
+                memcpy (&value, raw_data + i, 4);
+                tensor.data.push_back (value);
+            }
+        }
+        else if (data_type == 11)
+        {
+            res = (raw_size % 8 == 0);
+            for (size_t i = 0; (res) && (i < raw_size); i += 8)
+            {
+                double value = 0.0;
+                memcpy (&value, raw_data + i, 8);
+                tensor.data.push_back (value);
+            }
+        }
+    }
+    graph.initializers[name] = tensor;
+    return (res) && (!reader.is_failed ());
+}
+
+// only name of graph input or output is needed, types are checked by values passed to predict
+static bool parse_value_info (
+    const unsigned char *data, size_t size, std::vector<std::string> &names)
+{
+    ProtoReader reader (data, size);
+    std::string name;
+    int field = 0;
+    int wire_type = 0;
+    bool res = true;
+    while ((res) && (reader.next_field (&field, &wire_type)))
+    {
+        res = (field == 1) ? reader.read_string (&name) : reader.skip (wire_type);
+    }
+    names.push_back (name);
+    return (res) && (!reader.is_failed ());
+}
+
+static bool parse_graph (const unsigned char *data, size_t size, OnnxGraph &graph)
+{
+    ProtoReader reader (data, size);
+    int field = 0;
+    int wire_type = 0;
+    bool res = true;
+    while ((res) && (reader.next_field (&field, &wire_type)))
+    {
+        const unsigned char *nested = NULL;
+        size_t nested_size = 0;
+        switch (field)
+        {
+            case 1:
+                res = (reader.read_bytes (&nested, &nested_size)) &&
+                    (parse_node (nested, nested_size, graph));
+                break;
+            case 5:
+                res = (reader.read_bytes (&nested, &nested_size)) &&
+                    (parse_tensor (nested, nested_size, graph));
+                break;
+            case 11:
+                res = (reader.read_bytes (&nested, &nested_size)) &&
+                    (parse_value_info (nested, nested_size, graph.inputs));
+                break;
+            case 12:
+                res = (reader.read_bytes (&nested, &nested_size)) &&
+                    (parse_value_info (nested, nested_size, graph.outputs));
+                break;
+            default:
+                res = reader.skip (wire_type);
+                break;
+        }
+    }
+    return (res) && (!reader.is_failed ());
+}
+
+static bool parse_model (const std::string &content, OnnxGraph &graph)
+{
+    ProtoReader reader ((const unsigned char *)content.data (), content.size ());
+    int field = 0;
+    int wire_type = 0;
+    bool res = true;
+    bool has_graph = false;
+    while ((res) && (reader.next_field (&field, &wire_type)))
+    {
+        if (field == 7)
+        {
+            const unsigned char *nested = NULL;
+            size_t nested_size = 0;
+            res = (reader.read_bytes (&nested, &nested_size)) &&
+                (parse_graph (nested, nested_size, graph));
+            has_graph = true;
+        }
+        else
+        {
+            res = reader.skip (wire_type);
+        }
+    }
+    return (res) && (has_graph) && (!reader.is_failed ());
+}
+
+// independent accumulators break dependency chain between iterations, so compiler can keep them in
+// simd registers without reordering floating point additions
+template <typename T>
+static inline double dot_product (const double *a, const T *b, int len)
+{
+    double sum0 = 0.0;
+    double sum1 = 0.0;
+    double sum2 = 0.0;
+    double sum3 = 0.0;
+    int i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        sum0 += a[i] * b[i];
+        sum1 += a[i + 1] * b[i + 1];
+        sum2 += a[i + 2] * b[i + 2];
+        sum3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < len; i++)
+    {
+        sum0 += a[i] * b[i];
+    }
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+int LinearClassifier::prepare ()
+{
+    if (num_scores > 0)
+    {
+        return (int)BrainFlowExitCodes::ANOTHER_CLASSIFIER_IS_PREPARED_ERROR;
+    }
+    if (params.file.empty ())
+    {
+        safe_logger (spdlog::level::err, "file with linear model is not provided");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    std::string extension = (params.file.size () > 5) ?
+        params.file.substr (params.file.size () - 5) :
+        std::string ("");
+    std::transform (extension.begin (), extension.end (), extension.begin (), ::tolower);
+    if (extension == ".onnx")
+    {
+        res = load_onnx ();
+    }
+    else
+    {
+        res = load_coefficients ();
+    }
+    if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (num_outputs > params.max_array_size))
+    {
+        safe_logger (spdlog::level::err, "model has {} outputs, max array size is {}",
+            num_outputs, params.max_array_size);
+        res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        release ();
+        return res;
+    }
+    safe_logger (spdlog::level::info, "linear model loaded, features: {}, outputs: {}",
+        num_features, num_outputs);
+    return res;
+}
+
+int LinearClassifier::predict (double *data, int data_len, double *output, int *output_len)
+{
+    return predict_batch (data, 1, data_len, output, output_len);
+}
+
+int LinearClassifier::predict_batch (
+    double *data, int batch_size, int feature_len, double *output, int *output_len)
+{
+    return score_batch (data, batch_size, feature_len, output, output_len);
+}
+
+int LinearClassifier::predict_float (float *data, int data_len, double *output, int *output_len)
+{
+    return score_batch (data, 1, data_len, output, output_len);
+}
+
+int LinearClassifier::predict_batch_float (
+    float *data, int batch_size, int feature_len, double *output, int *output_len)
+{
+    return score_batch (data, batch_size, feature_len, output, output_len);
+}
+
+// float input is widened inside dot product, so there is no extra copy for it
+template <typename T>
+int LinearClassifier::score_batch (
+    const T *data, int batch_size, int feature_len, double *output, int *output_len)
+{
+    if (num_scores < 1)
+    {
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    if ((data == NULL) || (output == NULL) || (output_len == NULL) || (batch_size < 1) ||
+        (feature_len != num_features))
+    {
+        safe_logger (spdlog::level::err,
+            "Incorrect arguments. Null pointers or invalid feature vector size, expected size: {}",
+            num_features);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    for (int i = 0; i < batch_size; i++)
+    {
+        const T *sample = data + (size_t)i * num_features;
+        double *scores = output + (size_t)i * num_outputs;
+        for (int j = 0; j < num_scores; j++)
+        {
+            scores[j] = intercepts[j] +
+                dot_product (&coefficients[(size_t)j * num_features], sample, num_features);
+        }
+    }
+    if ((post_transform != NONE) || (normalization != NO_NORM) || (num_outputs > num_scores))
+    {
+        for (int i = 0; i < batch_size; i++)
+        {
+            apply_post_transform (output + (size_t)i * num_outputs);
+        }
+    }
+    *output_len = batch_size * num_outputs;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int LinearClassifier::release ()
+{
+    coefficients.clear ();
+    intercepts.clear ();
+    num_features = 0;
+    num_scores = 0;
+    num_outputs = 0;
+    post_transform = NONE;
+    normalization = NO_NORM;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// values holds num_scores scores and has space for num_outputs results
+void LinearClassifier::apply_post_transform (double *values)
+{
+    if (num_outputs > num_scores)
+    {
+        // binary model has a single score, outputs are 1 - p, p for logistic and 1 - score, score
+        // otherwise
+        if (post_transform == LOGISTIC)
+        {
+            values[0] = 1.0 / (1.0 + exp (-values[0]));
+        }
+        values[1] = values[0];
+        values[0] = 1.0 - values[1];
+    }
+    else if (post_transform == LOGISTIC)
+    {
+        for (int i = 0; i < num_scores; i++)
+        {
+            values[i] = 1.0 / (1.0 + exp (-values[i]));
+        }
+    }
+    else if (post_transform == SOFTMAX)
+    {
+        double max_value = values[0];
+        for (int i = 1; i < num_scores; i++)
+        {
+            max_value = std::max (max_value, values[i]);
+        }
+        double sum = 0.0;
+        for (int i = 0; i < num_scores; i++)
+        {
+            values[i] = exp (values[i] - max_value);
+            sum += values[i];
+        }
+        for (int i = 0; i < num_scores; i++)
+        {
+            values[i] /= sum;
+        }
+    }
+    if (normalization != NO_NORM)
+    {
+        double norm = 0.0;
+        for (int i = 0; i < num_outputs; i++)
+        {
+            if (normalization == NORM_MAX)
+            {
+                norm = (i == 0) ? values[i] : std::max (norm, values[i]);
+            }
+            else if (normalization == NORM_L1)
+            {
+                norm += fabs (values[i]);
+            }
+            else
+            {
+                norm += values[i] * values[i];
+            }
+        }
+        if (normalization == NORM_L2)
+        {
+            norm = sqrt (norm);
+        }
+        // the same as onnxruntime, zero vector is kept as is
+        for (int i = 0; (i < num_outputs) && (norm != 0.0); i++)
+        {
+            values[i] /= norm;
+        }
+    }
+}
+
+int LinearClassifier::parse_post_transform (const std::string &name)
+{
+    std::string lower_name = name;
+    std::transform (lower_name.begin (), lower_name.end (), lower_name.begin (), ::tolower);
+    if ((lower_name.empty ()) || (lower_name == "none"))
+    {
+        post_transform = NONE;
+    }
+    else if (lower_name == "logistic")
+    {
+        post_transform = LOGISTIC;
+    }
+    else if (lower_name == "softmax")
+    {
+        post_transform = SOFTMAX;
+    }
+    else
+    {
+        safe_logger (spdlog::level::err, "unsupported post transform: {}", name);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int LinearClassifier::parse_normalization (const std::string &name)
+{
+    if (name == "MAX")
+    {
+        normalization = NORM_MAX;
+    }
+    else if (name == "L1")
+    {
+        normalization = NORM_L1;
+    }
+    else if (name == "L2")
+    {
+        normalization = NORM_L2;
+    }
+    else
+    {
+        safe_logger (spdlog::level::err, "unsupported normalizer: {}", name);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// weights are num_scores x num_features or num_features x num_scores if transposed, bias is empty,
+// has a single value or value per score
+int LinearClassifier::set_linear_part (const std::vector<double> &weights,
+    const std::vector<double> &bias, int scores, bool transposed)
+{
+    if ((scores < 1) || (weights.empty ()) || (weights.size () % (size_t)scores != 0) ||
+        ((bias.size () > 1) && (bias.size () != (size_t)scores)))
+    {
+        safe_logger (spdlog::level::err, "invalid shape of linear model coefficients");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    num_scores = scores;
+    num_outputs = scores;
+    num_features = (int)(weights.size () / (size_t)scores);
+    if (transposed)
+    {
+        coefficients.resize (weights.size ());
+        for (int i = 0; i < num_features; i++)
+        {
+            for (int j = 0; j < num_scores; j++)
+            {
+                coefficients[(size_t)j * num_features + i] = weights[(size_t)i * num_scores + j];
+            }
+        }
+    }
+    else
+    {
+        coefficients = weights;
+    }
+    intercepts.assign ((size_t)num_scores, 0.0);
+    for (int i = 0; (i < num_scores) && (!bias.empty ()); i++)
+    {
+        intercepts[i] = (bias.size () == 1) ? bias[0] : bias[i];
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int LinearClassifier::load_coefficients ()
+{
+    std::ifstream file (params.file);
+    if (!file.is_open ())
+    {
+        safe_logger (spdlog::level::err, "failed to open file {}", params.file);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    try
+    {
+        json config = json::parse (file);
+        std::vector<double> weights;
+        int scores = 1;
+        json rows = config.at ("coefficients");
+        if ((!rows.empty ()) && (rows[0].is_array ()))
+        {
+            scores = (int)rows.size ();
+            for (size_t i = 0; i < rows.size (); i++)
+            {
+                std::vector<double> row = rows[i].get<std::vector<double>> ();
+                weights.insert (weights.end (), row.begin (), row.end ());
+            }
+        }
+        else
+        {
+            weights = rows.get<std::vector<double>> ();
+        }
+        std::vector<double> bias = config.value ("intercepts", std::vector<double> ());
+        int res = parse_post_transform (config.value ("post_transform", ""));
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            res = set_linear_part (weights, bias, scores, false);
+        }
+        // the same as predict_proba for binary logistic regression
+        if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (num_scores == 1) &&
+            (post_transform == LOGISTIC))
+        {
+            num_outputs = 2;
+        }
+        return res;
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, "invalid file with coefficients: {}", e.what ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+}
+
+int LinearClassifier::load_onnx ()
+{
+    std::ifstream file (params.file, std::ios::binary);
+    if (!file.is_open ())
+    {
+        safe_logger (spdlog::level::err, "failed to open file {}", params.file);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf ();
+    OnnxGraph graph;
+    if (!parse_model (buffer.str (), graph))
+    {
+        safe_logger (spdlog::level::err, "failed to parse onnx model {}", params.file);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    // scores flow from the single non constant graph input through every node, label output of
+    // LinearClassifier may be only cast and ZipMap may only wrap final scores
+    std::string scores_tensor;
+    for (size_t i = 0; i < graph.inputs.size (); i++)
+    {
+        if (graph.is_constant (graph.inputs[i]))
+        {
+            continue;
+        }
+        if (!scores_tensor.empty ())
+        {
+            safe_logger (spdlog::level::err, "onnx model should have a single input");
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        scores_tensor = graph.inputs[i];
+    }
+    if (scores_tensor.empty ())
+    {
+        safe_logger (spdlog::level::err, "onnx model has no input");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    bool has_linear_part = false;
+    std::set<std::string> label_tensors;
+    std::string zip_map_output;
+    for (size_t i = 0; (i < graph.nodes.size ()) && (res == (int)BrainFlowExitCodes::STATUS_OK);
+         i++)
+    {
+        const OnnxNode &node = graph.nodes[i];
+        const std::string &op = node.op_type;
+        if (((op == "Cast") || (op == "Identity")) && (node.inputs.size () == 1) &&
+            (node.outputs.size () == 1) && (label_tensors.count (node.inputs[0]) > 0))
+        {
+            label_tensors.insert (node.outputs[0]);
+            continue;
+        }
+        // scores are the first input, Add may take them as the second one, other inputs should be
+        // initializers, omitted optional inputs are NULL
+        size_t data_input = 0;
+        if ((op == "Add") && (node.inputs.size () == 2) && (node.inputs[1] == scores_tensor))
+        {
+            data_input = 1;
+        }
+        bool is_chain_node = (zip_map_output.empty ()) && (node.inputs.size () > data_input) &&
+            (node.inputs[data_input] == scores_tensor);
+        std::vector<const OnnxTensor *> constants;
+        for (size_t j = 0; (is_chain_node) && (j < node.inputs.size ()); j++)
+        {
+            if (j == data_input)
+            {
+                continue;
+            }
+            auto constant = graph.initializers.find (node.inputs[j]);
+            if (constant != graph.initializers.end ())
+            {
+                constants.push_back (&constant->second);
+            }
+            else if (node.inputs[j].empty ())
+            {
+                constants.push_back (NULL);
+            }
+            else
+            {
+                is_chain_node = false;
+            }
+        }
+        size_t max_constants = (op == "Gemm") ? 2 : (((op == "MatMul") || (op == "Add")) ? 1 : 0);
+        if ((!is_chain_node) || (constants.size () > max_constants))
+        {
+            safe_logger (spdlog::level::err,
+                "{} node should read output of the previous node and constants, use onnx "
+                "classifier for other graphs",
+                op);
+            res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+            break;
+        }
+
+        if ((op == "Cast") || (op == "Identity"))
+        {
+            // values are kept in doubles, casts between float types dont change them
+        }
+        else if (op == "ZipMap")
+        {
+            zip_map_output = node.outputs.empty () ? "" : node.outputs[0];
+            continue;
+        }
+        else if ((has_linear_part) &&
+            ((op == "LinearClassifier") || (op == "LinearRegressor") || (op == "Gemm") ||
+                (op == "MatMul")))
+        {
+            safe_logger (spdlog::level::err, "only one linear operator is supported");
+            res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        else if ((op == "LinearClassifier") || (op == "LinearRegressor"))
+        {
+            const std::vector<double> &bias = node.get_attribute ("intercepts").floats;
+            int scores = (int)bias.size ();
+            int num_labels = std::max ((int)node.get_attribute ("classlabels_ints").ints.size (),
+                node.get_attribute ("classlabels_strings").num_strings);
+            if (op == "LinearRegressor")
+            {
+                scores =
+                    node.has_attribute ("targets") ? (int)node.get_attribute ("targets").i : 1;
+            }
+            else if (scores == 0)
+            {
+                scores = num_labels;
+            }
+            res = parse_post_transform (node.get_attribute ("post_transform").s);
+            if (res == (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                res = set_linear_part (
+                    node.get_attribute ("coefficients").floats, bias, scores, false);
+            }
+            // onnxruntime outputs 1 - score, score if there is a single score for two classes and
+            // ignores post transform in this case
+            if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (num_scores == 1) &&
+                (num_labels == 2))
+            {
+                num_outputs = 2;
+                post_transform = NONE;
+            }
+            has_linear_part = true;
+            // outputs are label and scores
+            if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (op == "LinearClassifier"))
+            {
+                if (node.outputs.size () != 2)
+                {
+                    safe_logger (
+                        spdlog::level::err, "LinearClassifier should output label and scores");
+                    res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+                    break;
+                }
+                label_tensors.insert (node.outputs[0]);
+                scores_tensor = node.outputs[1];
+                continue;
+            }
+        }
+        else if ((op == "Gemm") || (op == "MatMul"))
+        {
+            const OnnxTensor *weights = constants.empty () ? NULL : constants[0];
+            if ((weights == NULL) || (weights->dims.size () != 2) ||
+                (node.get_attribute ("transA").i != 0))
+            {
+                safe_logger (spdlog::level::err, "{} should use constant 2d weights", op);
+                res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+                break;
+            }
+            bool transposed = (node.get_attribute ("transB").i == 0);
+            double alpha = node.has_attribute ("alpha") ? node.get_attribute ("alpha").f : 1.0;
+            double beta = node.has_attribute ("beta") ? node.get_attribute ("beta").f : 1.0;
+            std::vector<double> bias;
+            if ((constants.size () > 1) && (constants[1] != NULL))
+            {
+                bias = constants[1]->data;
+                for (size_t j = 0; j < bias.size (); j++)
+                {
+                    bias[j] *= beta;
+                }
+            }
+            int scores = (int)(transposed ? weights->dims[1] : weights->dims[0]);
+            res = set_linear_part (weights->data, bias, scores, transposed);
+            for (size_t j = 0; j < coefficients.size (); j++)
+            {
+                coefficients[j] *= alpha;
+            }
+            has_linear_part = true;
+        }
+        else if ((op == "Add") && (has_linear_part) && (constants.size () == 1) &&
+            (constants[0] != NULL) &&
+            ((constants[0]->data.size () == 1) ||
+                (constants[0]->data.size () == intercepts.size ())))
+        {
+            const std::vector<double> &bias = constants[0]->data;
+            for (size_t j = 0; j < intercepts.size (); j++)
+            {
+                intercepts[j] += (bias.size () == 1) ? bias[0] : bias[j];
+            }
+        }
+        else if (((op == "Sigmoid") || (op == "Softmax")) && (has_linear_part) &&
+            (post_transform == NONE) && (normalization == NO_NORM))
+        {
+            post_transform = (op == "Sigmoid") ? LOGISTIC : SOFTMAX;
+        }
+        else if ((op == "Normalizer") && (has_linear_part) && (normalization == NO_NORM))
+        {
+            res = parse_normalization (node.get_attribute ("norm").s);
+        }
+        else
+        {
+            safe_logger (spdlog::level::err,
+                "operator {} is not supported by linear classifier, use onnx classifier", op);
+            res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (node.outputs.size () != 1))
+        {
+            safe_logger (spdlog::level::err, "{} node should have a single output", op);
+            res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            scores_tensor = node.outputs[0];
+        }
+    }
+    if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (!has_linear_part))
+    {
+        safe_logger (spdlog::level::err, "onnx model has no linear operator");
+        res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // selected output should hold final scores, labels are not computed
+    bool has_scores_output = false;
+    for (size_t i = 0; i < graph.outputs.size (); i++)
+    {
+        if (((params.output_name.empty ()) || (graph.outputs[i] == params.output_name)) &&
+            ((graph.outputs[i] == scores_tensor) || (graph.outputs[i] == zip_map_output)))
+        {
+            has_scores_output = true;
+        }
+    }
+    if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (!has_scores_output))
+    {
+        safe_logger (spdlog::level::err, "onnx model should output scores of the last node {}",
+            scores_tensor);
+        res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return res;
+}
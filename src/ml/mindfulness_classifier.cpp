@@ -31,6 +31,36 @@ int MindfulnessClassifier::predict (double *data, int data_len, double *output,
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+int MindfulnessClassifier::predict_batch (
+    double *data, int batch_size, int feature_len, double *output, int *output_len)
+{
+    if ((feature_len < 5) || (batch_size < 1) || (data == NULL) || (output == NULL) ||
+        (output_len == NULL))
+    {
+        safe_logger (spdlog::level::err,
+            "Incorrect arguments. Null pointers or invalid feature vector size.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // first pass computes linear part for all samples, second applies sigmoid, both loops have no
+    // branches and are vectorized by compiler
+    for (int i = 0; i < batch_size; i++)
+    {
+        const double *sample = data + (size_t)i * feature_len;
+        double value = mindfulness_intercept;
+        for (int j = 0; j < 5; j++)
+        {
+            value += mindfulness_coefficients[j] * sample[j];
+        }
+        output[i] = -value;
+    }
+    for (int i = 0; i < batch_size; i++)
+    {
+        output[i] = 1.0 / (1.0 + exp (output[i]));
+    }
+    *output_len = batch_size;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 int MindfulnessClassifier::release ()
 {
     return (int)BrainFlowExitCodes::STATUS_OK;
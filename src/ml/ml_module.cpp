@@ -3,16 +3,22 @@
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
+#include "band_power_pipeline.h"
 #include "base_classifier.h"
 #include "brainflow_constants.h"
 #include "brainflow_model_params.h"
 #include "brainflow_version.h"
 #include "dyn_lib_classifier.h"
+#include "get_dll_dir.h"
+#include "lazy_classifier.h"
+#include "linear_classifier.h"
 #include "mindfulness_classifier.h"
 #include "ml_module.h"
 #include "onnx_classifier.h"
 #include "restfulness_classifier.h"
+#include "runtime_dll_loader.h"
 
 #include "json.hpp"
 
@@ -20,28 +26,28 @@ using json = nlohmann::json;
 
 int string_to_brainflow_model_params (const char *json_params, struct BrainFlowModelParams *params);
 
-std::map<struct BrainFlowModelParams, std::shared_ptr<BaseClassifier>> ml_models;
+// registry is never deleted, lazy models unregister themselves from it in destructors of static
+// maps below and its worker thread is stopped by release_all, not by a static destructor
+ModelRegistry *model_registry = new ModelRegistry ();
+// models_mutex guards only these maps, it is never held while a model prepares, predicts or
+// releases, so different models and thread safe classifiers run concurrently
+std::map<struct BrainFlowModelParams, int> model_handles;
+std::map<int, std::shared_ptr<BaseClassifier>> ml_models;
+int next_model_handle = 1;
 std::mutex models_mutex;
+// pipelines own their models, they are not added to maps above
+std::map<int, std::shared_ptr<BandPowerPipeline>> pipelines;
+int next_pipeline_handle = 1;
+std::mutex pipelines_mutex;
+// libs used by pipelines are loaded once and never unloaded
+DLLLoader *board_controller_loader = NULL;
+DLLLoader *data_handler_loader = NULL;
+BandPowerPipelineApi pipeline_api;
+std::mutex pipeline_api_mutex;
 
 
-int prepare (const char *json_params)
+static int create_model (struct BrainFlowModelParams key, std::shared_ptr<BaseClassifier> &model)
 {
-    std::lock_guard<std::mutex> lock (models_mutex);
-
-    std::shared_ptr<BaseClassifier> model = NULL;
-    BaseClassifier::ml_logger->trace ("(Prepararing)Incoming json: {}", json_params);
-    struct BrainFlowModelParams key (
-        (int)BrainFlowMetrics::MINDFULNESS, (int)BrainFlowClassifiers::DEFAULT_CLASSIFIER);
-    int res = string_to_brainflow_model_params (json_params, &key);
-    if (res != (int)BrainFlowExitCodes::STATUS_OK)
-    {
-        return res;
-    }
-    if (ml_models.find (key) != ml_models.end ())
-    {
-        return (int)BrainFlowExitCodes::ANOTHER_CLASSIFIER_IS_PREPARED_ERROR;
-    }
-
     if ((key.metric == (int)BrainFlowMetrics::USER_DEFINED) &&
         (key.classifier == (int)BrainFlowClassifiers::DYN_LIB_CLASSIFIER))
     {
@@ -52,6 +58,11 @@ int prepare (const char *json_params)
     {
         model = std::shared_ptr<BaseClassifier> (new OnnxClassifier (key));
     }
+    else if ((key.metric == (int)BrainFlowMetrics::USER_DEFINED) &&
+        (key.classifier == (int)BrainFlowClassifiers::LINEAR_CLASSIFIER))
+    {
+        model = std::shared_ptr<BaseClassifier> (new LinearClassifier (key));
+    }
     else if ((key.metric == (int)BrainFlowMetrics::MINDFULNESS) &&
         (key.classifier == (int)BrainFlowClassifiers::DEFAULT_CLASSIFIER))
     {
@@ -66,62 +77,603 @@ int prepare (const char *json_params)
     {
         return (int)BrainFlowExitCodes::UNSUPPORTED_CLASSIFIER_AND_METRIC_COMBINATION_ERROR;
     }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// lazy models are only validated here and loaded on first use or by preload
+static int prepare_model (const char *json_params, int *handle, bool lazy)
+{
+    BaseClassifier::ml_logger->trace ("(Prepararing)Incoming json: {}", json_params);
+    struct BrainFlowModelParams key (
+        (int)BrainFlowMetrics::MINDFULNESS, (int)BrainFlowClassifiers::DEFAULT_CLASSIFIER);
+    int res = string_to_brainflow_model_params (json_params, &key);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    std::shared_ptr<BaseClassifier> model = NULL;
+    if (lazy)
+    {
+        model = std::shared_ptr<BaseClassifier> (
+            new LazyClassifier (key, create_model, model_registry));
+    }
+    else
+    {
+        res = create_model (key, model);
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+
+    // reserve handle first, prepare can be slow and should not block other models
+    int model_handle = 0;
+    {
+        std::lock_guard<std::mutex> lock (models_mutex);
+        if (model_handles.find (key) != model_handles.end ())
+        {
+            return (int)BrainFlowExitCodes::ANOTHER_CLASSIFIER_IS_PREPARED_ERROR;
+        }
+        while ((next_model_handle < 1) || (ml_models.find (next_model_handle) != ml_models.end ()))
+        {
+            next_model_handle = (next_model_handle < 1) ? 1 : next_model_handle + 1;
+        }
+        model_handle = next_model_handle++;
+        model_handles[key] = model_handle;
+    }
 
     res = model->prepare ();
+
+    std::lock_guard<std::mutex> lock (models_mutex);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         BaseClassifier::ml_logger->error ("Unable to prepare model. Please refer to logs above.");
-        model = NULL;
+        model_handles.erase (key);
     }
     else
     {
-        ml_models[key] = model;
+        ml_models[model_handle] = model;
+        if (handle != NULL)
+        {
+            *handle = model_handle;
+        }
     }
     return res;
 }
 
-int predict (double *data, int data_len, double *output, int *output_len, const char *json_params)
+static std::shared_ptr<BaseClassifier> find_model (int handle)
 {
     std::lock_guard<std::mutex> lock (models_mutex);
+    auto model = ml_models.find (handle);
+    if (model == ml_models.end ())
+    {
+        return NULL;
+    }
+    return model->second;
+}
+
+static std::shared_ptr<BaseClassifier> find_model (const char *json_params, int *res)
+{
     struct BrainFlowModelParams key (
         (int)BrainFlowMetrics::MINDFULNESS, (int)BrainFlowClassifiers::DEFAULT_CLASSIFIER);
+    *res = string_to_brainflow_model_params (json_params, &key);
+    if (*res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return NULL;
+    }
+    std::lock_guard<std::mutex> lock (models_mutex);
+    auto handle = model_handles.find (key);
+    if (handle == model_handles.end ())
+    {
+        return NULL;
+    }
+    auto model = ml_models.find (handle->second);
+    if (model == ml_models.end ())
+    {
+        return NULL;
+    }
+    return model->second;
+}
+
+// model is already removed from maps, if another thread still runs predict for it the last owner
+// releases it from the destructor
+static int release_model (std::shared_ptr<BaseClassifier> &model)
+{
+    if (model.use_count () > 1)
+    {
+        BaseClassifier::ml_logger->debug ("Model is in use, it will be released after prediction.");
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    return model->release ();
+}
+
+template <typename T>
+static int predict_model (
+    T *data, int data_len, double *output, int *output_len, const char *json_params)
+{
     BaseClassifier::ml_logger->trace ("(Predict)Incoming json: {}", json_params);
-    int res = string_to_brainflow_model_params (json_params, &key);
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    std::shared_ptr<BaseClassifier> model = find_model (json_params, &res);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto model = ml_models.find (key);
-    if (model == ml_models.end ())
+    if (model == NULL)
     {
         BaseClassifier::ml_logger->error ("Must prepare model before using it for prediction.");
         return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
     }
-    return model->second->predict (data, data_len, output, output_len);
+    return model->run_predict (data, data_len, output, output_len);
 }
 
-int release (const char *json_params)
+template <typename T>
+static int predict_model_batch (T *data, int batch_size, int feature_len, double *output,
+    int *output_len, const char *json_params)
 {
-    std::lock_guard<std::mutex> lock (models_mutex);
+    BaseClassifier::ml_logger->trace ("(PredictBatch)Incoming json: {}", json_params);
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    std::shared_ptr<BaseClassifier> model = find_model (json_params, &res);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    if (model == NULL)
+    {
+        BaseClassifier::ml_logger->error ("Must prepare model before using it for prediction.");
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    return model->run_predict_batch (data, batch_size, feature_len, output, output_len);
+}
+
+template <typename T>
+static int predict_model_with_handle (
+    T *data, int data_len, double *output, int *output_len, int handle)
+{
+    std::shared_ptr<BaseClassifier> model = find_model (handle);
+    if (model == NULL)
+    {
+        BaseClassifier::ml_logger->error ("Must prepare model before using it for prediction.");
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    return model->run_predict (data, data_len, output, output_len);
+}
+
+template <typename T>
+static int predict_model_batch_with_handle (
+    T *data, int batch_size, int feature_len, double *output, int *output_len, int handle)
+{
+    std::shared_ptr<BaseClassifier> model = find_model (handle);
+    if (model == NULL)
+    {
+        BaseClassifier::ml_logger->error ("Must prepare model before using it for prediction.");
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    return model->run_predict_batch (data, batch_size, feature_len, output, output_len);
+}
+
+int prepare (const char *json_params)
+{
+    return prepare_model (json_params, NULL, false);
+}
+
+int predict (double *data, int data_len, double *output, int *output_len, const char *json_params)
+{
+    return predict_model (data, data_len, output, output_len, json_params);
+}
+
+int predict_float (
+    float *data, int data_len, double *output, int *output_len, const char *json_params)
+{
+    return predict_model (data, data_len, output, output_len, json_params);
+}
+
+int predict_batch (double *data, int batch_size, int feature_len, double *output, int *output_len,
+    const char *json_params)
+{
+    return predict_model_batch (data, batch_size, feature_len, output, output_len, json_params);
+}
 
+int predict_batch_float (float *data, int batch_size, int feature_len, double *output,
+    int *output_len, const char *json_params)
+{
+    return predict_model_batch (data, batch_size, feature_len, output, output_len, json_params);
+}
+
+int release (const char *json_params)
+{
+    BaseClassifier::ml_logger->trace ("(Release)Incoming json: {}", json_params);
     struct BrainFlowModelParams key (
         (int)BrainFlowMetrics::MINDFULNESS, (int)BrainFlowClassifiers::DEFAULT_CLASSIFIER);
-    BaseClassifier::ml_logger->trace ("(Release)Incoming json: {}", json_params);
     int res = string_to_brainflow_model_params (json_params, &key);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
 
-    auto model = ml_models.find (key);
-    if (model == ml_models.end ())
+    std::shared_ptr<BaseClassifier> model = NULL;
+    {
+        std::lock_guard<std::mutex> lock (models_mutex);
+        auto handle = model_handles.find (key);
+        auto it = (handle == model_handles.end ()) ? ml_models.end () :
+                                                     ml_models.find (handle->second);
+        if (it == ml_models.end ())
+        {
+            BaseClassifier::ml_logger->error ("Must prepare model before releasing it.");
+            return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+        }
+        model = it->second;
+        ml_models.erase (it);
+        model_handles.erase (handle);
+    }
+    return release_model (model);
+}
+
+int prepare_with_handle (const char *json_params, int *handle)
+{
+    if ((json_params == NULL) || (handle == NULL))
+    {
+        BaseClassifier::ml_logger->error ("json params and handle must not be null.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return prepare_model (json_params, handle, false);
+}
+
+int register_model (const char *json_params, int *handle)
+{
+    if ((json_params == NULL) || (handle == NULL))
+    {
+        BaseClassifier::ml_logger->error ("json params and handle must not be null.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return prepare_model (json_params, handle, true);
+}
+
+int preload_model (int handle)
+{
+    std::shared_ptr<BaseClassifier> model = find_model (handle);
+    if (model == NULL)
     {
-        BaseClassifier::ml_logger->error ("Must prepare model before releasing it.");
+        BaseClassifier::ml_logger->error ("Must register model before preloading it.");
         return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
     }
-    res = model->second->release ();
-    ml_models.erase (model);
-    return res;
+    // models created by prepare are loaded already
+    std::shared_ptr<LazyClassifier> lazy_model = std::dynamic_pointer_cast<LazyClassifier> (model);
+    if (lazy_model != NULL)
+    {
+        model_registry->load_in_background (lazy_model);
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int set_model_registry_limits (int max_loaded_models, int max_memory_mb)
+{
+    if ((max_loaded_models < 0) || (max_memory_mb < 0))
+    {
+        BaseClassifier::ml_logger->error ("limits must be non negative, 0 means no limit.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    model_registry->set_limits (max_loaded_models, (size_t)max_memory_mb * 1024 * 1024);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int predict_with_handle (double *data, int data_len, double *output, int *output_len, int handle)
+{
+    return predict_model_with_handle (data, data_len, output, output_len, handle);
+}
+
+int predict_float_with_handle (
+    float *data, int data_len, double *output, int *output_len, int handle)
+{
+    return predict_model_with_handle (data, data_len, output, output_len, handle);
+}
+
+int predict_batch_with_handle (
+    double *data, int batch_size, int feature_len, double *output, int *output_len, int handle)
+{
+    return predict_model_batch_with_handle (
+        data, batch_size, feature_len, output, output_len, handle);
+}
+
+int predict_batch_float_with_handle (
+    float *data, int batch_size, int feature_len, double *output, int *output_len, int handle)
+{
+    return predict_model_batch_with_handle (
+        data, batch_size, feature_len, output, output_len, handle);
+}
+
+int release_with_handle (int handle)
+{
+    std::shared_ptr<BaseClassifier> model = NULL;
+    {
+        std::lock_guard<std::mutex> lock (models_mutex);
+        auto it = ml_models.find (handle);
+        if (it == ml_models.end ())
+        {
+            BaseClassifier::ml_logger->error ("Must prepare model before releasing it.");
+            return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+        }
+        model = it->second;
+        model_handles.erase (model->params);
+        ml_models.erase (it);
+    }
+    return release_model (model);
+}
+
+int get_model_stats (double *stats, int *stats_len, const char *json_params)
+{
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    std::shared_ptr<BaseClassifier> model = find_model (json_params, &res);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    if (model == NULL)
+    {
+        BaseClassifier::ml_logger->error ("Must prepare model before requesting its stats.");
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    return model->get_stats (stats, stats_len);
+}
+
+int get_model_stats_with_handle (double *stats, int *stats_len, int handle)
+{
+    std::shared_ptr<BaseClassifier> model = find_model (handle);
+    if (model == NULL)
+    {
+        BaseClassifier::ml_logger->error ("Must prepare model before requesting its stats.");
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    return model->get_stats (stats, stats_len);
+}
+
+static std::string get_brainflow_lib_path (const char *name)
+{
+#ifdef _WIN32
+    std::string lib_name = std::string (name) + ((sizeof (void *) == 4) ? "32.dll" : ".dll");
+#elif defined(__APPLE__)
+    std::string lib_name = std::string ("lib") + name + ".dylib";
+#else
+    std::string lib_name = std::string ("lib") + name + ".so";
+#endif
+    char lib_dir[1024];
+    if (get_dll_path (lib_dir))
+    {
+        return std::string (lib_dir) + lib_name;
+    }
+    return lib_name;
+}
+
+static int load_pipeline_api (BandPowerPipelineApi &api)
+{
+    std::lock_guard<std::mutex> lock (pipeline_api_mutex);
+    if (board_controller_loader != NULL)
+    {
+        api = pipeline_api;
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    DLLLoader *board_lib = new DLLLoader (get_brainflow_lib_path ("BoardController").c_str ());
+    DLLLoader *data_lib = new DLLLoader (get_brainflow_lib_path ("DataHandler").c_str ());
+    if ((!board_lib->load_library ()) || (!data_lib->load_library ()))
+    {
+        BaseClassifier::ml_logger->error ("Failed to load BoardController or DataHandler.");
+        delete board_lib;
+        delete data_lib;
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    pipeline_api.get_sampling_rate =
+        (int (*) (int, int, int *))board_lib->get_address ("get_sampling_rate");
+    pipeline_api.get_timestamp_channel =
+        (int (*) (int, int, int *))board_lib->get_address ("get_timestamp_channel");
+    pipeline_api.get_num_rows = (int (*) (int, int, int *))board_lib->get_address ("get_num_rows");
+    pipeline_api.get_eeg_channels =
+        (int (*) (int, int, int *, int *))board_lib->get_address ("get_eeg_channels");
+    pipeline_api.get_session_num_rows = (int (*) (int, int *, int,
+        const char *))board_lib->get_address ("get_session_num_rows");
+    pipeline_api.get_current_board_data = (int (*) (int, int, double *, int *, int,
+        const char *))board_lib->get_address ("get_current_board_data");
+    pipeline_api.get_board_data_from_index = (int (*) (int, double *, int, double *, int *, int,
+        const char *))board_lib->get_address ("get_board_data_from_index");
+    pipeline_api.get_custom_band_powers = (int (*) (double *, int, int, double *, double *, int,
+        int, int, double *, double *))data_lib->get_address ("get_custom_band_powers");
+    pipeline_api.get_nearest_power_of_two =
+        (int (*) (int, int *))data_lib->get_address ("get_nearest_power_of_two");
+    pipeline_api.get_psd = (int (*) (double *, int, int, int, double *,
+        double *))data_lib->get_address ("get_psd");
+    pipeline_api.get_band_power = (int (*) (double *, double *, int, double, double,
+        double *))data_lib->get_address ("get_band_power");
+    if ((pipeline_api.get_sampling_rate == NULL) || (pipeline_api.get_timestamp_channel == NULL) ||
+        (pipeline_api.get_num_rows == NULL) || (pipeline_api.get_eeg_channels == NULL) ||
+        (pipeline_api.get_session_num_rows == NULL) ||
+        (pipeline_api.get_current_board_data == NULL) ||
+        (pipeline_api.get_board_data_from_index == NULL) ||
+        (pipeline_api.get_custom_band_powers == NULL) ||
+        (pipeline_api.get_nearest_power_of_two == NULL) || (pipeline_api.get_psd == NULL) ||
+        (pipeline_api.get_band_power == NULL))
+    {
+        BaseClassifier::ml_logger->error ("Failed to get function addresses for pipeline.");
+        delete board_lib;
+        delete data_lib;
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    board_controller_loader = board_lib;
+    data_handler_loader = data_lib;
+    api = pipeline_api;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+static std::shared_ptr<BandPowerPipeline> find_pipeline (int handle)
+{
+    std::lock_guard<std::mutex> lock (pipelines_mutex);
+    auto pipeline = pipelines.find (handle);
+    if (pipeline == pipelines.end ())
+    {
+        BaseClassifier::ml_logger->error ("Invalid pipeline handle {}.", handle);
+        return NULL;
+    }
+    return pipeline->second;
+}
+
+int create_inference_pipeline (const char *json_params, int board_id,
+    const char *json_brainflow_input_params, double window_seconds, int update_interval_ms,
+    int apply_filters, int preset, int *handle)
+{
+    if ((json_params == NULL) || (json_brainflow_input_params == NULL) || (handle == NULL))
+    {
+        BaseClassifier::ml_logger->error ("json params and handle must not be null.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    struct BrainFlowModelParams key (
+        (int)BrainFlowMetrics::MINDFULNESS, (int)BrainFlowClassifiers::DEFAULT_CLASSIFIER);
+    int res = string_to_brainflow_model_params (json_params, &key);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    // optional bands field is a list of [start, stop] pairs in Hz, it's not a part of model params
+    std::vector<std::pair<double, double>> bands;
+    try
+    {
+        json config = json::parse (std::string (json_params));
+        if (config.find ("bands") != config.end ())
+        {
+            for (auto &band : config["bands"])
+            {
+                bands.push_back (std::make_pair ((double)band.at (0), (double)band.at (1)));
+            }
+            if (bands.empty ())
+            {
+                BaseClassifier::ml_logger->error ("Bands must not be empty.");
+                return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+            }
+        }
+    }
+    catch (json::exception &e)
+    {
+        BaseClassifier::ml_logger->error ("Unable to parse bands: {}", e.what ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // streaming and playback boards use description of master board
+    int descr_board_id = board_id;
+    if ((board_id == (int)BoardIds::STREAMING_BOARD) ||
+        (board_id == (int)BoardIds::PLAYBACK_FILE_BOARD))
+    {
+        try
+        {
+            json config = json::parse (std::string (json_brainflow_input_params));
+            descr_board_id = config["master_board"];
+        }
+        catch (json::exception &e)
+        {
+            BaseClassifier::ml_logger->error ("Unable to get master board: {}", e.what ());
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+    }
+    std::shared_ptr<BaseClassifier> model = NULL;
+    res = create_model (key, model);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    BandPowerPipelineApi api;
+    res = load_pipeline_api (api);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    std::shared_ptr<BandPowerPipeline> pipeline (new BandPowerPipeline (api, model, board_id,
+        descr_board_id, json_brainflow_input_params, preset, window_seconds, update_interval_ms,
+        apply_filters != 0, bands));
+    res = pipeline->init ();
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    std::lock_guard<std::mutex> lock (pipelines_mutex);
+    while ((next_pipeline_handle < 1) ||
+        (pipelines.find (next_pipeline_handle) != pipelines.end ()))
+    {
+        next_pipeline_handle = (next_pipeline_handle < 1) ? 1 : next_pipeline_handle + 1;
+    }
+    *handle = next_pipeline_handle++;
+    pipelines[*handle] = pipeline;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int start_inference_pipeline (int handle)
+{
+    std::shared_ptr<BandPowerPipeline> pipeline = find_pipeline (handle);
+    if (pipeline == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return pipeline->start ();
+}
+
+int stop_inference_pipeline (int handle)
+{
+    std::shared_ptr<BandPowerPipeline> pipeline = find_pipeline (handle);
+    if (pipeline == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return pipeline->stop ();
+}
+
+int set_inference_pipeline_callback (
+    int handle, void (*callback) (const double *, int, double, void *), void *user_data)
+{
+    std::shared_ptr<BandPowerPipeline> pipeline = find_pipeline (handle);
+    if (pipeline == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    pipeline->set_callback (callback, user_data);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int get_inference_pipeline_prediction (
+    int handle, double *output, int *output_len, double *timestamp)
+{
+    std::shared_ptr<BandPowerPipeline> pipeline = find_pipeline (handle);
+    if (pipeline == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return pipeline->get_latest_prediction (output, output_len, timestamp);
+}
+
+int get_inference_pipeline_num_errors (int handle, int *num_errors)
+{
+    if (num_errors == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<BandPowerPipeline> pipeline = find_pipeline (handle);
+    if (pipeline == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *num_errors = pipeline->get_num_errors ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// pipeline is stopped by its destructor when the last reference is dropped
+int release_inference_pipeline (int handle)
+{
+    std::shared_ptr<BandPowerPipeline> pipeline = NULL;
+    {
+        std::lock_guard<std::mutex> lock (pipelines_mutex);
+        auto it = pipelines.find (handle);
+        if (it == pipelines.end ())
+        {
+            BaseClassifier::ml_logger->error ("Invalid pipeline handle {}.", handle);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        pipeline = it->second;
+        pipelines.erase (it);
+    }
+    pipeline->stop ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 int string_to_brainflow_model_params (const char *json_params, struct BrainFlowModelParams *params)
@@ -182,13 +734,35 @@ int set_log_file_ml_module (const char *log_file)
 
 int release_all ()
 {
-    std::lock_guard<std::mutex> lock (models_mutex);
+    std::vector<std::shared_ptr<BandPowerPipeline>> running_pipelines;
+    {
+        std::lock_guard<std::mutex> lock (pipelines_mutex);
+        for (auto it = pipelines.begin (); it != pipelines.end (); ++it)
+        {
+            running_pipelines.push_back (it->second);
+        }
+        pipelines.clear ();
+    }
+    for (size_t i = 0; i < running_pipelines.size (); i++)
+    {
+        running_pipelines[i]->stop ();
+    }
+    // background loads are dropped before models are released
+    model_registry->shutdown ();
 
-    for (auto it = ml_models.begin (), next_it = it; it != ml_models.end (); it = next_it)
+    std::vector<std::shared_ptr<BaseClassifier>> models;
     {
-        ++next_it;
-        it->second->release ();
-        ml_models.erase (it);
+        std::lock_guard<std::mutex> lock (models_mutex);
+        for (auto it = ml_models.begin (); it != ml_models.end (); ++it)
+        {
+            models.push_back (it->second);
+            model_handles.erase (it->second->params);
+        }
+        ml_models.clear ();
+    }
+    for (size_t i = 0; i < models.size (); i++)
+    {
+        release_model (models[i]);
     }
 
     return (int)BrainFlowExitCodes::STATUS_OK;
@@ -0,0 +1,154 @@
+#include "model_registry.h"
+#include "lazy_classifier.h"
+
+
+ModelRegistry::ModelRegistry ()
+{
+    max_loaded_models = 0;
+    max_memory_bytes = 0;
+    used_memory_bytes = 0;
+    keep_alive = false;
+}
+
+ModelRegistry::~ModelRegistry ()
+{
+    shutdown ();
+}
+
+void ModelRegistry::shutdown ()
+{
+    std::lock_guard<std::mutex> worker_lock (worker_mutex);
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        keep_alive = false;
+        load_queue.clear ();
+    }
+    queue_cv.notify_one ();
+    // joined without registry mutex, model which is loading now may call on_loaded
+    if (worker.joinable ())
+    {
+        worker.join ();
+    }
+}
+
+void ModelRegistry::set_limits (int max_loaded_models, size_t max_memory_bytes)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    this->max_loaded_models = (max_loaded_models < 0) ? 0 : max_loaded_models;
+    this->max_memory_bytes = max_memory_bytes;
+}
+
+void ModelRegistry::on_loaded (std::shared_ptr<LazyClassifier> model, size_t memory_bytes)
+{
+    std::vector<std::shared_ptr<LazyClassifier>> victims;
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        auto it = loaded_models.find (model.get ());
+        if (it != loaded_models.end ())
+        {
+            used_memory_bytes -= it->second.memory_bytes;
+        }
+        Entry entry;
+        entry.model = model;
+        entry.memory_bytes = memory_bytes;
+        loaded_models[model.get ()] = entry;
+        used_memory_bytes += memory_bytes;
+        collect_victims (model.get (), victims);
+    }
+    // unload outside of the lock, victims may be in use by predict calls of other threads
+    for (size_t i = 0; i < victims.size (); i++)
+    {
+        BaseClassifier::ml_logger->debug ("evicting model {}", victims[i]->params.file);
+        victims[i]->unload ();
+    }
+}
+
+void ModelRegistry::on_unloaded (LazyClassifier *model)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    auto it = loaded_models.find (model);
+    if (it != loaded_models.end ())
+    {
+        used_memory_bytes -= it->second.memory_bytes;
+        loaded_models.erase (it);
+    }
+}
+
+void ModelRegistry::load_in_background (std::shared_ptr<LazyClassifier> model)
+{
+    std::lock_guard<std::mutex> worker_lock (worker_mutex);
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        load_queue.push_back (model);
+        if (!keep_alive)
+        {
+            keep_alive = true;
+            worker = std::thread ([this] { this->worker_thread (); });
+        }
+    }
+    queue_cv.notify_one ();
+}
+
+// picks least recently used models until limits are satisfied, model which was just loaded is
+// never evicted, mutex must be held
+void ModelRegistry::collect_victims (
+    LazyClassifier *loaded_model, std::vector<std::shared_ptr<LazyClassifier>> &victims)
+{
+    while (((max_loaded_models > 0) && ((int)loaded_models.size () > max_loaded_models)) ||
+        ((max_memory_bytes > 0) && (used_memory_bytes > max_memory_bytes)))
+    {
+        auto victim = loaded_models.end ();
+        uint64_t victim_last_used = 0;
+        for (auto it = loaded_models.begin (); it != loaded_models.end (); ++it)
+        {
+            std::shared_ptr<LazyClassifier> model = it->second.model.lock ();
+            // expired entries are removed first
+            uint64_t last_used = (model == NULL) ? 0 : model->get_last_used ();
+            if ((it->first != loaded_model) &&
+                ((victim == loaded_models.end ()) || (last_used < victim_last_used)))
+            {
+                victim = it;
+                victim_last_used = last_used;
+            }
+        }
+        if (victim == loaded_models.end ())
+        {
+            break;
+        }
+        std::shared_ptr<LazyClassifier> model = victim->second.model.lock ();
+        if (model != NULL)
+        {
+            victims.push_back (model);
+        }
+        used_memory_bytes -= victim->second.memory_bytes;
+        loaded_models.erase (victim);
+    }
+}
+
+void ModelRegistry::worker_thread ()
+{
+    while (true)
+    {
+        std::shared_ptr<LazyClassifier> model = NULL;
+        {
+            std::unique_lock<std::mutex> lock (mutex);
+            queue_cv.wait (lock, [this] { return (!keep_alive) || (!load_queue.empty ()); });
+            if (!keep_alive)
+            {
+                break;
+            }
+            model = load_queue.front ().lock ();
+            load_queue.pop_front ();
+        }
+        // model could be released after it was scheduled
+        if (model != NULL)
+        {
+            int res = model->load ();
+            if (res != 0)
+            {
+                BaseClassifier::ml_logger->error (
+                    "failed to load model {} in background: {}", model->params.file, res);
+            }
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <stdint.h>
 #include <string>
 #include <vector>
@@ -9,9 +10,73 @@
 #include "onnxruntime_c_api.h"
 
 
+// session settings parsed from BrainFlowModelParams.other_info, it should be a json object like
+// {"intra_op_num_threads": 1, "execution_mode": "sequential", "graph_optimization_level": "all",
+// "optimized_model_file": "model.opt.onnx", "use_global_thread_pool": true,
+// "warmup_iterations": 3}, all fields are optional, other text is ignored with a warning
+struct OnnxSessionConfig
+{
+    int intra_op_num_threads;        // 0 means ort default
+    int inter_op_num_threads;        // 0 means ort default
+    int execution_mode;              // ExecutionMode or -1 for ort default
+    int graph_optimization_level;    // GraphOptimizationLevel or -1 for ort default
+    // optimized model is saved to this file and loaded from it if it's newer than params.file
+    std::string optimized_model_file;
+    // sessions share thread pools of ort env instead of creating their own
+    bool use_global_thread_pool;
+    // size of global thread pools, applied only by the classifier which creates ort env, later
+    // classifiers with different sizes get a warning
+    int global_intra_op_num_threads;
+    int global_inter_op_num_threads;
+    // number of predict calls on zero input done in prepare, they are not included in model stats
+    int warmup_iterations;
+
+    OnnxSessionConfig ()
+    {
+        intra_op_num_threads = 0;
+        inter_op_num_threads = 0;
+        execution_mode = -1;
+        graph_optimization_level = -1;
+        optimized_model_file = "";
+        use_global_thread_pool = false;
+        global_intra_op_num_threads = 0;
+        global_inter_op_num_threads = 0;
+        warmup_iterations = 0;
+    }
+};
+
+
+// io binding with input and output tensors over preallocated buffers, it's used by one predict
+// call at a time
+struct OnnxBinding
+{
+    OrtIoBinding *io_binding;
+    OrtValue *bound_input;
+    OrtValue *bound_output;
+    void *bound_output_data;
+    size_t bound_output_size;
+    int bound_input_len;
+    std::vector<float> float_input;
+    std::vector<double> double_input;
+
+    OnnxBinding ()
+    {
+        io_binding = NULL;
+        bound_input = NULL;
+        bound_output = NULL;
+        bound_output_data = NULL;
+        bound_output_size = 0;
+        bound_input_len = 0;
+    }
+};
+
+
 class OnnxClassifier : public BaseClassifier
 {
-private:
+protected:
+    // float input of this size or longer is passed to ort without copy
+    static const int min_zero_copy_len = 4096;
+
     const OrtApi *ort;
     OrtEnv *env;
     OrtSessionOptions *session_options;
@@ -27,10 +92,53 @@ private:
     std::vector<const char *> output_node_names;
 
     DLLLoader *dll_loader;
+    OnnxSessionConfig session_config;
+
+    // created once in prepare and reused by all predict calls
+    OrtMemoryInfo *memory_info;
+    // predict takes a binding from free_bindings and puts it back after run, if all of them are
+    // used by other threads a new one is created, so each concurrent caller gets its own tensors
+    std::mutex bindings_mutex;
+    std::vector<OnnxBinding *> bindings;
+    std::vector<OnnxBinding *> free_bindings;
+    // false if io binding can not be created, predict uses per call tensors then
+    bool use_binding;
+    // shape of preallocated output, dynamic batch dimension is resolved to 1, output with other
+    // dynamic dimensions is not preallocated and ort allocates it during each run
+    bool preallocate_output;
+    std::vector<int64_t> bound_output_dims;
+    // if batch of output is resolved, only inputs of this length are scored with binding, longer
+    // batches use per call tensors, 0 means any length
+    int bound_sample_len;
 
     int load_api ();
+    int parse_session_config ();
+    int acquire_env ();
+    void release_env ();
+    int apply_session_config (std::string &model_path);
     int get_input_info ();
     int get_output_info ();
+    void resolve_output_shape ();
+    int create_binding (OnnxBinding *binding);
+    void free_binding (OnnxBinding *binding);
+    // returns NULL if binding can not be used for input of this length
+    OnnxBinding *acquire_binding (int data_len);
+    void release_binding (OnnxBinding *binding);
+    int bind_input (OnnxBinding *binding, int data_len);
+    void warmup ();
+    int get_input_shape (int data_len, std::vector<int64_t> &shape);
+    int predict_with_binding (
+        OnnxBinding *binding, double *data, int data_len, double *output, int *output_len);
+    int predict_float_with_binding (
+        OnnxBinding *binding, float *data, int data_len, double *output, int *output_len);
+    int run_with_binding (OnnxBinding *binding, double *output, int *output_len);
+    int predict_with_new_tensors (double *data, int data_len, double *output, int *output_len,
+        size_t max_output_size);
+    int run_with_input (void *input_data, int data_len, double *output, int *output_len,
+        size_t max_output_size);
+    int copy_output (const void *output_data, size_t output_size, size_t max_output_size,
+        double *output, int *output_len);
+    int check_status (OrtStatus *onnx_status, const char *method);
     std::string get_onnxlib_path ();
 
 
@@ -43,6 +151,10 @@ public:
         session = NULL;
         allocator = NULL;
         dll_loader = NULL;
+        memory_info = NULL;
+        use_binding = false;
+        preallocate_output = false;
+        bound_sample_len = 0;
     }
 
     ~OnnxClassifier ()
@@ -53,5 +165,16 @@ public:
 
     int prepare ();
     int predict (double *data, int data_len, double *output, int *output_len);
+    int predict_batch (
+        double *data, int batch_size, int feature_len, double *output, int *output_len);
+    int predict_float (float *data, int data_len, double *output, int *output_len);
+    int predict_batch_float (
+        float *data, int batch_size, int feature_len, double *output, int *output_len);
     int release ();
+
+    // OrtApi::Run is thread safe for the same session, other state is read only after prepare
+    bool is_thread_safe ()
+    {
+        return true;
+    }
 };
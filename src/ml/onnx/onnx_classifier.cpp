@@ -1,19 +1,35 @@
-#include "onnx_classifier.h"
+#include <algorithm>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "array_conversion.h"
 #include "brainflow_constants.h"
 #include "get_dll_dir.h"
+#include "onnx_classifier.h"
+
+#include "json.hpp"
 
+using json = nlohmann::json;
 
+
+// ort keeps a single env per process and it may outlive the classifier which created it, so the
+// logger doesnt use classifier instance
 void log_onnx_msg (void *param, OrtLoggingLevel severity, const char *category, const char *logid,
     const char *code_location, const char *message)
 {
-    BaseClassifier *classifier = (BaseClassifier *)param;
-    if (classifier != NULL)
-    {
-        classifier->safe_logger (
-            spdlog::level::trace, "msg from onnx: {}, code location: {}", message, code_location);
-    }
+    BaseClassifier::ml_logger->trace (
+        "msg from onnx: {}, code location: {}", message, code_location);
 }
 
+// env is shared by all onnx classifiers, global thread pools are created only if the first
+// classifier which creates env requests them
+static std::mutex ort_env_mutex;
+static OrtEnv *ort_env = NULL;
+static int ort_env_users = 0;
+static bool ort_env_has_global_threads = false;
+static int ort_env_global_intra_op_num_threads = 0;
+static int ort_env_global_inter_op_num_threads = 0;
+
 int OnnxClassifier::prepare ()
 {
     if (dll_loader != NULL)
@@ -21,7 +37,7 @@ int OnnxClassifier::prepare ()
         return (int)BrainFlowExitCodes::ANOTHER_CLASSIFIER_IS_PREPARED_ERROR;
     }
 
-    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    int res = parse_session_config ();
     if (params.file.empty ())
     {
         safe_logger (spdlog::level::err, "file with onnx model is not provided");
@@ -53,6 +69,30 @@ int OnnxClassifier::prepare ()
     {
         res = get_output_info ();
     }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = check_status (
+            ort->CreateCpuMemoryInfo (OrtArenaAllocator, OrtMemTypeDefault, &memory_info),
+            "CreateCpuMemoryInfo");
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        resolve_output_shape ();
+        // predict falls back to per call tensors if binding is unavailable
+        OnnxBinding *binding = new OnnxBinding ();
+        if (create_binding (binding) == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            bindings.push_back (binding);
+            free_bindings.push_back (binding);
+            use_binding = true;
+        }
+        else
+        {
+            free_binding (binding);
+            safe_logger (spdlog::level::warn, "failed to create io binding");
+        }
+        warmup ();
+    }
 
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
@@ -64,7 +104,6 @@ int OnnxClassifier::prepare ()
 
 int OnnxClassifier::predict (double *data, int data_len, double *output, int *output_len)
 {
-    int res = (int)BrainFlowExitCodes::STATUS_OK;
     if (ort == NULL)
     {
         return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
@@ -74,324 +113,943 @@ int OnnxClassifier::predict (double *data, int data_len, double *output, int *ou
         safe_logger (spdlog::level::err, "invalid input arguments");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-
     // todo add support for ints and float16
-    float *float_data = NULL;
-    if (input_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
+    if ((input_type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) &&
+        (input_type != ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE))
+    {
+        safe_logger (
+            spdlog::level::err, "only float and double input types are currently supported");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    OnnxBinding *binding = acquire_binding (data_len);
+    if (binding == NULL)
+    {
+        return predict_with_new_tensors (
+            data, data_len, output, output_len, (size_t)params.max_array_size);
+    }
+    int res = predict_with_binding (binding, data, data_len, output, output_len);
+    release_binding (binding);
+    return res;
+}
+
+// models with dynamic batch dimension score the whole batch in a single run, others are called per
+// sample
+int OnnxClassifier::predict_batch (
+    double *data, int batch_size, int feature_len, double *output, int *output_len)
+{
+    if (ort == NULL)
+    {
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    if ((data == NULL) || (batch_size < 1) || (feature_len < 1) || (output == NULL) ||
+        (output_len == NULL))
+    {
+        safe_logger (spdlog::level::err, "invalid input arguments");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    bool is_dynamic_batch = (!input_node_dims.empty ()) && (input_node_dims[0] < 1) &&
+        (!output_node_dims.empty ()) && (output_node_dims[0] < 1);
+    if ((!is_dynamic_batch) || (batch_size == 1) ||
+        ((input_type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) &&
+            (input_type != ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)))
+    {
+        return BaseClassifier::predict_batch (data, batch_size, feature_len, output, output_len);
+    }
+    return predict_with_new_tensors (data, batch_size * feature_len, output, output_len,
+        (size_t)batch_size * params.max_array_size);
+}
+
+// float models score caller's buffer directly, double models convert it in BaseClassifier
+int OnnxClassifier::predict_float (float *data, int data_len, double *output, int *output_len)
+{
+    if (ort == NULL)
+    {
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    if (input_type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
+    {
+        return BaseClassifier::predict_float (data, data_len, output, output_len);
+    }
+    if ((data == NULL) || (data_len < 1) || (output == NULL) || (output_len == NULL))
+    {
+        safe_logger (spdlog::level::err, "invalid input arguments");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    OnnxBinding *binding = acquire_binding (data_len);
+    if (binding == NULL)
     {
-        float_data = new float[data_len];
-        for (int i = 0; i < data_len; i++)
+        return run_with_input (data, data_len, output, output_len, (size_t)params.max_array_size);
+    }
+    int res = predict_float_with_binding (binding, data, data_len, output, output_len);
+    release_binding (binding);
+    return res;
+}
+
+int OnnxClassifier::predict_batch_float (
+    float *data, int batch_size, int feature_len, double *output, int *output_len)
+{
+    if (ort == NULL)
+    {
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    if (input_type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
+    {
+        return BaseClassifier::predict_batch_float (
+            data, batch_size, feature_len, output, output_len);
+    }
+    if ((data == NULL) || (batch_size < 1) || (feature_len < 1) || (output == NULL) ||
+        (output_len == NULL))
+    {
+        safe_logger (spdlog::level::err, "invalid input arguments");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    bool is_dynamic_batch = (!input_node_dims.empty ()) && (input_node_dims[0] < 1) &&
+        (!output_node_dims.empty ()) && (output_node_dims[0] < 1);
+    if (is_dynamic_batch)
+    {
+        return run_with_input (data, batch_size * feature_len, output, output_len,
+            (size_t)batch_size * params.max_array_size);
+    }
+    int total_len = 0;
+    for (int i = 0; i < batch_size; i++)
+    {
+        int sample_len = 0;
+        int res = predict_float (
+            data + (size_t)i * feature_len, feature_len, output + total_len, &sample_len);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
         {
-            float_data[i] = (float)data[i];
+            return res;
         }
+        total_len += sample_len;
     }
-    else if (input_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+    *output_len = total_len;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// short inputs are copied into bound buffer because rebinding costs more than copy, long inputs are
+// bound for a single run without copy and conversion buffer is bound back after run
+int OnnxClassifier::predict_float_with_binding (
+    OnnxBinding *binding, float *data, int data_len, double *output, int *output_len)
+{
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    if (data_len < min_zero_copy_len)
     {
-        // no need to convert
+        if (data_len != binding->bound_input_len)
+        {
+            res = bind_input (binding, data_len);
+            if (res != (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                return res;
+            }
+        }
+        memcpy (binding->float_input.data (), data, sizeof (float) * data_len);
+        return run_with_binding (binding, output, output_len);
+    }
+
+    std::vector<int64_t> input_shape;
+    res = get_input_shape (data_len, input_shape);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    OrtValue *input_tensor = NULL;
+    res = check_status (ort->CreateTensorWithDataAsOrtValue (memory_info, data,
+                            (size_t)data_len * sizeof (float), input_shape.data (),
+                            input_shape.size (), input_type, &input_tensor),
+        "CreateTensorWithDataAsOrtValue");
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = check_status (ort->BindInput (binding->io_binding, input_node_names[0], input_tensor),
+            "BindInput");
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = run_with_binding (binding, output, output_len);
+    }
+    if ((binding->bound_input == NULL) ||
+        (check_status (
+             ort->BindInput (binding->io_binding, input_node_names[0], binding->bound_input),
+             "BindInput") != (int)BrainFlowExitCodes::STATUS_OK))
+    {
+        // next predict binds input again
+        ort->ClearBoundInputs (binding->io_binding);
+        binding->bound_input_len = 0;
+    }
+    if (input_tensor != NULL)
+    {
+        ort->ReleaseValue (input_tensor);
+    }
+    return res;
+}
+
+// steady state path: input is converted into preallocated buffer which is already wrapped by bound
+// tensor, output is written by ort into preallocated tensor, no allocations for fixed shapes
+int OnnxClassifier::predict_with_binding (
+    OnnxBinding *binding, double *data, int data_len, double *output, int *output_len)
+{
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    if (data_len != binding->bound_input_len)
+    {
+        res = bind_input (binding, data_len);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+    }
+    if (input_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
+    {
+        convert_double_to_float (data, binding->float_input.data (), (size_t)data_len);
     }
     else
     {
-        safe_logger (
-            spdlog::level::err, "only float and double input types are currently supported");
-        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        memcpy (binding->double_input.data (), data, sizeof (double) * data_len);
     }
+    return run_with_binding (binding, output, output_len);
+}
 
-    // create input tensor object from data values
-    OrtMemoryInfo *memory_info = NULL;
-    OrtValue *input_tensor = NULL;
-    OrtValue *output_tensor = NULL;
-    OrtStatus *onnx_status =
-        ort->CreateCpuMemoryInfo (OrtArenaAllocator, OrtMemTypeDefault, &memory_info);
-    if (onnx_status != NULL)
+// runs model with currently bound input and copies output
+int OnnxClassifier::run_with_binding (OnnxBinding *binding, double *output, int *output_len)
+{
+    int res = check_status (
+        ort->RunWithBinding (session, NULL, binding->io_binding), "RunWithBinding");
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
-        const char *msg = ort->GetErrorMessage (onnx_status);
-        safe_logger (spdlog::level::err, "CreateCpuMemoryInfo failed: {}", msg);
-        ort->ReleaseStatus (onnx_status);
-        res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+        return res;
+    }
+    if (binding->bound_output != NULL)
+    {
+        return copy_output (binding->bound_output_data, binding->bound_output_size,
+            (size_t)params.max_array_size, output, output_len);
     }
-    else if (memory_info == NULL)
+
+    // output has dynamic dimensions other than batch, its shape is not known before run and ort
+    // allocates it on each call
+    OrtValue **output_values = NULL;
+    size_t output_count = 0;
+    res = check_status (ort->GetBoundOutputValues (
+                            binding->io_binding, allocator, &output_values, &output_count),
+        "GetBoundOutputValues");
+    if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (output_count < 1))
     {
-        safe_logger (spdlog::level::err, "CreateCpuMemoryInfo failed");
+        safe_logger (spdlog::level::err, "no output values");
         res = (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
+    void *output_data = NULL;
+    OrtTensorTypeAndShapeInfo *output_info = NULL;
+    size_t output_size = 0;
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = check_status (
+            ort->GetTensorMutableData (output_values[0], &output_data), "GetTensorMutableData");
+    }
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
-        if (input_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
+        res = check_status (ort->GetTensorTypeAndShape (output_values[0], &output_info),
+            "GetTensorTypeAndShape");
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = check_status (ort->GetTensorShapeElementCount (output_info, &output_size),
+            "GetTensorShapeElementCount");
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = copy_output (
+            output_data, output_size, (size_t)params.max_array_size, output, output_len);
+    }
+    if (output_info != NULL)
+    {
+        ort->ReleaseTensorTypeAndShapeInfo (output_info);
+    }
+    if (output_values != NULL)
+    {
+        for (size_t i = 0; i < output_count; i++)
         {
-            onnx_status = ort->CreateTensorWithDataAsOrtValue (memory_info, float_data,
-                data_len * sizeof (float), input_node_dims.data (), input_node_dims.size (),
-                ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &input_tensor);
+            ort->ReleaseValue (output_values[i]);
         }
-        else
+        check_status (ort->AllocatorFree (allocator, output_values), "AllocatorFree");
+    }
+    return res;
+}
+
+// allocating path for batches which don't fit bound output and for runtimes without io binding
+int OnnxClassifier::predict_with_new_tensors (
+    double *data, int data_len, double *output, int *output_len, size_t max_output_size)
+{
+    if (input_type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
+    {
+        return run_with_input (data, data_len, output, output_len, max_output_size);
+    }
+    std::vector<float> float_data ((size_t)data_len);
+    convert_double_to_float (data, float_data.data (), (size_t)data_len);
+    return run_with_input (float_data.data (), data_len, output, output_len, max_output_size);
+}
+
+// input_data must already have input_type, tensor wraps it without copy
+int OnnxClassifier::run_with_input (
+    void *input_data, int data_len, double *output, int *output_len, size_t max_output_size)
+{
+    std::vector<int64_t> input_shape;
+    int res = get_input_shape (data_len, input_shape);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    size_t input_bytes = (size_t)data_len *
+        ((input_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) ? sizeof (float) : sizeof (double));
+    OrtValue *input_tensor = NULL;
+    OrtValue *output_tensor = NULL;
+    res = check_status (ort->CreateTensorWithDataAsOrtValue (memory_info, input_data, input_bytes,
+                            input_shape.data (), input_shape.size (), input_type, &input_tensor),
+        "CreateTensorWithDataAsOrtValue");
+
+    // score model & input tensor, get back output tensor
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = check_status (ort->Run (session, NULL, input_node_names.data (),
+                                (const OrtValue *const *)&input_tensor, 1,
+                                output_node_names.data (), 1, &output_tensor),
+            "Run");
+    }
+    void *output_data = NULL;
+    OrtTensorTypeAndShapeInfo *output_info = NULL;
+    size_t output_size = 0;
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = check_status (
+            ort->GetTensorMutableData (output_tensor, &output_data), "GetTensorMutableData");
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = check_status (
+            ort->GetTensorTypeAndShape (output_tensor, &output_info), "GetTensorTypeAndShape");
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = check_status (ort->GetTensorShapeElementCount (output_info, &output_size),
+            "GetTensorShapeElementCount");
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = copy_output (output_data, output_size, max_output_size, output, output_len);
+    }
+
+    if (output_info != NULL)
+    {
+        ort->ReleaseTensorTypeAndShapeInfo (output_info);
+    }
+    if (output_tensor != NULL)
+    {
+        ort->ReleaseValue (output_tensor);
+    }
+    if (input_tensor != NULL)
+    {
+        ort->ReleaseValue (input_tensor);
+    }
+    return res;
+}
+
+int OnnxClassifier::copy_output (const void *output_data, size_t output_size,
+    size_t max_output_size, double *output, int *output_len)
+{
+    if (output_size > max_output_size)
+    {
+        safe_logger (spdlog::level::warn, "output is bigger than allocated array");
+        output_size = max_output_size;
+    }
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    switch (output_type)
+    {
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+            std::copy (
+                (const float *)output_data, (const float *)output_data + output_size, output);
+            break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+            std::copy (
+                (const double *)output_data, (const double *)output_data + output_size, output);
+            break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+            std::copy (
+                (const uint8_t *)output_data, (const uint8_t *)output_data + output_size, output);
+            break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+            std::copy (
+                (const int8_t *)output_data, (const int8_t *)output_data + output_size, output);
+            break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+            std::copy (
+                (const uint16_t *)output_data, (const uint16_t *)output_data + output_size, output);
+            break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+            std::copy (
+                (const int16_t *)output_data, (const int16_t *)output_data + output_size, output);
+            break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+            std::copy (
+                (const int32_t *)output_data, (const int32_t *)output_data + output_size, output);
+            break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+            std::copy (
+                (const int64_t *)output_data, (const int64_t *)output_data + output_size, output);
+            break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+            std::copy (
+                (const uint32_t *)output_data, (const uint32_t *)output_data + output_size, output);
+            break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+            std::copy (
+                (const uint64_t *)output_data, (const uint64_t *)output_data + output_size, output);
+            break;
+        default:
+            safe_logger (spdlog::level::err, "unsupported output type: {}", (int)output_type);
+            res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+            output_size = 0;
+            break;
+    }
+    *output_len = (int)output_size;
+    return res;
+}
+
+// dynamic dimensions (-1) are resolved from data_len, first dynamic dimension gets all remaining
+// elements and others are set to 1
+int OnnxClassifier::get_input_shape (int data_len, std::vector<int64_t> &shape)
+{
+    shape = input_node_dims;
+    int64_t static_size = 1;
+    int dynamic_dim = -1;
+    for (size_t i = 0; i < shape.size (); i++)
+    {
+        if (shape[i] > 0)
         {
-            onnx_status = ort->CreateTensorWithDataAsOrtValue (memory_info, data,
-                data_len * sizeof (double), input_node_dims.data (), input_node_dims.size (),
-                ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE, &input_tensor);
+            static_size *= shape[i];
         }
-        if (onnx_status != NULL)
+        else if (dynamic_dim < 0)
         {
-            const char *msg = ort->GetErrorMessage (onnx_status);
-            safe_logger (spdlog::level::err, "CreateTensorWithDataAsOrtValue failed: {}", msg);
-            ort->ReleaseStatus (onnx_status);
-            res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+            dynamic_dim = (int)i;
         }
-        else if (input_tensor == NULL)
+        else
         {
-            safe_logger (spdlog::level::err, "CreateTensorWithDataAsOrtValue failed");
-            res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+            shape[i] = 1;
         }
     }
-    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    if (dynamic_dim >= 0)
     {
-        int is_tensor = 0;
-        onnx_status = ort->IsTensor (input_tensor, &is_tensor);
-        if (onnx_status != NULL)
+        shape[dynamic_dim] = data_len / static_size;
+        static_size *= shape[dynamic_dim];
+    }
+    if (static_size != (int64_t)data_len)
+    {
+        safe_logger (spdlog::level::err, "input size {} doesnt match model input shape", data_len);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// first runs are much slower because ort allocates buffers lazily, run them in prepare on zero
+// input, dynamic dimensions are set to 1, failures here are not fatal for prepare
+void OnnxClassifier::warmup ()
+{
+    int data_len = 1;
+    for (size_t i = 0; i < input_node_dims.size (); i++)
+    {
+        if (input_node_dims[i] > 0)
         {
-            const char *msg = ort->GetErrorMessage (onnx_status);
-            safe_logger (spdlog::level::err, "IsTensor failed: {}", msg);
-            ort->ReleaseStatus (onnx_status);
-            res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+            data_len *= (int)input_node_dims[i];
         }
-        else
+    }
+    std::vector<double> data ((size_t)data_len, 0.0);
+    std::vector<double> output ((size_t)params.max_array_size, 0.0);
+    for (int i = 0; i < session_config.warmup_iterations; i++)
+    {
+        int output_len = 0;
+        int res = predict (data.data (), data_len, output.data (), &output_len);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
         {
-            if (!is_tensor)
-            {
-                safe_logger (spdlog::level::err, "Input isnt a tensor");
-                res = (int)BrainFlowExitCodes::GENERAL_ERROR;
-            }
+            safe_logger (spdlog::level::warn, "warmup inference failed: {}", res);
+            return;
         }
     }
+    if (session_config.warmup_iterations > 0)
+    {
+        safe_logger (
+            spdlog::level::debug, "{} warmup inferences done", session_config.warmup_iterations);
+    }
+}
 
-    // score model & input tensor, get back output tensor
+// (re)creates input tensor over owned conversion buffer, called on first predict and if input
+// length changes
+int OnnxClassifier::bind_input (OnnxBinding *binding, int data_len)
+{
+    std::vector<int64_t> input_shape;
+    int res = get_input_shape (data_len, input_shape);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    ort->ClearBoundInputs (binding->io_binding);
+    if (binding->bound_input != NULL)
+    {
+        ort->ReleaseValue (binding->bound_input);
+        binding->bound_input = NULL;
+    }
+    binding->bound_input_len = 0;
+
+    void *input_data = NULL;
+    size_t input_bytes = 0;
+    if (input_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
+    {
+        binding->float_input.resize (data_len);
+        input_data = binding->float_input.data ();
+        input_bytes = data_len * sizeof (float);
+    }
+    else
+    {
+        binding->double_input.resize (data_len);
+        input_data = binding->double_input.data ();
+        input_bytes = data_len * sizeof (double);
+    }
+    res = check_status (
+        ort->CreateTensorWithDataAsOrtValue (memory_info, input_data, input_bytes,
+            input_shape.data (), input_shape.size (), input_type, &binding->bound_input),
+        "CreateTensorWithDataAsOrtValue");
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
-        onnx_status = ort->Run (session, NULL, input_node_names.data (),
-            (const OrtValue *const *)&input_tensor, 1, output_node_names.data (), 1,
-            &output_tensor);
-        if (onnx_status != NULL)
+        res = check_status (
+            ort->BindInput (binding->io_binding, input_node_names[0], binding->bound_input),
+            "BindInput");
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        binding->bound_input_len = data_len;
+    }
+    return res;
+}
+
+// output shape is static or has only dynamic batch dimension like input, batch is resolved to 1 and
+// preallocated output is used for inputs of a single sample
+void OnnxClassifier::resolve_output_shape ()
+{
+    bound_output_dims = output_node_dims;
+    bound_sample_len = 0;
+    preallocate_output = true;
+    if ((!input_node_dims.empty ()) && (input_node_dims[0] < 1) && (!bound_output_dims.empty ()) &&
+        (bound_output_dims[0] < 1))
+    {
+        bound_output_dims[0] = 1;
+        bound_sample_len = 1;
+        for (size_t i = 1; i < input_node_dims.size (); i++)
         {
-            const char *msg = ort->GetErrorMessage (onnx_status);
-            safe_logger (spdlog::level::err, "Run failed: {}", msg);
-            ort->ReleaseStatus (onnx_status);
-            res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+            if (input_node_dims[i] > 0)
+            {
+                bound_sample_len *= (int)input_node_dims[i];
+            }
         }
-        else if (output_tensor == NULL)
+    }
+    for (int64_t output_dim : bound_output_dims)
+    {
+        if (output_dim < 1)
         {
-            safe_logger (spdlog::level::err, "Run failed");
-            res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+            preallocate_output = false;
+            bound_sample_len = 0;
+            break;
         }
     }
-    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+}
+
+// output is preallocated once if its shape is resolved, otherwise it is bound to cpu memory and
+// allocated by ort during run
+int OnnxClassifier::create_binding (OnnxBinding *binding)
+{
+    int res =
+        check_status (ort->CreateIoBinding (session, &binding->io_binding), "CreateIoBinding");
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
-        int is_tensor = 0;
-        onnx_status = ort->IsTensor (output_tensor, &is_tensor);
-        if (onnx_status != NULL)
+        binding->io_binding = NULL;
+        return res;
+    }
+
+    if (preallocate_output)
+    {
+        size_t output_size = 1;
+        for (int64_t output_dim : bound_output_dims)
         {
-            const char *msg = ort->GetErrorMessage (onnx_status);
-            safe_logger (spdlog::level::err, "IsTensor failed: {}", msg);
-            ort->ReleaseStatus (onnx_status);
-            res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+            output_size *= (size_t)output_dim;
         }
-        else
+        res = check_status (
+            ort->CreateTensorAsOrtValue (allocator, bound_output_dims.data (),
+                bound_output_dims.size (), output_type, &binding->bound_output),
+            "CreateTensorAsOrtValue");
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
         {
-            if (!is_tensor)
-            {
-                safe_logger (spdlog::level::err, "Output isnt a tensor");
-                res = (int)BrainFlowExitCodes::GENERAL_ERROR;
-            }
+            res = check_status (
+                ort->GetTensorMutableData (binding->bound_output, &binding->bound_output_data),
+                "GetTensorMutableData");
         }
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            res = check_status (
+                ort->BindOutput (binding->io_binding, output_node_names[0], binding->bound_output),
+                "BindOutput");
+        }
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            binding->bound_output_size = output_size;
+            return res;
+        }
+        if (binding->bound_output != NULL)
+        {
+            ort->ReleaseValue (binding->bound_output);
+            binding->bound_output = NULL;
+        }
+        binding->bound_output_data = NULL;
     }
+    return check_status (
+        ort->BindOutputToDevice (binding->io_binding, output_node_names[0], memory_info),
+        "BindOutputToDevice");
+}
 
-    // Get pointer to output tensor float values
-    size_t output_size = 1;
-    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+void OnnxClassifier::free_binding (OnnxBinding *binding)
+{
+    if (binding->io_binding != NULL)
+    {
+        ort->ReleaseIoBinding (binding->io_binding);
+    }
+    if (binding->bound_input != NULL)
+    {
+        ort->ReleaseValue (binding->bound_input);
+    }
+    if (binding->bound_output != NULL)
+    {
+        ort->ReleaseValue (binding->bound_output);
+    }
+    delete binding;
+}
+
+// batches which don't fit preallocated output are scored with per call tensors
+OnnxBinding *OnnxClassifier::acquire_binding (int data_len)
+{
+    if ((!use_binding) || ((bound_sample_len > 0) && (data_len != bound_sample_len)))
+    {
+        return NULL;
+    }
+    {
+        std::lock_guard<std::mutex> lock (bindings_mutex);
+        if (!free_bindings.empty ())
+        {
+            OnnxBinding *binding = free_bindings.back ();
+            free_bindings.pop_back ();
+            return binding;
+        }
+    }
+    // all bindings are used by other threads, this one gets its own and keeps it in the pool
+    OnnxBinding *binding = new OnnxBinding ();
+    if (create_binding (binding) != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        free_binding (binding);
+        return NULL;
+    }
+    std::lock_guard<std::mutex> lock (bindings_mutex);
+    bindings.push_back (binding);
+    return binding;
+}
+
+void OnnxClassifier::release_binding (OnnxBinding *binding)
+{
+    std::lock_guard<std::mutex> lock (bindings_mutex);
+    free_bindings.push_back (binding);
+}
+
+int OnnxClassifier::parse_session_config ()
+{
+    session_config = OnnxSessionConfig ();
+    if (params.other_info.empty ())
     {
-        for (int64_t output_dim : output_node_dims)
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    // other_info was free text before session settings were added, keep accepting it
+    json config;
+    try
+    {
+        config = json::parse (params.other_info);
+    }
+    catch (json::exception &e)
+    {
+        config = json ();
+    }
+    if (!config.is_object ())
+    {
+        safe_logger (spdlog::level::warn,
+            "other_info is not a json object, default onnx session settings are used");
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    try
+    {
+        session_config.intra_op_num_threads =
+            config.value ("intra_op_num_threads", session_config.intra_op_num_threads);
+        session_config.inter_op_num_threads =
+            config.value ("inter_op_num_threads", session_config.inter_op_num_threads);
+        session_config.optimized_model_file =
+            config.value ("optimized_model_file", session_config.optimized_model_file);
+        session_config.use_global_thread_pool =
+            config.value ("use_global_thread_pool", session_config.use_global_thread_pool);
+        session_config.global_intra_op_num_threads = config.value (
+            "global_intra_op_num_threads", session_config.global_intra_op_num_threads);
+        session_config.global_inter_op_num_threads = config.value (
+            "global_inter_op_num_threads", session_config.global_inter_op_num_threads);
+        session_config.warmup_iterations =
+            config.value ("warmup_iterations", session_config.warmup_iterations);
+
+        std::string execution_mode = config.value ("execution_mode", "");
+        if (execution_mode == "sequential")
+        {
+            session_config.execution_mode = (int)ORT_SEQUENTIAL;
+        }
+        else if (execution_mode == "parallel")
         {
-            output_size *= output_dim;
+            session_config.execution_mode = (int)ORT_PARALLEL;
         }
-        if (output_size > (uint64_t)params.max_array_size)
+        else if (!execution_mode.empty ())
         {
-            safe_logger (spdlog::level::warn, "output is bigger than allocated array");
-            output_size = params.max_array_size;
+            safe_logger (spdlog::level::err, "unknown execution mode: {}", execution_mode);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
         }
 
-        void *output_tensor_data = NULL;
-        onnx_status = ort->GetTensorMutableData (output_tensor, &output_tensor_data);
-        if (onnx_status != NULL)
+        std::string optimization_level = config.value ("graph_optimization_level", "");
+        if (optimization_level == "disable_all")
         {
-            const char *msg = ort->GetErrorMessage (onnx_status);
-            safe_logger (spdlog::level::err, "IsTensor failed: {}", msg);
-            ort->ReleaseStatus (onnx_status);
-            res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+            session_config.graph_optimization_level = (int)ORT_DISABLE_ALL;
         }
-        else if (output_tensor_data == NULL)
+        else if (optimization_level == "basic")
         {
-            safe_logger (spdlog::level::err, "GetTensorMutableData failed");
-            res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+            session_config.graph_optimization_level = (int)ORT_ENABLE_BASIC;
         }
-        else
+        else if (optimization_level == "extended")
+        {
+            session_config.graph_optimization_level = (int)ORT_ENABLE_EXTENDED;
+        }
+        else if (optimization_level == "all")
         {
-            *output_len = (int)output_size;
-            switch (output_type)
+            session_config.graph_optimization_level = (int)ORT_ENABLE_ALL;
+        }
+        else if (!optimization_level.empty ())
+        {
+            safe_logger (
+                spdlog::level::err, "unknown graph optimization level: {}", optimization_level);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, "invalid onnx session settings: {}", e.what ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int OnnxClassifier::acquire_env ()
+{
+    std::lock_guard<std::mutex> lock (ort_env_mutex);
+    if (ort_env == NULL)
+    {
+        int res = (int)BrainFlowExitCodes::STATUS_OK;
+        if (session_config.use_global_thread_pool)
+        {
+            OrtThreadingOptions *threading_options = NULL;
+            res = check_status (
+                ort->CreateThreadingOptions (&threading_options), "CreateThreadingOptions");
+            if (res == (int)BrainFlowExitCodes::STATUS_OK)
             {
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED:
-                {
-                    safe_logger (spdlog::level::trace, "undefined output type");
-                    res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
-                {
-                    float *output_data = (float *)output_tensor_data;
-                    for (uint64_t i = 0; i < output_size; i++)
-                    {
-                        output[i] = (double)output_data[i];
-                    }
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
-                {
-                    uint8_t *output_data = (uint8_t *)output_tensor_data;
-                    for (uint64_t i = 0; i < output_size; i++)
-                    {
-                        output[i] = (double)output_data[i];
-                    }
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
-                {
-                    int8_t *output_data = (int8_t *)output_tensor_data;
-                    for (uint64_t i = 0; i < output_size; i++)
-                    {
-                        output[i] = (double)output_data[i];
-                    }
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
-                {
-                    uint16_t *output_data = (uint16_t *)output_tensor_data;
-                    for (uint64_t i = 0; i < output_size; i++)
-                    {
-                        output[i] = (double)output_data[i];
-                    }
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
-                {
-                    int16_t *output_data = (int16_t *)output_tensor_data;
-                    for (uint64_t i = 0; i < output_size; i++)
-                    {
-                        output[i] = (double)output_data[i];
-                    }
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
-                {
-                    int32_t *output_data = (int32_t *)output_tensor_data;
-                    for (uint64_t i = 0; i < output_size; i++)
-                    {
-                        output[i] = (double)output_data[i];
-                    }
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
-                {
-                    int64_t *output_data = (int64_t *)output_tensor_data;
-                    for (uint64_t i = 0; i < output_size; i++)
-                    {
-                        output[i] = (double)output_data[i];
-                    }
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING:
-                {
-                    safe_logger (spdlog::level::err, "string output type is not supported");
-                    res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
-                {
-                    safe_logger (spdlog::level::err, "float16 output type is not supported");
-                    res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
-                {
-                    double *output_data = (double *)output_tensor_data;
-                    for (uint64_t i = 0; i < output_size; i++)
-                    {
-                        output[i] = output_data[i];
-                    }
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
-                {
-                    uint32_t *output_data = (uint32_t *)output_tensor_data;
-                    for (uint64_t i = 0; i < output_size; i++)
-                    {
-                        output[i] = (double)output_data[i];
-                    }
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
-                {
-                    uint64_t *output_data = (uint64_t *)output_tensor_data;
-                    for (uint64_t i = 0; i < output_size; i++)
-                    {
-                        output[i] = (double)output_data[i];
-                    }
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX64:
-                {
-                    safe_logger (spdlog::level::err, "complex64 output type is not supported");
-                    res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX128:
-                {
-                    safe_logger (spdlog::level::err, "complex128 output type is not supported");
-                    res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
-                    break;
-                }
-                case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
-                {
-                    safe_logger (spdlog::level::err, "bfloat16 output type is not supported");
-                    res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
-                    break;
-                }
-                default:
-                {
-                    safe_logger (spdlog::level::err, "unknown output type");
-                    res = (int)BrainFlowExitCodes::STATUS_OK;
-                }
+                res = check_status (ort->SetGlobalIntraOpNumThreads (threading_options,
+                                        session_config.global_intra_op_num_threads),
+                    "SetGlobalIntraOpNumThreads");
             }
+            if (res == (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                res = check_status (ort->SetGlobalInterOpNumThreads (threading_options,
+                                        session_config.global_inter_op_num_threads),
+                    "SetGlobalInterOpNumThreads");
+            }
+            if (res == (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                res = check_status (ort->CreateEnvWithCustomLoggerAndGlobalThreadPools (
+                                        (OrtLoggingFunction)log_onnx_msg, NULL,
+                                        ORT_LOGGING_LEVEL_VERBOSE, "brainflow_onnx_lib",
+                                        threading_options, &ort_env),
+                    "CreateEnvWithCustomLoggerAndGlobalThreadPools");
+            }
+            if (threading_options != NULL)
+            {
+                ort->ReleaseThreadingOptions (threading_options);
+            }
+            ort_env_has_global_threads = (res == (int)BrainFlowExitCodes::STATUS_OK);
+            ort_env_global_intra_op_num_threads = session_config.global_intra_op_num_threads;
+            ort_env_global_inter_op_num_threads = session_config.global_inter_op_num_threads;
+        }
+        else
+        {
+            res = check_status (
+                ort->CreateEnvWithCustomLogger ((OrtLoggingFunction)log_onnx_msg, NULL,
+                    ORT_LOGGING_LEVEL_VERBOSE, "brainflow_onnx_lib", &ort_env),
+                "CreateEnvWithCustomLogger");
+            ort_env_has_global_threads = false;
+        }
+        if ((res != (int)BrainFlowExitCodes::STATUS_OK) || (ort_env == NULL))
+        {
+            ort_env = NULL;
+            return (int)BrainFlowExitCodes::GENERAL_ERROR;
+        }
+    }
+    else if (session_config.use_global_thread_pool)
+    {
+        // env and its pools are created once per process, settings of later models cant change it
+        if (!ort_env_has_global_threads)
+        {
+            safe_logger (spdlog::level::warn,
+                "ort env was created by another model without global thread pools, "
+                "use_global_thread_pool is ignored and session uses its own threads");
+        }
+        else if (((session_config.global_intra_op_num_threads != 0) &&
+                     (session_config.global_intra_op_num_threads !=
+                         ort_env_global_intra_op_num_threads)) ||
+            ((session_config.global_inter_op_num_threads != 0) &&
+                (session_config.global_inter_op_num_threads !=
+                    ort_env_global_inter_op_num_threads)))
+        {
+            safe_logger (spdlog::level::warn,
+                "global thread pools were created by another model with intra {} and inter {} "
+                "threads, requested sizes are ignored",
+                ort_env_global_intra_op_num_threads, ort_env_global_inter_op_num_threads);
         }
     }
+    ort_env_users++;
+    env = ort_env;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
-    if (output_tensor != NULL)
+void OnnxClassifier::release_env ()
+{
+    std::lock_guard<std::mutex> lock (ort_env_mutex);
+    env = NULL;
+    ort_env_users--;
+    if ((ort_env_users == 0) && (ort_env != NULL))
     {
-        ort->ReleaseValue (output_tensor);
+        ort->ReleaseEnv (ort_env);
+        ort_env = NULL;
+        ort_env_has_global_threads = false;
+        ort_env_global_intra_op_num_threads = 0;
+        ort_env_global_inter_op_num_threads = 0;
     }
-    if (input_tensor != NULL)
+}
+
+// model_path is replaced by optimized model file if it's up to date
+int OnnxClassifier::apply_session_config (std::string &model_path)
+{
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    if (session_config.use_global_thread_pool)
     {
-        ort->ReleaseValue (input_tensor);
+        // acquire_env warns if env has no global pools
+        if (ort_env_has_global_threads)
+        {
+            res = check_status (
+                ort->DisablePerSessionThreads (session_options), "DisablePerSessionThreads");
+        }
+    }
+    if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (session_config.intra_op_num_threads > 0))
+    {
+        res = check_status (
+            ort->SetIntraOpNumThreads (session_options, session_config.intra_op_num_threads),
+            "SetIntraOpNumThreads");
+    }
+    if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (session_config.inter_op_num_threads > 0))
+    {
+        res = check_status (
+            ort->SetInterOpNumThreads (session_options, session_config.inter_op_num_threads),
+            "SetInterOpNumThreads");
     }
-    if (memory_info != NULL)
+    if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (session_config.execution_mode >= 0))
     {
-        ort->ReleaseMemoryInfo (memory_info);
+        res = check_status (ort->SetSessionExecutionMode (
+                                session_options, (ExecutionMode)session_config.execution_mode),
+            "SetSessionExecutionMode");
     }
-    if (float_data != NULL)
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
-        delete[] float_data;
+        return res;
     }
 
-    return (int)BrainFlowExitCodes::STATUS_OK;
+    int optimization_level = session_config.graph_optimization_level;
+    const std::string &optimized_file = session_config.optimized_model_file;
+    if (!optimized_file.empty ())
+    {
+        struct stat source_info;
+        struct stat optimized_info;
+        bool is_cached = (stat (optimized_file.c_str (), &optimized_info) == 0) &&
+            (stat (model_path.c_str (), &source_info) == 0) &&
+            (optimized_info.st_mtime >= source_info.st_mtime);
+        if (is_cached)
+        {
+            // graph is already optimized, skip optimization cost
+            safe_logger (spdlog::level::info, "loading optimized model from {}", optimized_file);
+            model_path = optimized_file;
+            optimization_level = (int)ORT_DISABLE_ALL;
+        }
+        else
+        {
+            safe_logger (spdlog::level::info, "saving optimized model to {}", optimized_file);
+#ifdef _WIN32
+            wchar_t optimized_path[1024];
+            mbstowcs (optimized_path, optimized_file.c_str (), 1024);
+            res = check_status (ort->SetOptimizedModelFilePath (session_options, optimized_path),
+                "SetOptimizedModelFilePath");
+#else
+            res = check_status (
+                ort->SetOptimizedModelFilePath (session_options, optimized_file.c_str ()),
+                "SetOptimizedModelFilePath");
+#endif
+        }
+    }
+    if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (optimization_level >= 0))
+    {
+        res = check_status (ort->SetSessionGraphOptimizationLevel (
+                                session_options, (GraphOptimizationLevel)optimization_level),
+            "SetSessionGraphOptimizationLevel");
+    }
+    return res;
+}
+
+int OnnxClassifier::check_status (OrtStatus *onnx_status, const char *method)
+{
+    if (onnx_status == NULL)
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    safe_logger (
+        spdlog::level::err, "{} failed: {}", method, ort->GetErrorMessage (onnx_status));
+    ort->ReleaseStatus (onnx_status);
+    return (int)BrainFlowExitCodes::GENERAL_ERROR;
 }
 
 int OnnxClassifier::release ()
 {
+    if (ort != NULL)
+    {
+        for (OnnxBinding *binding : bindings)
+        {
+            free_binding (binding);
+        }
+        if (memory_info != NULL)
+        {
+            ort->ReleaseMemoryInfo (memory_info);
+            memory_info = NULL;
+        }
+    }
+    bindings.clear ();
+    free_bindings.clear ();
+    use_binding = false;
+    preallocate_output = false;
+    bound_output_dims.clear ();
+    bound_sample_len = 0;
     if ((allocator != NULL) && (ort != NULL))
     {
         for (const char *node_name : input_node_names)
@@ -417,8 +1075,7 @@ int OnnxClassifier::release ()
     }
     if ((env != NULL) && (ort != NULL))
     {
-        ort->ReleaseEnv (env);
-        env = NULL;
+        release_env ();
     }
     ort = NULL;
     if (dll_loader != NULL)
@@ -500,20 +1157,7 @@ int OnnxClassifier::load_api ()
 
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
-        OrtStatus *onnx_status = ort->CreateEnvWithCustomLogger ((OrtLoggingFunction)log_onnx_msg,
-            (void *)this, ORT_LOGGING_LEVEL_VERBOSE, "brainflow_onnx_lib", &env);
-        if (onnx_status != NULL)
-        {
-            const char *msg = ort->GetErrorMessage (onnx_status);
-            safe_logger (spdlog::level::err, "CreateEnv failed: {}", msg);
-            ort->ReleaseStatus (onnx_status);
-            res = (int)BrainFlowExitCodes::GENERAL_ERROR;
-        }
-        else if (env == NULL)
-        {
-            safe_logger (spdlog::level::err, "CreateEnvWithCustomLogger failed");
-            res = (int)BrainFlowExitCodes::GENERAL_ERROR;
-        }
+        res = acquire_env ();
     }
 
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
@@ -533,15 +1177,21 @@ int OnnxClassifier::load_api ()
         }
     }
 
+    std::string model_file = params.file;
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = apply_session_config (model_file);
+    }
+
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
 #ifdef _WIN32
         wchar_t model_path[1024];
-        mbstowcs (model_path, params.file.c_str (), 1024);
+        mbstowcs (model_path, model_file.c_str (), 1024);
         OrtStatus *onnx_status = ort->CreateSession (env, model_path, session_options, &session);
 #else
         OrtStatus *onnx_status =
-            ort->CreateSession (env, params.file.c_str (), session_options, &session);
+            ort->CreateSession (env, model_file.c_str (), session_options, &session);
 #endif
         if (onnx_status != NULL)
         {
@@ -1,5 +1,6 @@
 import glob
 import argparse
+import json
 import os
 import pickle
 import logging
@@ -34,6 +35,16 @@ double %s_intercept = %lf;
     with open(file_path, 'w') as f:
         f.write(file_content)
 
+def write_linear_model(model, file_name, post_transform):
+    # coefficient file for LINEAR_CLASSIFIER, it doesnt need onnxruntime
+    content = {
+        'coefficients': model.coef_.tolist(),
+        'intercepts': np.atleast_1d(model.intercept_).tolist(),
+        'post_transform': post_transform
+    }
+    with open(file_name, 'w') as f:
+        json.dump(content, f)
+
 def prepare_data(first_class, second_class, blacklisted_channels=None):
     # use different windows, its kinda data augmentation
     window_sizes = [4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0]
@@ -134,6 +145,7 @@ def train_regression_mindfulness(data):
     with open('logreg_mindfulness.onnx', 'wb') as f:
         f.write(onx.SerializeToString())
     write_model(model.intercept_, model.coef_, 'mindfulness')
+    write_linear_model(model, 'logreg_mindfulness.json', 'logistic')
 
 def train_svm_mindfulness(data):
     model = SVC(kernel='linear', verbose=True, random_state=1, class_weight='balanced', probability=True)
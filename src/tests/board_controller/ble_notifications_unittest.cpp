@@ -0,0 +1,303 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "aavaa_v3.h"
+#include "brainalive.h"
+#include "ganglion_native.h"
+#include "muse.h"
+#include "muse_constants.h"
+
+using namespace testing;
+
+
+// boards are not connected, decoding state is initialized as in prepare_session and notifications
+// are injected the same way as BLE callbacks do it
+template <class T>
+class NotificationBoard : public T
+{
+public:
+    NotificationBoard () : T (BrainFlowInputParams ())
+    {
+    }
+
+    NotificationBoard (int board_id) : T (board_id, BrainFlowInputParams ())
+    {
+    }
+
+    int start ()
+    {
+        this->resolve_channels ();
+        int res = this->prepare_for_acquisition (1000, "");
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            res = this->start_notification_thread ();
+        }
+        return res;
+    }
+
+    // decodes all enqueued notifications before return
+    void stop ()
+    {
+        this->stop_notification_thread ();
+    }
+
+    // rows one after another
+    std::vector<double> get_data (int preset = (int)BrainFlowPresets::DEFAULT_PRESET)
+    {
+        int count = 0;
+        this->get_board_data_count (preset, &count);
+        int num_rows = this->board_descr[this->preset_to_string (preset)]["num_rows"];
+        std::vector<double> data ((size_t)num_rows * count);
+        if (count > 0)
+        {
+            this->get_board_data (count, preset, data.data ());
+        }
+        return data;
+    }
+};
+
+TEST (BLENotificationsTest, EnqueueNotification_NotStarted_Rejected)
+{
+    NotificationBoard<BrainAlive> board;
+    uint8_t data[BrainAlive::brainalive_packet_size] = {0};
+    EXPECT_FALSE (board.enqueue_notification (0, data, sizeof (data)));
+}
+
+TEST (BLENotificationsTest, BrainAlive_Notification_DecodedInNotificationThread)
+{
+    NotificationBoard<BrainAlive> board;
+    ASSERT_EQ (board.start (), (int)BrainFlowExitCodes::STATUS_OK);
+    // handshake with gains is handled in callback
+    uint8_t handshake[BrainAlive::brainalive_handshaking_packet_size] = {
+        0x0A, 0x03, BrainAlive::brainalive_handshaking_command, 1, 1, 0, 1, 0x0D};
+    board.read_data (simpleble_uuid_t (), simpleble_uuid_t (), handshake, sizeof (handshake));
+    EXPECT_EQ (board.get_internal_gain (), 1);
+    EXPECT_EQ (board.get_ref_voltage (), 1);
+
+    uint8_t data[BrainAlive::brainalive_packet_size] = {0};
+    for (int i = 0; i < BrainAlive::num_of_packets; i++)
+    {
+        uint8_t *packet = data + i * BrainAlive::brainalive_single_packet_size;
+        packet[BrainAlive::brainalive_eeg_Start_index + 2] = 10; // first eeg channel
+        packet[BrainAlive::brainalive_axl_start_index] = 0xFF;   // negative accel x
+        packet[BrainAlive::brainalive_axl_start_index + 1] = 0xF0;
+        packet[BrainAlive::brainalive_packet_index] = i;
+    }
+    EXPECT_TRUE (board.enqueue_notification (0, data, sizeof (data)));
+    // notifications with unexpected size are skipped
+    EXPECT_TRUE (board.enqueue_notification (0, data, 10));
+    board.stop ();
+
+    std::vector<double> res = board.get_data ();
+    int count = BrainAlive::num_of_packets;
+    ASSERT_EQ (res.size (), (size_t)(BrainAlive::ba_brainflow_package_size * count));
+    for (int i = 0; i < count; i++)
+    {
+        EXPECT_EQ (res[i], i);                                    // package num
+        EXPECT_NEAR (res[count + i], 10.0 * 1000 / 8388607, 1e-9); // eeg
+        EXPECT_EQ (res[9 * count + i], 0xFFF0 - 65535);           // accel x
+        EXPECT_GT (res[16 * count + i], 0.0);                     // timestamp
+    }
+}
+
+TEST (BLENotificationsTest, AAVAA_FrameSplitBetweenNotifications_Decoded)
+{
+    NotificationBoard<AAVAAv3> board;
+    ASSERT_EQ (board.start (), (int)BrainFlowExitCodes::STATUS_OK);
+    // 47 bytes frame, notifications have a header byte which is skipped
+    uint8_t frame[47] = {0};
+    frame[0] = 0xA0;
+    frame[1] = 5;
+    float eeg = 2.0f;
+    memcpy (frame + 2, &eeg, sizeof (eeg));
+    frame[35] = 100; // rotation x
+    frame[40] = 80;  // battery
+    frame[46] = 0xC0;
+    uint8_t first[21] = {0};
+    uint8_t second[29] = {0};
+    memcpy (first + 1, frame, 20);
+    memcpy (second + 1, frame + 20, 27);
+    // garbage before start byte is dropped
+    second[28] = 0x01;
+    EXPECT_TRUE (board.enqueue_notification (0, first, sizeof (first)));
+    EXPECT_TRUE (board.enqueue_notification (0, second, sizeof (second)));
+    board.stop ();
+
+    std::vector<double> res = board.get_data ();
+    ASSERT_EQ (res.size (), (size_t)17);
+    EXPECT_EQ (res[0], 5.0);
+    EXPECT_NEAR (res[1], 2.0 * 4.5 / 8388607.0 / 12.0 * 1000000.0, 1e-6);
+    EXPECT_NEAR (res[9], 1.0, 1e-9);
+    EXPECT_EQ (res[12], 80.0);
+}
+
+TEST (BLENotificationsTest, GanglionNative_ImpedanceNotification_Decoded)
+{
+    NotificationBoard<GanglionNative> board;
+    ASSERT_EQ (board.start (), (int)BrainFlowExitCodes::STATUS_OK);
+    const uint8_t first[] = {201, '1', '2', '3', 'Z'};
+    const uint8_t ref[] = {205, '4', '5', 'Z'};
+    const uint8_t broken[] = {202, 'x', 'Z'};
+    EXPECT_TRUE (board.enqueue_notification (0, first, sizeof (first)));
+    EXPECT_TRUE (board.enqueue_notification (0, ref, sizeof (ref)));
+    EXPECT_TRUE (board.enqueue_notification (0, broken, sizeof (broken)));
+    board.stop ();
+
+    std::vector<double> res = board.get_data ();
+    ASSERT_EQ (res.size (), (size_t)(15 * 2));
+    EXPECT_EQ (res[0], 201.0);
+    EXPECT_EQ (res[1], 205.0);
+    EXPECT_EQ (res[8 * 2], 123.0);
+    EXPECT_EQ (res[8 * 2 + 1], 123.0);
+    EXPECT_EQ (res[12 * 2], 0.0);
+    EXPECT_EQ (res[12 * 2 + 1], 45.0);
+}
+
+TEST (BLENotificationsTest, GanglionNative_LongerThanBoardLimit_Dropped)
+{
+    NotificationBoard<GanglionNative> board;
+    ASSERT_EQ (board.start (), (int)BrainFlowExitCodes::STATUS_OK);
+    uint8_t data[21] = {0};
+    EXPECT_FALSE (board.enqueue_notification (0, data, sizeof (data)));
+    EXPECT_EQ (board.get_dropped_notifications (), (size_t)1);
+    board.stop ();
+}
+
+TEST (BLENotificationsTest, ReleaseSession_StopsNotificationThread)
+{
+    NotificationBoard<BrainAlive> board;
+    ASSERT_EQ (board.start (), (int)BrainFlowExitCodes::STATUS_OK);
+    uint8_t data[BrainAlive::brainalive_packet_size] = {0};
+    EXPECT_TRUE (board.enqueue_notification (0, data, sizeof (data)));
+    // thread is joined before release returns, so nothing is decoded after it
+    EXPECT_EQ (board.release_session (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_FALSE (board.enqueue_notification (0, data, sizeof (data)));
+}
+
+TEST (BLENotificationsTest, GanglionNative_ConsumerSleeping_WokenUpByNotification)
+{
+    NotificationBoard<GanglionNative> board;
+    ASSERT_EQ (board.start (), (int)BrainFlowExitCodes::STATUS_OK);
+    // give consumer time to go to sleep on empty queue
+    std::this_thread::sleep_for (std::chrono::milliseconds (50));
+    const uint8_t first[] = {201, '1', '2', '3', 'Z'};
+    EXPECT_TRUE (board.enqueue_notification (0, first, sizeof (first)));
+    int count = 0;
+    for (int i = 0; (i < 1000) && (count == 0); i++)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+        board.get_board_data_count ((int)BrainFlowPresets::DEFAULT_PRESET, &count);
+    }
+    EXPECT_EQ (count, 1);
+    board.stop ();
+}
+
+TEST (BLENotificationsTest, GanglionNative_RestartWithActiveProducer_NoRace)
+{
+    NotificationBoard<GanglionNative> board;
+    std::atomic_bool keep_producer (true);
+    std::thread producer ([&board, &keep_producer] {
+        const uint8_t first[] = {201, '1', '2', '3', 'Z'};
+        while (keep_producer)
+        {
+            board.enqueue_notification (0, first, sizeof (first));
+        }
+    });
+    // queue is drained by each start while producer may be copying into it
+    for (int i = 0; i < 50; i++)
+    {
+        ASSERT_EQ (board.start (), (int)BrainFlowExitCodes::STATUS_OK);
+        board.stop ();
+    }
+    keep_producer = false;
+    producer.join ();
+}
+
+TEST (BLENotificationsTest, Muse_Notifications_DecodedToAllPresets)
+{
+    NotificationBoard<Muse> board ((int)BoardIds::MUSE_2_BOARD);
+    ASSERT_EQ (board.start (), (int)BrainFlowExitCodes::STATUS_OK);
+    // 2 bytes of package num, then 12 eeg samples packed as 12 bit pairs, odd samples are zero
+    const int eeg_types[] = {(int)MuseNotificationTypes::TP9, (int)MuseNotificationTypes::AF7,
+        (int)MuseNotificationTypes::AF8, (int)MuseNotificationTypes::TP10};
+    uint8_t eeg[4][20] = {{0}};
+    for (int ch = 0; ch < 4; ch++)
+    {
+        for (int i = 2; i < 20; i += 3)
+        {
+            eeg[ch][i] = 0x80 + 0x10 * (ch + 1);
+            eeg[ch][i + 1] = 0x08;
+        }
+    }
+    // 3 samples of x, y, z int16 values
+    uint8_t imu[20] = {0};
+    for (int i = 2; i < 20; i += 2)
+    {
+        imu[i] = 0x40;
+    }
+    // 6 int24 values
+    uint8_t ppg[20] = {0};
+    for (int i = 2; i < 20; i += 3)
+    {
+        ppg[i + 1] = 0x01;
+    }
+    // first round of each type only sets up timestamp correction
+    for (int round = 1; round < 3; round++)
+    {
+        for (int ch = 0; ch < 4; ch++)
+        {
+            eeg[ch][1] = (uint8_t)round;
+            EXPECT_TRUE (board.enqueue_notification (eeg_types[ch], eeg[ch], sizeof (eeg[ch])));
+        }
+        imu[1] = (uint8_t)round;
+        EXPECT_TRUE (board.enqueue_notification ((int)MuseNotificationTypes::ACCEL, imu, 20));
+        EXPECT_TRUE (board.enqueue_notification ((int)MuseNotificationTypes::GYRO, imu, 20));
+        EXPECT_TRUE (board.enqueue_notification ((int)MuseNotificationTypes::PPG0, ppg, 20));
+        EXPECT_TRUE (board.enqueue_notification ((int)MuseNotificationTypes::PPG1, ppg, 20));
+    }
+    board.stop ();
+
+    std::vector<double> res = board.get_data ();
+    int count = 12;
+    ASSERT_EQ (res.size (), (size_t)(8 * count));
+    for (int i = 0; i < count; i++)
+    {
+        EXPECT_EQ (res[i], 2.0); // package num
+        for (int ch = 0; ch < 4; ch++)
+        {
+            EXPECT_EQ (res[(1 + ch) * count + i], (i % 2 == 0) ? 125.0 * (ch + 1) : 0.0);
+        }
+        EXPECT_GT (res[6 * count + i], 0.0);
+        if (i > 0)
+        {
+            EXPECT_GE (res[6 * count + i], res[6 * count + i - 1]);
+        }
+    }
+
+    res = board.get_data ((int)BrainFlowPresets::AUXILIARY_PRESET);
+    count = 3;
+    ASSERT_EQ (res.size (), (size_t)(9 * count));
+    for (int i = 0; i < count; i++)
+    {
+        EXPECT_EQ (res[i], 2.0);
+        EXPECT_EQ (res[1 * count + i], 1.0);                                    // accel x
+        EXPECT_NEAR (res[4 * count + i], 16384 * MUSE_GYRO_SCALE_FACTOR, 1e-9); // gyro x
+        EXPECT_GT (res[7 * count + i], 0.0);
+    }
+
+    res = board.get_data ((int)BrainFlowPresets::ANCILLARY_PRESET);
+    count = 6;
+    ASSERT_EQ (res.size (), (size_t)(6 * count));
+    for (int i = 0; i < count; i++)
+    {
+        EXPECT_EQ (res[1 * count + i], 256.0);
+        EXPECT_EQ (res[2 * count + i], 256.0);
+        EXPECT_EQ (res[3 * count + i], 0.0);
+        EXPECT_GT (res[4 * count + i], 0.0);
+    }
+}
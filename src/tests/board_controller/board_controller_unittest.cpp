@@ -0,0 +1,270 @@
+#include <atomic>
+#include <chrono>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <math.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "runtime_dll_loader.h"
+
+#include "json.hpp"
+
+using json = nlohmann::json;
+using namespace testing;
+
+
+// sessions are created through C API of board controller library, path is passed from build.cmake
+class BoardControllerTest : public Test
+{
+protected:
+    DLLLoader *board_controller;
+    int (*prepare_session) (int, const char *);
+    int (*start_stream) (int, const char *, int, const char *);
+    int (*release_session) (int, const char *);
+    int (*get_board_data_count) (int, int *, int, const char *);
+    int (*insert_marker) (double, int, int, const char *);
+    int (*create_board_group) (const char *, int *);
+    int (*start_board_group_stream) (int, const char *, int);
+    int (*get_board_group_num_rows) (int *, int);
+    int (*get_board_group_data) (int, double *, int *, int);
+    int (*get_board_group_start_delays) (double *, double *, int *, int);
+    int (*release_board_group) (int);
+    int (*config_board) (const char *, char *, int *, int, const char *);
+
+    void SetUp ()
+    {
+        board_controller = new DLLLoader (BOARD_CONTROLLER_LIB);
+        ASSERT_TRUE (board_controller->load_library ());
+        prepare_session =
+            (int (*) (int, const char *))board_controller->get_address ("prepare_session");
+        start_stream = (int (*) (int, const char *, int, const char *))
+                           board_controller->get_address ("start_stream");
+        release_session =
+            (int (*) (int, const char *))board_controller->get_address ("release_session");
+        get_board_data_count = (int (*) (int, int *, int, const char *))
+                                   board_controller->get_address ("get_board_data_count");
+        insert_marker = (int (*) (double, int, int, const char *))board_controller->get_address (
+            "insert_marker");
+        create_board_group =
+            (int (*) (const char *, int *))board_controller->get_address ("create_board_group");
+        start_board_group_stream = (int (*) (int, const char *, int))board_controller->get_address (
+            "start_board_group_stream");
+        get_board_group_num_rows =
+            (int (*) (int *, int))board_controller->get_address ("get_board_group_num_rows");
+        get_board_group_data = (int (*) (int, double *, int *, int))board_controller->get_address (
+            "get_board_group_data");
+        get_board_group_start_delays = (int (*) (double *, double *, int *, int))
+                                           board_controller->get_address (
+                                               "get_board_group_start_delays");
+        release_board_group =
+            (int (*) (int))board_controller->get_address ("release_board_group");
+        config_board = (int (*) (const char *, char *, int *, int, const char *))
+                           board_controller->get_address ("config_board");
+        ASSERT_TRUE (prepare_session != NULL);
+        ASSERT_TRUE (start_stream != NULL);
+        ASSERT_TRUE (release_session != NULL);
+        ASSERT_TRUE (get_board_data_count != NULL);
+        ASSERT_TRUE (insert_marker != NULL);
+        ASSERT_TRUE (create_board_group != NULL);
+        ASSERT_TRUE (start_board_group_stream != NULL);
+        ASSERT_TRUE (get_board_group_num_rows != NULL);
+        ASSERT_TRUE (get_board_group_data != NULL);
+        ASSERT_TRUE (get_board_group_start_delays != NULL);
+        ASSERT_TRUE (release_board_group != NULL);
+        ASSERT_TRUE (config_board != NULL);
+    }
+
+    void TearDown ()
+    {
+        int (*release_all_sessions) () =
+            (int (*) ())board_controller->get_address ("release_all_sessions");
+        if (release_all_sessions != NULL)
+        {
+            release_all_sessions ();
+        }
+        delete board_controller;
+    }
+};
+
+// all fields are required by board controller, synthetic board uses none of them, different
+// serial numbers create different sessions
+static json get_input_params (const char *serial_number = "")
+{
+    json params;
+    params["serial_port"] = "";
+    params["ip_protocol"] = 0;
+    params["ip_port"] = 0;
+    params["ip_port_aux"] = 0;
+    params["ip_port_anc"] = 0;
+    params["other_info"] = "";
+    params["mac_address"] = "";
+    params["ip_address"] = "";
+    params["ip_address_aux"] = "";
+    params["ip_address_anc"] = "";
+    params["timeout"] = 0;
+    params["serial_number"] = serial_number;
+    params["file"] = "";
+    params["file_aux"] = "";
+    params["file_anc"] = "";
+    params["master_board"] = (int)BoardIds::NO_BOARD;
+    return params;
+}
+
+static std::string get_json_params (const char *serial_number = "")
+{
+    return get_input_params (serial_number).dump ();
+}
+
+TEST_F (BoardControllerTest, ReleaseWhileCalling_CallsSeeReleasedSession)
+{
+    const int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+    const int num_threads = 4;
+    std::string params = get_json_params ();
+    const char *synthetic_params = params.c_str ();
+    for (int round = 0; round < 10; round++)
+    {
+        ASSERT_EQ (
+            prepare_session (board_id, synthetic_params), (int)BrainFlowExitCodes::STATUS_OK);
+        ASSERT_EQ (start_stream (1000, "", board_id, synthetic_params),
+            (int)BrainFlowExitCodes::STATUS_OK);
+
+        // calls which found the session before release must not reach the released board
+        std::atomic<bool> released (false);
+        std::atomic<int> num_calls (0);
+        std::atomic<int> num_unexpected (0);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < num_threads; i++)
+        {
+            threads.push_back (std::thread ([&, i] () {
+                const int preset = (int)BrainFlowPresets::DEFAULT_PRESET;
+                int not_created = 0;
+                while (not_created < 10)
+                {
+                    int count = 0;
+                    int res = (i % 2 == 0) ?
+                        get_board_data_count (preset, &count, board_id, synthetic_params) :
+                        insert_marker (1.0, preset, board_id, synthetic_params);
+                    num_calls++;
+                    if (res == (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR)
+                    {
+                        // before release session is always found
+                        if (!released)
+                        {
+                            num_unexpected++;
+                        }
+                        not_created++;
+                    }
+                    else if (res != (int)BrainFlowExitCodes::STATUS_OK)
+                    {
+                        num_unexpected++;
+                    }
+                }
+            }));
+        }
+        while (num_calls < 100)
+        {
+            std::this_thread::yield ();
+        }
+        released = true;
+        EXPECT_EQ (
+            release_session (board_id, synthetic_params), (int)BrainFlowExitCodes::STATUS_OK);
+        for (size_t i = 0; i < threads.size (); i++)
+        {
+            threads[i].join ();
+        }
+        EXPECT_EQ (num_unexpected.load (), 0);
+        EXPECT_EQ (release_session (board_id, synthetic_params),
+            (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR);
+    }
+}
+
+TEST_F (BoardControllerTest, BoardGroup_ReadsWithoutRemovingAndDropsReleasedBoard)
+{
+    const int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+    const int preset = (int)BrainFlowPresets::DEFAULT_PRESET;
+    std::string first = get_json_params ("first");
+    std::string second = get_json_params ("second");
+    ASSERT_EQ (prepare_session (board_id, first.c_str ()), (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (prepare_session (board_id, second.c_str ()), (int)BrainFlowExitCodes::STATUS_OK);
+    json config;
+    config["boards"] = json::array ();
+    config["boards"].push_back (
+        {{"board_id", board_id}, {"input_params", get_input_params ("first")}});
+    config["boards"].push_back (
+        {{"board_id", board_id}, {"input_params", get_input_params ("second")}});
+    config["preset"] = preset;
+    int group_id = -1;
+    ASSERT_EQ (create_board_group (config.dump ().c_str (), &group_id),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (start_board_group_stream (10000, "", group_id), (int)BrainFlowExitCodes::STATUS_OK);
+    int num_rows = 0;
+    ASSERT_EQ (get_board_group_num_rows (&num_rows, group_id), (int)BrainFlowExitCodes::STATUS_OK);
+    const int board_values = (num_rows - 1) / 2;
+    const int max_samples = 2000;
+    std::vector<double> data ((size_t)num_rows * max_samples);
+    int num_samples = 0;
+
+    // data stays in buffers of boards after group reads it
+    std::this_thread::sleep_for (std::chrono::milliseconds (500));
+    int count_before = 0;
+    ASSERT_EQ (get_board_data_count (preset, &count_before, board_id, first.c_str ()),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (get_board_group_data (max_samples, data.data (), &num_samples, group_id),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_GT (num_samples, 0);
+    int count_after = 0;
+    ASSERT_EQ (get_board_data_count (preset, &count_after, board_id, first.c_str ()),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_GE (count_after, count_before);
+
+    // released board is dropped, its rows are NaN and group keeps merging the other one
+    ASSERT_EQ (release_session (board_id, second.c_str ()), (int)BrainFlowExitCodes::STATUS_OK);
+    std::this_thread::sleep_for (std::chrono::milliseconds (300));
+    ASSERT_EQ (get_board_group_data (max_samples, data.data (), &num_samples, group_id),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_GT (num_samples, 0);
+    for (int i = 0; i < num_samples; i++)
+    {
+        EXPECT_FALSE (isnan (data[(size_t)1 * num_samples + i]));
+        EXPECT_TRUE (isnan (data[(size_t)(1 + board_values) * num_samples + i]));
+    }
+    double start_delays[2] = {0.0};
+    double rates[2] = {0.0};
+    int num_boards = 0;
+    ASSERT_EQ (get_board_group_start_delays (start_delays, rates, &num_boards, group_id),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (num_boards, 2);
+    EXPECT_EQ (start_delays[0], 0.0);
+    EXPECT_GT (rates[0], 0.0);
+    EXPECT_TRUE (isnan (start_delays[1]));
+    EXPECT_TRUE (isnan (rates[1]));
+    EXPECT_EQ (release_board_group (group_id), (int)BrainFlowExitCodes::STATUS_OK);
+}
+
+TEST_F (BoardControllerTest, ConfigBoard_LongResponseRejected)
+{
+    const int board_id = (int)BoardIds::SYNTHETIC_LOAD_BOARD;
+    std::string params = get_json_params ();
+    ASSERT_EQ (prepare_session (board_id, params.c_str ()), (int)BrainFlowExitCodes::STATUS_OK);
+    // bindings allocate 4096 bytes, response including null terminator must fit
+    std::vector<char> response (4096 + 64, 'x');
+    int response_len = -1;
+    ASSERT_EQ (config_board ("{\"num_channels\": 1024}", response.data (), &response_len,
+                   board_id, params.c_str ()),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (std::string (response.data (), response_len), "num_channels: 1024, num_rows: 1027");
+    EXPECT_EQ (response[response_len], '\0');
+
+    std::string config (4096, 'a');
+    response_len = -1;
+    response[0] = 'x';
+    EXPECT_EQ (config_board (
+                   config.c_str (), response.data (), &response_len, board_id, params.c_str ()),
+        (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR);
+    EXPECT_EQ (response_len, -1);
+    EXPECT_EQ (response[0], 'x');
+    EXPECT_EQ (release_session (board_id, params.c_str ()), (int)BrainFlowExitCodes::STATUS_OK);
+}
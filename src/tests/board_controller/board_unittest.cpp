@@ -0,0 +1,356 @@
+#include <chrono>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board.h"
+#include "synthetic_board.h"
+
+using namespace testing;
+
+
+// board without device, packages are pushed by tests directly
+class TestBoard : public Board
+{
+public:
+    TestBoard () : Board ((int)BoardIds::SYNTHETIC_BOARD, BrainFlowInputParams ())
+    {
+    }
+
+    ~TestBoard ()
+    {
+        skip_logs = true;
+        release_session ();
+    }
+
+    int prepare_session ()
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    int start_stream (int buffer_size, const char *streamer_params)
+    {
+        return prepare_for_acquisition (buffer_size, streamer_params);
+    }
+
+    int stop_stream ()
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    int release_session ()
+    {
+        free_packages ();
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    int config_board (std::string config, std::string &response)
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    int get_int (const char *field)
+    {
+        return board_descr["default"][field];
+    }
+
+    // layout is changed at runtime like by boards configurable from config_board
+    void set_num_rows (int num_rows)
+    {
+        board_descr["default"]["num_rows"] = num_rows;
+    }
+
+    // packages with package num channel set to index and other channels to 0
+    void push (int first_index, int num_packages)
+    {
+        int num_rows = get_int ("num_rows");
+        std::vector<double> packages ((size_t)num_rows * num_packages, 0.0);
+        for (int i = 0; i < num_packages; i++)
+        {
+            packages[(size_t)i * num_rows + get_int ("package_num_channel")] =
+                (double)(first_index + i);
+        }
+        push_packages (packages.data (), num_packages);
+    }
+};
+
+TEST (BoardTest, PushPackages_MoreThanBufferSize_MarkersKeptForStoredPackages)
+{
+    TestBoard board;
+    ASSERT_EQ (board.start_stream (4, ""), (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (board.insert_marker (5.0, (int)BrainFlowPresets::DEFAULT_PRESET),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (board.insert_marker (6.0, (int)BrainFlowPresets::DEFAULT_PRESET),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    board.push (0, 10);
+
+    int num_rows = board.get_int ("num_rows");
+    int count = 0;
+    ASSERT_EQ (board.get_board_data_count ((int)BrainFlowPresets::DEFAULT_PRESET, &count),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (count, 4);
+    std::vector<double> data ((size_t)num_rows * count);
+    ASSERT_EQ (board.get_board_data (count, (int)BrainFlowPresets::DEFAULT_PRESET, data.data ()),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    int package_num_channel = board.get_int ("package_num_channel");
+    int marker_channel = board.get_int ("marker_channel");
+    double expected_markers[4] = {5.0, 6.0, 0.0, 0.0};
+    for (int i = 0; i < count; i++)
+    {
+        EXPECT_EQ (data[(size_t)package_num_channel * count + i], (double)(6 + i));
+        EXPECT_EQ (data[(size_t)marker_channel * count + i], expected_markers[i]);
+    }
+}
+
+TEST (BoardTest, LayoutWiderThanBoardDescription_DataNotWritten)
+{
+    TestBoard board;
+    int num_rows = board.get_int ("num_rows");
+    board.set_num_rows (num_rows + 3);
+    ASSERT_EQ (board.start_stream (10, ""), (int)BrainFlowExitCodes::STATUS_OK);
+    board.push (0, 5);
+
+    // caller allocated rows of board description only
+    std::vector<double> data ((size_t)num_rows * 5, -1.0);
+    int returned = 0;
+    EXPECT_EQ (board.get_current_board_data (
+                   5, (int)BrainFlowPresets::DEFAULT_PRESET, data.data (), &returned),
+        (int)BrainFlowExitCodes::GENERAL_ERROR);
+    EXPECT_EQ (board.get_board_data (5, (int)BrainFlowPresets::DEFAULT_PRESET, data.data ()),
+        (int)BrainFlowExitCodes::GENERAL_ERROR);
+    EXPECT_THAT (data, Each (-1.0));
+}
+
+TEST (BoardTest, SyntheticLoadMode_KeepsRowsOfBoardDescription)
+{
+    SyntheticBoard board ((int)BoardIds::SYNTHETIC_BOARD, BrainFlowInputParams ());
+    ASSERT_EQ (board.prepare_session (), (int)BrainFlowExitCodes::STATUS_OK);
+    std::string response;
+    EXPECT_EQ (board.config_board ("{\"num_channels\": 1024}", response),
+        (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    ASSERT_EQ (board.config_board (
+                   "{\"num_channels\": 8, \"sampling_rate\": 1000, \"profile\": \"sine\"}",
+                   response),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    int num_rows = 0;
+    ASSERT_EQ (board.get_session_num_rows ((int)BrainFlowPresets::DEFAULT_PRESET, &num_rows),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (num_rows, 32);
+
+    ASSERT_EQ (board.start_stream (1000, ""), (int)BrainFlowExitCodes::STATUS_OK);
+    int count = 0;
+    auto deadline = std::chrono::steady_clock::now () + std::chrono::seconds (5);
+    while ((count < 10) && (std::chrono::steady_clock::now () < deadline))
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (5));
+        board.get_board_data_count ((int)BrainFlowPresets::DEFAULT_PRESET, &count);
+    }
+    board.stop_stream ();
+    board.get_board_data_count ((int)BrainFlowPresets::DEFAULT_PRESET, &count);
+    ASSERT_GE (count, 10);
+    std::vector<double> data ((size_t)num_rows * count);
+    ASSERT_EQ (board.get_board_data (count, (int)BrainFlowPresets::DEFAULT_PRESET, data.data ()),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    board.release_session ();
+
+    // exg channels 1..8, timestamp and marker are the same as in board description
+    for (int i = 1; i < count; i++)
+    {
+        EXPECT_GT (data[(size_t)30 * count + i], data[(size_t)30 * count + i - 1]);
+        EXPECT_EQ (data[(size_t)31 * count + i], 0.0);
+        EXPECT_EQ (data[(size_t)9 * count + i], 0.0);
+    }
+    bool has_signal = false;
+    for (int i = 0; i < count; i++)
+    {
+        has_signal = has_signal || (data[(size_t)1 * count + i] != 0.0);
+    }
+    EXPECT_TRUE (has_signal);
+}
+
+TEST (BoardTest, SyntheticLoadMode_Disabled_RestoresBoardDescription)
+{
+    SyntheticBoard board ((int)BoardIds::SYNTHETIC_BOARD, BrainFlowInputParams ());
+    ASSERT_EQ (board.prepare_session (), (int)BrainFlowExitCodes::STATUS_OK);
+    std::string response;
+    ASSERT_EQ (board.config_board ("{\"num_channels\": 4}", response),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (response, "num_channels: 4, num_rows: 32");
+    json session_descr;
+    ASSERT_EQ (board.get_session_descr ((int)BrainFlowPresets::DEFAULT_PRESET, session_descr),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (session_descr["eeg_channels"].size (), (size_t)4);
+    ASSERT_EQ (board.config_board ("{\"enabled\": false}", response),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (response, "num_channels: 0, num_rows: 32");
+    json descr = boards_struct.brainflow_boards_json["boards"]["-1"]["default"];
+    ASSERT_EQ (board.get_session_descr ((int)BrainFlowPresets::DEFAULT_PRESET, session_descr),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (session_descr, descr);
+
+    // load layout of previous session is not kept
+    ASSERT_EQ (board.config_board ("{\"num_channels\": 4}", response),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    board.release_session ();
+    ASSERT_EQ (board.prepare_session (), (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (board.config_board ("{\"enabled\": false}", response),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (response, "num_channels: 0, num_rows: 32");
+    ASSERT_EQ (board.get_session_descr ((int)BrainFlowPresets::DEFAULT_PRESET, session_descr),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (session_descr, descr);
+}
+
+TEST (BoardTest, SyntheticLoadBoard_StreamsUpTo1024Channels)
+{
+    BrainFlowInputParams params;
+    params.other_info = "{\"num_channels\": 1024, \"sampling_rate\": 1000, \"batch_size\": 10}";
+    SyntheticBoard board ((int)BoardIds::SYNTHETIC_LOAD_BOARD, params);
+    ASSERT_EQ (board.prepare_session (), (int)BrainFlowExitCodes::STATUS_OK);
+    std::string response;
+    EXPECT_EQ (board.config_board ("{\"enabled\": false}", response),
+        (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    EXPECT_EQ (board.config_board ("{\"num_channels\": 1025}", response),
+        (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    int num_rows = 0;
+    ASSERT_EQ (board.get_session_num_rows ((int)BrainFlowPresets::DEFAULT_PRESET, &num_rows),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (num_rows, 1027);
+
+    ASSERT_EQ (board.start_stream (1000, ""), (int)BrainFlowExitCodes::STATUS_OK);
+    int count = 0;
+    auto deadline = std::chrono::steady_clock::now () + std::chrono::seconds (5);
+    while ((count < 10) && (std::chrono::steady_clock::now () < deadline))
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (5));
+        board.get_board_data_count ((int)BrainFlowPresets::DEFAULT_PRESET, &count);
+    }
+    board.stop_stream ();
+    board.get_board_data_count ((int)BrainFlowPresets::DEFAULT_PRESET, &count);
+    ASSERT_GE (count, 10);
+    std::vector<double> data ((size_t)num_rows * count);
+    ASSERT_EQ (board.get_board_data (count, (int)BrainFlowPresets::DEFAULT_PRESET, data.data ()),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    board.release_session ();
+
+    // last exg channel has signal, timestamp and marker are the last rows
+    bool has_signal = false;
+    for (int i = 0; i < count; i++)
+    {
+        has_signal = has_signal || (data[(size_t)1024 * count + i] != 0.0);
+        EXPECT_EQ (data[(size_t)1026 * count + i], 0.0);
+    }
+    EXPECT_TRUE (has_signal);
+    for (int i = 1; i < count; i++)
+    {
+        EXPECT_GT (data[(size_t)1025 * count + i], data[(size_t)1025 * count + i - 1]);
+    }
+}
+
+TEST (BoardTest, Snapshot_AfterPartialRead_ReturnsLatestStoredSamples)
+{
+    TestBoard board;
+    ASSERT_EQ (board.start_stream (8, ""), (int)BrainFlowExitCodes::STATUS_OK);
+    board.push (0, 6);
+    int num_rows = board.get_int ("num_rows");
+    std::vector<double> data ((size_t)num_rows * 10);
+    ASSERT_EQ (board.get_board_data (2, (int)BrainFlowPresets::DEFAULT_PRESET, data.data ()),
+        (int)BrainFlowExitCodes::STATUS_OK);
+
+    int preset = (int)BrainFlowPresets::DEFAULT_PRESET;
+    int num_samples = 10;
+    int returned = 0;
+    ASSERT_EQ (board.get_current_board_data_snapshot (
+                   &preset, &num_samples, 1, data.data (), &returned),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (returned, 4);
+    int package_num_channel = board.get_int ("package_num_channel");
+    for (int i = 0; i < returned; i++)
+    {
+        EXPECT_EQ (data[(size_t)package_num_channel * returned + i], (double)(2 + i));
+    }
+}
+
+TEST (BoardTest, Epochs_WindowBeforeFirstSample_CountedAsDropped)
+{
+    TestBoard board;
+    ASSERT_EQ (board.start_stream (16, ""), (int)BrainFlowExitCodes::STATUS_OK);
+    int preset = (int)BrainFlowPresets::DEFAULT_PRESET;
+    double marker = 1.0;
+    int definition_id = -1;
+    ASSERT_EQ (board.add_epoch_definition (&marker, 1, 2, 2, 4, preset, &definition_id),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    // the first marker has no pre window, the second one is complete
+    ASSERT_EQ (board.insert_marker (marker, preset), (int)BrainFlowExitCodes::STATUS_OK);
+    board.push (0, 5);
+    ASSERT_EQ (board.insert_marker (marker, preset), (int)BrainFlowExitCodes::STATUS_OK);
+    board.push (5, 5);
+
+    int count = 0;
+    double num_dropped = 0.0;
+    ASSERT_EQ (board.get_epoch_count (definition_id, &count), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (count, 1);
+    ASSERT_EQ (board.get_num_dropped_epochs (definition_id, &num_dropped),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (num_dropped, 1.0);
+    EXPECT_EQ (board.get_num_dropped_epochs (definition_id + 1, &num_dropped),
+        (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+}
+
+TEST (BoardTest, Snapshot_ConcurrentPush_FullAndConsecutive)
+{
+    TestBoard board;
+    ASSERT_EQ (board.start_stream (64, ""), (int)BrainFlowExitCodes::STATUS_OK);
+    board.push (0, 64);
+    const int num_pushed = 20000;
+    std::thread push_thread ([&] () {
+        for (int i = 64; i < 64 + num_pushed; i++)
+        {
+            board.push (i, 1);
+        }
+    });
+
+    // buffer is full at any cut, so each snapshot has all requested samples and they are the
+    // consecutive latest ones whatever the interleaving with pushes is
+    int num_rows = board.get_int ("num_rows");
+    int package_num_channel = board.get_int ("package_num_channel");
+    int preset = (int)BrainFlowPresets::DEFAULT_PRESET;
+    std::vector<double> data ((size_t)num_rows * 64);
+    int num_failed = 0;
+    for (int attempt = 0; attempt < 2000; attempt++)
+    {
+        // snapshot of the whole buffer is overwritten by any push during copy and falls back to
+        // copying under lock
+        int num_samples = (attempt % 2 == 0) ? 32 : 64;
+        int returned = 0;
+        int res = board.get_current_board_data_snapshot (
+            &preset, &num_samples, 1, data.data (), &returned);
+        if ((res != (int)BrainFlowExitCodes::STATUS_OK) || (returned != num_samples))
+        {
+            num_failed++;
+            continue;
+        }
+        const double *package_nums = data.data () + (size_t)package_num_channel * returned;
+        for (int i = 1; i < returned; i++)
+        {
+            if (package_nums[i] != package_nums[i - 1] + 1.0)
+            {
+                num_failed++;
+                break;
+            }
+        }
+    }
+    push_thread.join ();
+    EXPECT_EQ (num_failed, 0);
+
+    int num_samples = 32;
+    int returned = 0;
+    ASSERT_EQ (board.get_current_board_data_snapshot (
+                   &preset, &num_samples, 1, data.data (), &returned),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (returned, num_samples);
+    EXPECT_EQ (data[(size_t)package_num_channel * returned + returned - 1],
+        (double)(64 + num_pushed - 1));
+}
@@ -0,0 +1,123 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "emotibit_parser.h"
+
+using namespace testing;
+
+
+// same layout as emotibit board description
+static nlohmann::json get_board_descr ()
+{
+    nlohmann::json descr;
+    descr["default"] = {{"package_num_channel", 0}, {"timestamp_channel", 10},
+        {"marker_channel", 11}, {"num_rows", 12}, {"accel_channels", {1, 2, 3}},
+        {"gyro_channels", {4, 5, 6}}, {"magnetometer_channels", {7, 8, 9}}};
+    descr["auxiliary"] = {{"package_num_channel", 0}, {"timestamp_channel", 4},
+        {"marker_channel", 5}, {"num_rows", 6}, {"ppg_channels", {1, 2, 3}}};
+    descr["ancillary"] = {{"package_num_channel", 0}, {"timestamp_channel", 4},
+        {"marker_channel", 5}, {"num_rows", 6}, {"eda_channels", {1}},
+        {"temperature_channels", {2}}, {"other_channels", {3}}};
+    return descr;
+}
+
+struct PushedPackages
+{
+    std::vector<std::vector<double>> packages[3];
+
+    EmotibitParser::PushCallback callback ()
+    {
+        return [this] (double *package, int preset) {
+            int num_rows = (preset == (int)BrainFlowPresets::DEFAULT_PRESET) ? 12 : 6;
+            packages[preset].push_back (std::vector<double> (package, package + num_rows));
+        };
+    }
+};
+
+// clock which returns 1, 2, 3 ... to check that each datapoint takes its own timestamp
+static EmotibitParser::TimestampCallback get_counting_clock (double *counter)
+{
+    *counter = 0.0;
+    return [counter] () { return ++(*counter); };
+}
+
+TEST (EmotibitParserTest, Parse_RecordedImuPackages_PushesDefaultRows)
+{
+    EmotibitParser parser (get_board_descr ());
+    PushedPackages pushed;
+    // packages recorded from device, default preset is pushed on magnetometer z
+    std::string message = "18915,1021,2,AX,1,100,-0.139,-0.141\n"
+                          "18915,1022,2,AY,1,100,0.051,0.049\n"
+                          "18915,1023,2,AZ,1,100,0.986,0.988\n"
+                          "18915,1024,2,GX,1,100,0.244,0.183\n"
+                          "18915,1025,2,GY,1,100,-1.465,-1.404\n"
+                          "18915,1026,2,GZ,1,100,0.427,0.488\n"
+                          "18915,1027,2,MX,1,100,-27,-27\n"
+                          "18915,1028,2,MY,1,100,58,57\n"
+                          "18915,1029,2,MZ,1,100,-61,-60\n";
+    double counter = 0.0;
+    EXPECT_EQ (parser.parse (&message[0], get_counting_clock (&counter), pushed.callback ()), 0);
+    // timestamp is taken per datapoint of each type tag, the last one is of magnetometer z
+    ASSERT_EQ (pushed.packages[(int)BrainFlowPresets::DEFAULT_PRESET].size (), 2u);
+    EXPECT_THAT (pushed.packages[(int)BrainFlowPresets::DEFAULT_PRESET][0],
+        ElementsAre (1029.0, -0.139, 0.051, 0.986, 0.244, -1.465, 0.427, -27.0, 58.0, -61.0, 17.0,
+            0.0));
+    EXPECT_THAT (pushed.packages[(int)BrainFlowPresets::DEFAULT_PRESET][1],
+        ElementsAre (1029.0, -0.141, 0.049, 0.988, 0.183, -1.404, 0.488, -27.0, 57.0, -60.0, 18.0,
+            0.0));
+    EXPECT_TRUE (pushed.packages[(int)BrainFlowPresets::AUXILIARY_PRESET].empty ());
+}
+
+TEST (EmotibitParserTest, Parse_TemperatureAndEda_UpsamplesTemperature)
+{
+    EmotibitParser parser (get_board_descr ());
+    PushedPackages pushed;
+    std::string message = "20010,2001,2,T1,1,100,31.5,31.7\n"
+                          "20010,2002,1,TH,1,100,29.25\n"
+                          "20010,2003,4,EA,1,100,0.11,0.12,0.13,0.14\n";
+    double counter = 0.0;
+    EXPECT_EQ (parser.parse (&message[0], get_counting_clock (&counter), pushed.callback ()), 0);
+    const std::vector<std::vector<double>> &anc =
+        pushed.packages[(int)BrainFlowPresets::ANCILLARY_PRESET];
+    ASSERT_EQ (anc.size (), 4u);
+    EXPECT_THAT (anc[0], ElementsAre (2003.0, 0.11, 31.5, 29.25, 1.0, 0.0));
+    EXPECT_THAT (anc[1], ElementsAre (2003.0, 0.12, 31.5, 29.25, 2.0, 0.0));
+    EXPECT_THAT (anc[2], ElementsAre (2003.0, 0.13, 31.7, 0.0, 3.0, 0.0));
+    EXPECT_THAT (anc[3], ElementsAre (2003.0, 0.14, 31.7, 0.0, 4.0, 0.0));
+}
+
+TEST (EmotibitParserTest, Parse_TruncatedPackage_SkippedWithoutPush)
+{
+    EmotibitParser parser (get_board_descr ());
+    PushedPackages pushed;
+    // the second package lost its tail, the third has no complete header
+    std::string message = "30001,3001,2,PI,1,100,1200,1210\n"
+                          "30001,3002,2,PR,1,100,980\n"
+                          "30001,3003,2\n"
+                          "30001,3004,2,PR,1,100,990,991\n"
+                          "30001,3005,2,PG,1,100,450,abc\n";
+    double counter = 0.0;
+    EXPECT_EQ (parser.parse (&message[0], get_counting_clock (&counter), pushed.callback ()), 3);
+    const std::vector<std::vector<double>> &aux =
+        pushed.packages[(int)BrainFlowPresets::AUXILIARY_PRESET];
+    ASSERT_EQ (aux.size (), 2u);
+    EXPECT_THAT (aux[0], ElementsAre (3005.0, 1200.0, 990.0, 450.0, 5.0, 0.0));
+    // invalid value keeps previous one
+    EXPECT_THAT (aux[1], ElementsAre (3005.0, 1210.0, 991.0, 0.0, 6.0, 0.0));
+}
+
+TEST (EmotibitParserTest, Parse_UnknownTagAndEmptyPackages_Ignored)
+{
+    EmotibitParser parser (get_board_descr ());
+    PushedPackages pushed;
+    std::string message = "\n\n40001,4001,1,BV,1,100,3.9\n,,\n";
+    double counter = 0.0;
+    EXPECT_EQ (parser.parse (&message[0], get_counting_clock (&counter), pushed.callback ()), 1);
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_TRUE (pushed.packages[i].empty ());
+    }
+}
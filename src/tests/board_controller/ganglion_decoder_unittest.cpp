@@ -0,0 +1,217 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <random>
+#include <string.h>
+
+#include "ganglion_decoder.h"
+
+using namespace testing;
+
+
+// writes raw N bit fields MSB first starting at bit 8, right after package id
+template <unsigned int N>
+static void pack_raw_values (unsigned char *package, const uint32_t *raw)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        for (unsigned int bit = 0; bit < N; bit++)
+        {
+            int offset = 8 + i * (int)N + (int)bit;
+            if ((raw[i] >> (N - 1 - bit)) & 1)
+            {
+                package[offset / 8] |= (unsigned char)(0x80 >> (offset % 8));
+            }
+        }
+    }
+}
+
+// firmware 2 decoding as it was done before GanglionDecoder, via bit array and bitset cast
+static void reference_decode_firmware_2 (const unsigned char *package, float *last_data)
+{
+    if (package[0] == 0)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            last_data[i] = last_data[i + 4];
+            last_data[i + 4] = (float)cast_24bit_to_int32 (package + 1 + i * 3);
+        }
+        return;
+    }
+    unsigned char package_bits[160] = {0};
+    for (int i = 0; i < 20; i++)
+    {
+        uchar_to_bits (package[i], package_bits + i * 8);
+    }
+    float delta[8] = {0.f};
+    for (int i = 0; i < 8; i++)
+    {
+        if (package[0] <= 100)
+        {
+            delta[i] = (float)cast_ganglion_bits_to_int32<18> (package_bits + 8 + i * 18);
+        }
+        else if (package[0] <= 200)
+        {
+            delta[i] = (float)cast_ganglion_bits_to_int32<19> (package_bits + 8 + i * 19);
+        }
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        last_data[i] = last_data[i + 4] - delta[i];
+    }
+    for (int i = 4; i < 8; i++)
+    {
+        last_data[i] = last_data[i - 4] - delta[i];
+    }
+}
+
+// firmware 3 decoding as it was done before GanglionDecoder, via bit array and bitset cast
+static void reference_decode_firmware_3 (const unsigned char *package, float *last_data)
+{
+    unsigned char package_bits[160] = {0};
+    for (int i = 0; i < 20; i++)
+    {
+        uchar_to_bits (package[i], package_bits + i * 8);
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        if (package[0] < 100)
+        {
+            int32_t value = cast_ganglion_bits_to_int32<18> (package_bits + 8 + i * 18);
+            last_data[i] = (float)(value << 6);
+        }
+        else if (package[0] < 200)
+        {
+            int32_t value = cast_ganglion_bits_to_int32<19> (package_bits + 8 + i * 19);
+            last_data[i] = (float)(value << 5);
+        }
+    }
+}
+
+TEST (GanglionDecoderTest, DecodeFirmware3_18Bit_KnownPackage)
+{
+    unsigned char package[20] = {0};
+    package[0] = 1;
+    // 0x3FFFF and 0x20000 are negative, ganglion adds 2 after two's complement flip
+    uint32_t raw[8] = {1, 0x3FFFF, 0x20000, 100, 0x1FFFF, 0, 0, 7};
+    pack_raw_values<18> (package, raw);
+    package[19] = 0xFE;
+    float last_data[8] = {0.f};
+    double acceleration[3] = {0.0};
+
+    EXPECT_EQ (GanglionDecoder::decode_firmware_3 (package, last_data, acceleration, 0.5), 2);
+    int32_t expected[8] = {1, -2, -131073, 100, 131071, 0, 0, 7};
+    for (int i = 0; i < 8; i++)
+    {
+        EXPECT_EQ (last_data[i], (float)(expected[i] * 64));
+    }
+    // package id 1 carries accel y
+    EXPECT_EQ (acceleration[0], 0.0);
+    EXPECT_EQ (acceleration[1], -1.0);
+    EXPECT_EQ (acceleration[2], 0.0);
+}
+
+TEST (GanglionDecoderTest, DecodeFirmware3_19Bit_KnownPackage)
+{
+    unsigned char package[20] = {0};
+    package[0] = 101;
+    uint32_t raw[8] = {0x7FFFF, 0x40000, 1, 0, 0x3FFFF, 5, 0, 0};
+    pack_raw_values<19> (package, raw);
+    float last_data[8] = {0.f};
+    double acceleration[3] = {0.0};
+
+    EXPECT_EQ (GanglionDecoder::decode_firmware_3 (package, last_data, acceleration, 0.5), 2);
+    int32_t expected[8] = {-2, -262145, 1, 0, 262143, 5, 0, 0};
+    for (int i = 0; i < 8; i++)
+    {
+        EXPECT_EQ (last_data[i], (float)(expected[i] * 32));
+    }
+    // 19 bit packages have no accel data
+    EXPECT_EQ (acceleration[1], 0.0);
+}
+
+TEST (GanglionDecoderTest, DecodeFirmware2_RawThenDeltas_KnownSamples)
+{
+    float last_data[8] = {0.f};
+    double acceleration[3] = {0.0};
+
+    // package 0 holds 4 uncompressed 24 bit samples
+    unsigned char raw_package[20] = {0, 0x00, 0x03, 0xE8, 0xFF, 0xFC, 0x18, 0x00, 0x00, 0x01, 0x7F,
+        0xFF, 0xFF};
+    EXPECT_EQ (GanglionDecoder::decode_firmware_2 (raw_package, last_data, acceleration, 0.5), 1);
+    float expected_raw[4] = {1000.f, -1000.f, 1.f, 8388607.f};
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ (last_data[i], 0.f);
+        EXPECT_EQ (last_data[i + 4], expected_raw[i]);
+    }
+
+    // 18 bit deltas, first sample is subtracted from the previous one, second from the first
+    unsigned char delta_18[20] = {0};
+    delta_18[0] = 2;
+    uint32_t raw_18[8] = {1, 2, 3, 4, 0x3FFFF, 0, 0, 0};
+    pack_raw_values<18> (delta_18, raw_18);
+    delta_18[19] = 4;
+    EXPECT_EQ (GanglionDecoder::decode_firmware_2 (delta_18, last_data, acceleration, 0.5), 2);
+    float expected_18[8] = {999.f, -1002.f, -2.f, 8388603.f, 1001.f, -1002.f, -2.f, 8388603.f};
+    for (int i = 0; i < 8; i++)
+    {
+        EXPECT_EQ (last_data[i], expected_18[i]);
+    }
+    EXPECT_EQ (acceleration[0], 2.0);
+
+    // 19 bit deltas
+    unsigned char delta_19[20] = {0};
+    delta_19[0] = 150;
+    uint32_t raw_19[8] = {0, 0, 0, 0, 10, 0x7FFFF, 0, 0};
+    pack_raw_values<19> (delta_19, raw_19);
+    EXPECT_EQ (GanglionDecoder::decode_firmware_2 (delta_19, last_data, acceleration, 0.5), 2);
+    float expected_19[8] = {1001.f, -1002.f, -2.f, 8388603.f, 991.f, -1000.f, -2.f, 8388603.f};
+    for (int i = 0; i < 8; i++)
+    {
+        EXPECT_EQ (last_data[i], expected_19[i]);
+    }
+}
+
+TEST (GanglionDecoderTest, DecodeFirmware2_RandomStream_MatchesBitsetDecoding)
+{
+    std::mt19937 gen (7);
+    std::uniform_int_distribution<int> byte_dist (0, 255);
+    std::uniform_int_distribution<int> id_dist (0, 200);
+    float last_data[8] = {0.f};
+    float reference[8] = {0.f};
+    double acceleration[3] = {0.0};
+    unsigned char package[20];
+    for (int iter = 0; iter < 20000; iter++)
+    {
+        // deltas are small in real streams, reinit often so float values stay exact
+        package[0] = (iter % 16 == 0) ? 0 : (unsigned char)id_dist (gen);
+        for (int i = 1; i < 20; i++)
+        {
+            package[i] = (unsigned char)byte_dist (gen);
+        }
+        GanglionDecoder::decode_firmware_2 (package, last_data, acceleration, 0.5);
+        reference_decode_firmware_2 (package, reference);
+        ASSERT_EQ (memcmp (last_data, reference, sizeof (last_data)), 0) << "package " << iter;
+    }
+}
+
+TEST (GanglionDecoderTest, DecodeFirmware3_RandomStream_MatchesBitsetDecoding)
+{
+    std::mt19937 gen (11);
+    std::uniform_int_distribution<int> byte_dist (0, 255);
+    float last_data[8] = {0.f};
+    float reference[8] = {0.f};
+    double acceleration[3] = {0.0};
+    unsigned char package[20];
+    for (int iter = 0; iter < 20000; iter++)
+    {
+        // all package ids including impedance and ascii ones which keep previous values
+        for (int i = 0; i < 20; i++)
+        {
+            package[i] = (unsigned char)byte_dist (gen);
+        }
+        GanglionDecoder::decode_firmware_3 (package, last_data, acceleration, 0.5);
+        reference_decode_firmware_3 (package, reference);
+        ASSERT_EQ (memcmp (last_data, reference, sizeof (last_data)), 0) << "package " << iter;
+    }
+}
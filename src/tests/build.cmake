@@ -30,11 +30,92 @@ enable_testing()
 SET (TESTS_SRC
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/bluetooth/bluetooth_functions.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/sequence_tracker.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/stream_aligner.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/uniform_resampler.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/epoch_extractor.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/signal_quality_monitor.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/decimated_history.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/emotibit/emotibit_parser.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/timestamp.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/multicast_server.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/socket_client_udp.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/board.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/brainflow_boards.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/file_streamer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/multicast_streamer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/plotjuggler_udp_streamer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/ble_lib_board.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/brainalive/brainalive.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/aavaa/aavaa_v3.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/openbci/ganglion_native.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/muse/muse.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/synthetic_board.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/base_classifier.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/band_power_pipeline.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/linear_classifier.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/ml_module.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/dyn_lib_classifier.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/onnx/onnx_classifier.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/mindfulness_classifier.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/lazy_classifier.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/model_registry.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/generated/mindfulness_model.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/bluetooth/socket_bluetooth_test.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/bluetooth/bluetooth_functions_unittest.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/data_buffer_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/custom_cast_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/sequence_tracker_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/spsc_queue_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/latency_histogram_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/array_conversion_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/uniform_noise_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/stream_aligner_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/uniform_resampler_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/epoch_extractor_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/signal_quality_monitor_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/decimated_history_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/board_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/board_controller_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/emotibit_parser_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/ble_notifications_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/ganglion_decoder_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/ml/band_power_pipeline_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/ml/linear_classifier_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/ml/dyn_lib_classifier_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/ml/ml_module_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/ml/onnx_classifier_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/ml/model_registry_unittest.cpp
 )
 
+# plugins for DynLibClassifier tests, same source is built with context and legacy interfaces
+SET (DYN_LIB_TEST_PLUGIN_NAME "dyn_lib_test_plugin")
+SET (DYN_LIB_LEGACY_TEST_PLUGIN_NAME "dyn_lib_legacy_test_plugin")
+
+add_library (
+    ${DYN_LIB_TEST_PLUGIN_NAME} SHARED
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/ml/dyn_lib_test_plugin.cpp
+)
+add_library (
+    ${DYN_LIB_LEGACY_TEST_PLUGIN_NAME} SHARED
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/ml/dyn_lib_test_plugin.cpp
+)
+target_compile_definitions (${DYN_LIB_LEGACY_TEST_PLUGIN_NAME} PRIVATE DYN_LIB_TEST_PLUGIN_LEGACY)
+
+foreach (PLUGIN_NAME ${DYN_LIB_TEST_PLUGIN_NAME} ${DYN_LIB_LEGACY_TEST_PLUGIN_NAME})
+    target_include_directories (
+        ${PLUGIN_NAME} PRIVATE
+        ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/inc
+        ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/inc
+    )
+    set_target_properties (${PLUGIN_NAME}
+        PROPERTIES
+        ARCHIVE_OUTPUT_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/build/tests
+        LIBRARY_OUTPUT_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/build/tests
+        RUNTIME_OUTPUT_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/build/tests
+    )
+endforeach (PLUGIN_NAME)
+
 add_executable(
     ${TESTS_EXE_NAME}
     ${TESTS_SRC}
@@ -46,13 +127,44 @@ target_include_directories (
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/bluetooth/inc
     ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/bluetooth/inc
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/bluetooth/macos_third_party
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/emotibit/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/brainalive/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/aavaa/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/openbci/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/muse/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/ml/onnx/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/ml/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/third_party/onnxruntime/build/native/include
+    ${CMAKE_CURRENT_SOURCE_DIR}/third_party/SimpleBLE/simpleble/include
+    ${CMAKE_CURRENT_SOURCE_DIR}/third_party
+    ${CMAKE_CURRENT_SOURCE_DIR}/third_party/json
 )
 
 target_link_libraries(
     ${TESTS_EXE_NAME} PRIVATE
     gmock_main
+    ${CMAKE_DL_LIBS}
 )
 
+add_dependencies (${TESTS_EXE_NAME} ${DYN_LIB_TEST_PLUGIN_NAME} ${DYN_LIB_LEGACY_TEST_PLUGIN_NAME}
+    ${BOARD_CONTROLLER_NAME})
+target_compile_definitions (
+    ${TESTS_EXE_NAME} PRIVATE
+    DYN_LIB_TEST_PLUGIN="$<TARGET_FILE:${DYN_LIB_TEST_PLUGIN_NAME}>"
+    DYN_LIB_LEGACY_TEST_PLUGIN="$<TARGET_FILE:${DYN_LIB_LEGACY_TEST_PLUGIN_NAME}>"
+    BOARD_CONTROLLER_LIB="$<TARGET_FILE:${BOARD_CONTROLLER_NAME}>"
+    MINDFULNESS_ONNX_MODEL="${CMAKE_CURRENT_SOURCE_DIR}/src/ml/train/logreg_mindfulness.onnx"
+)
+
+# OnnxClassifier loads onnxruntime from the folder of the module, tests using it are skipped
+# without BUILD_ONNX
+if (BUILD_ONNX)
+    file (COPY ${ONNXRUNTIME_PATH} DESTINATION ${CMAKE_CURRENT_SOURCE_DIR}/build/tests/)
+    target_compile_definitions (${TESTS_EXE_NAME} PRIVATE BRAINFLOW_TEST_ONNXRUNTIME)
+endif (BUILD_ONNX)
+
 set_target_properties (${TESTS_EXE_NAME}
     PROPERTIES
     ARCHIVE_OUTPUT_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/build/tests
@@ -0,0 +1,565 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "band_power_pipeline.h"
+#include "synthetic_board.h"
+
+using namespace testing;
+
+
+// pipeline reads data of a real synthetic board session, board controller and data handler
+// methods are replaced by stubs which call board directly
+class PipelineBoard : public SyntheticBoard
+{
+public:
+    PipelineBoard () : SyntheticBoard ((int)BoardIds::SYNTHETIC_BOARD, BrainFlowInputParams ())
+    {
+    }
+
+    int get_int (const char *field)
+    {
+        return board_descr["default"][field];
+    }
+
+    std::vector<int> get_eeg_channels ()
+    {
+        return board_descr["default"]["eeg_channels"];
+    }
+
+    // creates ringbuffer without streaming thread, packages are pushed by tests
+    int start_manual (int buffer_size)
+    {
+        return prepare_for_acquisition (buffer_size, "");
+    }
+
+    // packages with timestamp set to index and sine wave in eeg channels
+    void push_eeg (int first_index, int num_packages)
+    {
+        int num_rows = get_int ("num_rows");
+        std::vector<double> packages ((size_t)num_rows * num_packages, 0.0);
+        for (int i = 0; i < num_packages; i++)
+        {
+            double *package = packages.data () + (size_t)i * num_rows;
+            for (int channel : get_eeg_channels ())
+            {
+                package[channel] = sin ((first_index + i) * 0.3) + 2.0;
+            }
+            package[get_int ("timestamp_channel")] = (double)(first_index + i);
+        }
+        push_packages (packages.data (), num_packages);
+    }
+};
+
+static PipelineBoard *test_board = NULL;
+
+static int stub_get_sampling_rate (int board_id, int preset, int *sampling_rate)
+{
+    *sampling_rate = test_board->get_int ("sampling_rate");
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+static int stub_get_timestamp_channel (int board_id, int preset, int *timestamp_channel)
+{
+    *timestamp_channel = test_board->get_int ("timestamp_channel");
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+static int stub_get_num_rows (int board_id, int preset, int *num_rows)
+{
+    *num_rows = test_board->get_int ("num_rows");
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+static int stub_get_eeg_channels (int board_id, int preset, int *eeg_channels, int *len)
+{
+    std::vector<int> channels = test_board->get_eeg_channels ();
+    std::copy (channels.begin (), channels.end (), eeg_channels);
+    *len = (int)channels.size ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// reports more channels than rows of the board, pipeline should not trust it
+static int stub_get_too_many_eeg_channels (int board_id, int preset, int *eeg_channels, int *len)
+{
+    eeg_channels[0] = 1;
+    *len = test_board->get_int ("num_rows") + 1;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+static int stub_get_session_num_rows (
+    int preset, int *num_rows, int board_id, const char *json_brainflow_input_params)
+{
+    *num_rows = test_board->get_int ("num_rows");
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+static int stub_get_current_board_data (int num_samples, int preset, double *data_buf,
+    int *returned_samples, int board_id, const char *json_brainflow_input_params)
+{
+    return test_board->get_current_board_data (num_samples, preset, data_buf, returned_samples);
+}
+
+static int stub_get_board_data_from_index (int preset, double *next_index, int max_samples,
+    double *data_buf, int *returned_samples, int board_id, const char *json_brainflow_input_params)
+{
+    uint64_t index = (uint64_t)*next_index;
+    int res = test_board->get_board_data_from_index (
+        preset, &index, max_samples, data_buf, returned_samples);
+    *next_index = (double)index;
+    return res;
+}
+
+static int stub_get_nearest_power_of_two (int value, int *output)
+{
+    int next = 1;
+    while (next < value)
+    {
+        next *= 2;
+    }
+    *output = ((next - value) > (value - next / 2)) ? next / 2 : next;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+static std::atomic<int> num_psd_calls (0);
+
+// flat spectrum with mean of squares of the segment in each bin
+static int stub_get_psd (double *data, int data_len, int sampling_rate, int window_function,
+    double *output_ampl, double *output_freq)
+{
+    num_psd_calls++;
+    double sum = 0.0;
+    for (int i = 0; i < data_len; i++)
+    {
+        sum += data[i] * data[i];
+    }
+    for (int i = 0; i < data_len / 2 + 1; i++)
+    {
+        output_ampl[i] = sum / data_len;
+        output_freq[i] = (double)i * sampling_rate / data_len;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// mean of psd multiplied by band width, relative band powers depend only on bands
+static int stub_get_band_power (double *ampl, double *freq, int data_len, double freq_start,
+    double freq_end, double *band_power)
+{
+    double sum = 0.0;
+    for (int i = 0; i < data_len; i++)
+    {
+        sum += ampl[i];
+    }
+    *band_power = sum / data_len * (freq_end - freq_start);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// band power is a mean of squares of all eeg samples, psd is tested in data handler
+static int stub_get_custom_band_powers (double *raw_data, int rows, int cols, double *start_freqs,
+    double *stop_freqs, int num_bands, int sampling_rate, int apply_filters,
+    double *avg_band_powers, double *stddev_band_powers)
+{
+    double sum = 0.0;
+    for (int i = 0; i < rows * cols; i++)
+    {
+        sum += raw_data[i] * raw_data[i];
+    }
+    for (int i = 0; i < num_bands; i++)
+    {
+        avg_band_powers[i] = sum / (rows * cols);
+        stddev_band_powers[i] = 0.0;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+class CountingClassifier : public BaseClassifier
+{
+public:
+    std::atomic<int> num_prepared;
+    std::atomic<int> num_released;
+
+    CountingClassifier ()
+        : BaseClassifier (BrainFlowModelParams ((int)BrainFlowMetrics::USER_DEFINED,
+              (int)BrainFlowClassifiers::DYN_LIB_CLASSIFIER))
+    {
+        num_prepared = 0;
+        num_released = 0;
+    }
+
+    int prepare ()
+    {
+        num_prepared++;
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    int predict (double *data, int data_len, double *output, int *output_len)
+    {
+        output[0] = (data_len == 5) ? data[0] : -1.0;
+        *output_len = 1;
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    int release ()
+    {
+        num_released++;
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+};
+
+// returns all features as prediction
+class FeaturesClassifier : public BaseClassifier
+{
+public:
+    FeaturesClassifier ()
+        : BaseClassifier (BrainFlowModelParams ((int)BrainFlowMetrics::USER_DEFINED,
+              (int)BrainFlowClassifiers::DYN_LIB_CLASSIFIER))
+    {
+    }
+
+    int prepare ()
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    int predict (double *data, int data_len, double *output, int *output_len)
+    {
+        std::copy (data, data + data_len, output);
+        *output_len = data_len;
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    int release ()
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+};
+
+struct CallbackData
+{
+    std::mutex mutex;
+    std::vector<double> timestamps;
+    std::vector<double> values;
+};
+
+static void store_prediction (
+    const double *prediction, int prediction_len, double timestamp, void *user_data)
+{
+    CallbackData *data = (CallbackData *)user_data;
+    std::lock_guard<std::mutex> lock (data->mutex);
+    data->timestamps.push_back (timestamp);
+    data->values.push_back ((prediction_len == 1) ? prediction[0] : -1.0);
+}
+
+// returns number of predictions once it reaches count or deadline passes
+static size_t wait_for_predictions (
+    CallbackData &data, size_t count, std::chrono::steady_clock::time_point deadline)
+{
+    while (std::chrono::steady_clock::now () < deadline)
+    {
+        {
+            std::lock_guard<std::mutex> lock (data.mutex);
+            if (data.timestamps.size () >= count)
+            {
+                return data.timestamps.size ();
+            }
+        }
+        std::this_thread::sleep_for (std::chrono::milliseconds (5));
+    }
+    std::lock_guard<std::mutex> lock (data.mutex);
+    return data.timestamps.size ();
+}
+
+// returns true once prediction for window ending at timestamp is published
+static bool wait_for_timestamp (
+    CallbackData &data, double timestamp, std::chrono::steady_clock::time_point deadline)
+{
+    while (std::chrono::steady_clock::now () < deadline)
+    {
+        {
+            std::lock_guard<std::mutex> lock (data.mutex);
+            if ((!data.timestamps.empty ()) && (data.timestamps.back () >= timestamp))
+            {
+                return true;
+            }
+        }
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+    return false;
+}
+
+struct BlockingCallbackData
+{
+    std::atomic<int> num_calls;
+    std::atomic<bool> entered;
+    std::atomic<bool> unblock;
+    std::atomic<bool> finished;
+};
+
+// the first call blocks until test unblocks it
+static void blocking_callback (
+    const double *prediction, int prediction_len, double timestamp, void *user_data)
+{
+    BlockingCallbackData *data = (BlockingCallbackData *)user_data;
+    data->num_calls++;
+    data->entered = true;
+    while (!data->unblock)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+    data->finished = true;
+}
+
+static BandPowerPipelineApi get_stub_api ()
+{
+    BandPowerPipelineApi api;
+    api.get_sampling_rate = stub_get_sampling_rate;
+    api.get_timestamp_channel = stub_get_timestamp_channel;
+    api.get_num_rows = stub_get_num_rows;
+    api.get_eeg_channels = stub_get_eeg_channels;
+    api.get_session_num_rows = stub_get_session_num_rows;
+    api.get_current_board_data = stub_get_current_board_data;
+    api.get_board_data_from_index = stub_get_board_data_from_index;
+    api.get_custom_band_powers = stub_get_custom_band_powers;
+    api.get_nearest_power_of_two = stub_get_nearest_power_of_two;
+    api.get_psd = stub_get_psd;
+    api.get_band_power = stub_get_band_power;
+    return api;
+}
+
+TEST (BandPowerPipelineTest, SyntheticBoard_PredictionsPublishedAtConfiguredRate)
+{
+    PipelineBoard board;
+    test_board = &board;
+    ASSERT_EQ (board.prepare_session (), (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (board.start_stream (45000, ""), (int)BrainFlowExitCodes::STATUS_OK);
+
+    std::shared_ptr<CountingClassifier> model (new CountingClassifier ());
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+    BandPowerPipeline pipeline (get_stub_api (), model, board_id, board_id, "{}",
+        (int)BrainFlowPresets::DEFAULT_PRESET, 0.2, 50, false);
+    CallbackData data;
+    pipeline.set_callback (store_prediction, &data);
+    ASSERT_EQ (pipeline.init (), (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (pipeline.start (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (pipeline.start (), (int)BrainFlowExitCodes::STREAM_ALREADY_RUN_ERROR);
+    EXPECT_EQ (model->num_prepared, 1);
+
+    // wait for the first full window and for a few more predictions, without fixed sleeps
+    auto deadline = std::chrono::steady_clock::now () + std::chrono::seconds (10);
+    size_t first_count = wait_for_predictions (data, 1, deadline);
+    ASSERT_GT (first_count, (size_t)0);
+    auto first_time = std::chrono::steady_clock::now ();
+    size_t last_count = wait_for_predictions (data, first_count + 5, deadline);
+    auto last_time = std::chrono::steady_clock::now ();
+    ASSERT_GE (last_count, first_count + 5);
+    double latest[4] = {0.0};
+    int latest_len = 0;
+    double latest_timestamp = 0.0;
+    EXPECT_EQ (pipeline.get_latest_prediction (latest, &latest_len, &latest_timestamp),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (pipeline.stop (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (pipeline.stop (), (int)BrainFlowExitCodes::STREAM_THREAD_IS_NOT_RUNNING);
+    EXPECT_EQ (model->num_released, 1);
+    board.stop_stream ();
+    board.release_session ();
+
+    // slow runners may skip updates but pipeline never publishes more often than every 50 ms
+    int published = (int)(last_count - first_count);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds> (last_time - first_time);
+    EXPECT_LE (published, (int)elapsed.count () / 50 + 2);
+    EXPECT_EQ (pipeline.get_num_errors (), 0);
+    EXPECT_EQ (latest_len, 1);
+    EXPECT_GT (latest[0], 0.0);
+    for (size_t i = 1; i < data.timestamps.size (); i++)
+    {
+        EXPECT_GE (data.timestamps[i], data.timestamps[i - 1]);
+        EXPECT_GT (data.values[i], 0.0);
+    }
+    test_board = NULL;
+}
+
+TEST (BandPowerPipelineTest, NoPrediction_ReturnsNotPrepared)
+{
+    PipelineBoard board;
+    test_board = &board;
+    std::shared_ptr<CountingClassifier> model (new CountingClassifier ());
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+    BandPowerPipeline pipeline (get_stub_api (), model, board_id, board_id, "{}",
+        (int)BrainFlowPresets::DEFAULT_PRESET, 0.0, 50, false);
+    EXPECT_EQ (pipeline.init (), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    double output[1] = {0.0};
+    int output_len = 0;
+    double timestamp = 0.0;
+    EXPECT_EQ (pipeline.get_latest_prediction (output, &output_len, &timestamp),
+        (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR);
+    test_board = NULL;
+}
+
+TEST (BandPowerPipelineTest, RemoveCallback_WaitsForRunningCallback)
+{
+    PipelineBoard board;
+    test_board = &board;
+    ASSERT_EQ (board.prepare_session (), (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (board.start_stream (45000, ""), (int)BrainFlowExitCodes::STATUS_OK);
+
+    std::shared_ptr<CountingClassifier> model (new CountingClassifier ());
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+    BandPowerPipeline pipeline (get_stub_api (), model, board_id, board_id, "{}",
+        (int)BrainFlowPresets::DEFAULT_PRESET, 0.2, 10, false);
+    BlockingCallbackData data;
+    data.num_calls = 0;
+    data.entered = false;
+    data.unblock = false;
+    data.finished = false;
+    pipeline.set_callback (blocking_callback, &data);
+    ASSERT_EQ (pipeline.init (), (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (pipeline.start (), (int)BrainFlowExitCodes::STATUS_OK);
+
+    auto deadline = std::chrono::steady_clock::now () + std::chrono::seconds (10);
+    while ((!data.entered) && (std::chrono::steady_clock::now () < deadline))
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+    ASSERT_TRUE (data.entered);
+
+    std::atomic<bool> removed (false);
+    std::atomic<bool> finished_before_return (false);
+    std::thread remove_thread ([&] () {
+        pipeline.set_callback (NULL, NULL);
+        finished_before_return = data.finished.load ();
+        removed = true;
+    });
+    // set_callback may not return while callback is running
+    std::this_thread::sleep_for (std::chrono::milliseconds (50));
+    EXPECT_FALSE (removed);
+    data.unblock = true;
+    remove_thread.join ();
+    EXPECT_TRUE (finished_before_return);
+
+    // user data may be freed now, callback is not called anymore
+    int num_calls = data.num_calls;
+    std::this_thread::sleep_for (std::chrono::milliseconds (100));
+    EXPECT_EQ (data.num_calls, num_calls);
+    EXPECT_EQ (pipeline.stop (), (int)BrainFlowExitCodes::STATUS_OK);
+    board.stop_stream ();
+    board.release_session ();
+    test_board = NULL;
+}
+
+TEST (BandPowerPipelineTest, TooManyEegChannels_Rejected)
+{
+    PipelineBoard board;
+    test_board = &board;
+    std::shared_ptr<CountingClassifier> model (new CountingClassifier ());
+    BandPowerPipelineApi api = get_stub_api ();
+    api.get_eeg_channels = stub_get_too_many_eeg_channels;
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+    BandPowerPipeline pipeline (api, model, board_id, board_id, "{}",
+        (int)BrainFlowPresets::DEFAULT_PRESET, 1.0, 50, false);
+    EXPECT_EQ (pipeline.init (), (int)BrainFlowExitCodes::GENERAL_ERROR);
+    test_board = NULL;
+}
+
+TEST (BandPowerPipelineTest, NoFilters_PsdCalculatedOnlyForNewSegments)
+{
+    PipelineBoard board;
+    test_board = &board;
+    ASSERT_EQ (board.start_manual (1000), (int)BrainFlowExitCodes::STATUS_OK);
+    int num_channels = (int)board.get_eeg_channels ().size ();
+
+    // 2 seconds at 250 Hz, nfft is 256 and segments start every 52 samples
+    std::shared_ptr<CountingClassifier> model (new CountingClassifier ());
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+    BandPowerPipeline pipeline (get_stub_api (), model, board_id, board_id, "{}",
+        (int)BrainFlowPresets::DEFAULT_PRESET, 2.0, 5, false);
+    CallbackData data;
+    pipeline.set_callback (store_prediction, &data);
+    ASSERT_EQ (pipeline.init (), (int)BrainFlowExitCodes::STATUS_OK);
+    num_psd_calls = 0;
+    ASSERT_EQ (pipeline.start (), (int)BrainFlowExitCodes::STATUS_OK);
+
+    // segments 0, 52, ..., 208 fit into the first window
+    auto deadline = std::chrono::steady_clock::now () + std::chrono::seconds (10);
+    board.push_eeg (0, 500);
+    ASSERT_TRUE (wait_for_timestamp (data, 499.0, deadline));
+    EXPECT_EQ (num_psd_calls, 5 * num_channels);
+
+    // only segment 260 is completed by new samples
+    board.push_eeg (500, 52);
+    ASSERT_TRUE (wait_for_timestamp (data, 551.0, deadline));
+    EXPECT_EQ (num_psd_calls, 6 * num_channels);
+    std::this_thread::sleep_for (std::chrono::milliseconds (50));
+    EXPECT_EQ (num_psd_calls, 6 * num_channels);
+
+    // overwritten samples restart segments from the oldest sample, only the latest window is used
+    board.push_eeg (552, 2000);
+    ASSERT_TRUE (wait_for_timestamp (data, 2551.0, deadline));
+    EXPECT_EQ (num_psd_calls, 11 * num_channels);
+
+    EXPECT_EQ (pipeline.stop (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (pipeline.get_num_errors (), 0);
+    std::lock_guard<std::mutex> lock (data.mutex);
+    for (double value : data.values)
+    {
+        EXPECT_NEAR (value, 2.0 / 43.0, 1e-9);
+    }
+    test_board = NULL;
+}
+
+TEST (BandPowerPipelineTest, CustomBands_UsedAsFeatures)
+{
+    PipelineBoard board;
+    test_board = &board;
+    ASSERT_EQ (board.start_manual (1000), (int)BrainFlowExitCodes::STATUS_OK);
+
+    std::shared_ptr<FeaturesClassifier> model (new FeaturesClassifier ());
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+    std::vector<std::pair<double, double>> bands = {{1.0, 3.0}, {3.0, 9.0}};
+    BandPowerPipeline pipeline (get_stub_api (), model, board_id, board_id, "{}",
+        (int)BrainFlowPresets::DEFAULT_PRESET, 1.0, 5, false, bands);
+    ASSERT_EQ (pipeline.init (), (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (pipeline.start (), (int)BrainFlowExitCodes::STATUS_OK);
+    board.push_eeg (0, 250);
+
+    double output[2] = {0.0};
+    int output_len = 0;
+    double timestamp = 0.0;
+    int res = (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    auto deadline = std::chrono::steady_clock::now () + std::chrono::seconds (10);
+    while ((res != (int)BrainFlowExitCodes::STATUS_OK) &&
+        (std::chrono::steady_clock::now () < deadline))
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+        res = pipeline.get_latest_prediction (output, &output_len, &timestamp);
+    }
+    EXPECT_EQ (pipeline.stop (), (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (res, (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (output_len, 2);
+    EXPECT_NEAR (output[0], 0.25, 1e-9);
+    EXPECT_NEAR (output[1], 0.75, 1e-9);
+    EXPECT_EQ (timestamp, 249.0);
+    test_board = NULL;
+}
+
+TEST (BandPowerPipelineTest, InvalidBands_Rejected)
+{
+    PipelineBoard board;
+    test_board = &board;
+    std::shared_ptr<FeaturesClassifier> model (new FeaturesClassifier ());
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+    std::vector<std::vector<std::pair<double, double>>> invalid_bands = {
+        {{1.0, 3.0}, {130.0, 140.0}}, {{5.0, 5.0}}, {{-1.0, 4.0}}};
+    for (const std::vector<std::pair<double, double>> &bands : invalid_bands)
+    {
+        BandPowerPipeline pipeline (get_stub_api (), model, board_id, board_id, "{}",
+            (int)BrainFlowPresets::DEFAULT_PRESET, 1.0, 5, false, bands);
+        EXPECT_EQ (pipeline.init (), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    test_board = NULL;
+}
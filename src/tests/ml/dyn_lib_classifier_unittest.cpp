@@ -0,0 +1,140 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+#include "dyn_lib_classifier.h"
+#include "runtime_dll_loader.h"
+
+using namespace testing;
+
+
+// plugin paths are passed from build.cmake, plugin is built from dyn_lib_test_plugin.cpp
+class DynLibClassifierTest : public Test
+{
+protected:
+    DLLLoader *plugin;
+    int (*get_counters) (int *);
+
+    void SetUp ()
+    {
+        plugin = NULL;
+        get_counters = NULL;
+    }
+
+    void TearDown ()
+    {
+        if (plugin != NULL)
+        {
+            delete plugin;
+        }
+    }
+
+    // test keeps its own reference to plugin, so counters survive unloading by classifier
+    void load_plugin (const char *path)
+    {
+        plugin = new DLLLoader (path);
+        ASSERT_TRUE (plugin->load_library ());
+        get_counters = (int (*) (int *))plugin->get_address ("get_test_plugin_counters");
+        void (*reset_counters) () =
+            (void (*) ())plugin->get_address ("reset_test_plugin_counters");
+        ASSERT_TRUE (get_counters != NULL);
+        ASSERT_TRUE (reset_counters != NULL);
+        reset_counters ();
+    }
+
+    // live contexts, predict calls, batch calls, max concurrent predict calls
+    int get_counter (int index)
+    {
+        int counters[4] = {0};
+        get_counters (counters);
+        return counters[index];
+    }
+};
+
+static struct BrainFlowModelParams get_params (const char *path, const char *scale)
+{
+    struct BrainFlowModelParams params (
+        (int)BrainFlowMetrics::USER_DEFINED, (int)BrainFlowClassifiers::DYN_LIB_CLASSIFIER);
+    params.file = path;
+    params.other_info = scale;
+    params.max_array_size = 8;
+    return params;
+}
+
+TEST_F (DynLibClassifierTest, ContextPlugin_TwoModelsHaveOwnContexts)
+{
+    load_plugin (DYN_LIB_TEST_PLUGIN);
+    DynLibClassifier first (get_params (DYN_LIB_TEST_PLUGIN, "2"));
+    DynLibClassifier second (get_params (DYN_LIB_TEST_PLUGIN, "3"));
+    ASSERT_EQ (first.prepare (), (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (second.prepare (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (get_counter (0), 2);
+    EXPECT_EQ (first.prepare (), (int)BrainFlowExitCodes::ANOTHER_CLASSIFIER_IS_PREPARED_ERROR);
+
+    double data[3] = {1.0, 2.0, 3.0};
+    double output[8] = {0.0};
+    int output_len = 0;
+    ASSERT_EQ (first.predict (data, 3, output, &output_len), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (output_len, 1);
+    EXPECT_EQ (output[0], 12.0);
+    ASSERT_EQ (second.predict (data, 3, output, &output_len), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (output[0], 18.0);
+
+    EXPECT_EQ (first.release (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (get_counter (0), 1);
+    EXPECT_EQ (first.predict (data, 3, output, &output_len),
+        (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR);
+    EXPECT_EQ (first.release (), (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR);
+    EXPECT_EQ (second.release (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (get_counter (0), 0);
+}
+
+TEST_F (DynLibClassifierTest, ContextPlugin_PredictBatchUsesBatchEntryPoint)
+{
+    load_plugin (DYN_LIB_TEST_PLUGIN);
+    DynLibClassifier classifier (get_params (DYN_LIB_TEST_PLUGIN, "0.5"));
+    ASSERT_EQ (classifier.prepare (), (int)BrainFlowExitCodes::STATUS_OK);
+
+    double data[8] = {1, 1, 2, 2, 3, 3, 4, 4};
+    double output[8] = {0.0};
+    int output_len = 0;
+    ASSERT_EQ (classifier.predict_batch (data, 4, 2, output, &output_len),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (output_len, 4);
+    EXPECT_THAT (std::vector<double> (output, output + 4), ElementsAre (1.0, 2.0, 3.0, 4.0));
+    EXPECT_EQ (get_counter (2), 1);
+    EXPECT_EQ (get_counter (1), 4);
+}
+
+TEST_F (DynLibClassifierTest, LegacyPlugin_PredictBatchFallsBackToPredict)
+{
+    load_plugin (DYN_LIB_LEGACY_TEST_PLUGIN);
+    DynLibClassifier classifier (get_params (DYN_LIB_LEGACY_TEST_PLUGIN, "2"));
+    ASSERT_EQ (classifier.prepare (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (get_counter (0), 1);
+
+    double data[6] = {1, 2, 3, 4, 5, 6};
+    double output[8] = {0.0};
+    int output_len = 0;
+    ASSERT_EQ (classifier.predict_batch (data, 3, 2, output, &output_len),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (output_len, 3);
+    EXPECT_THAT (std::vector<double> (output, output + 3), ElementsAre (6.0, 14.0, 22.0));
+    EXPECT_EQ (get_counter (2), 0);
+    EXPECT_EQ (get_counter (1), 3);
+
+    EXPECT_EQ (classifier.release (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (get_counter (0), 0);
+}
+
+TEST_F (DynLibClassifierTest, MissingLibrary_PrepareFails)
+{
+    DynLibClassifier classifier (get_params ("missing_dyn_lib_test_plugin", ""));
+    EXPECT_EQ (classifier.prepare (), (int)BrainFlowExitCodes::GENERAL_ERROR);
+    double data[1] = {1.0};
+    double output[8] = {0.0};
+    int output_len = 0;
+    EXPECT_EQ (classifier.predict_batch (data, 1, 1, output, &output_len),
+        (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR);
+}
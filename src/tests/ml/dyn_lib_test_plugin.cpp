@@ -0,0 +1,149 @@
+#include <atomic>
+#include <chrono>
+#include <stdlib.h>
+#include <thread>
+
+#include "brainflow_constants.h"
+#include "brainflow_model_params.h"
+#include "dyn_lib_classifier_api.h"
+#include "shared_export.h"
+
+// plugin for DynLibClassifier tests, prediction is a sum of features multiplied by a scale from
+// other_info, built with context interface by default and with legacy one if
+// DYN_LIB_TEST_PLUGIN_LEGACY is defined, legacy version has no predict_batch
+
+
+struct PluginContext
+{
+    double scale;
+};
+
+static std::atomic<int> num_contexts (0);
+static std::atomic<int> num_predict_calls (0);
+static std::atomic<int> num_batch_calls (0);
+static std::atomic<int> active_calls (0);
+static std::atomic<int> max_active_calls (0);
+#ifdef DYN_LIB_TEST_PLUGIN_LEGACY
+static double legacy_scale = 1.0;
+#endif
+
+
+static double parse_scale (const char *other_info)
+{
+    if ((other_info == NULL) || (other_info[0] == '\0'))
+    {
+        return 1.0;
+    }
+    return atof (other_info);
+}
+
+// sleeps inside predict so overlapping calls are visible in max_active_calls
+static int score (double scale, double *data, int data_len, double *output, int *output_len)
+{
+    if ((data == NULL) || (data_len < 1) || (output == NULL) || (output_len == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int active = ++active_calls;
+    int max_active = max_active_calls.load ();
+    while ((active > max_active) && (!max_active_calls.compare_exchange_weak (max_active, active)))
+    {
+    }
+    num_predict_calls++;
+    std::this_thread::sleep_for (std::chrono::microseconds (200));
+    double sum = 0.0;
+    for (int i = 0; i < data_len; i++)
+    {
+        sum += data[i];
+    }
+    output[0] = sum * scale;
+    *output_len = 1;
+    active_calls--;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+extern "C"
+{
+    // counters: live contexts, predict calls, batch calls, max concurrent predict calls
+    SHARED_EXPORT int CALLING_CONVENTION get_test_plugin_counters (int *counters)
+    {
+        counters[0] = num_contexts.load ();
+        counters[1] = num_predict_calls.load ();
+        counters[2] = num_batch_calls.load ();
+        counters[3] = max_active_calls.load ();
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    SHARED_EXPORT void CALLING_CONVENTION reset_test_plugin_counters ()
+    {
+        num_predict_calls = 0;
+        num_batch_calls = 0;
+        max_active_calls = 0;
+    }
+
+#ifndef DYN_LIB_TEST_PLUGIN_LEGACY
+    SHARED_EXPORT void *CALLING_CONVENTION init_context (const struct BrainFlowModelParamsC *params)
+    {
+        if ((params == NULL) || (params->version < 1) ||
+            (params->struct_size < (int)sizeof (struct BrainFlowModelParamsC)))
+        {
+            return NULL;
+        }
+        PluginContext *context = new PluginContext ();
+        context->scale = parse_scale (params->other_info);
+        num_contexts++;
+        return context;
+    }
+
+    SHARED_EXPORT int CALLING_CONVENTION predict_with_context (
+        void *context, double *data, int data_len, double *output, int *output_len)
+    {
+        return score (((PluginContext *)context)->scale, data, data_len, output, output_len);
+    }
+
+    SHARED_EXPORT int CALLING_CONVENTION predict_batch_with_context (void *context, double *data,
+        int batch_size, int feature_len, double *output, int *output_len)
+    {
+        num_batch_calls++;
+        for (int i = 0; i < batch_size; i++)
+        {
+            int sample_len = 0;
+            int res = score (((PluginContext *)context)->scale, data + (size_t)i * feature_len,
+                feature_len, output + i, &sample_len);
+            if (res != (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                return res;
+            }
+        }
+        *output_len = batch_size;
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    SHARED_EXPORT int CALLING_CONVENTION release_context (void *context)
+    {
+        delete (PluginContext *)context;
+        num_contexts--;
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+#else
+    SHARED_EXPORT int CALLING_CONVENTION prepare (
+        void *classifier, struct BrainFlowModelParams *params)
+    {
+        legacy_scale = parse_scale (params->other_info.c_str ());
+        num_contexts++;
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    SHARED_EXPORT int CALLING_CONVENTION predict (double *data, int data_len, double *output,
+        int *output_len, struct BrainFlowModelParams *params)
+    {
+        return score (legacy_scale, data, data_len, output, output_len);
+    }
+
+    SHARED_EXPORT int CALLING_CONVENTION release (struct BrainFlowModelParams *params)
+    {
+        num_contexts--;
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+#endif
+}
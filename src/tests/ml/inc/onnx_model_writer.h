@@ -0,0 +1,135 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "proto_reader.h"
+
+
+// minimal protobuf writer to build onnx graphs in tests, field numbers are from onnx.proto
+class ProtoWriter
+{
+public:
+    std::string data;
+
+    ProtoWriter &varint (int field, uint64_t value)
+    {
+        write_varint ((uint64_t)field << 3 | ProtoReader::varint);
+        write_varint (value);
+        return *this;
+    }
+
+    ProtoWriter &bytes (int field, const std::string &value)
+    {
+        write_varint ((uint64_t)field << 3 | ProtoReader::length_delimited);
+        write_varint (value.size ());
+        data += value;
+        return *this;
+    }
+
+    ProtoWriter &message (int field, const ProtoWriter &value)
+    {
+        return bytes (field, value.data);
+    }
+
+    ProtoWriter &packed_floats (int field, const std::vector<float> &values)
+    {
+        return bytes (field, std::string ((const char *)values.data (), values.size () * 4));
+    }
+
+    ProtoWriter &packed_ints (int field, const std::vector<uint64_t> &values)
+    {
+        ProtoWriter packed;
+        for (uint64_t value : values)
+        {
+            packed.write_varint (value);
+        }
+        return bytes (field, packed.data);
+    }
+
+private:
+    void write_varint (uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            data += (char)((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        data += (char)value;
+    }
+};
+
+// attribute type is required by onnxruntime: 3 is STRING, 6 is FLOATS, 7 is INTS
+inline ProtoWriter string_attribute (const std::string &name, const std::string &value)
+{
+    return ProtoWriter ().bytes (1, name).bytes (4, value).varint (20, 3);
+}
+
+inline ProtoWriter floats_attribute (const std::string &name, const std::vector<float> &values)
+{
+    return ProtoWriter ().bytes (1, name).packed_floats (7, values).varint (20, 6);
+}
+
+inline ProtoWriter ints_attribute (const std::string &name, const std::vector<uint64_t> &values)
+{
+    return ProtoWriter ().bytes (1, name).packed_ints (8, values).varint (20, 7);
+}
+
+inline ProtoWriter node (const std::string &op, const std::vector<std::string> &inputs,
+    const std::vector<std::string> &outputs = std::vector<std::string> (),
+    const std::string &domain = "")
+{
+    ProtoWriter res;
+    for (const std::string &input : inputs)
+    {
+        res.bytes (1, input);
+    }
+    for (const std::string &output : outputs)
+    {
+        res.bytes (2, output);
+    }
+    res.bytes (4, op);
+    if (!domain.empty ())
+    {
+        res.bytes (7, domain);
+    }
+    return res;
+}
+
+inline ProtoWriter float_tensor (
+    const std::string &name, const std::vector<uint64_t> &dims, const std::vector<float> &values)
+{
+    return ProtoWriter ().packed_ints (1, dims).varint (2, 1).packed_floats (4, values).bytes (
+        8, name);
+}
+
+// graph input or output, negative dims are dynamic, elem_type 1 is float and 11 is double
+inline ProtoWriter value_info (
+    const std::string &name, int elem_type, const std::vector<int64_t> &dims)
+{
+    ProtoWriter shape;
+    for (int64_t dim : dims)
+    {
+        if (dim < 0)
+        {
+            shape.message (1, ProtoWriter ().bytes (2, "N"));
+        }
+        else
+        {
+            shape.message (1, ProtoWriter ().varint (1, (uint64_t)dim));
+        }
+    }
+    ProtoWriter tensor_type = ProtoWriter ().varint (1, (uint64_t)elem_type).message (2, shape);
+    return ProtoWriter ().bytes (1, name).message (2, ProtoWriter ().message (1, tensor_type));
+}
+
+inline ProtoWriter model (const ProtoWriter &graph)
+{
+    // ir_version before graph like in exported models, opsets are needed only by onnxruntime
+    return ProtoWriter ()
+        .varint (1, 8)
+        .message (8, ProtoWriter ().bytes (1, "").varint (2, 13))
+        .message (8, ProtoWriter ().bytes (1, "ai.onnx.ml").varint (2, 1))
+        .message (7, graph);
+}
@@ -0,0 +1,488 @@
+#include <cmath>
+#include <fstream>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "linear_classifier.h"
+#include "onnx_classifier.h"
+#include "onnx_model_writer.h"
+#include "proto_reader.h"
+
+using namespace testing;
+
+
+class LinearClassifierTest : public Test
+{
+protected:
+    std::string file_name;
+    std::vector<std::string> written_files;
+
+    void TearDown ()
+    {
+        for (const std::string &name : written_files)
+        {
+            remove (name.c_str ());
+        }
+    }
+
+    void write_file (const std::string &name, const std::string &content)
+    {
+        file_name = name;
+        written_files.push_back (name);
+        std::ofstream file (name, std::ios::binary);
+        file << content;
+    }
+
+    // prepares classifier over file written by write_file
+    int prepare (LinearClassifier &classifier)
+    {
+        classifier.params.file = file_name;
+        return classifier.prepare ();
+    }
+};
+
+static struct BrainFlowModelParams get_params ()
+{
+    struct BrainFlowModelParams params (
+        (int)BrainFlowMetrics::USER_DEFINED, (int)BrainFlowClassifiers::LINEAR_CLASSIFIER);
+    params.max_array_size = 8;
+    return params;
+}
+
+static double sigmoid (double value)
+{
+    return 1.0 / (1.0 + exp (-value));
+}
+
+// sklearn-onnx like LinearClassifier node over input X, classes are 0, 1, ...
+static ProtoWriter linear_classifier_node (int num_classes, const std::string &post_transform,
+    const std::vector<float> &coefficients, const std::vector<float> &intercepts,
+    const std::string &scores)
+{
+    std::vector<uint64_t> labels;
+    for (int i = 0; i < num_classes; i++)
+    {
+        labels.push_back ((uint64_t)i);
+    }
+    return node ("LinearClassifier", {"X"}, {"label", scores}, "ai.onnx.ml")
+        .message (5, floats_attribute ("coefficients", coefficients))
+        .message (5, floats_attribute ("intercepts", intercepts))
+        .message (5, ints_attribute ("classlabels_ints", labels))
+        .message (5, string_attribute ("post_transform", post_transform));
+}
+
+static ProtoWriter linear_classifier_graph (int num_features, int num_classes,
+    const std::string &post_transform, const std::vector<float> &coefficients,
+    const std::vector<float> &intercepts, const std::string &scores)
+{
+    int num_scores = (num_classes == 2) ? 2 : num_classes;
+    return ProtoWriter ()
+        .message (1,
+            linear_classifier_node (num_classes, post_transform, coefficients, intercepts, scores))
+        .message (11, value_info ("X", 1, {-1, num_features}))
+        .message (12, value_info ("label", 7, {-1}))
+        .message (12, value_info (scores, 1, {-1, num_scores}));
+}
+
+TEST (ProtoReaderTest, NestedMessage_Parsed)
+{
+    ProtoWriter inner = ProtoWriter ().varint (1, 300).bytes (2, "abc");
+    ProtoWriter outer = ProtoWriter ().message (3, inner).varint (4, 1);
+    ProtoReader reader ((const unsigned char *)outer.data.data (), outer.data.size ());
+    int field = 0;
+    int wire_type = 0;
+    ASSERT_TRUE (reader.next_field (&field, &wire_type));
+    EXPECT_EQ (field, 3);
+    EXPECT_EQ (wire_type, (int)ProtoReader::length_delimited);
+    const unsigned char *nested = NULL;
+    size_t nested_size = 0;
+    ASSERT_TRUE (reader.read_bytes (&nested, &nested_size));
+
+    ProtoReader nested_reader (nested, nested_size);
+    uint64_t value = 0;
+    std::string text;
+    ASSERT_TRUE (nested_reader.next_field (&field, &wire_type));
+    ASSERT_TRUE (nested_reader.read_varint (&value));
+    EXPECT_EQ (value, (uint64_t)300);
+    ASSERT_TRUE (nested_reader.next_field (&field, &wire_type));
+    ASSERT_TRUE (nested_reader.read_string (&text));
+    EXPECT_EQ (text, "abc");
+    EXPECT_FALSE (nested_reader.next_field (&field, &wire_type));
+    EXPECT_FALSE (nested_reader.is_failed ());
+
+    ASSERT_TRUE (reader.next_field (&field, &wire_type));
+    EXPECT_EQ (field, 4);
+    EXPECT_TRUE (reader.skip (wire_type));
+    EXPECT_TRUE (reader.at_end ());
+    EXPECT_FALSE (reader.is_failed ());
+}
+
+TEST (ProtoReaderTest, TruncatedInput_Failed)
+{
+    ProtoWriter writer = ProtoWriter ().bytes (1, "abcdef");
+    // length says 6 bytes but only 3 are left
+    ProtoReader reader ((const unsigned char *)writer.data.data (), writer.data.size () - 3);
+    int field = 0;
+    int wire_type = 0;
+    std::string text;
+    ASSERT_TRUE (reader.next_field (&field, &wire_type));
+    EXPECT_FALSE (reader.read_string (&text));
+    EXPECT_TRUE (reader.is_failed ());
+    EXPECT_FALSE (reader.next_field (&field, &wire_type));
+
+    // varint without last byte
+    const unsigned char varint[] = {0x08, 0xAC};
+    ProtoReader varint_reader (varint, sizeof (varint));
+    uint64_t value = 0;
+    ASSERT_TRUE (varint_reader.next_field (&field, &wire_type));
+    EXPECT_FALSE (varint_reader.read_varint (&value));
+    EXPECT_TRUE (varint_reader.is_failed ());
+
+    // wire types 3 and 4 are deprecated groups
+    ProtoReader group_reader (varint, sizeof (varint));
+    EXPECT_FALSE (group_reader.skip (3));
+    EXPECT_TRUE (group_reader.is_failed ());
+}
+
+TEST_F (LinearClassifierTest, OnnxLinearClassifier_BinaryOutputsTwoScores)
+{
+    ProtoWriter graph =
+        linear_classifier_graph (2, 2, "LOGISTIC", {1.0f, -2.0f}, {0.5f}, "probabilities");
+    write_file ("linear_classifier_binary.onnx", model (graph).data);
+    LinearClassifier classifier (get_params ());
+    ASSERT_EQ (prepare (classifier), (int)BrainFlowExitCodes::STATUS_OK);
+
+    double data[2] = {3.0, 1.0};
+    double output[8] = {0.0};
+    int output_len = 0;
+    ASSERT_EQ (classifier.predict (data, 2, output, &output_len),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (output_len, 2);
+    // the same as onnxruntime, single score is not transformed and first class gets 1 - score
+    EXPECT_NEAR (output[0], -0.5, 1e-6);
+    EXPECT_NEAR (output[1], 1.5, 1e-6);
+    EXPECT_EQ (classifier.predict (data, 3, output, &output_len),
+        (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+}
+
+TEST_F (LinearClassifierTest, OnnxGemmSigmoid_KnownOutputs)
+{
+    // weights are features x scores because transB is 0
+    ProtoWriter graph = ProtoWriter ()
+                            .message (1, node ("Gemm", {"X", "W", "B"}, {"Y"}))
+                            .message (1, node ("Sigmoid", {"Y"}, {"probabilities"}))
+                            .message (5, float_tensor ("W", {3, 2}, {1, 0, 0, 1, 1, -1}))
+                            .message (5, float_tensor ("B", {2}, {0.0f, 1.0f}))
+                            .message (11, value_info ("X", 1, {-1, 3}))
+                            .message (12, value_info ("probabilities", 1, {-1, 2}));
+    write_file ("linear_classifier_gemm.onnx", model (graph).data);
+    LinearClassifier classifier (get_params ());
+    ASSERT_EQ (prepare (classifier), (int)BrainFlowExitCodes::STATUS_OK);
+
+    double data[3] = {0.5, -1.0, 2.0};
+    double output[8] = {0.0};
+    int output_len = 0;
+    ASSERT_EQ (classifier.predict (data, 3, output, &output_len),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (output_len, 2);
+    EXPECT_NEAR (output[0], sigmoid (0.5 + 2.0), 1e-9);
+    EXPECT_NEAR (output[1], sigmoid (-1.0 - 2.0 + 1.0), 1e-9);
+}
+
+TEST_F (LinearClassifierTest, OnnxSklearnTail_NormalizerCastAndZipMapAccepted)
+{
+    // sklearn-onnx exports one vs rest logistic regression as LinearClassifier and Normalizer, label
+    // is cast and probabilities are wrapped by ZipMap
+    ProtoWriter graph =
+        ProtoWriter ()
+            .message (1,
+                linear_classifier_node (2, "LOGISTIC", {1, 0, 0, 1}, {0, 0}, "probability_tensor"))
+            .message (1,
+                node ("Normalizer", {"probability_tensor"}, {"probabilities"}, "ai.onnx.ml")
+                    .message (5, string_attribute ("norm", "L1")))
+            .message (1, node ("Cast", {"label"}, {"output_label"}))
+            .message (1,
+                node ("ZipMap", {"probabilities"}, {"output_probability"}, "ai.onnx.ml")
+                    .message (5, ints_attribute ("classlabels_int64s", {0, 1})))
+            .message (11, value_info ("X", 1, {-1, 2}))
+            .message (12, value_info ("output_label", 7, {-1}))
+            .message (12, value_info ("output_probability", 1, {-1, 2}));
+    write_file ("linear_classifier_sklearn.onnx", model (graph).data);
+    LinearClassifier classifier (get_params ());
+    ASSERT_EQ (prepare (classifier), (int)BrainFlowExitCodes::STATUS_OK);
+
+    double data[2] = {1.0, 2.0};
+    double output[8] = {0.0};
+    int output_len = 0;
+    ASSERT_EQ (classifier.predict (data, 2, output, &output_len),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (output_len, 2);
+    double sum = sigmoid (1.0) + sigmoid (2.0);
+    EXPECT_NEAR (output[0], sigmoid (1.0) / sum, 1e-6);
+    EXPECT_NEAR (output[1], sigmoid (2.0) / sum, 1e-6);
+
+    // label is not computed
+    classifier.release ();
+    classifier.params.output_name = "output_label";
+    EXPECT_EQ (classifier.prepare (), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+}
+
+TEST_F (LinearClassifierTest, OnnxUnsupportedOperator_Rejected)
+{
+    ProtoWriter graph = ProtoWriter ()
+                            .message (1, node ("Gemm", {"X", "W"}, {"Y"}))
+                            .message (1, node ("Relu", {"Y"}, {"Z"}))
+                            .message (5, float_tensor ("W", {2, 1}, {1, 1}))
+                            .message (11, value_info ("X", 1, {-1, 2}))
+                            .message (12, value_info ("Z", 1, {-1, 1}));
+    write_file ("linear_classifier_relu.onnx", model (graph).data);
+    LinearClassifier classifier (get_params ());
+    EXPECT_EQ (prepare (classifier), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    double data[2] = {1.0, 1.0};
+    double output[8] = {0.0};
+    int output_len = 0;
+    EXPECT_EQ (classifier.predict (data, 2, output, &output_len),
+        (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR);
+}
+
+TEST_F (LinearClassifierTest, OnnxGraphNotChain_Rejected)
+{
+    ProtoWriter weights = ProtoWriter ().message (5, float_tensor ("W", {2, 2}, {1, 0, 0, 1}));
+    ProtoWriter io = ProtoWriter ()
+                         .message (11, value_info ("X", 1, {-1, 2}))
+                         .message (12, value_info ("P", 1, {-1, 2}));
+    LinearClassifier classifier (get_params ());
+
+    // Softmax reads Gemm output instead of Sigmoid output
+    ProtoWriter branch = ProtoWriter ()
+                             .message (1, node ("Gemm", {"X", "W"}, {"Y"}))
+                             .message (1, node ("Sigmoid", {"Y"}, {"S"}))
+                             .message (1, node ("Softmax", {"Y"}, {"P"}));
+    branch.data += weights.data + io.data;
+    write_file ("linear_classifier_branch.onnx", model (branch).data);
+    EXPECT_EQ (prepare (classifier), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+
+    // bias is a graph input, not a constant
+    ProtoWriter input_bias = ProtoWriter ()
+                                 .message (1, node ("Gemm", {"X", "W", "C"}, {"P"}))
+                                 .message (11, value_info ("C", 1, {2}));
+    input_bias.data += weights.data + io.data;
+    write_file ("linear_classifier_input_bias.onnx", model (input_bias).data);
+    EXPECT_EQ (prepare (classifier), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+
+    // bias is computed by another node
+    ProtoWriter node_bias = ProtoWriter ()
+                                .message (1, node ("Identity", {"X"}, {"C"}))
+                                .message (1, node ("Gemm", {"X", "W", "C"}, {"P"}));
+    node_bias.data += weights.data + io.data;
+    write_file ("linear_classifier_node_bias.onnx", model (node_bias).data);
+    EXPECT_EQ (prepare (classifier), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+
+    // Add uses model input instead of constant
+    ProtoWriter input_add = ProtoWriter ()
+                                .message (1, node ("Gemm", {"X", "W"}, {"Y"}))
+                                .message (1, node ("Add", {"Y", "X"}, {"P"}));
+    input_add.data += weights.data + io.data;
+    write_file ("linear_classifier_input_add.onnx", model (input_add).data);
+    EXPECT_EQ (prepare (classifier), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+
+    // graph output is not the last node
+    ProtoWriter early_output = ProtoWriter ()
+                                   .message (1, node ("Gemm", {"X", "W"}, {"P"}))
+                                   .message (1, node ("Sigmoid", {"P"}, {"S"}));
+    early_output.data += weights.data + io.data;
+    write_file ("linear_classifier_early_output.onnx", model (early_output).data);
+    EXPECT_EQ (prepare (classifier), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+
+    // the same chain with constant bias on any side of Add is accepted
+    ProtoWriter valid = ProtoWriter ()
+                            .message (1, node ("MatMul", {"X", "W"}, {"Y"}))
+                            .message (1, node ("Add", {"B", "Y"}, {"P"}))
+                            .message (5, float_tensor ("B", {2}, {1, 2}));
+    valid.data += weights.data + io.data;
+    write_file ("linear_classifier_valid.onnx", model (valid).data);
+    EXPECT_EQ (prepare (classifier), (int)BrainFlowExitCodes::STATUS_OK);
+}
+
+TEST_F (LinearClassifierTest, OnnxTruncatedFile_Rejected)
+{
+    ProtoWriter graph = ProtoWriter ()
+                            .message (1, node ("Gemm", {"X", "W"}, {"Y"}))
+                            .message (5, float_tensor ("W", {2, 1}, {1, 1}))
+                            .message (11, value_info ("X", 1, {-1, 2}))
+                            .message (12, value_info ("Y", 1, {-1, 1}));
+    std::string content = model (graph).data;
+    write_file ("linear_classifier_truncated.onnx", content.substr (0, content.size () - 5));
+    LinearClassifier classifier (get_params ());
+    EXPECT_EQ (prepare (classifier), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+
+    write_file ("linear_classifier_truncated.onnx", "not a protobuf");
+    EXPECT_EQ (prepare (classifier), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+}
+
+TEST_F (LinearClassifierTest, JsonCoefficients_BatchMatchesSinglePredict)
+{
+    write_file ("linear_classifier_coefficients.json",
+        "{\"coefficients\": [[1.0, 2.0, 3.0], [-1.0, 0.5, 0.0], [0.0, 0.0, 1.0]], "
+        "\"intercepts\": [0.1, 0.2, 0.3], \"post_transform\": \"softmax\"}");
+    LinearClassifier classifier (get_params ());
+    ASSERT_EQ (prepare (classifier), (int)BrainFlowExitCodes::STATUS_OK);
+
+    double batch[12] = {1, 2, 3, -1, 0, 1, 0.5, 0.5, 0.5, 10, -10, 0};
+    double batch_output[32] = {0.0};
+    int batch_len = 0;
+    ASSERT_EQ (classifier.predict_batch (batch, 4, 3, batch_output, &batch_len),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (batch_len, 12);
+    for (int i = 0; i < 4; i++)
+    {
+        double output[8] = {0.0};
+        int output_len = 0;
+        ASSERT_EQ (classifier.predict (batch + i * 3, 3, output, &output_len),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        ASSERT_EQ (output_len, 3);
+        double sum = 0.0;
+        for (int j = 0; j < 3; j++)
+        {
+            EXPECT_DOUBLE_EQ (output[j], batch_output[i * 3 + j]);
+            sum += output[j];
+        }
+        EXPECT_NEAR (sum, 1.0, 1e-9);
+    }
+    // scores of the first sample are 14.1, 0.2 and 3.3
+    double max_score = exp (14.1 - 14.1) + exp (0.2 - 14.1) + exp (3.3 - 14.1);
+    EXPECT_NEAR (batch_output[0], 1.0 / max_score, 1e-9);
+}
+
+TEST_F (LinearClassifierTest, JsonBinaryLogistic_OutputsTwoProbabilities)
+{
+    write_file ("linear_classifier_binary.json",
+        "{\"coefficients\": [2.0, -1.0], \"intercepts\": [0.5], \"post_transform\": \"logistic\"}");
+    LinearClassifier classifier (get_params ());
+    ASSERT_EQ (prepare (classifier), (int)BrainFlowExitCodes::STATUS_OK);
+    float data[2] = {1.0f, 1.0f};
+    double output[8] = {0.0};
+    int output_len = 0;
+    ASSERT_EQ (classifier.predict_float (data, 2, output, &output_len),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (output_len, 2);
+    EXPECT_NEAR (output[1], sigmoid (1.5), 1e-9);
+    EXPECT_NEAR (output[0] + output[1], 1.0, 1e-12);
+}
+
+TEST_F (LinearClassifierTest, JsonMalformed_Rejected)
+{
+    LinearClassifier classifier (get_params ());
+    write_file ("linear_classifier_malformed.json", "{\"coefficients\": [1.0, ");
+    EXPECT_EQ (prepare (classifier), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    write_file ("linear_classifier_malformed.json",
+        "{\"coefficients\": [1.0], \"post_transform\": \"probit\"}");
+    EXPECT_EQ (prepare (classifier), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    write_file ("linear_classifier_malformed.json",
+        "{\"coefficients\": [[1.0, 2.0], [3.0]], \"intercepts\": [0.0, 0.0]}");
+    EXPECT_EQ (prepare (classifier), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    classifier.params.file = "linear_classifier_missing.json";
+    EXPECT_EQ (classifier.prepare (), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+}
+
+// onnxruntime is the reference for supported graphs, tests are skipped without BUILD_ONNX
+static void expect_same_as_onnxruntime (
+    const std::string &file, int num_features, const std::string &output_name)
+{
+    struct BrainFlowModelParams params = get_params ();
+    params.file = file;
+    params.output_name = output_name;
+    LinearClassifier classifier (params);
+    ASSERT_EQ (classifier.prepare (), (int)BrainFlowExitCodes::STATUS_OK);
+    params.classifier = (int)BrainFlowClassifiers::ONNX_CLASSIFIER;
+    OnnxClassifier reference (params);
+    ASSERT_EQ (reference.prepare (), (int)BrainFlowExitCodes::STATUS_OK);
+
+    for (int i = 0; i < 4; i++)
+    {
+        std::vector<double> data (num_features);
+        for (int j = 0; j < num_features; j++)
+        {
+            data[j] = (i - 1.5) * (j % 3 + 1) * 0.7 + j * 0.1;
+        }
+        double output[8] = {0.0};
+        int output_len = 0;
+        double expected[8] = {0.0};
+        int expected_len = 0;
+        ASSERT_EQ (classifier.predict (data.data (), num_features, output, &output_len),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        ASSERT_EQ (reference.predict (data.data (), num_features, expected, &expected_len),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        ASSERT_EQ (output_len, expected_len) << file;
+        for (int j = 0; j < output_len; j++)
+        {
+            EXPECT_NEAR (output[j], expected[j], 1e-5) << file << " output " << j;
+        }
+    }
+}
+
+TEST_F (LinearClassifierTest, OnnxRuntime_SameOutputs)
+{
+#ifndef BRAINFLOW_TEST_ONNXRUNTIME
+    GTEST_SKIP () << "onnxruntime is not available, build with BUILD_ONNX=ON";
+#endif
+    expect_same_as_onnxruntime (MINDFULNESS_ONNX_MODEL, 5, "");
+
+    const char *binary_transforms[] = {"NONE", "LOGISTIC", "SOFTMAX"};
+    for (const char *post_transform : binary_transforms)
+    {
+        write_file ("linear_classifier_reference.onnx",
+            model (linear_classifier_graph (
+                       2, 2, post_transform, {1.0f, -2.0f}, {0.5f}, "probabilities"))
+                .data);
+        expect_same_as_onnxruntime (file_name, 2, "probabilities");
+    }
+
+    const char *multiclass_transforms[] = {"NONE", "LOGISTIC", "SOFTMAX"};
+    for (const char *post_transform : multiclass_transforms)
+    {
+        write_file ("linear_classifier_reference.onnx",
+            model (linear_classifier_graph (2, 3, post_transform, {1, -1, 0.5f, 2, -0.5f, 0},
+                       {0.1f, 0.2f, -0.3f}, "probabilities"))
+                .data);
+        expect_same_as_onnxruntime (file_name, 2, "probabilities");
+    }
+
+    ProtoWriter normalized =
+        ProtoWriter ()
+            .message (1,
+                linear_classifier_node (
+                    3, "LOGISTIC", {1, -1, 0.5f, 2, -0.5f, 0}, {0.1f, 0.2f, -0.3f}, "scores"))
+            .message (1,
+                node ("Normalizer", {"scores"}, {"probabilities"}, "ai.onnx.ml")
+                    .message (5, string_attribute ("norm", "L1")))
+            .message (11, value_info ("X", 1, {-1, 2}))
+            .message (12, value_info ("label", 7, {-1}))
+            .message (12, value_info ("probabilities", 1, {-1, 3}));
+    write_file ("linear_classifier_reference.onnx", model (normalized).data);
+    expect_same_as_onnxruntime (file_name, 2, "probabilities");
+
+    ProtoWriter gemm = ProtoWriter ()
+                           .message (1, node ("Gemm", {"X", "W", "B"}, {"Y"}))
+                           .message (1, node ("Sigmoid", {"Y"}, {"probabilities"}))
+                           .message (5, float_tensor ("W", {3, 2}, {1, 0, 0, 1, 1, -1}))
+                           .message (5, float_tensor ("B", {2}, {0.0f, 1.0f}))
+                           .message (11, value_info ("X", 1, {-1, 3}))
+                           .message (12, value_info ("probabilities", 1, {-1, 2}));
+    write_file ("linear_classifier_reference.onnx", model (gemm).data);
+    expect_same_as_onnxruntime (file_name, 3, "");
+
+    ProtoWriter matmul = ProtoWriter ()
+                             .message (1, node ("MatMul", {"X", "W"}, {"Y"}))
+                             .message (1, node ("Add", {"Y", "B"}, {"Z"}))
+                             .message (1, node ("Softmax", {"Z"}, {"probabilities"}))
+                             .message (5, float_tensor ("W", {2, 3}, {1, 0, -1, 0.5f, 2, 0}))
+                             .message (5, float_tensor ("B", {3}, {0.0f, 1.0f, -1.0f}))
+                             .message (11, value_info ("X", 1, {-1, 2}))
+                             .message (12, value_info ("probabilities", 1, {-1, 3}));
+    write_file ("linear_classifier_reference.onnx", model (matmul).data);
+    expect_same_as_onnxruntime (file_name, 2, "");
+}
@@ -0,0 +1,253 @@
+#include <atomic>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base_classifier.h"
+#include "brainflow_constants.h"
+#include "ml_module.h"
+#include "runtime_dll_loader.h"
+
+#include "json.hpp"
+
+using json = nlohmann::json;
+using namespace testing;
+
+
+// models are created through C API of ml_module from the dyn lib test plugin, which is not thread
+// safe for ml_module and sleeps inside predict so overlapping calls are visible in its counters
+class MLModuleTest : public Test
+{
+protected:
+    DLLLoader *plugin;
+    int (*get_counters) (int *);
+
+    void SetUp ()
+    {
+        plugin = new DLLLoader (DYN_LIB_TEST_PLUGIN);
+        ASSERT_TRUE (plugin->load_library ());
+        get_counters = (int (*) (int *))plugin->get_address ("get_test_plugin_counters");
+        void (*reset_counters) () =
+            (void (*) ())plugin->get_address ("reset_test_plugin_counters");
+        ASSERT_TRUE (get_counters != NULL);
+        ASSERT_TRUE (reset_counters != NULL);
+        reset_counters ();
+    }
+
+    void TearDown ()
+    {
+        release_all ();
+        delete plugin;
+    }
+
+    // live contexts, predict calls, batch calls, max concurrent predict calls
+    int get_counter (int index)
+    {
+        int counters[4] = {0};
+        get_counters (counters);
+        return counters[index];
+    }
+};
+
+static std::string get_json_params (const char *scale)
+{
+    json params;
+    params["metric"] = (int)BrainFlowMetrics::USER_DEFINED;
+    params["classifier"] = (int)BrainFlowClassifiers::DYN_LIB_CLASSIFIER;
+    params["file"] = DYN_LIB_TEST_PLUGIN;
+    params["other_info"] = scale;
+    params["output_name"] = "";
+    params["max_array_size"] = 8;
+    return params.dump ();
+}
+
+TEST_F (MLModuleTest, PrepareWithHandle_HandleAndJsonShareModel)
+{
+    std::string params = get_json_params ("2");
+    int handle = 0;
+    ASSERT_EQ (prepare_with_handle (params.c_str (), &handle), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_GT (handle, 0);
+    EXPECT_EQ (get_counter (0), 1);
+    int other_handle = 0;
+    EXPECT_EQ (prepare_with_handle (params.c_str (), &other_handle),
+        (int)BrainFlowExitCodes::ANOTHER_CLASSIFIER_IS_PREPARED_ERROR);
+    EXPECT_EQ (prepare (params.c_str ()),
+        (int)BrainFlowExitCodes::ANOTHER_CLASSIFIER_IS_PREPARED_ERROR);
+
+    double data[2] = {1.0, 2.0};
+    double output[8] = {0.0};
+    int output_len = 0;
+    ASSERT_EQ (predict_with_handle (data, 2, output, &output_len, handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (output[0], 6.0);
+    ASSERT_EQ (predict (data, 2, output, &output_len, params.c_str ()),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (output[0], 6.0);
+    EXPECT_EQ (get_counter (0), 1);
+
+    // release by json invalidates handle too
+    EXPECT_EQ (release (params.c_str ()), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (get_counter (0), 0);
+    EXPECT_EQ (predict_with_handle (data, 2, output, &output_len, handle),
+        (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR);
+    EXPECT_EQ (release_with_handle (handle),
+        (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR);
+
+    // released model can be prepared again and gets a new handle
+    ASSERT_EQ (prepare_with_handle (params.c_str (), &other_handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_NE (other_handle, handle);
+    EXPECT_EQ (release_with_handle (other_handle), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (predict (data, 2, output, &output_len, params.c_str ()),
+        (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR);
+}
+
+TEST_F (MLModuleTest, InvalidArguments_Rejected)
+{
+    int handle = 0;
+    EXPECT_EQ (
+        prepare_with_handle (NULL, &handle), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    EXPECT_EQ (prepare_with_handle ("{\"metric\": 0", &handle),
+        (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    double data[1] = {1.0};
+    double output[8] = {0.0};
+    int output_len = 0;
+    EXPECT_EQ (predict_with_handle (data, 1, output, &output_len, 12345),
+        (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR);
+    EXPECT_EQ (predict_batch_with_handle (data, 1, 1, output, &output_len, 12345),
+        (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR);
+}
+
+TEST_F (MLModuleTest, ConcurrentPredictOnOneHandle_SerializedForNotThreadSafeModel)
+{
+    int handle = 0;
+    ASSERT_EQ (prepare_with_handle (get_json_params ("1").c_str (), &handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    const int num_threads = 8;
+    const int num_calls = 20;
+    std::atomic<int> num_failed (0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; i++)
+    {
+        threads.push_back (std::thread ([&, i] () {
+            for (int j = 0; j < num_calls; j++)
+            {
+                double data[2] = {(double)i, (double)j};
+                double output[8] = {0.0};
+                int output_len = 0;
+                int res = predict_with_handle (data, 2, output, &output_len, handle);
+                if ((res != (int)BrainFlowExitCodes::STATUS_OK) || (output[0] != (double)(i + j)))
+                {
+                    num_failed++;
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size (); i++)
+    {
+        threads[i].join ();
+    }
+    EXPECT_EQ (num_failed.load (), 0);
+    EXPECT_EQ (get_counter (1), num_threads * num_calls);
+    EXPECT_EQ (get_counter (3), 1);
+
+    double stats[BaseClassifier::num_stats] = {0.0};
+    int stats_len = 0;
+    ASSERT_EQ (get_model_stats_with_handle (stats, &stats_len, handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (stats_len, (int)BaseClassifier::num_stats);
+    EXPECT_EQ (stats[0], (double)(num_threads * num_calls));
+    EXPECT_EQ (stats[1], 0.0);
+}
+
+TEST_F (MLModuleTest, DifferentModels_PredictConcurrently)
+{
+    int first = 0;
+    int second = 0;
+    ASSERT_EQ (prepare_with_handle (get_json_params ("1").c_str (), &first),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (prepare_with_handle (get_json_params ("2").c_str (), &second),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    // each model is serialized on its own, so two threads may overlap only across models
+    std::thread first_thread ([&] () {
+        for (int i = 0; i < 50; i++)
+        {
+            double data[1] = {1.0};
+            double output[8] = {0.0};
+            int output_len = 0;
+            predict_with_handle (data, 1, output, &output_len, first);
+        }
+    });
+    for (int i = 0; i < 50; i++)
+    {
+        double data[1] = {1.0};
+        double output[8] = {0.0};
+        int output_len = 0;
+        EXPECT_EQ (predict_with_handle (data, 1, output, &output_len, second),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        EXPECT_EQ (output[0], 2.0);
+    }
+    first_thread.join ();
+    EXPECT_LE (get_counter (3), 2);
+    EXPECT_EQ (get_counter (1), 100);
+}
+
+TEST_F (MLModuleTest, ReleaseWhilePredicting_ModelReleasedAfterLastCall)
+{
+    int handle = 0;
+    ASSERT_EQ (prepare_with_handle (get_json_params ("1").c_str (), &handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    std::atomic<int> num_ok (0);
+    std::atomic<bool> started (false);
+    std::thread predict_thread ([&] () {
+        double data[1] = {1.0};
+        double output[8] = {0.0};
+        int output_len = 0;
+        while (predict_with_handle (data, 1, output, &output_len, handle) ==
+            (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            num_ok++;
+            started = true;
+        }
+    });
+    while (!started)
+    {
+        std::this_thread::yield ();
+    }
+    EXPECT_EQ (release_with_handle (handle), (int)BrainFlowExitCodes::STATUS_OK);
+    predict_thread.join ();
+    EXPECT_GT (num_ok.load (), 0);
+    // context is released by the last owner, either release_with_handle or predict thread
+    EXPECT_EQ (get_counter (0), 0);
+}
+
+TEST_F (MLModuleTest, PredictBatchWithHandle_MatchesPerSample)
+{
+    int handle = 0;
+    ASSERT_EQ (prepare_with_handle (get_json_params ("3").c_str (), &handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    double data[6] = {1, 0, 0, 1, 1, 1};
+    double batch_output[8] = {0.0};
+    int batch_len = 0;
+    ASSERT_EQ (predict_batch_with_handle (data, 3, 2, batch_output, &batch_len, handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (batch_len, 3);
+    EXPECT_EQ (get_counter (2), 1);
+    for (int i = 0; i < 3; i++)
+    {
+        double output[8] = {0.0};
+        int output_len = 0;
+        ASSERT_EQ (predict_with_handle (data + i * 2, 2, output, &output_len, handle),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        EXPECT_EQ (output[0], batch_output[i]);
+    }
+
+    float float_data[6] = {1, 0, 0, 1, 1, 1};
+    double float_output[8] = {0.0};
+    ASSERT_EQ (predict_batch_float_with_handle (float_data, 3, 2, float_output, &batch_len, handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_THAT (std::vector<double> (float_output, float_output + 3),
+        ElementsAre (3.0, 3.0, 6.0));
+}
@@ -0,0 +1,234 @@
+#include <atomic>
+#include <chrono>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "lazy_classifier.h"
+#include "model_registry.h"
+
+using namespace testing;
+
+
+// counts created and alive models, prediction is data[0] + id from other_info, predict blocks
+// while block_predict is set
+static std::atomic<int> num_created (0);
+static std::atomic<int> num_alive (0);
+static std::atomic<bool> block_predict (false);
+static std::atomic<int> num_blocked (0);
+
+class RegistryTestModel : public BaseClassifier
+{
+public:
+    RegistryTestModel (struct BrainFlowModelParams params) : BaseClassifier (params)
+    {
+        num_created++;
+        num_alive++;
+    }
+
+    ~RegistryTestModel ()
+    {
+        num_alive--;
+    }
+
+    int prepare ()
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    int predict (double *data, int data_len, double *output, int *output_len)
+    {
+        if (block_predict)
+        {
+            num_blocked++;
+            while (block_predict)
+            {
+                std::this_thread::sleep_for (std::chrono::milliseconds (1));
+            }
+            num_blocked--;
+        }
+        output[0] = data[0] + atof (params.other_info.c_str ());
+        *output_len = 1;
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    int release ()
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+};
+
+static int create_test_model (
+    struct BrainFlowModelParams params, std::shared_ptr<BaseClassifier> &model)
+{
+    model = std::shared_ptr<BaseClassifier> (new RegistryTestModel (params));
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+class ModelRegistryTest : public Test
+{
+protected:
+    ModelRegistry registry;
+
+    void SetUp ()
+    {
+        num_created = 0;
+        num_alive = 0;
+        block_predict = false;
+        num_blocked = 0;
+    }
+
+    void TearDown ()
+    {
+        block_predict = false;
+        registry.shutdown ();
+    }
+
+    std::shared_ptr<LazyClassifier> create_lazy_model (int id)
+    {
+        struct BrainFlowModelParams params (
+            (int)BrainFlowMetrics::USER_DEFINED, (int)BrainFlowClassifiers::DYN_LIB_CLASSIFIER);
+        params.other_info = std::to_string (id);
+        return std::shared_ptr<LazyClassifier> (
+            new LazyClassifier (params, create_test_model, &registry));
+    }
+};
+
+static double predict_value (std::shared_ptr<LazyClassifier> model, double value)
+{
+    double output[1] = {0.0};
+    int output_len = 0;
+    int res = model->run_predict (&value, 1, output, &output_len);
+    return (res == (int)BrainFlowExitCodes::STATUS_OK) ? output[0] : -1.0;
+}
+
+static bool wait_until_loaded (std::shared_ptr<LazyClassifier> model)
+{
+    auto deadline = std::chrono::steady_clock::now () + std::chrono::seconds (5);
+    while ((!model->is_loaded ()) && (std::chrono::steady_clock::now () < deadline))
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+    return model->is_loaded ();
+}
+
+TEST_F (ModelRegistryTest, Prepare_ModelLoadedOnFirstPredict)
+{
+    std::shared_ptr<LazyClassifier> model = create_lazy_model (10);
+    ASSERT_EQ (model->prepare (), (int)BrainFlowExitCodes::STATUS_OK);
+    // prepare creates a model only to check params
+    EXPECT_FALSE (model->is_loaded ());
+    EXPECT_EQ (num_alive, 0);
+
+    EXPECT_EQ (predict_value (model, 1.0), 11.0);
+    EXPECT_TRUE (model->is_loaded ());
+    EXPECT_EQ (predict_value (model, 2.0), 12.0);
+    EXPECT_EQ (num_alive, 1);
+
+    EXPECT_EQ (model->release (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_FALSE (model->is_loaded ());
+    EXPECT_EQ (num_alive, 0);
+}
+
+TEST_F (ModelRegistryTest, CountLimit_LeastRecentlyUsedEvictedAndReloaded)
+{
+    registry.set_limits (2, 0);
+    std::shared_ptr<LazyClassifier> first = create_lazy_model (1);
+    std::shared_ptr<LazyClassifier> second = create_lazy_model (2);
+    std::shared_ptr<LazyClassifier> third = create_lazy_model (3);
+    EXPECT_EQ (predict_value (first, 0.0), 1.0);
+    EXPECT_EQ (predict_value (second, 0.0), 2.0);
+    // first is used after second, so second is the least recently used one
+    EXPECT_EQ (predict_value (first, 0.0), 1.0);
+    EXPECT_EQ (predict_value (third, 0.0), 3.0);
+    EXPECT_TRUE (first->is_loaded ());
+    EXPECT_FALSE (second->is_loaded ());
+    EXPECT_TRUE (third->is_loaded ());
+    EXPECT_EQ (num_alive, 2);
+
+    // evicted model is loaded again on the next call and evicts first
+    int created = num_created;
+    EXPECT_EQ (predict_value (second, 1.0), 3.0);
+    EXPECT_EQ (num_created, created + 1);
+    EXPECT_FALSE (first->is_loaded ());
+    EXPECT_TRUE (second->is_loaded ());
+    EXPECT_TRUE (third->is_loaded ());
+    EXPECT_EQ (num_alive, 2);
+}
+
+TEST_F (ModelRegistryTest, EvictedWhilePredicting_CallCompletesAndModelFreedAfter)
+{
+    registry.set_limits (1, 0);
+    std::shared_ptr<LazyClassifier> first = create_lazy_model (1);
+    std::shared_ptr<LazyClassifier> second = create_lazy_model (2);
+    EXPECT_EQ (predict_value (first, 0.0), 1.0);
+
+    block_predict = true;
+    std::atomic<double> blocked_result (0.0);
+    std::thread predict_thread ([&] () { blocked_result = predict_value (first, 5.0); });
+    auto deadline = std::chrono::steady_clock::now () + std::chrono::seconds (5);
+    while ((num_blocked == 0) && (std::chrono::steady_clock::now () < deadline))
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+    ASSERT_EQ (num_blocked, 1);
+
+    // loading second evicts first while its prediction is in flight, evicted model is alive
+    // until the call returns
+    EXPECT_EQ (second->load (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_FALSE (first->is_loaded ());
+    EXPECT_EQ (num_alive, 2);
+    block_predict = false;
+    predict_thread.join ();
+    EXPECT_EQ (blocked_result.load (), 6.0);
+    EXPECT_EQ (num_alive, 1);
+}
+
+TEST_F (ModelRegistryTest, ConcurrentUseAndEviction_AllCallsSucceed)
+{
+    registry.set_limits (1, 0);
+    std::vector<std::shared_ptr<LazyClassifier>> models;
+    for (int i = 0; i < 3; i++)
+    {
+        models.push_back (create_lazy_model (i * 10));
+    }
+    // every call may evict a model which is used by another thread
+    std::atomic<int> num_failed (0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 3; i++)
+    {
+        threads.push_back (std::thread ([&, i] () {
+            for (int j = 0; j < 200; j++)
+            {
+                if (predict_value (models[i], (double)j) != (double)(i * 10 + j))
+                {
+                    num_failed++;
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size (); i++)
+    {
+        threads[i].join ();
+    }
+    EXPECT_EQ (num_failed.load (), 0);
+    EXPECT_LE (num_alive, 1);
+}
+
+TEST_F (ModelRegistryTest, LoadInBackground_WorkerRestartedAfterShutdown)
+{
+    std::shared_ptr<LazyClassifier> first = create_lazy_model (1);
+    registry.load_in_background (first);
+    EXPECT_TRUE (wait_until_loaded (first));
+
+    registry.shutdown ();
+    registry.shutdown ();
+    std::shared_ptr<LazyClassifier> second = create_lazy_model (2);
+    registry.load_in_background (second);
+    EXPECT_TRUE (wait_until_loaded (second));
+    EXPECT_EQ (num_alive, 2);
+}
@@ -0,0 +1,229 @@
+#include <atomic>
+#include <fstream>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <mutex>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "onnx_classifier.h"
+#include "onnx_model_writer.h"
+
+using namespace testing;
+
+
+// gives tests access to binding pool, so a binding can be held like by another thread
+class TestOnnxClassifier : public OnnxClassifier
+{
+public:
+    TestOnnxClassifier (struct BrainFlowModelParams params) : OnnxClassifier (params)
+    {
+    }
+
+    OnnxBinding *take_binding (int data_len)
+    {
+        return acquire_binding (data_len);
+    }
+
+    void put_binding (OnnxBinding *binding)
+    {
+        release_binding (binding);
+    }
+
+    size_t get_num_bindings ()
+    {
+        std::lock_guard<std::mutex> lock (bindings_mutex);
+        return bindings.size ();
+    }
+};
+
+// onnxruntime is copied next to test executable only if BUILD_ONNX is ON
+class OnnxClassifierTest : public Test
+{
+protected:
+    std::string file_name;
+
+    void SetUp ()
+    {
+#ifndef BRAINFLOW_TEST_ONNXRUNTIME
+        GTEST_SKIP () << "onnxruntime is not available, build with BUILD_ONNX=ON";
+#endif
+    }
+
+    void TearDown ()
+    {
+        if (!file_name.empty ())
+        {
+            remove (file_name.c_str ());
+        }
+    }
+
+    // Y = X * W + B, first score is x0 + x2, second is x1 - x2 + 1, batch_dim < 0 is dynamic
+    void write_gemm_model (const std::string &name, int64_t batch_dim)
+    {
+        ProtoWriter graph =
+            ProtoWriter ()
+                .message (1, node ("Gemm", {"X", "W", "B"}, {"Y"}))
+                .message (5, float_tensor ("W", {3, 2}, {1, 0, 0, 1, 1, -1}))
+                .message (5, float_tensor ("B", {2}, {0.0f, 1.0f}))
+                .message (11, value_info ("X", 1, {batch_dim, 3}))
+                .message (12, value_info ("Y", 1, {batch_dim, 2}));
+        file_name = name;
+        std::ofstream file (name, std::ios::binary);
+        file << model (graph).data;
+    }
+};
+
+static struct BrainFlowModelParams get_params (const std::string &file)
+{
+    struct BrainFlowModelParams params (
+        (int)BrainFlowMetrics::USER_DEFINED, (int)BrainFlowClassifiers::ONNX_CLASSIFIER);
+    params.file = file;
+    params.max_array_size = 8;
+    return params;
+}
+
+static void expect_scores (const double *data, const double *output)
+{
+    EXPECT_NEAR (output[0], data[0] + data[2], 1e-5);
+    EXPECT_NEAR (output[1], data[1] - data[2] + 1.0, 1e-5);
+}
+
+TEST_F (OnnxClassifierTest, StaticShape_BindingAndPerCallTensorsMatch)
+{
+    write_gemm_model ("onnx_classifier_static.onnx", 1);
+    TestOnnxClassifier classifier (get_params (file_name));
+    ASSERT_EQ (classifier.prepare (), (int)BrainFlowExitCodes::STATUS_OK);
+
+    double data[3] = {0.5, -1.0, 2.0};
+    double output[8] = {0.0};
+    int output_len = 0;
+    // repeated calls reuse bound input and output
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_EQ (classifier.predict (data, 3, output, &output_len),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        ASSERT_EQ (output_len, 2);
+        expect_scores (data, output);
+    }
+
+    EXPECT_EQ (classifier.get_num_bindings (), (size_t)1);
+
+    // binding is busy, predict creates another one and keeps it for next calls
+    double fallback_output[8] = {0.0};
+    float float_data[3] = {0.5f, -1.0f, 2.0f};
+    double float_output[8] = {0.0};
+    OnnxBinding *busy_binding = classifier.take_binding (3);
+    ASSERT_NE (busy_binding, (OnnxBinding *)NULL);
+    ASSERT_EQ (classifier.predict (data, 3, fallback_output, &output_len),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (output_len, 2);
+    ASSERT_EQ (classifier.predict_float (float_data, 3, float_output, &output_len),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (output_len, 2);
+    EXPECT_EQ (classifier.get_num_bindings (), (size_t)2);
+    classifier.put_binding (busy_binding);
+    EXPECT_EQ (fallback_output[0], output[0]);
+    EXPECT_EQ (fallback_output[1], output[1]);
+    EXPECT_EQ (float_output[0], output[0]);
+    EXPECT_EQ (float_output[1], output[1]);
+
+    EXPECT_EQ (classifier.predict (data, 2, output, &output_len),
+        (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    EXPECT_EQ (classifier.release (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (classifier.predict (data, 3, output, &output_len),
+        (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR);
+}
+
+TEST_F (OnnxClassifierTest, DynamicBatch_SingleRunMatchesPerSample)
+{
+    write_gemm_model ("onnx_classifier_dynamic.onnx", -1);
+    TestOnnxClassifier classifier (get_params (file_name));
+    ASSERT_EQ (classifier.prepare (), (int)BrainFlowExitCodes::STATUS_OK);
+
+    const int batch_size = 4;
+    double data[batch_size * 3] = {1, 2, 3, -1, 0, 1, 0.5, 0.5, 0.5, 10, -10, 0};
+    double batch_output[batch_size * 8] = {0.0};
+    int batch_len = 0;
+    ASSERT_EQ (classifier.predict_batch (data, batch_size, 3, batch_output, &batch_len),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (batch_len, batch_size * 2);
+    std::vector<float> float_data (data, data + batch_size * 3);
+    double float_output[batch_size * 8] = {0.0};
+    ASSERT_EQ (classifier.predict_batch_float (
+                   float_data.data (), batch_size, 3, float_output, &batch_len),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (batch_len, batch_size * 2);
+    for (int i = 0; i < batch_size; i++)
+    {
+        double output[8] = {0.0};
+        int output_len = 0;
+        ASSERT_EQ (classifier.predict (data + i * 3, 3, output, &output_len),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        ASSERT_EQ (output_len, 2);
+        expect_scores (data + i * 3, output);
+        EXPECT_EQ (batch_output[i * 2], output[0]);
+        EXPECT_EQ (batch_output[i * 2 + 1], output[1]);
+        EXPECT_EQ (float_output[i * 2], output[0]);
+        EXPECT_EQ (float_output[i * 2 + 1], output[1]);
+    }
+    // single samples are scored with preallocated output of batch 1, batches don't take bindings
+    EXPECT_NE (classifier.take_binding (3), (OnnxBinding *)NULL);
+    EXPECT_EQ (classifier.take_binding (batch_size * 3), (OnnxBinding *)NULL);
+}
+
+TEST_F (OnnxClassifierTest, ConcurrentPredict_AllResultsCorrect)
+{
+    write_gemm_model ("onnx_classifier_concurrent.onnx", 1);
+    TestOnnxClassifier classifier (get_params (file_name));
+    ASSERT_EQ (classifier.prepare (), (int)BrainFlowExitCodes::STATUS_OK);
+
+    // threads contend for bindings, each concurrent caller gets its own one
+    const int num_threads = 8;
+    const int num_calls = 200;
+    std::atomic<int> num_failed (0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; i++)
+    {
+        threads.push_back (std::thread ([&, i] () {
+            for (int j = 0; j < num_calls; j++)
+            {
+                double data[3] = {(double)i, (double)j, 1.0};
+                double output[8] = {0.0};
+                int output_len = 0;
+                int res = classifier.run_predict (data, 3, output, &output_len);
+                if ((res != (int)BrainFlowExitCodes::STATUS_OK) || (output_len != 2) ||
+                    (output[0] != (double)(i + 1)) || (output[1] != (double)j))
+                {
+                    num_failed++;
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size (); i++)
+    {
+        threads[i].join ();
+    }
+    EXPECT_EQ (num_failed.load (), 0);
+    EXPECT_GE (classifier.get_num_bindings (), (size_t)1);
+    EXPECT_LE (classifier.get_num_bindings (), (size_t)num_threads);
+}
+
+TEST_F (OnnxClassifierTest, OtherInfo_NonJsonIgnoredInvalidSettingsRejected)
+{
+    write_gemm_model ("onnx_classifier_other_info.onnx", 1);
+    struct BrainFlowModelParams params = get_params (file_name);
+    params.other_info = "trained on session 3";
+    OnnxClassifier free_text (params);
+    EXPECT_EQ (free_text.prepare (), (int)BrainFlowExitCodes::STATUS_OK);
+
+    params.other_info = "{\"execution_mode\": \"fastest\"}";
+    OnnxClassifier invalid_mode (params);
+    EXPECT_EQ (invalid_mode.prepare (), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+
+    params.other_info = "{\"intra_op_num_threads\": \"two\"}";
+    OnnxClassifier invalid_type (params);
+    EXPECT_EQ (invalid_type.prepare (), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+}
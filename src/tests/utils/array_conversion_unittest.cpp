@@ -0,0 +1,82 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <limits>
+#include <vector>
+
+#include "array_conversion.h"
+#include "custom_cast.h"
+
+using namespace testing;
+
+
+TEST (ArrayConversionTest, ConvertDoubleToFloat_UnalignedTail_MatchesScalarCast)
+{
+    std::vector<double> src (19);
+    for (size_t i = 0; i < src.size (); i++)
+    {
+        src[i] = 0.1 * (double)i - 1.0;
+    }
+    // start from the second element to check unaligned loads
+    std::vector<float> dst (src.size () - 1, 0.0f);
+    convert_double_to_float (src.data () + 1, dst.data (), dst.size ());
+    for (size_t i = 0; i < dst.size (); i++)
+    {
+        EXPECT_EQ (dst[i], (float)src[i + 1]);
+    }
+}
+
+TEST (ArrayConversionTest, ConvertDoubleToFloat_SpecialValues_Preserved)
+{
+    double src[4] = {std::numeric_limits<double>::infinity (), -0.0, 1e300, -1e-300};
+    float dst[4];
+    convert_double_to_float (src, dst, 4);
+    EXPECT_EQ (dst[0], std::numeric_limits<float>::infinity ());
+    EXPECT_EQ (dst[1], 0.0f);
+    EXPECT_EQ (dst[2], std::numeric_limits<float>::infinity ());
+    EXPECT_EQ (dst[3], -0.0f);
+}
+
+TEST (ArrayConversionTest, ConvertFloatToDouble_AnyLength_ExactValues)
+{
+    for (size_t len = 0; len < 11; len++)
+    {
+        std::vector<float> src (len);
+        for (size_t i = 0; i < len; i++)
+        {
+            src[i] = 1.5f * (float)i - 3.25f;
+        }
+        std::vector<double> dst (len + 1, 42.0);
+        convert_float_to_double (src.data (), dst.data (), len);
+        for (size_t i = 0; i < len; i++)
+        {
+            EXPECT_EQ (dst[i], (double)src[i]);
+        }
+        // must not write past the end
+        EXPECT_EQ (dst[len], 42.0);
+    }
+}
+
+TEST (ArrayConversionTest, ConvertInt24ToDouble_SignedValues_MatchScalarCast)
+{
+    // 18 values to cover simd loop and tail, includes min, max, -1 and 0
+    std::vector<unsigned char> src = {0x80, 0x00, 0x00, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+        0x00, 0x00, 0x00, 0x03, 0xE8, 0xFF, 0xFC, 0x18};
+    for (int i = 0; i < 36; i++)
+    {
+        src.push_back ((unsigned char)(i * 37 + 11));
+    }
+    size_t len = src.size () / 3;
+    std::vector<double> scales (len);
+    for (size_t i = 0; i < len; i++)
+    {
+        scales[i] = 0.5 + 0.25 * (double)i;
+    }
+    std::vector<double> dst (len, 0.0);
+    convert_int24_to_double (src.data (), scales.data (), dst.data (), len);
+    for (size_t i = 0; i < len; i++)
+    {
+        EXPECT_EQ (dst[i], scales[i] * (double)cast_24bit_to_int32 (src.data () + i * 3));
+    }
+    EXPECT_EQ (dst[0], -8388608.0 * scales[0]);
+    EXPECT_EQ (dst[2], -1.0 * scales[2]);
+}
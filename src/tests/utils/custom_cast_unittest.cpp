@@ -0,0 +1,52 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <cstring>
+#include <random>
+
+#include "custom_cast.h"
+
+using namespace testing;
+
+
+template <unsigned int N>
+static void expect_packed_bits_match_bitset_cast (const unsigned char *package)
+{
+    unsigned char package_bits[160] = {0}; // 20 * 8
+    for (int i = 0; i < 20; i++)
+    {
+        uchar_to_bits (package[i], package_bits + i * 8);
+    }
+    for (int i = 8; i < (int)N * 8; i += N)
+    {
+        EXPECT_EQ (cast_ganglion_packed_bits_to_int32<N> (package, i),
+            cast_ganglion_bits_to_int32<N> (package_bits + i));
+    }
+}
+
+TEST (CustomCastTest, CastGanglionPackedBits_RandomPackages_MatchBitsetCast)
+{
+    std::mt19937 gen (42);
+    std::uniform_int_distribution<int> dist (0, 255);
+    unsigned char package[20];
+    for (int iter = 0; iter < 10000; iter++)
+    {
+        for (int i = 0; i < 20; i++)
+        {
+            package[i] = (unsigned char)dist (gen);
+        }
+        expect_packed_bits_match_bitset_cast<18> (package);
+        expect_packed_bits_match_bitset_cast<19> (package);
+    }
+}
+
+TEST (CustomCastTest, CastGanglionPackedBits_AllOnesAndZeros_MatchBitsetCast)
+{
+    unsigned char zeros[20] = {0};
+    unsigned char ones[20];
+    memset (ones, 0xFF, sizeof (ones));
+    expect_packed_bits_match_bitset_cast<18> (zeros);
+    expect_packed_bits_match_bitset_cast<19> (zeros);
+    expect_packed_bits_match_bitset_cast<18> (ones);
+    expect_packed_bits_match_bitset_cast<19> (ones);
+    EXPECT_EQ (cast_ganglion_packed_bits_to_int32<18> (ones, 8), -2);
+}
@@ -424,4 +424,197 @@ TEST (DataBufferTest, IsReady_BufferSizeIsZero_ReturnFalse)
 {
     DataBuffer buffer_zero (4, 0);
     EXPECT_EQ (buffer_zero.is_ready (), false);
-}
\ No newline at end of file
+}
+TEST (DataBufferTest, AddDataBatch_AddLessDataThanBufferCapacity_StoreAllData)
+{
+    DataBuffer buffer (2, 4);
+    double values[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    double retrieved[6];
+
+    buffer.add_data (values, 3);
+
+    EXPECT_EQ (buffer.get_data_count (), 3);
+    EXPECT_EQ (buffer.get_data (3, retrieved), 3);
+    for (int i = 0; i < 6; i++)
+    {
+        EXPECT_EQ (retrieved[i], values[i]);
+    }
+}
+
+TEST (DataBufferTest, AddDataBatch_WrapAround_OverwriteOldestData)
+{
+    DataBuffer buffer (2, 3);
+    double first_values[4] = {1.0, 2.0, 3.0, 4.0};
+    double second_values[4] = {5.0, 6.0, 7.0, 8.0};
+    double retrieved[6];
+
+    buffer.add_data (first_values, 2);
+    buffer.add_data (second_values, 2);
+
+    EXPECT_EQ (buffer.get_data_count (), 3);
+    EXPECT_EQ (buffer.get_current_data (3, retrieved), 3);
+    double expected[6] = {3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+    for (int i = 0; i < 6; i++)
+    {
+        EXPECT_EQ (retrieved[i], expected[i]);
+    }
+}
+
+TEST (DataBufferTest, AddDataBatch_MoreDataThanBufferCapacity_StoreLatestData)
+{
+    DataBuffer buffer (1, 3);
+    double values[5] = {1.0, 2.0, 3.0, 4.0, 5.0};
+    double retrieved[3];
+
+    buffer.add_data (values, 1);
+    buffer.add_data (values, 5);
+
+    EXPECT_EQ (buffer.get_data_count (), 3);
+    EXPECT_EQ (buffer.get_data (3, retrieved), 3);
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ (retrieved[i], values[i + 2]);
+    }
+}
+
+TEST (DataBufferTest, AddDataBatch_SameAsSingleAdds_ReturnSameData)
+{
+    DataBuffer single (3, 7);
+    DataBuffer batch (3, 7);
+    double values[30];
+    for (int i = 0; i < 30; i++)
+    {
+        values[i] = (double)i;
+    }
+
+    for (int i = 0; i < 10; i++)
+    {
+        single.add_data (values + i * 3);
+    }
+    batch.add_data (values, 4);
+    batch.add_data (values + 12, 6);
+
+    double retrieved_single[21];
+    double retrieved_batch[21];
+    EXPECT_EQ (single.get_current_data (7, retrieved_single), 7);
+    EXPECT_EQ (batch.get_current_data (7, retrieved_batch), 7);
+    for (int i = 0; i < 21; i++)
+    {
+        EXPECT_EQ (retrieved_single[i], retrieved_batch[i]);
+    }
+}
+
+TEST (DataBufferTest, GetSamples_AfterGetDataAndWrap_ReturnsByAbsoluteIndex)
+{
+    DataBuffer buffer (1, 4);
+    double retrieved[4];
+    for (int i = 0; i < 6; i++)
+    {
+        double value = (double)i;
+        buffer.add_data (&value);
+        buffer.get_data (4, retrieved);
+    }
+    EXPECT_EQ (buffer.get_total_count (), 6u);
+    ASSERT_TRUE (buffer.get_samples (2, 4, retrieved));
+    EXPECT_THAT (std::vector<double> (retrieved, retrieved + 4), ElementsAre (2.0, 3.0, 4.0, 5.0));
+    // overwritten and not added yet
+    EXPECT_FALSE (buffer.get_samples (1, 2, retrieved));
+    EXPECT_FALSE (buffer.get_samples (5, 2, retrieved));
+}
+
+TEST (DataBufferTest, GetDataByTime_WrappedBuffer_ReturnsInclusiveRange)
+{
+    DataBuffer buffer (2, 8);
+    for (int i = 0; i < 12; i++)
+    {
+        // value, timestamp
+        double sample[2] = {(double)i, 0.5 * i};
+        buffer.add_data (sample);
+    }
+    double retrieved[16];
+    EXPECT_EQ (buffer.get_data_by_time (2.5, 3.5, 1, 8, false, retrieved), 3);
+    EXPECT_THAT (std::vector<double> (retrieved, retrieved + 6),
+        ElementsAre (5.0, 2.5, 6.0, 3.0, 7.0, 3.5));
+    // range is clipped to stored samples and max_count
+    EXPECT_EQ (buffer.get_data_by_time (0.0, 100.0, 1, 2, false, retrieved), 2);
+    EXPECT_DOUBLE_EQ (retrieved[0], 4.0);
+    EXPECT_EQ (buffer.get_data_by_time (10.0, 100.0, 1, 8, false, retrieved), 0);
+    EXPECT_EQ (buffer.get_data_count (), 8);
+}
+
+TEST (DataBufferTest, GetDataByTime_Remove_DropsRangeAndOlderSamples)
+{
+    DataBuffer buffer (2, 8);
+    for (int i = 0; i < 8; i++)
+    {
+        double sample[2] = {(double)i, (double)i};
+        buffer.add_data (sample);
+    }
+    double retrieved[16];
+    EXPECT_EQ (buffer.get_data_by_time (2.0, 4.0, 1, 8, true, retrieved), 3);
+    EXPECT_EQ (buffer.get_data_count (), 3);
+    buffer.get_data (1, retrieved);
+    EXPECT_DOUBLE_EQ (retrieved[0], 5.0);
+}
+
+TEST (DataBufferTest, GetDataByTime_NaNPlaceholders_IncludedInRange)
+{
+    DataBuffer buffer (2, 16);
+    for (int i = 0; i < 10; i++)
+    {
+        bool is_lost = (i >= 3) && (i <= 5);
+        double sample[2] = {(double)i, is_lost ? NAN : (double)i};
+        buffer.add_data (sample);
+    }
+    double retrieved[32];
+    EXPECT_EQ (buffer.get_data_by_time (2.0, 6.0, 1, 16, false, retrieved), 5);
+    EXPECT_DOUBLE_EQ (retrieved[0], 2.0);
+    EXPECT_DOUBLE_EQ (retrieved[8], 6.0);
+    EXPECT_EQ (buffer.get_data_by_time (4.0, 4.5, 1, 16, false, retrieved), 0);
+}
+
+TEST (DataBufferTest, Resize_Grow_KeepsSamplesAndAbsoluteIndexes)
+{
+    DataBuffer buffer (1, 4);
+    for (int i = 0; i < 6; i++)
+    {
+        double sample = (double)i;
+        buffer.add_data (&sample);
+    }
+    double retrieved[8];
+    buffer.get_data (1, retrieved);
+    ASSERT_TRUE (buffer.resize (8));
+    EXPECT_EQ (buffer.get_buffer_size (), 8u);
+    EXPECT_EQ (buffer.get_data_count (), 3);
+    ASSERT_TRUE (buffer.get_samples (2, 4, retrieved));
+    EXPECT_THAT (std::vector<double> (retrieved, retrieved + 4), ElementsAre (2.0, 3.0, 4.0, 5.0));
+    for (int i = 6; i < 10; i++)
+    {
+        double sample = (double)i;
+        buffer.add_data (&sample);
+    }
+    EXPECT_EQ (buffer.get_data (8, retrieved), 7);
+    EXPECT_THAT (std::vector<double> (retrieved, retrieved + 7),
+        ElementsAre (3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0));
+}
+
+TEST (DataBufferTest, Resize_Shrink_KeepsLatestSamples)
+{
+    DataBuffer buffer (1, 8);
+    for (int i = 0; i < 11; i++)
+    {
+        double sample = (double)i;
+        buffer.add_data (&sample);
+    }
+    ASSERT_TRUE (buffer.resize (3));
+    EXPECT_EQ (buffer.get_data_count (), 3);
+    double retrieved[3];
+    EXPECT_FALSE (buffer.get_samples (7, 2, retrieved));
+    EXPECT_EQ (buffer.get_current_data (3, retrieved), 3);
+    EXPECT_THAT (std::vector<double> (retrieved, retrieved + 3), ElementsAre (8.0, 9.0, 10.0));
+    double sample = 11.0;
+    buffer.add_data (&sample);
+    EXPECT_EQ (buffer.get_data (3, retrieved), 3);
+    EXPECT_THAT (std::vector<double> (retrieved, retrieved + 3), ElementsAre (9.0, 10.0, 11.0));
+    EXPECT_FALSE (buffer.resize (0));
+}
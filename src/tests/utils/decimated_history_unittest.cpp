@@ -0,0 +1,93 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <math.h>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "decimated_history.h"
+
+using namespace testing;
+
+
+// rows: value, marker, timestamp
+static std::vector<double> make_samples (int count)
+{
+    std::vector<double> samples;
+    for (int i = 0; i < count; i++)
+    {
+        samples.push_back ((double)(i % 4));
+        samples.push_back ((i == 5) ? 7.0 : 0.0);
+        samples.push_back ((double)i);
+    }
+    return samples;
+}
+
+TEST (DecimatedHistoryTest, AddSamples_Mean_AveragesBlocksAndKeepsMarker)
+{
+    DecimatedHistory history (3, 4, (int)DecimationTypes::MEAN, 16, 1);
+    std::vector<double> samples = make_samples (10);
+    // split across calls, incomplete block is not stored
+    history.add_samples (samples.data (), 3);
+    history.add_samples (samples.data () + 3 * 3, 7);
+    ASSERT_EQ (history.get_data_count (), 2);
+    double retrieved[6];
+    history.get_current_data (2, retrieved);
+    EXPECT_THAT (std::vector<double> (retrieved, retrieved + 6),
+        ElementsAre (1.5, 0.0, 1.5, 1.5, 7.0, 5.5));
+}
+
+TEST (DecimatedHistoryTest, AddSamples_MinMax_StoresEnvelopePairs)
+{
+    DecimatedHistory history (3, 4, (int)DecimationTypes::MIN_MAX, 16, 1);
+    std::vector<double> samples = make_samples (8);
+    history.add_samples (samples.data (), 8);
+    ASSERT_EQ (history.get_data_count (), 4);
+    double retrieved[12];
+    history.get_current_data (4, retrieved);
+    // timestamps of min and max samples are bounds of the block
+    EXPECT_THAT (std::vector<double> (retrieved, retrieved + 12),
+        ElementsAre (0.0, 0.0, 0.0, 3.0, 0.0, 3.0, 0.0, 7.0, 4.0, 3.0, 0.0, 7.0));
+}
+
+TEST (DecimatedHistoryTest, AddSamples_SeveralMarkersInBlock_FirstKeptOthersCounted)
+{
+    // rows: value, marker, markers 1, 2 and 3 in the first block
+    double samples[8] = {0.0, 1.0, 0.0, 2.0, 0.0, 0.0, 0.0, 3.0};
+    DecimatedHistory mean_history (2, 4, (int)DecimationTypes::MEAN, 4, 1);
+    mean_history.add_samples (samples, 4);
+    double retrieved[4];
+    ASSERT_EQ (mean_history.get_current_data (1, retrieved), 1);
+    EXPECT_EQ (retrieved[1], 1.0);
+    EXPECT_EQ (mean_history.get_dropped_markers (), 2);
+
+    DecimatedHistory min_max_history (2, 4, (int)DecimationTypes::MIN_MAX, 4, 1);
+    min_max_history.add_samples (samples, 4);
+    ASSERT_EQ (min_max_history.get_current_data (2, retrieved), 2);
+    EXPECT_EQ (retrieved[1], 1.0);
+    EXPECT_EQ (retrieved[3], 2.0);
+    EXPECT_EQ (min_max_history.get_dropped_markers (), 1);
+}
+
+TEST (DecimatedHistoryTest, AddSamples_NanValues_Skipped)
+{
+    DecimatedHistory history (3, 2, (int)DecimationTypes::MEAN, 4, 1);
+    double samples[12] = {1.0, 0.0, 0.0, NAN, 0.0, 1.0, NAN, 0.0, 2.0, NAN, 0.0, 3.0};
+    history.add_samples (samples, 4);
+    double retrieved[6];
+    ASSERT_EQ (history.get_current_data (2, retrieved), 2);
+    EXPECT_DOUBLE_EQ (retrieved[0], 1.0);
+    EXPECT_TRUE (isnan (retrieved[3]));
+    EXPECT_DOUBLE_EQ (retrieved[5], 2.5);
+}
+
+TEST (DecimatedHistoryTest, AddSamples_MoreThanCapacity_KeepsLatest)
+{
+    DecimatedHistory history (3, 1, (int)DecimationTypes::MEAN, 4, -1);
+    std::vector<double> samples = make_samples (10);
+    history.add_samples (samples.data (), 10);
+    EXPECT_EQ (history.get_data_count (), 4);
+    double retrieved[12];
+    history.get_current_data (4, retrieved);
+    EXPECT_DOUBLE_EQ (retrieved[2], 6.0);
+    EXPECT_DOUBLE_EQ (retrieved[11], 9.0);
+}
@@ -0,0 +1,94 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <vector>
+
+#include "data_buffer.h"
+#include "epoch_extractor.h"
+
+using namespace testing;
+
+
+// rows: value, marker
+static void push (DataBuffer &buffer, EpochExtractor &extractor, int first, int count,
+    const std::vector<int> &marker_positions, double marker)
+{
+    std::vector<double> samples;
+    for (int i = first; i < first + count; i++)
+    {
+        samples.push_back ((double)i);
+        bool is_marker = std::find (marker_positions.begin (), marker_positions.end (), i) !=
+            marker_positions.end ();
+        samples.push_back (is_marker ? marker : 0.0);
+    }
+    uint64_t first_index = buffer.get_total_count ();
+    buffer.add_data (samples.data (), (size_t)count);
+    extractor.add_samples (samples.data (), (size_t)count, first_index, &buffer);
+}
+
+TEST (EpochExtractorTest, AddSamples_PostWindowFilled_ReturnsEpochAsRows)
+{
+    DataBuffer buffer (2, 100);
+    EpochExtractor extractor ({1.0}, 2, 3, 4, 2, 1);
+    push (buffer, extractor, 0, 13, {10}, 1.0);
+    EXPECT_EQ (extractor.get_epoch_count (), 0);
+    push (buffer, extractor, 13, 1, {}, 0.0);
+    ASSERT_EQ (extractor.get_epoch_count (), 1);
+
+    std::vector<double> epoch (2 * 6);
+    EXPECT_EQ (extractor.get_epochs (10, epoch.data ()), 1);
+    EXPECT_THAT (std::vector<double> (epoch.begin (), epoch.begin () + 6),
+        ElementsAre (8.0, 9.0, 10.0, 11.0, 12.0, 13.0));
+    EXPECT_THAT (std::vector<double> (epoch.begin () + 6, epoch.end ()),
+        ElementsAre (0.0, 0.0, 1.0, 0.0, 0.0, 0.0));
+    EXPECT_EQ (extractor.get_epoch_count (), 0);
+}
+
+TEST (EpochExtractorTest, AddSamples_OtherMarkerValue_Ignored)
+{
+    DataBuffer buffer (2, 100);
+    EpochExtractor extractor ({1.0, 3.0}, 1, 1, 4, 2, 1);
+    push (buffer, extractor, 0, 10, {3}, 2.0);
+    push (buffer, extractor, 10, 10, {13}, 3.0);
+    EXPECT_EQ (extractor.get_epoch_count (), 1);
+}
+
+TEST (EpochExtractorTest, AddSamples_DrainedAndWrappedBuffer_UsesRingContents)
+{
+    DataBuffer buffer (2, 8);
+    EpochExtractor extractor ({1.0}, 3, 2, 4, 2, 1);
+    std::vector<double> drained (2 * 8);
+    for (int i = 0; i < 30; i++)
+    {
+        push (buffer, extractor, i, 1, {21}, 1.0);
+        // consumer drains buffer, epochs are still cut from ring
+        buffer.get_data (8, drained.data ());
+    }
+    std::vector<double> epoch (2 * 6);
+    ASSERT_EQ (extractor.get_epochs (1, epoch.data ()), 1);
+    EXPECT_DOUBLE_EQ (epoch[0], 18.0);
+    EXPECT_DOUBLE_EQ (epoch[5], 23.0);
+}
+
+TEST (EpochExtractorTest, AddSamples_WindowLargerThanHistory_CountsDropped)
+{
+    DataBuffer buffer (2, 8);
+    EpochExtractor extractor ({1.0}, 2, 2, 4, 2, 1);
+    // pre window is before the first sample
+    push (buffer, extractor, 0, 5, {1}, 1.0);
+    // post window arrives in a batch larger than the buffer
+    push (buffer, extractor, 5, 1, {5}, 1.0);
+    push (buffer, extractor, 6, 20, {}, 0.0);
+    EXPECT_EQ (extractor.get_epoch_count (), 0);
+    EXPECT_EQ (extractor.get_num_dropped (), 2);
+}
+
+TEST (EpochExtractorTest, AddSamples_QueueFull_KeepsNewestEpochs)
+{
+    DataBuffer buffer (2, 100);
+    EpochExtractor extractor ({1.0}, 0, 0, 2, 2, 1);
+    push (buffer, extractor, 0, 10, {2, 4, 6}, 1.0);
+    std::vector<double> epochs (2 * 2);
+    ASSERT_EQ (extractor.get_epochs (5, epochs.data ()), 2);
+    EXPECT_DOUBLE_EQ (epochs[0], 4.0);
+    EXPECT_DOUBLE_EQ (epochs[2], 6.0);
+}
@@ -0,0 +1,84 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+
+#include "latency_histogram.h"
+
+using namespace testing;
+
+
+TEST (LatencyHistogramTest, GetBucket_AllValues_BoundsContainValue)
+{
+    const int num_buckets = LatencyHistogram::num_buckets;
+    uint64_t values[] = {0, 1, 15, 16, 17, 31, 32, 1000, 123456789, 0xFFFFFFFFFFFFFFFFULL};
+    for (uint64_t value : values)
+    {
+        int bucket = LatencyHistogram::get_bucket (value);
+        ASSERT_GE (bucket, 0);
+        ASSERT_LT (bucket, num_buckets);
+        EXPECT_GE (LatencyHistogram::get_bucket_upper_bound (bucket), value);
+        if (bucket > 0)
+        {
+            EXPECT_LT (LatencyHistogram::get_bucket_upper_bound (bucket - 1), value);
+        }
+    }
+    EXPECT_EQ (LatencyHistogram::get_bucket (0xFFFFFFFFFFFFFFFFULL), num_buckets - 1);
+}
+
+TEST (LatencyHistogramTest, GetPercentile_EmptyHistogram_ReturnsZero)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ (histogram.get_count (), 0);
+    EXPECT_EQ (histogram.get_percentile (50.0), 0);
+    EXPECT_DOUBLE_EQ (histogram.get_mean (), 0.0);
+}
+
+TEST (LatencyHistogramTest, GetPercentile_UniformValues_WithinRelativeError)
+{
+    LatencyHistogram histogram;
+    for (uint64_t i = 1; i <= 10000; i++)
+    {
+        histogram.record (i * 1000);
+    }
+    EXPECT_EQ (histogram.get_count (), 10000);
+    EXPECT_EQ (histogram.get_max (), 10000000);
+    EXPECT_DOUBLE_EQ (histogram.get_mean (), 5000500.0);
+    double p50 = (double)histogram.get_percentile (50.0);
+    double p99 = (double)histogram.get_percentile (99.0);
+    EXPECT_NEAR (p50, 5000000.0, 5000000.0 * 0.125);
+    EXPECT_NEAR (p99, 9900000.0, 9900000.0 * 0.125);
+    EXPECT_EQ (histogram.get_percentile (100.0), 10000000);
+}
+
+TEST (LatencyHistogramTest, Reset_AfterRecords_ClearsEverything)
+{
+    LatencyHistogram histogram;
+    histogram.record (5);
+    histogram.record (500);
+    histogram.reset ();
+    EXPECT_EQ (histogram.get_count (), 0);
+    EXPECT_EQ (histogram.get_max (), 0);
+    EXPECT_EQ (histogram.get_percentile (99.0), 0);
+}
+
+TEST (LatencyHistogramTest, Record_ConcurrentThreads_NoLostUpdates)
+{
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back ([&histogram, t] {
+            for (int i = 0; i < 50000; i++)
+            {
+                histogram.record ((uint64_t)(t * 100 + i % 100));
+            }
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join ();
+    }
+    EXPECT_EQ (histogram.get_count (), 200000);
+    EXPECT_EQ (histogram.get_max (), 399);
+}
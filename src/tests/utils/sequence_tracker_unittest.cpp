@@ -0,0 +1,121 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include "sequence_tracker.h"
+
+using namespace testing;
+
+
+TEST (SequenceTrackerTest, Update_ConsecutiveWithWrap_NoLosses)
+{
+    SequenceTracker tracker;
+    for (int i = 0; i < 1000; i++)
+    {
+        EXPECT_EQ (tracker.update (i % 256, 8), 0);
+    }
+    EXPECT_EQ (tracker.get_received (), 1000);
+    EXPECT_EQ (tracker.get_lost (), 0);
+    EXPECT_EQ (tracker.get_duplicated (), 0);
+    EXPECT_EQ (tracker.get_reordered (), 0);
+}
+
+TEST (SequenceTrackerTest, Update_GapAcrossWrap_ReturnsLostCount)
+{
+    SequenceTracker tracker;
+    tracker.update (250, 8);
+    EXPECT_EQ (tracker.update (253, 8), 2);
+    // 254, 255, 0 and 1 are lost
+    EXPECT_EQ (tracker.update (2, 8), 4);
+    EXPECT_EQ (tracker.update (3, 8), 0);
+    EXPECT_EQ (tracker.get_received (), 4);
+    EXPECT_EQ (tracker.get_lost (), 6);
+}
+
+TEST (SequenceTrackerTest, Update_RepeatedCounter_CountsDuplicate)
+{
+    SequenceTracker tracker;
+    tracker.update (10, 8);
+    EXPECT_EQ (tracker.update (10, 8), 0);
+    EXPECT_EQ (tracker.update (11, 8), 0);
+    EXPECT_EQ (tracker.get_duplicated (), 1);
+    EXPECT_EQ (tracker.get_lost (), 0);
+}
+
+TEST (SequenceTrackerTest, Update_LatePackage_MovedFromLostToReordered)
+{
+    SequenceTracker tracker;
+    tracker.update (0, 16);
+    EXPECT_EQ (tracker.update (2, 16), 1);
+    EXPECT_EQ (tracker.update (1, 16), 0);
+    EXPECT_EQ (tracker.update (3, 16), 0);
+    EXPECT_EQ (tracker.get_received (), 4);
+    EXPECT_EQ (tracker.get_lost (), 0);
+    EXPECT_EQ (tracker.get_reordered (), 1);
+}
+
+TEST (SequenceTrackerTest, Update_RepeatedOlderCounter_CountsDuplicateAndKeepsLost)
+{
+    SequenceTracker tracker;
+    tracker.update (0, 16);
+    tracker.update (1, 16);
+    EXPECT_EQ (tracker.update (4, 16), 2);
+    // 1 was already received, 2 is late
+    EXPECT_EQ (tracker.update (1, 16), 0);
+    EXPECT_EQ (tracker.update (2, 16), 0);
+    EXPECT_EQ (tracker.update (2, 16), 0);
+    EXPECT_EQ (tracker.get_duplicated (), 2);
+    EXPECT_EQ (tracker.get_reordered (), 1);
+    EXPECT_EQ (tracker.get_lost (), 1);
+}
+
+TEST (SequenceTrackerTest, Update_CounterOlderThanWindow_CountsDuplicate)
+{
+    SequenceTracker tracker;
+    tracker.update (0, 16);
+    EXPECT_EQ (tracker.update (101, 16), 100);
+    EXPECT_EQ (tracker.update (1, 16), 0);
+    EXPECT_EQ (tracker.get_duplicated (), 1);
+    EXPECT_EQ (tracker.get_reordered (), 0);
+    EXPECT_EQ (tracker.get_lost (), 100);
+}
+
+TEST (SequenceTrackerTest, SetFillLost_MaxGap_Stored)
+{
+    SequenceTracker tracker;
+    EXPECT_EQ (tracker.get_max_fill_gap (), SequenceTracker::default_max_fill_gap);
+    tracker.set_fill_lost (true, 10);
+    EXPECT_TRUE (tracker.get_fill_lost ());
+    EXPECT_EQ (tracker.get_max_fill_gap (), 10);
+}
+
+TEST (SequenceTrackerTest, Update_ValueWiderThanCounter_IsMasked)
+{
+    SequenceTracker tracker;
+    tracker.update (0xFFFFFFFF, 32);
+    EXPECT_EQ (tracker.update (0x100000000ULL, 32), 0);
+    EXPECT_EQ (tracker.update (0x100000002ULL, 32), 1);
+    EXPECT_EQ (tracker.get_lost (), 1);
+}
+
+TEST (SequenceTrackerTest, Update_InvalidCounterBits_Ignored)
+{
+    SequenceTracker tracker;
+    EXPECT_EQ (tracker.update (1, 0), 0);
+    EXPECT_EQ (tracker.update (1, 33), 0);
+    EXPECT_EQ (tracker.get_received (), 0);
+}
+
+TEST (SequenceTrackerTest, Reset_AfterLosses_ClearsStatsAndKeepsFillMode)
+{
+    SequenceTracker tracker;
+    tracker.set_fill_lost (true);
+    tracker.update (0, 8);
+    tracker.update (5, 8);
+    tracker.reset ();
+    EXPECT_EQ (tracker.get_received (), 0);
+    EXPECT_EQ (tracker.get_lost (), 0);
+    EXPECT_TRUE (tracker.get_fill_lost ());
+    // first package after reset only sets the reference counter
+    EXPECT_EQ (tracker.update (100, 8), 0);
+    EXPECT_EQ (tracker.get_lost (), 0);
+}
@@ -0,0 +1,100 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <math.h>
+#include <vector>
+
+#include "signal_quality_monitor.h"
+
+using namespace testing;
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+
+// rows: channel 0, channel 1, timestamp
+static std::vector<double> make_samples (int count, double rate, double amplitude, double freq,
+    double offset)
+{
+    std::vector<double> samples;
+    for (int i = 0; i < count; i++)
+    {
+        double time = (double)i / rate;
+        samples.push_back (offset + amplitude * sin (2.0 * M_PI * freq * time));
+        samples.push_back (offset);
+        samples.push_back (time);
+    }
+    return samples;
+}
+
+TEST (SignalQualityMonitorTest, GetQuality_NoSamples_ReturnsNan)
+{
+    SignalQualityMonitor monitor ({0, 1}, 3, 250.0, 1.0, 100.0, 200.0, 0.5);
+    std::vector<double> quality (2 * SignalQualityMonitor::NUM_METRICS);
+    EXPECT_EQ (monitor.get_quality (quality.data ()), 2);
+    EXPECT_EQ (quality[SignalQualityMonitor::CHANNEL], 0.0);
+    EXPECT_EQ (quality[SignalQualityMonitor::NUM_METRICS + SignalQualityMonitor::CHANNEL], 1.0);
+    EXPECT_TRUE (isnan (quality[SignalQualityMonitor::STD_DEV]));
+    EXPECT_EQ (quality[SignalQualityMonitor::FLATLINE], 0.0);
+    EXPECT_EQ (quality[SignalQualityMonitor::SATURATION_COUNT], 0.0);
+}
+
+TEST (SignalQualityMonitorTest, AddSamples_LineNoise_DetectedAtMatchingFrequency)
+{
+    SignalQualityMonitor monitor ({0, 1}, 3, 250.0, 1.0, 1000.0, 2000.0, 0.5);
+    std::vector<double> samples = make_samples (500, 250.0, 10.0, 50.0, 30.0);
+    monitor.add_samples (samples.data (), 500);
+    std::vector<double> quality (2 * SignalQualityMonitor::NUM_METRICS);
+    monitor.get_quality (quality.data ());
+    EXPECT_NEAR (quality[SignalQualityMonitor::LINE_NOISE_50], 10.0, 0.5);
+    EXPECT_NEAR (quality[SignalQualityMonitor::LINE_NOISE_60], 0.0, 0.5);
+    // dc offset of 30 is not included in standard deviation
+    EXPECT_NEAR (quality[SignalQualityMonitor::STD_DEV], 10.0 / sqrt (2.0), 0.5);
+    EXPECT_EQ (quality[SignalQualityMonitor::FLATLINE], 0.0);
+    // second channel is constant
+    const double *flat = quality.data () + SignalQualityMonitor::NUM_METRICS;
+    EXPECT_NEAR (flat[SignalQualityMonitor::STD_DEV], 0.0, 1e-9);
+    EXPECT_EQ (flat[SignalQualityMonitor::FLATLINE], 1.0);
+    EXPECT_NEAR (flat[SignalQualityMonitor::LINE_NOISE_50], 0.0, 1e-9);
+}
+
+TEST (SignalQualityMonitorTest, AddSamples_RailedSignal_CountsSaturation)
+{
+    SignalQualityMonitor monitor ({0}, 3, 250.0, 1.0, 90.0, 100.0, 0.5);
+    // half of the window is railed
+    std::vector<double> samples = make_samples (125, 250.0, 0.0, 10.0, 5.0);
+    std::vector<double> railed = make_samples (125, 250.0, 0.0, 10.0, -100.0);
+    samples.insert (samples.end (), railed.begin (), railed.end ());
+    monitor.add_samples (samples.data (), 250);
+    std::vector<double> quality (SignalQualityMonitor::NUM_METRICS);
+    monitor.get_quality (quality.data ());
+    EXPECT_NEAR (quality[SignalQualityMonitor::RAILED_RATIO], 0.5, 1e-9);
+    EXPECT_EQ (quality[SignalQualityMonitor::SATURATION_COUNT], 125.0);
+
+    monitor.reset ();
+    monitor.get_quality (quality.data ());
+    EXPECT_EQ (quality[SignalQualityMonitor::SATURATION_COUNT], 0.0);
+}
+
+TEST (SignalQualityMonitorTest, AddSamples_NanSamples_Skipped)
+{
+    SignalQualityMonitor monitor ({0}, 3, 250.0, 1.0, 90.0, 100.0, 0.5);
+    std::vector<double> samples = make_samples (10, 250.0, 0.0, 10.0, 5.0);
+    samples[3 * 5] = NAN;
+    monitor.add_samples (samples.data (), 10);
+    std::vector<double> quality (SignalQualityMonitor::NUM_METRICS);
+    monitor.get_quality (quality.data ());
+    EXPECT_NEAR (quality[SignalQualityMonitor::STD_DEV], 0.0, 1e-9);
+    EXPECT_EQ (quality[SignalQualityMonitor::RAILED_RATIO], 0.0);
+}
+
+TEST (SignalQualityMonitorTest, Constructor_LowSamplingRate_LineNoiseUnsupported)
+{
+    SignalQualityMonitor monitor ({0}, 3, 100.0, 1.0, 90.0, 100.0, 0.5);
+    std::vector<double> samples = make_samples (200, 100.0, 1.0, 10.0, 0.0);
+    monitor.add_samples (samples.data (), 200);
+    std::vector<double> quality (SignalQualityMonitor::NUM_METRICS);
+    monitor.get_quality (quality.data ());
+    EXPECT_TRUE (isnan (quality[SignalQualityMonitor::LINE_NOISE_50]));
+    EXPECT_TRUE (isnan (quality[SignalQualityMonitor::LINE_NOISE_60]));
+}
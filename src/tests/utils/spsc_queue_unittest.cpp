@@ -0,0 +1,82 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+
+#include "spsc_queue.h"
+
+using namespace testing;
+
+
+TEST (SPSCQueueTest, Constructor_NotPowerOfTwo_RoundsCapacityUp)
+{
+    SPSCQueue<int> queue (100);
+    EXPECT_EQ (queue.get_capacity (), 128);
+    EXPECT_EQ (queue.size (), 0);
+    EXPECT_EQ (queue.front (), nullptr);
+}
+
+TEST (SPSCQueueTest, Push_FullQueue_ReturnsFalse)
+{
+    SPSCQueue<int> queue (4);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE (queue.push (i));
+    }
+    EXPECT_FALSE (queue.push (4));
+    EXPECT_EQ (queue.claim (), nullptr);
+    EXPECT_EQ (queue.size (), 4);
+
+    queue.pop ();
+    EXPECT_TRUE (queue.push (4));
+    for (int i = 1; i < 5; i++)
+    {
+        ASSERT_NE (queue.front (), nullptr);
+        EXPECT_EQ (*queue.front (), i);
+        queue.pop ();
+    }
+    EXPECT_EQ (queue.front (), nullptr);
+}
+
+TEST (SPSCQueueTest, ClaimPublish_UnpublishedSlot_InvisibleToConsumer)
+{
+    SPSCQueue<std::vector<int>> queue (2);
+    std::vector<int> *slot = queue.claim ();
+    ASSERT_NE (slot, nullptr);
+    slot->assign (3, 7);
+    EXPECT_EQ (queue.front (), nullptr);
+    queue.publish ();
+    ASSERT_NE (queue.front (), nullptr);
+    EXPECT_THAT (*queue.front (), ElementsAre (7, 7, 7));
+}
+
+TEST (SPSCQueueTest, PushPop_ConcurrentProducer_KeepsOrderWithoutLosses)
+{
+    const int num_elements = 200000;
+    SPSCQueue<int> queue (64);
+    std::thread producer ([&queue] {
+        for (int i = 0; i < num_elements; i++)
+        {
+            while (!queue.push (i))
+            {
+                std::this_thread::yield ();
+            }
+        }
+    });
+
+    int expected = 0;
+    while (expected < num_elements)
+    {
+        int *value = queue.front ();
+        if (value == nullptr)
+        {
+            std::this_thread::yield ();
+            continue;
+        }
+        ASSERT_EQ (*value, expected);
+        queue.pop ();
+        expected++;
+    }
+    producer.join ();
+    EXPECT_EQ (queue.size (), 0);
+}
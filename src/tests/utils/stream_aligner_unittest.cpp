@@ -0,0 +1,107 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <math.h>
+#include <vector>
+
+#include "stream_aligner.h"
+
+using namespace testing;
+
+
+// rows: value, timestamp, marker
+static std::vector<double> make_data (
+    int num_samples, double start, double rate, double jitter, int first_index = 0)
+{
+    std::vector<double> data (3 * num_samples, 0.0);
+    for (int i = 0; i < num_samples; i++)
+    {
+        int index = first_index + i;
+        data[i] = (double)index;
+        // alternating arrival jitter
+        data[num_samples + i] = start + index / rate + ((index % 2 == 0) ? jitter : -jitter);
+    }
+    return data;
+}
+
+TEST (StreamAlignerTest, AddSamples_JitteredTimestamps_FitRemovesJitter)
+{
+    StreamAligner aligner (3, 1, 2, 100.0);
+    std::vector<double> data = make_data (1000, 50.0, 100.0, 0.004);
+    aligner.add_samples (data.data (), 1000);
+    EXPECT_NEAR (aligner.get_estimated_rate (), 100.0, 0.01);
+    EXPECT_NEAR (aligner.get_start_time (), 50.0, 0.001);
+    EXPECT_NEAR (aligner.get_last_time (), 50.0 + 999 / 100.0, 0.001);
+
+    // value is equal to sample index, so interpolation at time t returns (t - start) * rate
+    double output[2];
+    ASSERT_TRUE (aligner.get_values (55.005, output));
+    EXPECT_NEAR (output[0], 500.5, 0.2);
+    EXPECT_EQ (output[1], 0.0);
+    EXPECT_FALSE (aligner.get_values (aligner.get_last_time () + 1.0, output));
+}
+
+TEST (StreamAlignerTest, GetValues_Marker_ReturnedOnceAtFirstTimeAfterIt)
+{
+    StreamAligner aligner (3, 1, 2, 10.0);
+    std::vector<double> data = make_data (10, 0.0, 10.0, 0.0);
+    data[2 * 10 + 3] = 7.0;
+    aligner.add_samples (data.data (), 10);
+    double output[2];
+    ASSERT_TRUE (aligner.get_values (0.25, output));
+    EXPECT_EQ (output[1], 0.0);
+    ASSERT_TRUE (aligner.get_values (0.35, output));
+    EXPECT_EQ (output[1], 7.0);
+    ASSERT_TRUE (aligner.get_values (0.45, output));
+    EXPECT_EQ (output[1], 0.0);
+}
+
+TEST (StreamAlignerTest, AddSamples_PlaceholderPackages_GetExtrapolatedTime)
+{
+    StreamAligner aligner (3, 1, 2, 10.0);
+    std::vector<double> data = make_data (20, 0.0, 10.0, 0.0);
+    for (int i = 10; i < 15; i++)
+    {
+        data[i] = NAN;
+        data[20 + i] = NAN;
+        data[40 + i] = NAN;
+    }
+    aligner.add_samples (data.data (), 20);
+    double output[2];
+    ASSERT_TRUE (aligner.get_values (1.85, output));
+    EXPECT_NEAR (output[0], 18.5, 1e-6);
+    EXPECT_NEAR (aligner.get_estimated_rate (), 10.0, 1e-6);
+}
+
+TEST (StreamAlignerTest, AddSamples_SeveralBatches_SameAsSingleBatch)
+{
+    StreamAligner single (3, 1, 2, 250.0);
+    StreamAligner batched (3, 1, 2, 250.0);
+    std::vector<double> data = make_data (100, 10.0, 250.0, 0.001);
+    single.add_samples (data.data (), 100);
+    for (int i = 0; i < 100; i += 25)
+    {
+        std::vector<double> batch = make_data (25, 10.0, 250.0, 0.001, i);
+        batched.add_samples (batch.data (), 25);
+    }
+    EXPECT_DOUBLE_EQ (single.get_last_time (), batched.get_last_time ());
+    EXPECT_DOUBLE_EQ (single.get_start_time (), batched.get_start_time ());
+}
+
+TEST (StreamAlignerTest, AddSamples_OverMaxBufferedTime_OldestDroppedWithMarkers)
+{
+    StreamAligner aligner (3, 1, 2, 10.0, 30.0, 2.0);
+    std::vector<double> data = make_data (50, 0.0, 10.0, 0.0);
+    data[2 * 50 + 5] = 3.0;
+    data[2 * 50 + 45] = 4.0;
+    aligner.add_samples (data.data (), 50);
+    // 2 seconds at 10 hz, the last 20 samples are kept
+    EXPECT_NEAR (aligner.get_first_time (), 3.0, 1e-6);
+    EXPECT_NEAR (aligner.get_last_time (), 4.9, 1e-6);
+    double output[2];
+    EXPECT_FALSE (aligner.get_values (2.5, output));
+    ASSERT_TRUE (aligner.get_values (3.0, output));
+    EXPECT_NEAR (output[0], 30.0, 1e-6);
+    EXPECT_EQ (output[1], 0.0);
+    ASSERT_TRUE (aligner.get_values (4.55, output));
+    EXPECT_EQ (output[1], 4.0);
+}
@@ -0,0 +1,48 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <math.h>
+#include <vector>
+
+#include "uniform_noise.h"
+
+using namespace testing;
+
+
+TEST (UniformNoiseTest, Fill_LargeBuffer_StaysInRangeWithZeroMean)
+{
+    UniformNoise noise (42);
+    std::vector<double> values (100003);
+    noise.fill (values.data (), (int)values.size (), 5.0);
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    for (double value : values)
+    {
+        ASSERT_GE (value, -5.0);
+        ASSERT_LT (value, 5.0);
+        sum += value;
+        sum_squares += value * value;
+    }
+    double mean = sum / values.size ();
+    double variance = sum_squares / values.size () - mean * mean;
+    EXPECT_NEAR (mean, 0.0, 0.05);
+    // variance of uniform distribution in [-a, a) is a^2 / 3
+    EXPECT_NEAR (variance, 25.0 / 3.0, 0.1);
+}
+
+TEST (UniformNoiseTest, Fill_SameSeed_SameSequence)
+{
+    UniformNoise first (7);
+    UniformNoise second (7);
+    UniformNoise other (8);
+    std::vector<double> first_values (37);
+    std::vector<double> second_values (37);
+    std::vector<double> other_values (37);
+    for (int i = 0; i < 3; i++)
+    {
+        first.fill (first_values.data (), 37, 1.0);
+        second.fill (second_values.data (), 37, 1.0);
+        other.fill (other_values.data (), 37, 1.0);
+        EXPECT_THAT (first_values, ElementsAreArray (second_values));
+        EXPECT_NE (first_values[0], other_values[0]);
+    }
+}
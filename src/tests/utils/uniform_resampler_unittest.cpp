@@ -0,0 +1,135 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <math.h>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "uniform_resampler.h"
+
+using namespace testing;
+
+
+// rows: package num, value, timestamp
+static std::vector<std::vector<double>> resample (
+    UniformResampler &resampler, const std::vector<double> &timestamps)
+{
+    std::vector<std::vector<double>> result;
+    for (size_t i = 0; i < timestamps.size (); i++)
+    {
+        double package[3] = {(double)i, (double)i, timestamps[i]};
+        if (isnan (timestamps[i]))
+        {
+            package[0] = NAN;
+            package[1] = NAN;
+        }
+        resampler.add_sample (package);
+        while (double *output = resampler.next ())
+        {
+            result.push_back (std::vector<double> (output, output + 3));
+        }
+    }
+    return result;
+}
+
+TEST (UniformResamplerTest, AddSample_JitteredTimestamps_ReturnsExactGrid)
+{
+    UniformResampler resampler (3, 2, 0, 100.0, (int)ResamplingTypes::LINEAR);
+    std::vector<double> timestamps;
+    for (int i = 0; i < 1000; i++)
+    {
+        // arrival jitter up to 3 ms
+        timestamps.push_back (10.0 + i * 0.01 + 0.003 * ((i * 7) % 5) / 4.0);
+    }
+    std::vector<std::vector<double>> result = resample (resampler, timestamps);
+    ASSERT_GT (result.size (), 990u);
+    for (size_t i = 1; i < result.size (); i++)
+    {
+        EXPECT_NEAR (result[i][2] - result[i - 1][2], 0.01, 1e-9);
+        EXPECT_NEAR (result[i][1] - result[i - 1][1], 1.0, 0.05);
+        EXPECT_FALSE (isnan (result[i][1]));
+    }
+}
+
+TEST (UniformResamplerTest, AddSample_TimestampJump_ReturnsGapSamples)
+{
+    UniformResampler resampler (3, 2, 0, 100.0, (int)ResamplingTypes::LINEAR);
+    std::vector<double> timestamps;
+    for (int i = 0; i < 10; i++)
+    {
+        timestamps.push_back (i * 0.01);
+    }
+    // 0.5 seconds without data
+    for (int i = 0; i < 10; i++)
+    {
+        timestamps.push_back (0.59 + i * 0.01);
+    }
+    std::vector<std::vector<double>> result = resample (resampler, timestamps);
+    int num_gaps = 0;
+    for (size_t i = 0; i < result.size (); i++)
+    {
+        EXPECT_NEAR (result[i][2], i * 0.01, 1e-9);
+        if (isnan (result[i][1]))
+        {
+            num_gaps++;
+        }
+    }
+    EXPECT_EQ (num_gaps, 50);
+    EXPECT_EQ (result.size (), 68u);
+    EXPECT_DOUBLE_EQ (result.back ()[1], 18.0);
+}
+
+TEST (UniformResamplerTest, AddSample_Placeholder_MarksNeighbourGridPoints)
+{
+    UniformResampler resampler (3, 2, 0, 100.0, (int)ResamplingTypes::LINEAR);
+    std::vector<double> timestamps;
+    for (int i = 0; i < 20; i++)
+    {
+        timestamps.push_back ((i == 10) ? NAN : i * 0.01);
+    }
+    std::vector<std::vector<double>> result = resample (resampler, timestamps);
+    ASSERT_GE (result.size (), 19u);
+    for (size_t i = 0; i < result.size (); i++)
+    {
+        EXPECT_NEAR (result[i][2], i * 0.01, 1e-9);
+        EXPECT_EQ (isnan (result[i][1]), (i == 9) || (i == 10));
+    }
+}
+
+TEST (UniformResamplerTest, AddSample_CubicSine_CloserThanLinear)
+{
+    UniformResampler linear (3, 2, -1, 100.0, (int)ResamplingTypes::LINEAR);
+    UniformResampler cubic (3, 2, -1, 100.0, (int)ResamplingTypes::CUBIC);
+    double linear_error = 0.0;
+    double cubic_error = 0.0;
+    int num_cubic = 0;
+    for (int i = 0; i < 1500; i++)
+    {
+        // device clock is 2% slower, grid points fall between samples
+        double time = i * 0.0102;
+        double package[3] = {0.0, sin (2.0 * M_PI * 5.0 * time), time};
+        linear.add_sample (package);
+        cubic.add_sample (package);
+        // skip adaptation to device clock
+        bool is_adapted = time > 10.0;
+        while (double *output = linear.next ())
+        {
+            if (is_adapted)
+            {
+                linear_error = std::max (
+                    linear_error, fabs (output[1] - sin (2.0 * M_PI * 5.0 * output[2])));
+            }
+        }
+        while (double *output = cubic.next ())
+        {
+            if (is_adapted)
+            {
+                cubic_error = std::max (
+                    cubic_error, fabs (output[1] - sin (2.0 * M_PI * 5.0 * output[2])));
+            }
+            num_cubic++;
+        }
+    }
+    EXPECT_GT (num_cubic, 1500);
+    EXPECT_LT (cubic_error, 0.01);
+    EXPECT_LT (cubic_error, linear_error);
+}
@@ -1,5 +1,7 @@
 #include "data_buffer.h"
 
+#include <algorithm>
+#include <math.h>
 #include <new>
 
 DataBuffer::DataBuffer (int num_samples, size_t buffer_size)
@@ -7,6 +9,7 @@ DataBuffer::DataBuffer (int num_samples, size_t buffer_size)
     this->buffer_size = buffer_size;
     this->num_samples = num_samples;
     first_free = first_used = count = 0;
+    total_count = 0;
 
     if (buffer_size == 0)
     {
@@ -44,11 +47,7 @@ void DataBuffer::add_data (double *value)
 
     lock.lock ();
 
-    if (count == 0)
-    {
-        first_used = first_free = 0;
-    }
-    else if (first_free == first_used)
+    if ((count != 0) && (first_free == first_used))
     {
         first_used = next (first_used);
         count--;
@@ -57,6 +56,47 @@ void DataBuffer::add_data (double *value)
     memcpy (this->data + first_free * num_samples, value, sizeof (double) * num_samples);
     first_free = next (first_free);
     count++;
+    total_count++;
+
+    lock.unlock ();
+}
+
+void DataBuffer::add_data (double *values, size_t count)
+{
+    if ((!is_ready ()) || (count == 0))
+    {
+        return;
+    }
+    lock.lock ();
+
+    // only last buffer_size samples can be stored, skipped ones still take their positions
+    if (count > buffer_size)
+    {
+        size_t num_skipped = count - buffer_size;
+        values += num_skipped * num_samples;
+        first_free = (first_free + num_skipped) % buffer_size;
+        total_count += num_skipped;
+        this->count = buffer_size;
+        count = buffer_size;
+    }
+
+    size_t first_half = buffer_size - first_free;
+    if (first_half > count)
+    {
+        first_half = count;
+    }
+    memcpy (
+        this->data + first_free * num_samples, values, sizeof (double) * num_samples * first_half);
+    memcpy (this->data, values + first_half * num_samples,
+        sizeof (double) * num_samples * (count - first_half));
+    first_free = (first_free + count) % buffer_size;
+    total_count += count;
+    this->count += count;
+    if (this->count > buffer_size)
+    {
+        this->count = buffer_size;
+    }
+    first_used = (first_free + buffer_size - this->count) % buffer_size;
 
     lock.unlock ();
 }
@@ -112,6 +152,64 @@ size_t DataBuffer::get_current_data (size_t max_count, double *data_buf)
     return result_count;
 }
 
+size_t DataBuffer::find_time (double time, int timestamp_channel, bool is_upper)
+{
+    // binary search over logical indexes [0, count), placeholders of lost samples have NaN time
+    size_t low = 0;
+    size_t high = count;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        size_t valid = middle;
+        double sample_time = NAN;
+        while ((valid < high) && (isnan (sample_time)))
+        {
+            sample_time = data[((first_used + valid) % buffer_size) * num_samples +
+                timestamp_channel];
+            valid++;
+        }
+        if (isnan (sample_time))
+        {
+            high = middle;
+        }
+        else if ((sample_time < time) || ((is_upper) && (sample_time == time)))
+        {
+            low = valid;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+size_t DataBuffer::get_data_by_time (double start_time, double end_time, int timestamp_channel,
+    size_t max_count, bool remove, double *data_buf)
+{
+    if ((!is_ready ()) || (timestamp_channel < 0) || ((size_t)timestamp_channel >= num_samples))
+    {
+        return 0;
+    }
+    lock.lock ();
+    size_t first = find_time (start_time, timestamp_channel, false);
+    size_t last = find_time (end_time, timestamp_channel, true);
+    size_t result_count = 0;
+    if (last > first)
+    {
+        result_count = std::min (last - first, max_count);
+        get_chunk ((first_used + first) % buffer_size, result_count, data_buf);
+    }
+    if (remove)
+    {
+        size_t num_removed = first + result_count;
+        first_used = (first_used + num_removed) % buffer_size;
+        count -= num_removed;
+    }
+    lock.unlock ();
+    return result_count;
+}
+
 size_t DataBuffer::get_data_count ()
 {
     lock.lock ();
@@ -119,3 +217,80 @@ size_t DataBuffer::get_data_count ()
     lock.unlock ();
     return result;
 }
+
+uint64_t DataBuffer::get_total_count ()
+{
+    lock.lock ();
+    uint64_t result = total_count;
+    lock.unlock ();
+    return result;
+}
+
+bool DataBuffer::get_samples (uint64_t first_index, size_t count, double *data_buf)
+{
+    if ((!is_ready ()) || (count == 0) || (count > buffer_size))
+    {
+        return false;
+    }
+    lock.lock ();
+    bool is_stored = (first_index + count <= total_count) &&
+        (first_index + buffer_size >= total_count);
+    if (is_stored)
+    {
+        get_chunk ((size_t)(first_index % buffer_size), count, data_buf);
+    }
+    lock.unlock ();
+    return is_stored;
+}
+
+bool DataBuffer::resize (size_t new_size)
+{
+    if ((!is_ready ()) || (new_size == 0))
+    {
+        return false;
+    }
+    double *new_data = NULL;
+    try
+    {
+        new_data = new double[new_size * num_samples];
+    }
+    catch (const std::bad_alloc &)
+    {
+        return false;
+    }
+
+    lock.lock ();
+    // all samples still in memory are kept, including already returned by get_data, so
+    // get_samples works across resize
+    size_t num_kept = (size_t)std::min ((uint64_t)std::min (buffer_size, new_size), total_count);
+    if (num_kept > 0)
+    {
+        uint64_t first_index = total_count - num_kept;
+        size_t source = (size_t)(first_index % buffer_size);
+        size_t dest = (size_t)(first_index % new_size);
+        size_t first_half = std::min (num_kept, new_size - dest);
+        get_chunk (source, first_half, new_data + dest * num_samples);
+        if (num_kept > first_half)
+        {
+            get_chunk ((source + first_half) % buffer_size, num_kept - first_half, new_data);
+        }
+    }
+    double *old_data = data;
+    data = new_data;
+    buffer_size = new_size;
+    count = std::min (count, new_size);
+    first_free = (size_t)(total_count % new_size);
+    first_used = (first_free + new_size - count) % new_size;
+    lock.unlock ();
+
+    delete[] old_data;
+    return true;
+}
+
+size_t DataBuffer::get_buffer_size ()
+{
+    lock.lock ();
+    size_t result = buffer_size;
+    lock.unlock ();
+    return result;
+}
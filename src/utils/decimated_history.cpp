@@ -0,0 +1,115 @@
+#include <limits>
+#include <math.h>
+
+#include "brainflow_constants.h"
+#include "decimated_history.h"
+
+
+DecimatedHistory::DecimatedHistory (
+    int num_rows, int ratio, int method, size_t capacity, int marker_channel)
+    : db (num_rows, capacity)
+{
+    this->num_rows = num_rows;
+    this->ratio = ratio;
+    this->method = method;
+    this->marker_channel = marker_channel;
+    dropped_markers = 0;
+    sums.resize (num_rows);
+    counts.resize (num_rows);
+    mins.resize (num_rows);
+    maxs.resize (num_rows);
+    output.resize ((size_t)num_rows * 2);
+    start_block ();
+}
+
+void DecimatedHistory::start_block ()
+{
+    block_pos = 0;
+    markers[0] = 0.0;
+    markers[1] = 0.0;
+    num_markers = 0;
+    for (int i = 0; i < num_rows; i++)
+    {
+        sums[i] = 0.0;
+        counts[i] = 0;
+        mins[i] = std::numeric_limits<double>::infinity ();
+        maxs[i] = -std::numeric_limits<double>::infinity ();
+    }
+}
+
+void DecimatedHistory::add_samples (const double *samples, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const double *sample = samples + i * num_rows;
+        for (int j = 0; j < num_rows; j++)
+        {
+            double value = sample[j];
+            if (isnan (value))
+            {
+                continue;
+            }
+            sums[j] += value;
+            counts[j]++;
+            if (value < mins[j])
+            {
+                mins[j] = value;
+            }
+            if (value > maxs[j])
+            {
+                maxs[j] = value;
+            }
+        }
+        if ((marker_channel >= 0) && (sample[marker_channel] != 0.0))
+        {
+            int max_markers = (method == (int)DecimationTypes::MIN_MAX) ? 2 : 1;
+            if (num_markers < max_markers)
+            {
+                markers[num_markers++] = sample[marker_channel];
+            }
+            else
+            {
+                dropped_markers++;
+            }
+        }
+        block_pos++;
+        if (block_pos == ratio)
+        {
+            finish_block ();
+            start_block ();
+        }
+    }
+}
+
+void DecimatedHistory::finish_block ()
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN ();
+    if (method == (int)DecimationTypes::MIN_MAX)
+    {
+        double *min_sample = output.data ();
+        double *max_sample = output.data () + num_rows;
+        for (int i = 0; i < num_rows; i++)
+        {
+            min_sample[i] = (counts[i] == 0) ? nan : mins[i];
+            max_sample[i] = (counts[i] == 0) ? nan : maxs[i];
+        }
+        if (marker_channel >= 0)
+        {
+            min_sample[marker_channel] = markers[0];
+            max_sample[marker_channel] = markers[1];
+        }
+        db.add_data (output.data (), 2);
+    }
+    else
+    {
+        for (int i = 0; i < num_rows; i++)
+        {
+            output[i] = (counts[i] == 0) ? nan : sums[i] / counts[i];
+        }
+        if (marker_channel >= 0)
+        {
+            output[marker_channel] = markers[0];
+        }
+        db.add_data (output.data ());
+    }
+}
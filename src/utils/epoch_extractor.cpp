@@ -0,0 +1,105 @@
+#include <algorithm>
+
+#include "epoch_extractor.h"
+
+
+EpochExtractor::EpochExtractor (const std::vector<double> &marker_values, int pre_samples,
+    int post_samples, int max_epochs, int num_rows, int marker_channel)
+{
+    this->marker_values = marker_values;
+    this->pre_samples = pre_samples;
+    this->post_samples = post_samples;
+    this->max_epochs = max_epochs;
+    this->num_rows = num_rows;
+    this->marker_channel = marker_channel;
+    epochs.resize ((size_t)max_epochs * get_epoch_size () * num_rows);
+    first_epoch = 0;
+    num_epochs = 0;
+    num_dropped = 0;
+}
+
+void EpochExtractor::reset ()
+{
+    pending.clear ();
+    std::lock_guard<std::mutex> lock (mutex);
+    first_epoch = 0;
+    num_epochs = 0;
+    num_dropped = 0;
+}
+
+void EpochExtractor::add_samples (
+    const double *samples, size_t count, uint64_t first_index, DataBuffer *db)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        double marker = samples[i * num_rows + marker_channel];
+        if ((marker != 0.0) &&
+            (std::find (marker_values.begin (), marker_values.end (), marker) !=
+                marker_values.end ()))
+        {
+            pending.push_back (first_index + i);
+        }
+    }
+
+    uint64_t next_index = first_index + count;
+    const size_t epoch_size = (size_t)get_epoch_size ();
+    while ((!pending.empty ()) && (pending.front () + post_samples < next_index))
+    {
+        uint64_t marker_index = pending.front ();
+        pending.pop_front ();
+        std::lock_guard<std::mutex> lock (mutex);
+        // if queue is full slot of the oldest epoch is reused
+        int slot = (first_epoch + num_epochs) % max_epochs;
+        // window is contiguous in ring buffer, so it takes at most two copies
+        if ((marker_index < (uint64_t)pre_samples) ||
+            (!db->get_samples (marker_index - pre_samples, epoch_size,
+                epochs.data () + (size_t)slot * epoch_size * num_rows)))
+        {
+            num_dropped++;
+            continue;
+        }
+        if (num_epochs == max_epochs)
+        {
+            first_epoch = (first_epoch + 1) % max_epochs;
+        }
+        else
+        {
+            num_epochs++;
+        }
+    }
+}
+
+int EpochExtractor::get_epochs (int max_epochs, double *data_buf)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    int result = std::min (max_epochs, num_epochs);
+    const size_t epoch_size = (size_t)get_epoch_size ();
+    for (int i = 0; i < result; i++)
+    {
+        const double *epoch = epochs.data () + (size_t)first_epoch * epoch_size * num_rows;
+        double *output = data_buf + (size_t)i * epoch_size * num_rows;
+        // samples are stored one after another, transpose to rows
+        for (size_t j = 0; j < epoch_size; j++)
+        {
+            for (int k = 0; k < num_rows; k++)
+            {
+                output[k * epoch_size + j] = epoch[j * num_rows + k];
+            }
+        }
+        first_epoch = (first_epoch + 1) % this->max_epochs;
+        num_epochs--;
+    }
+    return result;
+}
+
+int EpochExtractor::get_epoch_count ()
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    return num_epochs;
+}
+
+int64_t EpochExtractor::get_num_dropped ()
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    return num_dropped;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BRAINFLOW_CONVERSION_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define BRAINFLOW_CONVERSION_NEON
+#endif
+
+
+// converts 4 values per iteration with simd instructions if available, tail and other platforms use
+// plain loop, no alignment requirements for src and dst
+inline void convert_double_to_float (const double *src, float *dst, size_t len)
+{
+    size_t i = 0;
+#if defined(BRAINFLOW_CONVERSION_SSE2)
+    for (; i + 4 <= len; i += 4)
+    {
+        __m128 low = _mm_cvtpd_ps (_mm_loadu_pd (src + i));
+        __m128 high = _mm_cvtpd_ps (_mm_loadu_pd (src + i + 2));
+        _mm_storeu_ps (dst + i, _mm_movelh_ps (low, high));
+    }
+#elif defined(BRAINFLOW_CONVERSION_NEON)
+    for (; i + 4 <= len; i += 4)
+    {
+        float32x2_t low = vcvt_f32_f64 (vld1q_f64 (src + i));
+        float32x2_t high = vcvt_f32_f64 (vld1q_f64 (src + i + 2));
+        vst1q_f32 (dst + i, vcombine_f32 (low, high));
+    }
+#endif
+    for (; i < len; i++)
+    {
+        dst[i] = (float)src[i];
+    }
+}
+
+inline void convert_float_to_double (const float *src, double *dst, size_t len)
+{
+    size_t i = 0;
+#if defined(BRAINFLOW_CONVERSION_SSE2)
+    for (; i + 4 <= len; i += 4)
+    {
+        __m128 values = _mm_loadu_ps (src + i);
+        _mm_storeu_pd (dst + i, _mm_cvtps_pd (values));
+        _mm_storeu_pd (dst + i + 2, _mm_cvtps_pd (_mm_movehl_ps (values, values)));
+    }
+#elif defined(BRAINFLOW_CONVERSION_NEON)
+    for (; i + 4 <= len; i += 4)
+    {
+        float32x4_t values = vld1q_f32 (src + i);
+        vst1q_f64 (dst + i, vcvt_f64_f32 (vget_low_f32 (values)));
+        vst1q_f64 (dst + i + 2, vcvt_high_f64_f32 (values));
+    }
+#endif
+    for (; i < len; i++)
+    {
+        dst[i] = (double)src[i];
+    }
+}
+
+// decodes len signed big endian 24 bit values stored one after another and multiplies each by its
+// scale, bytes are gathered with scalar loads since sse2 and neon have no byte shuffle across
+// 3 byte fields, sign extension, conversion and scaling run 4 values per iteration
+inline void convert_int24_to_double (
+    const unsigned char *src, const double *scales, double *dst, size_t len)
+{
+    size_t i = 0;
+#if defined(BRAINFLOW_CONVERSION_SSE2) || defined(BRAINFLOW_CONVERSION_NEON)
+    for (; i + 4 <= len; i += 4)
+    {
+        // value is placed in upper 24 bits, arithmetic shift right restores the sign
+        int32_t raw[4];
+        for (int j = 0; j < 4; j++)
+        {
+            const unsigned char *value = src + (i + j) * 3;
+            raw[j] = (int32_t)(((uint32_t)value[0] << 24) | ((uint32_t)value[1] << 16) |
+                ((uint32_t)value[2] << 8));
+        }
+#if defined(BRAINFLOW_CONVERSION_SSE2)
+        __m128i values = _mm_srai_epi32 (_mm_loadu_si128 ((const __m128i *)raw), 8);
+        __m128d low = _mm_cvtepi32_pd (values);
+        __m128d high = _mm_cvtepi32_pd (_mm_shuffle_epi32 (values, _MM_SHUFFLE (1, 0, 3, 2)));
+        _mm_storeu_pd (dst + i, _mm_mul_pd (low, _mm_loadu_pd (scales + i)));
+        _mm_storeu_pd (dst + i + 2, _mm_mul_pd (high, _mm_loadu_pd (scales + i + 2)));
+#else
+        int32x4_t values = vshrq_n_s32 (vld1q_s32 (raw), 8);
+        float64x2_t low = vcvtq_f64_s64 (vmovl_s32 (vget_low_s32 (values)));
+        float64x2_t high = vcvtq_f64_s64 (vmovl_s32 (vget_high_s32 (values)));
+        vst1q_f64 (dst + i, vmulq_f64 (low, vld1q_f64 (scales + i)));
+        vst1q_f64 (dst + i + 2, vmulq_f64 (high, vld1q_f64 (scales + i + 2)));
+#endif
+    }
+#endif
+    for (; i < len; i++)
+    {
+        const unsigned char *value = src + i * 3;
+        int32_t raw = (int32_t)(((uint32_t)value[0] << 24) | ((uint32_t)value[1] << 16) |
+            ((uint32_t)value[2] << 8));
+        dst[i] = scales[i] * (double)(raw >> 8);
+    }
+}
@@ -97,9 +97,10 @@ enum class BoardIds : int
     OB3000_24_CHANNELS_BOARD = 63,
     BIOLISTENER_BOARD = 64,
     CERELOG_X8_BOARD = 65,
+    SYNTHETIC_LOAD_BOARD = 66,
     // use it to iterate
     FIRST = PLAYBACK_FILE_BOARD,
-    LAST = BIOLISTENER_BOARD
+    LAST = SYNTHETIC_LOAD_BOARD
 };
 
 enum class IpProtocolTypes : int
@@ -152,7 +153,8 @@ enum class BrainFlowClassifiers : int
 {
     DEFAULT_CLASSIFIER = 0,
     DYN_LIB_CLASSIFIER = 1,
-    ONNX_CLASSIFIER = 2
+    ONNX_CLASSIFIER = 2,
+    LINEAR_CLASSIFIER = 3
 };
 
 enum class BrainFlowPresets : int
@@ -255,3 +257,16 @@ enum class WaveletTypes : int
     FIRST_WAVELET = HAAR,
     LAST_WAVELET = SYM10
 };
+
+enum class ResamplingTypes : int
+{
+    NONE = 0,
+    LINEAR = 1,
+    CUBIC = 2
+};
+
+enum class DecimationTypes : int
+{
+    MEAN = 0,
+    MIN_MAX = 1
+};
@@ -122,6 +122,28 @@ inline int32_t cast_ganglion_bits_to_int32 (const unsigned char *array)
     return result;
 }
 
+// same as cast_ganglion_bits_to_int32 but reads N bits (MSB first) starting at bit_offset directly
+// from the packed byte array, N should not exceed 25 to fit in a single 32 bit load
+template <unsigned int N>
+inline int32_t cast_ganglion_packed_bits_to_int32 (const unsigned char *byte_array, int bit_offset)
+{
+    const int first_byte = bit_offset >> 3;
+    const int last_byte = (bit_offset + (int)N - 1) >> 3;
+    uint32_t word = 0;
+    for (int i = first_byte; i <= last_byte; i++)
+    {
+        word = (word << 8) | byte_array[i];
+    }
+    const uint32_t mask = (1u << N) - 1;
+    uint32_t bits = (word >> ((last_byte + 1) * 8 - bit_offset - (int)N)) & mask;
+    if (bits & (1u << (N - 1)))
+    {
+        // same quirk as above: flip bits and add 2
+        return -(int32_t)((~bits) & mask) - 2;
+    }
+    return (int32_t)bits;
+}
+
 inline std::string int_to_string (int val)
 {
     std::ostringstream ss;
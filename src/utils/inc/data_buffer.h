@@ -1,6 +1,7 @@
 #pragma once
 
 #include "spinlock.h"
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -14,6 +15,8 @@ class DataBuffer
     size_t first_used, first_free;
     size_t count;
     size_t num_samples;
+    // samples added since creation, sample with absolute index i is stored at i % buffer_size
+    uint64_t total_count;
 
     size_t next (size_t index)
     {
@@ -21,14 +24,31 @@ class DataBuffer
     }
 
     void get_chunk (size_t start, size_t size, double *data_buf);
+    // index of the first stored sample with timestamp not less than time (or greater if
+    // is_upper), NaN timestamps take time of the next valid sample, lock should be acquired
+    size_t find_time (double time, int timestamp_channel, bool is_upper);
 
 public:
     DataBuffer (int num_samples, size_t buffer_size);
     ~DataBuffer ();
 
     void add_data (double *value);
+    // adds count samples stored one after another under a single lock
+    void add_data (double *values, size_t count);
     size_t get_data (size_t max_count, double *data_buf);
     size_t get_current_data (size_t max_count, double *data_buf);
+    // samples with timestamps inside [start_time, end_time], timestamps should not decrease, if
+    // remove is true returned samples and all samples before them are removed
+    size_t get_data_by_time (double start_time, double end_time, int timestamp_channel,
+        size_t max_count, bool remove, double *data_buf);
     size_t get_data_count ();
+    uint64_t get_total_count ();
+    // copies samples by absolute index regardless of get_data calls, returns false if some of
+    // them are not added yet or already overwritten
+    bool get_samples (uint64_t first_index, size_t count, double *data_buf);
+    // changes capacity keeping the latest samples and absolute indexes, memory is allocated
+    // before lock so writers wait only for a copy of at most min (old, new) size samples
+    bool resize (size_t new_size);
+    size_t get_buffer_size ();
     bool is_ready ();
 };
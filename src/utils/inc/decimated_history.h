@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "data_buffer.h"
+
+
+// long history of the preset at reduced rate, filled incrementally from pushed samples
+// each block of ratio samples is reduced to one sample with mean of each row (boxcar anti aliasing
+// filter) or to two samples with min and max of each row for envelope plots, NaN values are
+// skipped, marker row keeps markers of the block in order instead of aggregate: the first one for
+// mean and the first two for min max, other markers of the block are dropped and counted
+// add_samples is called by data thread, reads go through internal DataBuffer and can be called
+// from any thread
+class DecimatedHistory
+{
+public:
+    // method is a value of DecimationTypes, capacity is in output samples
+    DecimatedHistory (int num_rows, int ratio, int method, size_t capacity, int marker_channel);
+
+    // samples are stored one after another, num_rows values each
+    void add_samples (const double *samples, size_t count);
+    // the latest samples, history is not cleared
+    size_t get_current_data (size_t max_count, double *data_buf)
+    {
+        return db.get_current_data (max_count, data_buf);
+    }
+    size_t get_data_count ()
+    {
+        return db.get_data_count ();
+    }
+    bool is_ready ()
+    {
+        return db.is_ready ();
+    }
+    int get_num_rows () const
+    {
+        return num_rows;
+    }
+    // markers which didnt fit into decimated samples of their block
+    int64_t get_dropped_markers () const
+    {
+        return dropped_markers.load ();
+    }
+
+private:
+    int num_rows;
+    int ratio;
+    int method;
+    int marker_channel;
+    DataBuffer db;
+
+    // state of the current block, used only by data thread
+    int block_pos;
+    double markers[2];
+    int num_markers;
+    std::atomic<int64_t> dropped_markers;
+    std::vector<double> sums;
+    std::vector<int> counts;
+    std::vector<double> mins;
+    std::vector<double> maxs;
+    std::vector<double> output;
+
+    void start_block ();
+    void finish_block ();
+};
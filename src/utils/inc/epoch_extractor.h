@@ -0,0 +1,56 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+#include "data_buffer.h"
+
+
+// cuts windows of pre_samples before and post_samples after each marker with one of marker_values
+// from ring buffer, epoch is copied as soon as its post window is added, up to max_epochs complete
+// epochs are queued, the oldest one is dropped if queue is full
+// add_samples is called by data thread after samples are added to ring buffer, get_epochs can be
+// called from any thread
+class EpochExtractor
+{
+public:
+    EpochExtractor (const std::vector<double> &marker_values, int pre_samples, int post_samples,
+        int max_epochs, int num_rows, int marker_channel);
+
+    void reset ();
+    // samples are stored one after another, first_index is absolute index of the first one in db
+    void add_samples (const double *samples, size_t count, uint64_t first_index, DataBuffer *db);
+    // writes epochs one after another, each as num_rows x get_epoch_size () row major matrix
+    int get_epochs (int max_epochs, double *data_buf);
+    int get_epoch_count ();
+    int get_epoch_size () const
+    {
+        return pre_samples + post_samples + 1;
+    }
+    int get_num_rows () const
+    {
+        return num_rows;
+    }
+    // markers whose window is not in ring buffer anymore
+    int64_t get_num_dropped ();
+
+private:
+    std::vector<double> marker_values;
+    int pre_samples;
+    int post_samples;
+    int max_epochs;
+    int num_rows;
+    int marker_channel;
+
+    // absolute indexes of markers waiting for post window, used only by data thread
+    std::deque<uint64_t> pending;
+
+    // complete epochs in the same layout as in ring buffer
+    std::mutex mutex;
+    std::vector<double> epochs;
+    int first_epoch;
+    int num_epochs;
+    int64_t num_dropped;
+};
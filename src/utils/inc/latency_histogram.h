@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+
+// lock free log-linear histogram for durations in nanoseconds, values below 16 have exact buckets,
+// others use 8 sub buckets per power of two so relative error of percentiles is below 12.5%
+// record can be called from any number of threads concurrently
+class LatencyHistogram
+{
+public:
+    static const int num_linear_buckets = 16;
+    static const int sub_bucket_bits = 3;
+    static const int num_buckets = num_linear_buckets + (64 - 4) * (1 << sub_bucket_bits);
+
+    LatencyHistogram ()
+    {
+        reset ();
+    }
+
+    LatencyHistogram (const LatencyHistogram &other) = delete;
+    LatencyHistogram &operator= (const LatencyHistogram &other) = delete;
+
+    void record (uint64_t value)
+    {
+        buckets[get_bucket (value)].fetch_add (1, std::memory_order_relaxed);
+        count.fetch_add (1, std::memory_order_relaxed);
+        sum.fetch_add (value, std::memory_order_relaxed);
+        uint64_t current_max = max_value.load (std::memory_order_relaxed);
+        while ((value > current_max) &&
+            (!max_value.compare_exchange_weak (current_max, value, std::memory_order_relaxed)))
+        {
+        }
+    }
+
+    // not atomic with respect to concurrent record calls, counters may be slightly inconsistent
+    void reset ()
+    {
+        for (int i = 0; i < num_buckets; i++)
+        {
+            buckets[i].store (0, std::memory_order_relaxed);
+        }
+        count.store (0, std::memory_order_relaxed);
+        sum.store (0, std::memory_order_relaxed);
+        max_value.store (0, std::memory_order_relaxed);
+    }
+
+    uint64_t get_count () const
+    {
+        return count.load (std::memory_order_relaxed);
+    }
+
+    uint64_t get_max () const
+    {
+        return max_value.load (std::memory_order_relaxed);
+    }
+
+    double get_mean () const
+    {
+        uint64_t current_count = get_count ();
+        if (current_count == 0)
+        {
+            return 0.0;
+        }
+        return (double)sum.load (std::memory_order_relaxed) / (double)current_count;
+    }
+
+    // returns upper bound of the bucket which contains requested percentile, capped by max value
+    uint64_t get_percentile (double percentile) const
+    {
+        uint64_t total = 0;
+        for (int i = 0; i < num_buckets; i++)
+        {
+            total += buckets[i].load (std::memory_order_relaxed);
+        }
+        if (total == 0)
+        {
+            return 0;
+        }
+        if (percentile < 0.0)
+        {
+            percentile = 0.0;
+        }
+        if (percentile > 100.0)
+        {
+            percentile = 100.0;
+        }
+        uint64_t rank = (uint64_t)(percentile / 100.0 * (double)total + 0.5);
+        if (rank < 1)
+        {
+            rank = 1;
+        }
+        uint64_t seen = 0;
+        for (int i = 0; i < num_buckets; i++)
+        {
+            seen += buckets[i].load (std::memory_order_relaxed);
+            if (seen >= rank)
+            {
+                uint64_t upper = get_bucket_upper_bound (i);
+                uint64_t current_max = get_max ();
+                return (upper < current_max) ? upper : current_max;
+            }
+        }
+        return get_max ();
+    }
+
+    static int get_bucket (uint64_t value)
+    {
+        if (value < (uint64_t)num_linear_buckets)
+        {
+            return (int)value;
+        }
+        int msb = get_highest_bit (value);
+        int sub_bucket = (int)((value >> (msb - sub_bucket_bits)) & ((1 << sub_bucket_bits) - 1));
+        return num_linear_buckets + ((msb - 4) << sub_bucket_bits) + sub_bucket;
+    }
+
+    static uint64_t get_bucket_upper_bound (int bucket)
+    {
+        if (bucket < num_linear_buckets)
+        {
+            return (uint64_t)bucket;
+        }
+        int msb = ((bucket - num_linear_buckets) >> sub_bucket_bits) + 4;
+        uint64_t sub_bucket =
+            (uint64_t)((bucket - num_linear_buckets) & ((1 << sub_bucket_bits) - 1));
+        uint64_t width = (uint64_t)1 << (msb - sub_bucket_bits);
+        return ((uint64_t)1 << msb) + (sub_bucket + 1) * width - 1;
+    }
+
+private:
+    std::atomic<uint64_t> buckets[num_buckets];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> max_value;
+
+    static int get_highest_bit (uint64_t value)
+    {
+        int bit = 0;
+        for (int shift = 32; shift > 0; shift >>= 1)
+        {
+            if (value >> shift)
+            {
+                value >>= shift;
+                bit += shift;
+            }
+        }
+        return bit;
+    }
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+// package loss accounting based on package counter sent by device, counter wraps after
+// 2^counter_bits values, only consecutive counters are expected
+// counters received within the last window_size packages are remembered to tell late packages
+// (previously counted as lost) from duplicates, older counters are counted as duplicates
+// update is called from a single data thread, stats can be read from any thread
+class SequenceTracker
+{
+    std::atomic<int64_t> received;
+    std::atomic<int64_t> lost;
+    std::atomic<int64_t> duplicated;
+    std::atomic<int64_t> reordered;
+    std::atomic_bool fill_lost;
+    std::atomic_int max_fill_gap;
+    bool initialized;
+    uint64_t last_package_num;
+    // bit i is set if package last_package_num - i was received
+    uint64_t window;
+
+    static void increment (std::atomic<int64_t> &counter, int64_t value)
+    {
+        // single writer, no need for read-modify-write
+        counter.store (counter.load (std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+public:
+    static const int window_size = 64;
+    // device restart looks like a huge gap, such gaps are not filled
+    static const int default_max_fill_gap = 256;
+
+    SequenceTracker ();
+
+    // returns number of packages lost right before this one
+    int update (uint64_t package_num, int counter_bits);
+    void reset ();
+
+    int64_t get_received ()
+    {
+        return received.load (std::memory_order_relaxed);
+    }
+    int64_t get_lost ()
+    {
+        return lost.load (std::memory_order_relaxed);
+    }
+    int64_t get_duplicated ()
+    {
+        return duplicated.load (std::memory_order_relaxed);
+    }
+    int64_t get_reordered ()
+    {
+        return reordered.load (std::memory_order_relaxed);
+    }
+
+    // if enabled, board pushes NaN filled packages instead of lost ones, gaps longer than
+    // max_gap packages are not filled
+    void set_fill_lost (bool enable, int max_gap = default_max_fill_gap)
+    {
+        max_fill_gap = max_gap;
+        fill_lost = enable;
+    }
+    bool get_fill_lost ()
+    {
+        return fill_lost;
+    }
+    int get_max_fill_gap ()
+    {
+        return max_fill_gap;
+    }
+};
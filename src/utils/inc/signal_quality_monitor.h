@@ -0,0 +1,83 @@
+#pragma once
+
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+
+// per channel contact quality updated incrementally from pushed samples
+// standard deviation, mean and railed ratio are exponentially weighted over window_seconds, standard
+// deviation is taken around the mean, so unlike rms it ignores dc offset of electrodes, line noise
+// amplitude at 50 and 60 Hz is computed by Goertzel over blocks of window_seconds, saturation count
+// is cumulative since reset, NaN samples are skipped
+// add_samples is called by data thread, snapshot is published every few samples and get_quality
+// only copies it so it can be called from any thread at UI rate
+class SignalQualityMonitor
+{
+public:
+    // row layout of get_quality output
+    enum Metrics
+    {
+        CHANNEL = 0,
+        STD_DEV = 1,
+        RAILED_RATIO = 2,
+        FLATLINE = 3,
+        LINE_NOISE_50 = 4,
+        LINE_NOISE_60 = 5,
+        SATURATION_COUNT = 6,
+        NUM_METRICS = 7
+    };
+
+    SignalQualityMonitor (const std::vector<int> &channels, int num_rows, double sampling_rate,
+        double window_seconds, double railed_threshold, double saturation_value,
+        double flatline_threshold);
+
+    void reset ();
+    // samples are stored one after another, num_rows values each
+    void add_samples (const double *samples, size_t count);
+    // writes num_channels x NUM_METRICS row major matrix, returns number of channels
+    int get_quality (double *output);
+    int get_num_channels () const
+    {
+        return (int)channels.size ();
+    }
+    int get_num_rows () const
+    {
+        return num_rows;
+    }
+
+private:
+    struct ChannelState
+    {
+        uint64_t count;
+        double mean;
+        double var;
+        double railed_ratio;
+        int64_t saturation_count;
+        // Goertzel state for 50 and 60 Hz
+        double s1[2];
+        double s2[2];
+        double line_noise[2];
+    };
+
+    std::vector<int> channels;
+    int num_rows;
+    double railed_threshold;
+    double saturation_value;
+    double flatline_threshold;
+    uint64_t window_size;
+    double coeffs[2];
+    bool line_supported[2];
+    uint64_t publish_interval;
+
+    // used only by data thread
+    std::vector<ChannelState> states;
+    uint64_t block_pos;
+    uint64_t since_publish;
+
+    std::mutex mutex;
+    std::vector<double> snapshot;
+
+    void update (ChannelState &state, double value);
+    void publish ();
+};
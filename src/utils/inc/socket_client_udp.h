@@ -11,6 +11,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+// max number of datagrams returned by a single recv_batch call
+#define MAX_UDP_BATCH_SIZE 64
+
 
 enum class SocketClientUDPReturnCodes : int
 {
@@ -41,6 +44,10 @@ public:
     int set_timeout (int num_seconds);
     int send (const char *data, int size);
     int recv (void *data, int size);
+    // data should have space for max_messages datagrams of message_size bytes each, returns number
+    // of received datagrams and stores their sizes, or -1 on error
+    int recv_batch (void *data, int message_size, int max_messages, int *sizes);
+    int set_recv_buffer_size (int size);
     void close ();
     int get_local_ip_addr (const char *local_ip);
     char *get_ip_addr ()
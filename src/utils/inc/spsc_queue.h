@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <vector>
+
+
+// bounded lock free queue for exactly one producer thread and one consumer thread
+// slots are preallocated, producer fills a slot in place via claim/publish and consumer reads it in
+// place via front/pop, so there is no allocation and no extra copy per element
+template <typename T>
+class SPSCQueue
+{
+public:
+    // capacity is rounded up to the power of two
+    explicit SPSCQueue (size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        slots.resize (size);
+        mask = size - 1;
+        head = 0;
+        tail = 0;
+    }
+
+    SPSCQueue (const SPSCQueue &other) = delete;
+    SPSCQueue &operator= (const SPSCQueue &other) = delete;
+
+    // producer: returns free slot or nullptr if queue is full, slot is invisible to consumer until
+    // publish is called
+    inline T *claim ()
+    {
+        const size_t current_tail = tail.load (std::memory_order_relaxed);
+        if (current_tail - head.load (std::memory_order_acquire) > mask)
+        {
+            return nullptr;
+        }
+        return &slots[current_tail & mask];
+    }
+
+    // producer: makes slot returned by the last claim available for consumer
+    inline void publish ()
+    {
+        tail.store (tail.load (std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    inline bool push (const T &value)
+    {
+        T *slot = claim ();
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        *slot = value;
+        publish ();
+        return true;
+    }
+
+    // consumer: returns oldest element or nullptr if queue is empty
+    inline T *front ()
+    {
+        const size_t current_head = head.load (std::memory_order_relaxed);
+        if (current_head == tail.load (std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &slots[current_head & mask];
+    }
+
+    // consumer: releases slot returned by front
+    inline void pop ()
+    {
+        head.store (head.load (std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // approximate if called concurrently with producer or consumer
+    size_t size () const
+    {
+        return tail.load (std::memory_order_acquire) - head.load (std::memory_order_acquire);
+    }
+
+    size_t get_capacity () const
+    {
+        return slots.size ();
+    }
+
+    // direct access to preallocated slots, only to initialize them before queue is used
+    T &get_slot (size_t index)
+    {
+        return slots[index];
+    }
+
+private:
+    std::vector<T> slots;
+    size_t mask;
+    // separate cache lines to avoid false sharing between producer and consumer
+    alignas (64) std::atomic_size_t head;
+    alignas (64) std::atomic_size_t tail;
+};
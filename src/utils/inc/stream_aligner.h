@@ -0,0 +1,75 @@
+#pragma once
+
+#include <deque>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+
+// aligns one stream to a common time axis, timestamps of incoming samples contain arrival jitter,
+// so each sample gets a time from a linear fit of timestamp vs sample index, fit forgets old
+// samples with time constant forgetting_time to follow clock drift
+// values can be requested at any non decreasing time inside [get_first_time (), get_last_time ()],
+// they are interpolated linearly and consumed samples are dropped, marker channel is not
+// interpolated: each non zero marker is returned once at the first requested time after it
+// at most max_buffered_time seconds of samples are kept, older ones are dropped with their markers
+// if values are not requested, e.g. while other stream of a group stalls
+class StreamAligner
+{
+public:
+    StreamAligner (int num_rows, int timestamp_channel, int marker_channel, double sampling_rate,
+        double forgetting_time = 30.0, double max_buffered_time = 60.0);
+
+    void reset ();
+    // data is row major num_rows x num_samples, as returned by get_board_data
+    void add_samples (const double *data, int num_samples);
+    // NaN if there are no samples
+    double get_first_time () const;
+    double get_last_time () const;
+    // writes num_rows - 1 values, timestamp channel is skipped, returns false if time is outside
+    // of buffered samples
+    bool get_values (double time, double *output);
+    // time of the first sample extrapolated back from the current fit, NaN if there are no samples
+    double get_start_time () const;
+    // sampling rate estimated from timestamps
+    double get_estimated_rate () const;
+    int get_num_rows () const
+    {
+        return num_rows;
+    }
+
+private:
+    int num_rows;
+    int timestamp_channel;
+    int marker_channel;
+    double nominal_rate;
+    double forgetting_factor;
+    size_t max_samples;
+
+    // weighted least squares sums, x is sample index relative to the newest sample, y is timestamp
+    // relative to base_time
+    double base_time;
+    double sum_w;
+    double sum_x;
+    double sum_y;
+    double sum_xx;
+    double sum_xy;
+    int64_t num_fitted;
+
+    // samples are stored one after another as fitted time followed by num_rows values
+    std::vector<double> samples;
+    size_t head;
+    std::deque<std::pair<double, double>> markers;
+
+    double fit_time (double timestamp);
+    size_t get_num_samples () const
+    {
+        return (samples.size () - head) / (num_rows + 1);
+    }
+    const double *get_sample (size_t index) const
+    {
+        return samples.data () + head + index * (num_rows + 1);
+    }
+    void drop_front ();
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+
+
+// fast uniform noise in [-scale, scale) for synthetic data, not suitable for statistics
+// lanes are independent xorshift32 generators, inner loop has no dependency between lanes and uses
+// only shifts and xors, so compilers vectorize it
+class UniformNoise
+{
+public:
+    static const int num_lanes = 8;
+
+    explicit UniformNoise (uint64_t seed = 1)
+    {
+        set_seed (seed);
+    }
+
+    void set_seed (uint64_t seed)
+    {
+        for (int i = 0; i < num_lanes; i++)
+        {
+            // splitmix64 to decorrelate lanes, xorshift state must be non zero
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            z ^= z >> 31;
+            state[i] = (uint32_t)z;
+            if (state[i] == 0)
+            {
+                state[i] = 0x6D2B79F5u;
+            }
+        }
+    }
+
+    void fill (double *output, int len, double scale)
+    {
+        const double multiplier = scale / 2147483648.0;
+        uint32_t lanes[num_lanes];
+        for (int i = 0; i < num_lanes; i++)
+        {
+            lanes[i] = state[i];
+        }
+        int i = 0;
+        for (; i + num_lanes <= len; i += num_lanes)
+        {
+            for (int j = 0; j < num_lanes; j++)
+            {
+                uint32_t x = lanes[j];
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+                lanes[j] = x;
+                output[i + j] = (double)(int32_t)x * multiplier;
+            }
+        }
+        for (int j = 0; (i < len) && (j < num_lanes); i++, j++)
+        {
+            uint32_t x = lanes[j];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            lanes[j] = x;
+            output[i] = (double)(int32_t)x * multiplier;
+        }
+        for (int j = 0; j < num_lanes; j++)
+        {
+            state[j] = lanes[j];
+        }
+    }
+
+private:
+    uint32_t state[num_lanes];
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+
+// puts irregularly timestamped samples of one preset on exact grid with nominal sampling rate
+// arrival jitter is removed by tracking expected time of each sample, timestamp jumps larger than
+// max_gap start a new segment, grid points inside gaps or next to NaN placeholders are returned as
+// gap samples: valid timestamp and NaN in other rows, gaps longer than max_fill_time are skipped
+// add_sample and next dont allocate memory, usage:
+//     resampler.add_sample (package);
+//     while (double *output = resampler.next ()) {...}
+class UniformResampler
+{
+public:
+    static constexpr double smoothing_time = 1.0;
+    static constexpr double max_gap = 0.25;
+    static constexpr double max_fill_time = 1.0;
+
+    // method is a value of ResamplingTypes, package num channel is not interpolated, -1 if absent
+    UniformResampler (int num_rows, int timestamp_channel, int package_num_channel,
+        double sampling_rate, int method);
+
+    void reset ();
+    // package with NaN timestamp is a placeholder for lost sample, it produces gap samples
+    void add_sample (const double *package);
+    // returns next grid sample ready after the last add_sample or nullptr, buffer is reused
+    double *next ();
+
+private:
+    enum class RangeTypes : int
+    {
+        INTERPOLATE = 0,
+        GAP = 1,
+        SKIP = 2,
+        ANCHOR = 3
+    };
+
+    // grid points before end_time which are produced from the same samples or gap
+    struct Range
+    {
+        RangeTypes type;
+        int64_t points[4];
+        double end_time;
+    };
+
+    static const int history_size = 4;
+
+    int num_rows;
+    int timestamp_channel;
+    int package_num_channel;
+    int method;
+    double period;
+    double alpha;
+    double beta;
+    // estimated period of device clock
+    double sample_period;
+
+    // last samples with smoothed timestamps, indexed by total sample count
+    std::vector<double> history;
+    std::vector<double> output;
+    int64_t num_samples;
+    int64_t segment_start;
+    double last_time;
+
+    double grid_start;
+    int64_t grid_index;
+
+    Range ranges[2];
+    int num_ranges;
+    int current_range;
+
+    double *get_sample (int64_t index)
+    {
+        return history.data () + (size_t)(index % history_size) * num_rows;
+    }
+    void store_sample (const double *package, double time);
+    void add_interpolation_range (int64_t first, int64_t last_in_segment);
+    void interpolate (const Range &range, double time);
+};
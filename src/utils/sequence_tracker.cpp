@@ -0,0 +1,67 @@
+#include "sequence_tracker.h"
+
+
+const int SequenceTracker::window_size;
+const int SequenceTracker::default_max_fill_gap;
+
+SequenceTracker::SequenceTracker ()
+{
+    fill_lost = false;
+    max_fill_gap = default_max_fill_gap;
+    reset ();
+}
+
+void SequenceTracker::reset ()
+{
+    received = 0;
+    lost = 0;
+    duplicated = 0;
+    reordered = 0;
+    initialized = false;
+    last_package_num = 0;
+    window = 0;
+}
+
+int SequenceTracker::update (uint64_t package_num, int counter_bits)
+{
+    if ((counter_bits < 1) || (counter_bits > 32))
+    {
+        return 0;
+    }
+    const uint64_t mask = (((uint64_t)1) << counter_bits) - 1;
+    package_num &= mask;
+    increment (received, 1);
+    if (!initialized)
+    {
+        initialized = true;
+        last_package_num = package_num;
+        window = 1;
+        return 0;
+    }
+
+    // forward distances up to half of the counter range are treated as new packages and
+    // backward distances as late or repeated packages
+    uint64_t distance = (package_num - last_package_num) & mask;
+    if ((distance != 0) && (distance - 1 <= (mask >> 1)))
+    {
+        int64_t num_lost = (int64_t)distance - 1;
+        increment (lost, num_lost);
+        window = (distance < (uint64_t)window_size) ? ((window << distance) | 1) : 1;
+        last_package_num = package_num;
+        return (int)num_lost;
+    }
+    uint64_t age = (last_package_num - package_num) & mask;
+    if ((age >= (uint64_t)window_size) || ((window >> age) & 1))
+    {
+        increment (duplicated, 1);
+        return 0;
+    }
+    // late package was already counted as lost
+    window |= ((uint64_t)1) << age;
+    increment (reordered, 1);
+    if (get_lost () > 0)
+    {
+        increment (lost, -1);
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "signal_quality_monitor.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+
+SignalQualityMonitor::SignalQualityMonitor (const std::vector<int> &channels, int num_rows,
+    double sampling_rate, double window_seconds, double railed_threshold, double saturation_value,
+    double flatline_threshold)
+{
+    this->channels = channels;
+    this->num_rows = num_rows;
+    this->railed_threshold = railed_threshold;
+    this->saturation_value = saturation_value;
+    this->flatline_threshold = flatline_threshold;
+    window_size = (uint64_t)std::max (1.0, std::round (sampling_rate * window_seconds));
+    const double line_freqs[2] = {50.0, 60.0};
+    for (int i = 0; i < 2; i++)
+    {
+        line_supported[i] = (line_freqs[i] < sampling_rate / 2.0);
+        coeffs[i] = 2.0 * std::cos (2.0 * M_PI * line_freqs[i] / sampling_rate);
+    }
+    // about 100 updates per second are enough for any UI
+    publish_interval = (uint64_t)std::max (1.0, sampling_rate / 100.0);
+    states.resize (channels.size ());
+    snapshot.resize (channels.size () * NUM_METRICS);
+    reset ();
+}
+
+void SignalQualityMonitor::reset ()
+{
+    for (ChannelState &state : states)
+    {
+        state.count = 0;
+        state.mean = 0.0;
+        state.var = 0.0;
+        state.railed_ratio = 0.0;
+        state.saturation_count = 0;
+        for (int i = 0; i < 2; i++)
+        {
+            state.s1[i] = 0.0;
+            state.s2[i] = 0.0;
+            state.line_noise[i] = std::numeric_limits<double>::quiet_NaN ();
+        }
+    }
+    block_pos = 0;
+    since_publish = 0;
+    publish ();
+}
+
+void SignalQualityMonitor::update (ChannelState &state, double value)
+{
+    double deviation = 0.0;
+    if (!std::isnan (value))
+    {
+        // plain average while the first window is filled, so estimates are valid from the start
+        state.count++;
+        double alpha = 1.0 / (double)std::min (state.count, window_size);
+        double diff = value - state.mean;
+        state.mean += alpha * diff;
+        state.var = (1.0 - alpha) * (state.var + alpha * diff * diff);
+        double magnitude = std::fabs (value);
+        state.railed_ratio +=
+            alpha * (((magnitude >= railed_threshold) ? 1.0 : 0.0) - state.railed_ratio);
+        if (magnitude >= saturation_value)
+        {
+            state.saturation_count++;
+        }
+        deviation = value - state.mean;
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        double s0 = deviation + coeffs[i] * state.s1[i] - state.s2[i];
+        state.s2[i] = state.s1[i];
+        state.s1[i] = s0;
+    }
+}
+
+void SignalQualityMonitor::add_samples (const double *samples, size_t count)
+{
+    const size_t num_channels = channels.size ();
+    for (size_t i = 0; i < count; i++)
+    {
+        const double *sample = samples + i * num_rows;
+        for (size_t j = 0; j < num_channels; j++)
+        {
+            update (states[j], sample[channels[j]]);
+        }
+        block_pos++;
+        if (block_pos == window_size)
+        {
+            for (ChannelState &state : states)
+            {
+                for (int k = 0; k < 2; k++)
+                {
+                    double power = state.s1[k] * state.s1[k] + state.s2[k] * state.s2[k] -
+                        coeffs[k] * state.s1[k] * state.s2[k];
+                    state.line_noise[k] = 2.0 * std::sqrt (std::max (0.0, power)) / window_size;
+                    state.s1[k] = 0.0;
+                    state.s2[k] = 0.0;
+                }
+            }
+            block_pos = 0;
+        }
+        since_publish++;
+        if (since_publish >= publish_interval)
+        {
+            publish ();
+            since_publish = 0;
+        }
+    }
+}
+
+void SignalQualityMonitor::publish ()
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN ();
+    std::lock_guard<std::mutex> lock (mutex);
+    for (size_t i = 0; i < states.size (); i++)
+    {
+        const ChannelState &state = states[i];
+        double *row = snapshot.data () + i * NUM_METRICS;
+        double std_dev = (state.count == 0) ? nan : std::sqrt (state.var);
+        row[CHANNEL] = (double)channels[i];
+        row[STD_DEV] = std_dev;
+        row[RAILED_RATIO] = (state.count == 0) ? nan : state.railed_ratio;
+        // dont report flat channel until the first window is filled
+        row[FLATLINE] =
+            ((state.count >= window_size) && (std_dev < flatline_threshold)) ? 1.0 : 0.0;
+        row[LINE_NOISE_50] = line_supported[0] ? state.line_noise[0] : nan;
+        row[LINE_NOISE_60] = line_supported[1] ? state.line_noise[1] : nan;
+        row[SATURATION_COUNT] = (double)state.saturation_count;
+    }
+}
+
+int SignalQualityMonitor::get_quality (double *output)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    std::copy (snapshot.begin (), snapshot.end (), output);
+    return (int)channels.size ();
+}
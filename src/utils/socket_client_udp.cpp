@@ -227,6 +227,59 @@ int SocketClientUDP::recv (void *data, int size)
     return res;
 }
 
+// no recvmmsg on windows, block for the first datagram and drain queued ones while FIONREAD
+// reports pending data, so recv never blocks after the first datagram
+int SocketClientUDP::recv_batch (void *data, int message_size, int max_messages, int *sizes)
+{
+    if ((data == NULL) || (sizes == NULL) || (max_messages < 1))
+    {
+        return -1;
+    }
+    if (max_messages > MAX_UDP_BATCH_SIZE)
+    {
+        max_messages = MAX_UDP_BATCH_SIZE;
+    }
+    int res = recv (data, message_size);
+    if (res < 0)
+    {
+        return -1;
+    }
+    sizes[0] = res;
+    int num_messages = 1;
+    while (num_messages < max_messages)
+    {
+        u_long available = 0;
+        if ((ioctlsocket (connect_socket, FIONREAD, &available) != 0) || (available == 0))
+        {
+            break;
+        }
+        res = recv ((char *)data + (size_t)num_messages * message_size, message_size);
+        if (res < 0)
+        {
+            break;
+        }
+        sizes[num_messages++] = res;
+    }
+    return num_messages;
+}
+
+int SocketClientUDP::set_recv_buffer_size (int size)
+{
+    if (size < 1)
+    {
+        return (int)SocketClientUDPReturnCodes::INVALID_ARGUMENT_ERROR;
+    }
+    if (connect_socket == INVALID_SOCKET)
+    {
+        return (int)SocketClientUDPReturnCodes::CREATE_SOCKET_ERROR;
+    }
+    if (setsockopt (connect_socket, SOL_SOCKET, SO_RCVBUF, (char *)&size, sizeof (size)) != 0)
+    {
+        return (int)SocketClientUDPReturnCodes::INVALID_ARGUMENT_ERROR;
+    }
+    return (int)SocketClientUDPReturnCodes::STATUS_OK;
+}
+
 void SocketClientUDP::close ()
 {
     closesocket (connect_socket);
@@ -428,6 +481,82 @@ int SocketClientUDP::recv (void *data, int size)
     return res;
 }
 
+// on linux read all queued datagrams with a single syscall, blocks only for the first one
+int SocketClientUDP::recv_batch (void *data, int message_size, int max_messages, int *sizes)
+{
+    if ((data == NULL) || (sizes == NULL) || (max_messages < 1))
+    {
+        return -1;
+    }
+#ifdef __linux__
+    if (max_messages > MAX_UDP_BATCH_SIZE)
+    {
+        max_messages = MAX_UDP_BATCH_SIZE;
+    }
+    struct mmsghdr msgs[MAX_UDP_BATCH_SIZE];
+    struct iovec iovecs[MAX_UDP_BATCH_SIZE];
+    memset (msgs, 0, sizeof (struct mmsghdr) * max_messages);
+    for (int i = 0; i < max_messages; i++)
+    {
+        iovecs[i].iov_base = (char *)data + (size_t)i * message_size;
+        iovecs[i].iov_len = message_size;
+        msgs[i].msg_hdr.msg_iov = &iovecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int res = recvmmsg (connect_socket, msgs, max_messages, MSG_WAITFORONE, NULL);
+    if (res < 0)
+    {
+        return -1;
+    }
+    for (int i = 0; i < res; i++)
+    {
+        sizes[i] = (int)msgs[i].msg_len;
+    }
+    return res;
+#else
+    // no recvmmsg, block for the first datagram and drain queued ones without blocking
+    if (max_messages > MAX_UDP_BATCH_SIZE)
+    {
+        max_messages = MAX_UDP_BATCH_SIZE;
+    }
+    int res = recv (data, message_size);
+    if (res < 0)
+    {
+        return -1;
+    }
+    sizes[0] = res;
+    int num_messages = 1;
+    while (num_messages < max_messages)
+    {
+        res = (int)recvfrom (connect_socket, (char *)data + (size_t)num_messages * message_size,
+            message_size, MSG_DONTWAIT, NULL, 0);
+        if (res < 0)
+        {
+            break;
+        }
+        sizes[num_messages++] = res;
+    }
+    return num_messages;
+#endif
+}
+
+int SocketClientUDP::set_recv_buffer_size (int size)
+{
+    if (size < 1)
+    {
+        return (int)SocketClientUDPReturnCodes::INVALID_ARGUMENT_ERROR;
+    }
+    if (connect_socket < 0)
+    {
+        return (int)SocketClientUDPReturnCodes::CREATE_SOCKET_ERROR;
+    }
+    if (setsockopt (connect_socket, SOL_SOCKET, SO_RCVBUF, (const char *)&size, sizeof (size)) != 0)
+    {
+        return (int)SocketClientUDPReturnCodes::INVALID_ARGUMENT_ERROR;
+    }
+    return (int)SocketClientUDPReturnCodes::STATUS_OK;
+}
+
 void SocketClientUDP::close ()
 {
     ::close (connect_socket);
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <math.h>
+
+#include "stream_aligner.h"
+
+
+StreamAligner::StreamAligner (int num_rows, int timestamp_channel, int marker_channel,
+    double sampling_rate, double forgetting_time, double max_buffered_time)
+{
+    this->num_rows = num_rows;
+    this->timestamp_channel = timestamp_channel;
+    this->marker_channel = marker_channel;
+    nominal_rate = (sampling_rate > 0.0) ? sampling_rate : 1.0;
+    forgetting_factor = exp (-1.0 / (nominal_rate * forgetting_time));
+    max_samples = (size_t)std::max (1.0, ceil (nominal_rate * max_buffered_time));
+    reset ();
+}
+
+void StreamAligner::reset ()
+{
+    base_time = 0.0;
+    sum_w = 0.0;
+    sum_x = 0.0;
+    sum_y = 0.0;
+    sum_xx = 0.0;
+    sum_xy = 0.0;
+    num_fitted = 0;
+    samples.clear ();
+    head = 0;
+    markers.clear ();
+}
+
+// placeholders for lost packages have no timestamp, they still advance sample index and get time
+// extrapolated from the fit
+double StreamAligner::fit_time (double timestamp)
+{
+    bool is_valid = !isnan (timestamp);
+    if (sum_w == 0.0)
+    {
+        if (!is_valid)
+        {
+            return NAN;
+        }
+        base_time = timestamp;
+    }
+    // move origin to the new sample: x of previous samples decreases by one
+    sum_xx = sum_xx - 2.0 * sum_x + sum_w;
+    sum_xy = sum_xy - sum_y;
+    sum_x = sum_x - sum_w;
+    sum_w *= forgetting_factor;
+    sum_x *= forgetting_factor;
+    sum_y *= forgetting_factor;
+    sum_xx *= forgetting_factor;
+    sum_xy *= forgetting_factor;
+    if (is_valid)
+    {
+        sum_w += 1.0;
+        sum_y += timestamp - base_time;
+    }
+    num_fitted++;
+
+    double det = sum_w * sum_xx - sum_x * sum_x;
+    if ((sum_w < 2.0) || (fabs (det) < 1e-12))
+    {
+        return is_valid ? timestamp : NAN;
+    }
+    // intercept at x = 0, i.e. fitted time of the newest sample
+    return base_time + (sum_y * sum_xx - sum_x * sum_xy) / det;
+}
+
+double StreamAligner::get_estimated_rate () const
+{
+    double det = sum_w * sum_xx - sum_x * sum_x;
+    if ((sum_w < 2.0) || (fabs (det) < 1e-12))
+    {
+        return nominal_rate;
+    }
+    double period = (sum_w * sum_xy - sum_x * sum_y) / det;
+    return (period > 0.0) ? 1.0 / period : nominal_rate;
+}
+
+double StreamAligner::get_start_time () const
+{
+    if (num_fitted == 0)
+    {
+        return NAN;
+    }
+    double det = sum_w * sum_xx - sum_x * sum_x;
+    if ((sum_w < 2.0) || (fabs (det) < 1e-12))
+    {
+        return base_time;
+    }
+    double intercept = (sum_y * sum_xx - sum_x * sum_xy) / det;
+    return base_time + intercept - (double)(num_fitted - 1) / get_estimated_rate ();
+}
+
+void StreamAligner::add_samples (const double *data, int num_samples)
+{
+    const int stride = num_rows + 1;
+    size_t offset = samples.size ();
+    samples.resize (offset + (size_t)num_samples * stride);
+    for (int i = 0; i < num_samples; i++)
+    {
+        double *sample = samples.data () + offset;
+        for (int j = 0; j < num_rows; j++)
+        {
+            sample[j + 1] = data[(size_t)j * num_samples + i];
+        }
+        sample[0] = fit_time (sample[timestamp_channel + 1]);
+        if (isnan (sample[0]))
+        {
+            continue;
+        }
+        if ((marker_channel >= 0) && (sample[marker_channel + 1] != 0.0))
+        {
+            markers.push_back (std::make_pair (sample[0], sample[marker_channel + 1]));
+        }
+        offset += stride;
+    }
+    samples.resize (offset);
+    if (get_num_samples () > max_samples)
+    {
+        head += (get_num_samples () - max_samples) * stride;
+        samples.erase (samples.begin (), samples.begin () + head);
+        head = 0;
+        while ((!markers.empty ()) && (markers.front ().first < get_sample (0)[0]))
+        {
+            markers.pop_front ();
+        }
+    }
+}
+
+double StreamAligner::get_first_time () const
+{
+    return (get_num_samples () == 0) ? NAN : get_sample (0)[0];
+}
+
+double StreamAligner::get_last_time () const
+{
+    size_t num_samples = get_num_samples ();
+    return (num_samples == 0) ? NAN : get_sample (num_samples - 1)[0];
+}
+
+void StreamAligner::drop_front ()
+{
+    head += num_rows + 1;
+    // compact storage once consumed part is larger than remaining one
+    if (head * 2 > samples.size ())
+    {
+        samples.erase (samples.begin (), samples.begin () + head);
+        head = 0;
+    }
+}
+
+bool StreamAligner::get_values (double time, double *output)
+{
+    while ((get_num_samples () > 1) && (get_sample (1)[0] <= time))
+    {
+        drop_front ();
+    }
+    size_t num_samples = get_num_samples ();
+    if ((num_samples == 0) || (time < get_sample (0)[0]) ||
+        ((num_samples == 1) && (time > get_sample (0)[0])))
+    {
+        return false;
+    }
+    const double *left = get_sample (0);
+    const double *right = (num_samples > 1) ? get_sample (1) : left;
+    double weight = (right[0] > left[0]) ? (time - left[0]) / (right[0] - left[0]) : 0.0;
+    int output_channel = 0;
+    for (int j = 0; j < num_rows; j++)
+    {
+        if (j == timestamp_channel)
+        {
+            continue;
+        }
+        if (j == marker_channel)
+        {
+            output[output_channel] = 0.0;
+            if ((!markers.empty ()) && (markers.front ().first <= time))
+            {
+                output[output_channel] = markers.front ().second;
+                markers.pop_front ();
+            }
+        }
+        else
+        {
+            output[output_channel] = left[j + 1] + weight * (right[j + 1] - left[j + 1]);
+        }
+        output_channel++;
+    }
+    return true;
+}
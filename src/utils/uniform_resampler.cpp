@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <limits>
+#include <math.h>
+#include <string.h>
+
+#include "brainflow_constants.h"
+#include "uniform_resampler.h"
+
+
+UniformResampler::UniformResampler (int num_rows, int timestamp_channel, int package_num_channel,
+    double sampling_rate, int method)
+{
+    this->num_rows = num_rows;
+    this->timestamp_channel = timestamp_channel;
+    this->package_num_channel = package_num_channel;
+    this->method = method;
+    period = 1.0 / sampling_rate;
+    // second order loop tracks both time and real sample period of device clock, so there is no
+    // steady lag if device rate differs from nominal, critically damped with time constant
+    // smoothing_time
+    double omega = std::min (0.5, period / smoothing_time);
+    alpha = 1.414 * omega;
+    beta = omega * omega;
+    history.resize ((size_t)history_size * num_rows);
+    output.resize ((size_t)num_rows);
+    reset ();
+}
+
+void UniformResampler::reset ()
+{
+    num_samples = 0;
+    segment_start = 0;
+    last_time = 0.0;
+    sample_period = period;
+    grid_start = 0.0;
+    grid_index = 0;
+    num_ranges = 0;
+    current_range = 0;
+}
+
+void UniformResampler::store_sample (const double *package, double time)
+{
+    double *sample = get_sample (num_samples);
+    memcpy (sample, package, sizeof (double) * num_rows);
+    sample[timestamp_channel] = time;
+    last_time = time;
+    num_samples++;
+}
+
+void UniformResampler::add_interpolation_range (int64_t first, int64_t last_in_segment)
+{
+    Range &range = ranges[num_ranges++];
+    range.type = RangeTypes::INTERPOLATE;
+    range.points[0] = std::max (first - 1, segment_start);
+    range.points[1] = first;
+    range.points[2] = first + 1;
+    range.points[3] = std::min (first + 2, last_in_segment);
+    range.end_time = get_sample (first + 1)[timestamp_channel];
+}
+
+void UniformResampler::add_sample (const double *package)
+{
+    num_ranges = 0;
+    current_range = 0;
+    double timestamp = package[timestamp_channel];
+    int64_t segment_size = num_samples - segment_start;
+    if (segment_size == 0)
+    {
+        // placeholder before the first sample has no time
+        if (isnan (timestamp))
+        {
+            return;
+        }
+        grid_start = timestamp;
+        grid_index = 0;
+        store_sample (package, timestamp);
+        return;
+    }
+
+    double expected_time = last_time + sample_period;
+    double diff = isnan (timestamp) ? 0.0 : timestamp - expected_time;
+    if (fabs (diff) > max_gap)
+    {
+        // close current segment and start a new one from this package
+        int64_t last = num_samples - 1;
+        if ((method == (int)ResamplingTypes::CUBIC) && (segment_size > 1))
+        {
+            add_interpolation_range (last - 1, last);
+        }
+        Range &range = ranges[num_ranges++];
+        range.end_time = timestamp;
+        if (diff < 0.0)
+        {
+            range.type = RangeTypes::ANCHOR;
+        }
+        else if (timestamp - last_time > max_fill_time)
+        {
+            range.type = RangeTypes::SKIP;
+        }
+        else
+        {
+            range.type = RangeTypes::GAP;
+        }
+        segment_start = num_samples;
+        store_sample (package, timestamp);
+        return;
+    }
+
+    store_sample (package, expected_time + alpha * diff);
+    sample_period = std::max (0.9 * period, std::min (1.1 * period, sample_period + beta * diff));
+    int64_t last = num_samples - 1;
+    if (method == (int)ResamplingTypes::CUBIC)
+    {
+        if (segment_size >= 2)
+        {
+            add_interpolation_range (last - 2, last);
+        }
+    }
+    else
+    {
+        add_interpolation_range (last - 1, last);
+    }
+}
+
+double *UniformResampler::next ()
+{
+    while (current_range < num_ranges)
+    {
+        const Range &range = ranges[current_range];
+        if (range.type == RangeTypes::ANCHOR)
+        {
+            // timestamps went back, restart grid from the new segment
+            grid_start = range.end_time;
+            grid_index = 0;
+            current_range++;
+            continue;
+        }
+        if (range.type == RangeTypes::SKIP)
+        {
+            int64_t first_index = (int64_t)ceil ((range.end_time - grid_start) / period - 1e-9);
+            grid_index = std::max (grid_index, first_index);
+            current_range++;
+            continue;
+        }
+        double time = grid_start + (double)grid_index * period;
+        if (time >= range.end_time)
+        {
+            current_range++;
+            continue;
+        }
+        if (range.type == RangeTypes::GAP)
+        {
+            std::fill (output.begin (), output.end (), std::numeric_limits<double>::quiet_NaN ());
+        }
+        else
+        {
+            interpolate (range, time);
+        }
+        output[timestamp_channel] = time;
+        grid_index++;
+        return output.data ();
+    }
+    return nullptr;
+}
+
+void UniformResampler::interpolate (const Range &range, double time)
+{
+    const double *p0 = get_sample (range.points[0]);
+    const double *p1 = get_sample (range.points[1]);
+    const double *p2 = get_sample (range.points[2]);
+    const double *p3 = get_sample (range.points[3]);
+    double start_time = p1[timestamp_channel];
+    double u = (time - start_time) / (range.end_time - start_time);
+    u = std::max (0.0, std::min (1.0, u));
+    if (method == (int)ResamplingTypes::CUBIC)
+    {
+        // catmull-rom spline, NaN in any of 4 samples makes result NaN
+        for (int i = 0; i < num_rows; i++)
+        {
+            output[i] = p1[i] +
+                0.5 * u *
+                    (p2[i] - p0[i] +
+                        u * (2.0 * p0[i] - 5.0 * p1[i] + 4.0 * p2[i] - p3[i] +
+                                u * (3.0 * (p1[i] - p2[i]) + p3[i] - p0[i])));
+        }
+    }
+    else
+    {
+        for (int i = 0; i < num_rows; i++)
+        {
+            output[i] = p1[i] + u * (p2[i] - p1[i]);
+        }
+    }
+    if (package_num_channel >= 0)
+    {
+        output[package_num_channel] = p1[package_num_channel];
+    }
+}